@@ -8,6 +8,9 @@
 #include <stddef.h>//size_t
 #include <array>
 #include <algorithm>
+#include <bit>//std::countr_zero
+
+#include "SIMD_Define.h"//指令集判断
 
 /// @file
 /// @brief Java Modified-UTF-8工具集
@@ -560,6 +563,299 @@ private:
 		u8CharArr[3] = (uint8_t)(((u32RawChar & (uint32_t)0b0000'0000'0000'0000'0000'0000'0011'1111) >>  0) | (uint32_t)0b1000'0000);//10 + 5-0   6bit
 	}
 
+private:
+	//运行期批量扫描辅助：找出从起始位置开始连续的、转换时无需任何处理的字符，
+	//这样转换例程可以按块跳过或批量拷贝它们，只把真正需要转换的字符交给下面的标量解码流程。
+	//以下函数均不可在编译期求值，调用方需要用std::is_constant_evaluated()隔开
+
+	//普通字节扫描模式
+	enum class ScanMode
+	{
+		U8Normal,//UTF-8到M-UTF-8：遇到0x00或0xF0及以上的字节停止
+		MU8Normal,//M-UTF-8到UTF-8：遇到0xC0或0xE0~0xEF的字节停止
+	};
+
+	template<ScanMode enMode>
+	static constexpr bool IsStopByte(uint8_t u8Byte) noexcept
+	{
+		if constexpr (enMode == ScanMode::U8Normal)
+		{
+			return u8Byte == 0x00 || u8Byte >= 0xF0;
+		}
+		else
+		{
+			return u8Byte == 0xC0 || (u8Byte & 0xF0) == 0xE0;
+		}
+	}
+
+	//返回从pData开始连续的非停止字节数
+	//注意停止字节的判断可以比标量流程更保守（比如U8模式下0xF8~0xFF也会停止），
+	//多停下来的字节会由标量流程按普通字节处理，结果不受影响
+	template<ScanMode enMode>
+	static size_t NormalRunLength(const uint8_t *pData, size_t szLength) noexcept
+	{
+		size_t i = 0;
+
+#if CJF2_NBT_CPP_SIMD_AVX2
+		{
+			const __m256i vZero = _mm256_setzero_si256();
+
+			for (; i + 32 <= szLength; i += 32)
+			{
+				__m256i v = _mm256_loadu_si256((const __m256i *)&pData[i]);
+				__m256i vStop{};
+
+				if constexpr (enMode == ScanMode::U8Normal)
+				{
+					vStop = _mm256_or_si256(_mm256_cmpeq_epi8(v, vZero),
+						_mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8((char)0xF0)), v));
+				}
+				else
+				{
+					vStop = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8((char)0xC0)),
+						_mm256_cmpeq_epi8(_mm256_and_si256(v, _mm256_set1_epi8((char)0xF0)), _mm256_set1_epi8((char)0xE0)));
+				}
+
+				uint32_t u32Mask = (uint32_t)_mm256_movemask_epi8(vStop);
+				if (u32Mask != 0)
+				{
+					return i + std::countr_zero(u32Mask);
+				}
+			}
+		}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_SSE2
+		{
+			const __m128i vZero = _mm_setzero_si128();
+
+			for (; i + 16 <= szLength; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i *)&pData[i]);
+				__m128i vStop{};
+
+				if constexpr (enMode == ScanMode::U8Normal)
+				{
+					vStop = _mm_or_si128(_mm_cmpeq_epi8(v, vZero),
+						_mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8((char)0xF0)), v));
+				}
+				else
+				{
+					vStop = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)0xC0)),
+						_mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char)0xF0)), _mm_set1_epi8((char)0xE0)));
+				}
+
+				uint32_t u32Mask = (uint32_t)_mm_movemask_epi8(vStop);
+				if (u32Mask != 0)
+				{
+					return i + std::countr_zero(u32Mask);
+				}
+			}
+		}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_NEON
+		{
+			for (; i + 16 <= szLength; i += 16)
+			{
+				uint8x16_t v = vld1q_u8(&pData[i]);
+				uint8x16_t vStop{};
+
+				if constexpr (enMode == ScanMode::U8Normal)
+				{
+					vStop = vorrq_u8(vceqq_u8(v, vdupq_n_u8(0x00)), vcgeq_u8(v, vdupq_n_u8(0xF0)));
+				}
+				else
+				{
+					vStop = vorrq_u8(vceqq_u8(v, vdupq_n_u8(0xC0)), vceqq_u8(vandq_u8(v, vdupq_n_u8(0xF0)), vdupq_n_u8(0xE0)));
+				}
+
+				uint64x2_t vStop64 = vreinterpretq_u64_u8(vStop);
+				if ((vgetq_lane_u64(vStop64, 0) | vgetq_lane_u64(vStop64, 1)) != 0)
+				{
+					break;//交给下面的标量流程找出具体位置
+				}
+			}
+		}
+#endif
+
+		//标量回落：先按8字节一组判断是否全为非0的ASCII（两种模式下都不会停止），再逐字节判断
+		constexpr uint64_t u64Low = 0x0101'0101'0101'0101;
+		constexpr uint64_t u64High = 0x8080'8080'8080'8080;
+		for (; i + 8 <= szLength; i += 8)
+		{
+			uint64_t u64Word{};
+			memcpy(&u64Word, &pData[i], sizeof(u64Word));
+
+			if (((u64Word | ((u64Word - u64Low) & ~u64Word)) & u64High) != 0)//存在高位字节或0字节
+			{
+				break;
+			}
+		}
+
+		for (; i < szLength; ++i)
+		{
+			if (IsStopByte<enMode>(pData[i]))
+			{
+				break;
+			}
+		}
+
+		return i;
+	}
+
+	//把从pSrc开始连续的ASCII字节（0x00~0x7F）扩展为UTF-16码元写入pDest，返回处理的数量
+	static size_t WidenAsciiRun(const MU8T *pSrc, size_t szLength, U16T *pDest) noexcept
+	{
+		[[maybe_unused]] const uint8_t *pSrcByte = (const uint8_t *)pSrc;
+		size_t i = 0;
+
+#if CJF2_NBT_CPP_SIMD_AVX2
+		for (; i + 16 <= szLength; i += 16)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i *)&pSrcByte[i]);
+			if (_mm_movemask_epi8(v) != 0)
+			{
+				break;
+			}
+
+			_mm256_storeu_si256((__m256i *)&pDest[i], _mm256_cvtepu8_epi16(v));
+		}
+#elif CJF2_NBT_CPP_SIMD_SSE2
+		{
+			const __m128i vZero = _mm_setzero_si128();
+
+			for (; i + 16 <= szLength; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i *)&pSrcByte[i]);
+				if (_mm_movemask_epi8(v) != 0)
+				{
+					break;
+				}
+
+				_mm_storeu_si128((__m128i *)&pDest[i + 0], _mm_unpacklo_epi8(v, vZero));
+				_mm_storeu_si128((__m128i *)&pDest[i + 8], _mm_unpackhi_epi8(v, vZero));
+			}
+		}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_NEON
+		for (; i + 16 <= szLength; i += 16)
+		{
+			uint8x16_t v = vld1q_u8(&pSrcByte[i]);
+
+			uint64x2_t vHigh64 = vreinterpretq_u64_u8(vandq_u8(v, vdupq_n_u8(0x80)));
+			if ((vgetq_lane_u64(vHigh64, 0) | vgetq_lane_u64(vHigh64, 1)) != 0)
+			{
+				break;
+			}
+
+			vst1q_u16((uint16_t *)&pDest[i + 0], vmovl_u8(vget_low_u8(v)));
+			vst1q_u16((uint16_t *)&pDest[i + 8], vmovl_u8(vget_high_u8(v)));
+		}
+#endif
+
+		for (; i < szLength; ++i)
+		{
+			uint8_t u8Byte = (uint8_t)pSrc[i];
+			if ((u8Byte & 0x80) != 0)
+			{
+				break;
+			}
+
+			pDest[i] = (U16T)u8Byte;
+		}
+
+		return i;
+	}
+
+	//把从pSrc开始连续的单字节码点（0x0001~0x007F）收窄为M-UTF-8字节写入pDest，返回处理的数量
+	//判断方法：(u16 - 1)的高9位全为0，当且仅当u16在1~0x7F之间（0减1会回绕到0xFFFF）
+	static size_t NarrowAsciiRun(const U16T *pSrc, size_t szLength, MU8T *pDest) noexcept
+	{
+		[[maybe_unused]] uint8_t *pDestByte = (uint8_t *)pDest;
+		size_t i = 0;
+
+#if CJF2_NBT_CPP_SIMD_AVX2
+		{
+			const __m256i vOne = _mm256_set1_epi16(1);
+			const __m256i vHigh = _mm256_set1_epi16((short)0xFF80);
+
+			for (; i + 32 <= szLength; i += 32)
+			{
+				__m256i v0 = _mm256_loadu_si256((const __m256i *)&pSrc[i + 0]);
+				__m256i v1 = _mm256_loadu_si256((const __m256i *)&pSrc[i + 16]);
+
+				__m256i vBad = _mm256_and_si256(_mm256_or_si256(_mm256_sub_epi16(v0, vOne), _mm256_sub_epi16(v1, vOne)), vHigh);
+				if (!_mm256_testz_si256(vBad, vBad))
+				{
+					break;
+				}
+
+				//256位打包是按128位通道交错的，需要重排回顺序
+				__m256i vPack = _mm256_permute4x64_epi64(_mm256_packus_epi16(v0, v1), 0b11'01'10'00);
+				_mm256_storeu_si256((__m256i *)&pDestByte[i], vPack);
+			}
+		}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_SSE2
+		{
+			const __m128i vOne = _mm_set1_epi16(1);
+			const __m128i vHigh = _mm_set1_epi16((short)0xFF80);
+			const __m128i vZero = _mm_setzero_si128();
+
+			for (; i + 16 <= szLength; i += 16)
+			{
+				__m128i v0 = _mm_loadu_si128((const __m128i *)&pSrc[i + 0]);
+				__m128i v1 = _mm_loadu_si128((const __m128i *)&pSrc[i + 8]);
+
+				__m128i vBad = _mm_and_si128(_mm_or_si128(_mm_sub_epi16(v0, vOne), _mm_sub_epi16(v1, vOne)), vHigh);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(vBad, vZero)) != 0xFFFF)
+				{
+					break;
+				}
+
+				_mm_storeu_si128((__m128i *)&pDestByte[i], _mm_packus_epi16(v0, v1));
+			}
+		}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_NEON
+		{
+			const uint16x8_t vOne = vdupq_n_u16(1);
+			const uint16x8_t vHigh = vdupq_n_u16(0xFF80);
+
+			for (; i + 16 <= szLength; i += 16)
+			{
+				uint16x8_t v0 = vld1q_u16((const uint16_t *)&pSrc[i + 0]);
+				uint16x8_t v1 = vld1q_u16((const uint16_t *)&pSrc[i + 8]);
+
+				uint64x2_t vBad64 = vreinterpretq_u64_u16(vandq_u16(vorrq_u16(vsubq_u16(v0, vOne), vsubq_u16(v1, vOne)), vHigh));
+				if ((vgetq_lane_u64(vBad64, 0) | vgetq_lane_u64(vBad64, 1)) != 0)
+				{
+					break;
+				}
+
+				vst1q_u8(&pDestByte[i], vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+			}
+		}
+#endif
+
+		for (; i < szLength; ++i)
+		{
+			uint16_t u16Char = (uint16_t)pSrc[i];
+			if (((uint16_t)(u16Char - 1) & 0xFF80) != 0)
+			{
+				break;
+			}
+
+			pDest[i] = (MU8T)u16Char;
+		}
+
+		return i;
+	}
+
 private:
 ///@cond
 
@@ -588,6 +884,26 @@ private:
 			U16T u16Char = *it;//第一次
 			if (IN_RANGE(u16Char, 0x0001, 0x007F))//单字节码点
 			{
+				if (!std::is_constant_evaluated())//运行期按块收窄连续的单字节码点
+				{
+					MU8T mu8Buffer[128];
+					while (true)
+					{
+						size_t szChunk = std::min((size_t)(end - it), sizeof(mu8Buffer) / sizeof(MU8T));
+						size_t szRun = NarrowAsciiRun(it, szChunk, mu8Buffer);
+						mu8String.append(mu8Buffer, szRun);
+						it += szRun;
+
+						if (szRun != szChunk || it == end)
+						{
+							break;
+						}
+					}
+
+					--it;//当前至少处理了一个，回退到最后处理的位置，for会重新++it
+					continue;
+				}
+
 				MU8T mu8Char[1]{};
 				EncodeMUTF8Bmp(u16Char, mu8Char);
 				mu8String.append(mu8Char, sizeof(mu8Char) / sizeof(MU8T));
@@ -662,6 +978,26 @@ private:
 			//判断是几字节的mu8
 			if (HAS_BITMASK(mu8Char, 0b1000'0000, 0b0000'0000))//最高位为0，单字节码点
 			{
+				if (!std::is_constant_evaluated())//运行期按块扩展连续的单字节码点
+				{
+					U16T u16Buffer[128];
+					while (true)
+					{
+						size_t szChunk = std::min((size_t)(end - it), sizeof(u16Buffer) / sizeof(U16T));
+						size_t szRun = WidenAsciiRun(it, szChunk, u16Buffer);
+						u16String.append(u16Buffer, szRun);
+						it += szRun;
+
+						if (szRun != szChunk || it == end)
+						{
+							break;
+						}
+					}
+
+					--it;//当前至少处理了一个，回退到最后处理的位置，for会重新++it
+					continue;
+				}
+
 				//放入数组
 				MU8T mu8CharArr[1] = { mu8Char };
 
@@ -895,6 +1231,13 @@ private:
 			else//都不是，递增普通字符长度，直到遇到特殊字符的时候插入
 			{
 				++szNormalLength;
+
+				if (!std::is_constant_evaluated())//运行期一次性跳过后续连续的普通字节
+				{
+					size_t szRun = NormalRunLength<ScanMode::U8Normal>((const uint8_t *)(it + 1), (size_t)(end - (it + 1)));
+					szNormalLength += szRun;
+					it += szRun;
+				}
 			}
 		}
 		//结束后再插入一次，因为for内可能完全没有进入过任何一个特殊块，
@@ -1037,6 +1380,13 @@ private:
 			else
 			{
 				++szNormalLength;//普通字符，递增
+
+				if (!std::is_constant_evaluated())//运行期一次性跳过后续连续的普通字节
+				{
+					size_t szRun = NormalRunLength<ScanMode::MU8Normal>((const uint8_t *)(it + 1), (size_t)(end - (it + 1)));
+					szNormalLength += szRun;
+					it += szRun;
+				}
 				continue;//继续
 			}
 		}
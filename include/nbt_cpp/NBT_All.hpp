@@ -7,10 +7,20 @@
 #include "NBT_Node.hpp"
 #include "NBT_Node_View.hpp"
 #include "NBT_Helper.hpp"
+#include "NBT_SNBT_Reader.hpp"
 #include "NBT_Scanner.hpp"
+#include "NBT_PathQuery.hpp"
 #include "NBT_Reader.hpp"
+#include "NBT_KeyPool.hpp"
+#include "NBT_LazyCompound.hpp"
+#include "NBT_Borrowed.hpp"
 #include "NBT_Writer.hpp"
+#include "NBT_Format.hpp"
 #include "NBT_IO.hpp"
+#include "NBT_RegionFile.hpp"
+#include "NBT_RegionWriter.hpp"
+#include "NBT_Allocator.hpp"
+#include "NBT_FlatMap.hpp"
 
 /*
 此头文件包含所有公开可选NBT模块
@@ -20,10 +30,14 @@
 目前的可选接口有：
 #define CJF2_NBT_CPP_USE_ZLIB//安装zlib库的情况下
 #define CJF2_NBT_CPP_USE_XXHASH//安装xxhash库的情况下
+#define CJF2_NBT_CPP_USE_ARENA_ALLOCATOR//无需额外的库，需要在包含任何头文件前定义
+#define CJF2_NBT_CPP_USE_FLAT_COMPOUND//无需额外的库，需要在包含任何头文件前定义
 
 解锁的功能有：
 NBT_IO中的nbt压缩
 NBT_Helper中的nbt哈希
+NBT_Type中的容器使用NBT_Allocator（配合NBT_ArenaScope）
+NBT_Type中的Compound使用NBT_FlatMap作为底层容器
 
 说明：
 vcpkg安装本库会自动在vcpkg_config.h头文件中
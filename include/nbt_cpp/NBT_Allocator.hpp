@@ -0,0 +1,180 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <stddef.h>//size_t
+#include <memory_resource>//std::pmr::memory_resource
+#include <type_traits>//std::true_type
+
+/// @file
+/// @brief NBT树的可选分配器支持
+///
+/// 定义宏CJF2_NBT_CPP_USE_ARENA_ALLOCATOR后，NBT_Type中所有的数组、字符串、列表与集合类型都会使用NBT_Allocator分配内存，
+/// 此时可以通过NBT_ArenaScope把当前线程上新建的NBT对象全部放入同一个std::pmr::memory_resource（比如std::pmr::monotonic_buffer_resource）中，
+/// 从而让NBT_Reader::ReadNBT等例程把整棵树构建在一块连续的内存区域内。
+/// 未定义此宏时，NBT_Type使用标准分配器，本文件中的类型仍然可用，但是不会影响NBT_Type。
+
+
+/// @brief 当前线程上新建的NBT容器使用的内存资源
+/// @note 这个类只提供静态接口，一般通过NBT_ArenaScope修改
+class NBT_MemoryResource
+{
+	/// @brief 禁止构造
+	NBT_MemoryResource(void) = delete;
+	/// @brief 禁止析构
+	~NBT_MemoryResource(void) = delete;
+
+private:
+	static inline thread_local std::pmr::memory_resource *pCurrent = NULL;
+
+public:
+	/// @brief 获取当前线程的内存资源
+	/// @return 当前线程的内存资源，未设置时返回std::pmr::get_default_resource()
+	static std::pmr::memory_resource *Get(void) noexcept
+	{
+		return pCurrent != NULL ? pCurrent : std::pmr::get_default_resource();
+	}
+
+	/// @brief 设置当前线程的内存资源
+	/// @param pResource 新的内存资源，为NULL则恢复为std::pmr::get_default_resource()
+	/// @return 之前设置的内存资源（可能为NULL）
+	static std::pmr::memory_resource *Set(std::pmr::memory_resource *pResource) noexcept
+	{
+		std::pmr::memory_resource *pOld = pCurrent;
+		pCurrent = pResource;
+		return pOld;
+	}
+};
+
+/// @brief NBT容器使用的分配器
+/// @tparam T 分配的元素类型
+/// @note 与std::pmr::polymorphic_allocator类似，分配器持有一个内存资源指针，所有分配与释放都转发给这个内存资源。
+/// 区别在于：
+/// - 默认构造时使用的是当前线程的NBT_MemoryResource，而不是全局默认资源，因此在NBT_ArenaScope内默认构造的所有NBT对象都会放入指定的资源中
+/// - 容器移动赋值与交换时分配器随内容一起转移，不会因为资源不同而逐个拷贝元素
+/// - 容器拷贝构造时，副本使用当前线程的NBT_MemoryResource，而不是被拷贝对象的资源
+///
+/// 容器在析构时会把内存还给分配它的资源，请保证资源的生命周期长于所有使用它的对象。
+template<typename T>
+class NBT_Allocator
+{
+	template<typename U>
+	friend class NBT_Allocator;
+
+private:
+	std::pmr::memory_resource *pResource;
+
+public:
+	/// @brief 元素类型
+	using value_type = T;
+
+	/// @brief 容器移动赋值时转移分配器
+	using propagate_on_container_move_assignment = std::true_type;
+	/// @brief 容器交换时交换分配器
+	using propagate_on_container_swap = std::true_type;
+	/// @brief 容器拷贝赋值时不转移分配器
+	using propagate_on_container_copy_assignment = std::false_type;
+	/// @brief 不同实例不一定相等
+	using is_always_equal = std::false_type;
+
+	/// @brief 默认构造，使用当前线程的NBT_MemoryResource
+	NBT_Allocator(void) noexcept :pResource(NBT_MemoryResource::Get())
+	{}
+
+	/// @brief 使用指定的内存资源构造
+	/// @param _pResource 内存资源，不能为NULL
+	NBT_Allocator(std::pmr::memory_resource *_pResource) noexcept :pResource(_pResource)
+	{}
+
+	/// @brief 从其它元素类型的分配器构造，共享同一个内存资源
+	/// @tparam U 其它元素类型
+	/// @param _Other 其它分配器
+	template<typename U>
+	NBT_Allocator(const NBT_Allocator<U> &_Other) noexcept :pResource(_Other.pResource)
+	{}
+
+	/// @brief 分配内存
+	/// @param szCount 元素个数
+	/// @return 分配的内存
+	/// @note 失败时抛出std::bad_alloc或内存资源抛出的异常
+	T *allocate(size_t szCount)
+	{
+		if (szCount > (size_t)-1 / sizeof(T))
+		{
+			throw std::bad_array_new_length();
+		}
+
+		return (T *)pResource->allocate(szCount * sizeof(T), alignof(T));
+	}
+
+	/// @brief 释放内存
+	/// @param pData 由allocate分配的内存
+	/// @param szCount 分配时的元素个数
+	void deallocate(T *pData, size_t szCount) noexcept
+	{
+		pResource->deallocate(pData, szCount * sizeof(T), alignof(T));
+	}
+
+	/// @brief 容器拷贝构造时选择副本使用的分配器
+	/// @return 使用当前线程NBT_MemoryResource的分配器
+	NBT_Allocator select_on_container_copy_construction(void) const noexcept
+	{
+		return NBT_Allocator();
+	}
+
+	/// @brief 获取内存资源
+	/// @return 内存资源
+	std::pmr::memory_resource *GetResource(void) const noexcept
+	{
+		return pResource;
+	}
+
+	/// @brief 比较两个分配器是否可以互相释放对方分配的内存
+	/// @tparam U 其它元素类型
+	/// @param _Right 其它分配器
+	/// @return 使用相同（或相等的）内存资源时返回true
+	template<typename U>
+	bool operator==(const NBT_Allocator<U> &_Right) const noexcept
+	{
+		return pResource == _Right.pResource || pResource->is_equal(*_Right.pResource);
+	}
+};
+
+/// @brief 作用域内把当前线程的NBT_MemoryResource设置为指定资源，离开作用域时恢复
+/// @note 作用域内默认构造（包括NBT_Reader解析时构造）的NBT对象都会从指定资源分配内存。
+/// 配合std::pmr::monotonic_buffer_resource使用时，整棵树的内存会在资源析构时一次性归还，
+/// 树中的对象析构时不会再逐个调用free（单调资源的释放操作为空操作）。例如：
+/// @code
+/// std::pmr::monotonic_buffer_resource mbrArena;
+/// {
+/// 	NBT_ArenaScope asScope(&mbrArena);
+/// 	NBT_Type::Compound cpd;
+/// 	NBT_Reader::ReadNBT(vData, 0, cpd);
+/// 	//使用cpd...
+/// }//cpd必须在mbrArena之前析构
+/// @endcode
+class NBT_ArenaScope
+{
+private:
+	std::pmr::memory_resource *pOld;
+
+public:
+	/// @brief 构造并设置当前线程的内存资源
+	/// @param pResource 内存资源
+	NBT_ArenaScope(std::pmr::memory_resource *pResource) noexcept :pOld(NBT_MemoryResource::Set(pResource))
+	{}
+
+	/// @brief 析构并恢复之前的内存资源
+	~NBT_ArenaScope(void) noexcept
+	{
+		NBT_MemoryResource::Set(pOld);
+	}
+
+	/// @brief 禁止拷贝构造
+	NBT_ArenaScope(const NBT_ArenaScope &) = delete;
+	/// @brief 禁止移动构造
+	NBT_ArenaScope(NBT_ArenaScope &&) = delete;
+	/// @brief 禁止拷贝赋值
+	NBT_ArenaScope &operator=(const NBT_ArenaScope &) = delete;
+	/// @brief 禁止移动赋值
+	NBT_ArenaScope &operator=(NBT_ArenaScope &&) = delete;
+};
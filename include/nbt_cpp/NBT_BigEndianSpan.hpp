@@ -0,0 +1,245 @@
+﻿#pragma once
+
+#include <span>//std::span
+#include <vector>//std::vector
+#include <iterator>//std::forward_iterator_tag
+#include <stdexcept>//std::out_of_range
+#include <concepts>//std::integral
+#include <bit>//std::endian
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <string.h>//memcpy memcmp
+
+#include "NBT_Endian.hpp"//字节序
+
+/// @file
+/// @brief 指向大端序原始数据的只读数组视图
+
+/// @brief 指向字节流中一段大端序数组数据的只读视图，元素在访问时才转换字节序
+/// @tparam T 元素类型，必须是整数类型（NBT_Type::Byte、NBT_Type::Int或NBT_Type::Long）
+/// @note 视图只持有原始数据的指针、元素个数与原始数据的字节序，不持有数据，调用者需要保证数据在视图使用期间有效。
+/// 字节序默认为大端序（Java版格式），借用模式读取小端序格式（基岩版）的数据时为小端序，可以通过GetByteOrder获取。
+/// 原始数据不要求按元素类型对齐，所有访问都通过memcpy完成。
+/// 只需要长度或少数元素时直接使用下标访问，需要全部元素时使用Decode或ToArray批量转换，
+/// 批量转换会使用NBT_Endian::BigToNativeArray的向量化实现。
+template<typename T>
+requires std::integral<T>
+class NBT_BigEndianSpan
+{
+public:
+	/// @brief 元素类型
+	using value_type = T;
+	/// @brief 大小类型
+	using size_type = size_t;
+
+	/// @brief 只读前向迭代器，解引用时转换字节序并返回元素的值
+	class Iterator
+	{
+	private:
+		const uint8_t *pCur = NULL;
+		bool bLittleEndian = false;
+
+	public:
+		/// @cond
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = ptrdiff_t;
+		using pointer = void;
+		using reference = T;
+		/// @endcond
+
+		/// @brief 默认构造
+		Iterator(void) = default;
+
+		/// @brief 从原始数据指针构造
+		/// @param _pCur 当前元素的原始数据起始位置
+		/// @param enByteOrder 原始数据的字节序
+		explicit Iterator(const uint8_t *_pCur, std::endian enByteOrder = std::endian::big) noexcept
+			:pCur(_pCur), bLittleEndian(enByteOrder == std::endian::little)
+		{}
+
+		/// @brief 解引用
+		/// @return 当前元素转换到平台字节序后的值
+		T operator*(void) const noexcept
+		{
+			T tVal{};
+			memcpy(&tVal, pCur, sizeof(T));
+			return bLittleEndian ? NBT_Endian::LittleToNativeAny(tVal) : NBT_Endian::BigToNativeAny(tVal);
+		}
+
+		/// @brief 前置递增
+		/// @return 自身的引用
+		Iterator &operator++(void) noexcept
+		{
+			pCur += sizeof(T);
+			return *this;
+		}
+
+		/// @brief 后置递增
+		/// @return 递增前的迭代器
+		Iterator operator++(int) noexcept
+		{
+			Iterator itOld = *this;
+			pCur += sizeof(T);
+			return itOld;
+		}
+
+		/// @brief 比较运算符
+		/// @param _Right 要比较的迭代器
+		/// @return 指向同一位置时返回true
+		bool operator==(const Iterator &_Right) const noexcept
+		{
+			return pCur == _Right.pCur;
+		}
+	};
+
+private:
+	const uint8_t *pData = NULL;
+	size_t szSize = 0;
+	std::endian enByteOrder = std::endian::big;
+
+public:
+	/// @brief 默认构造，得到一个空视图
+	NBT_BigEndianSpan(void) = default;
+	/// @brief 默认析构
+	~NBT_BigEndianSpan(void) = default;
+	/// @brief 拷贝构造
+	NBT_BigEndianSpan(const NBT_BigEndianSpan &) = default;
+	/// @brief 拷贝赋值
+	NBT_BigEndianSpan &operator=(const NBT_BigEndianSpan &) = default;
+
+	/// @brief 从原始数据构造
+	/// @param _pData 第一个元素的原始数据起始位置
+	/// @param _szSize 元素个数（不是字节数）
+	/// @param _enByteOrder 原始数据的字节序，只能是大端序或小端序
+	/// @note 调用者保证[_pData, _pData + _szSize * sizeof(T))范围有效
+	NBT_BigEndianSpan(const uint8_t *_pData, size_t _szSize, std::endian _enByteOrder = std::endian::big) noexcept
+		:pData(_pData), szSize(_szSize), enByteOrder(_enByteOrder)
+	{}
+
+	/// @brief 获取原始数据的字节序
+	/// @return 大端序或小端序
+	std::endian GetByteOrder(void) const noexcept
+	{
+		return enByteOrder;
+	}
+
+	/// @brief 获取元素个数
+	/// @return 元素个数
+	size_t size(void) const noexcept
+	{
+		return szSize;
+	}
+
+	/// @brief 检查是否为空
+	/// @return 没有任何元素时返回true
+	bool empty(void) const noexcept
+	{
+		return szSize == 0;
+	}
+
+	/// @brief 下标访问，转换字节序后返回元素的值
+	/// @param szPos 元素索引
+	/// @return 元素的值
+	/// @note 调用者保证索引合法
+	T operator[](size_t szPos) const noexcept
+	{
+		return *Iterator(pData + szPos * sizeof(T), enByteOrder);
+	}
+
+	/// @brief 带范围检查的下标访问
+	/// @param szPos 元素索引
+	/// @return 元素的值
+	/// @note 索引超出范围时抛出std::out_of_range
+	T at(size_t szPos) const
+	{
+		if (szPos >= szSize)
+		{
+			throw std::out_of_range("NBT_BigEndianSpan::at: index out of range");
+		}
+
+		return operator[](szPos);
+	}
+
+	/// @brief 获取起始迭代器
+	/// @return 指向第一个元素的迭代器
+	Iterator begin(void) const noexcept
+	{
+		return Iterator(pData, enByteOrder);
+	}
+
+	/// @brief 获取末尾迭代器
+	/// @return 指向最后一个元素之后的迭代器
+	Iterator end(void) const noexcept
+	{
+		return Iterator(pData + szSize * sizeof(T), enByteOrder);
+	}
+
+	/// @brief 获取原始数据
+	/// @return 原始数据的字节范围，大小为size() * sizeof(T)，字节序见GetByteOrder
+	std::span<const uint8_t> GetRawData(void) const noexcept
+	{
+		return std::span<const uint8_t>(pData, szSize * sizeof(T));
+	}
+
+	/// @brief 批量转换一段元素到调用者的缓冲区
+	/// @param szPos 起始元素索引
+	/// @param szCount 元素个数
+	/// @param[out] pDest 输出缓冲区，至少能容纳szCount个元素
+	/// @note 调用者保证szPos + szCount不超过size()
+	void Decode(size_t szPos, size_t szCount, T *pDest) const noexcept
+	{
+		if (szCount == 0)
+		{
+			return;
+		}
+
+		memcpy(pDest, pData + szPos * sizeof(T), szCount * sizeof(T));
+		if (enByteOrder == std::endian::little)
+		{
+			NBT_Endian::LittleToNativeArray(pDest, szCount);
+		}
+		else
+		{
+			NBT_Endian::BigToNativeArray(pDest, szCount);
+		}
+	}
+
+	/// @brief 转换全部元素到一个新的数组对象
+	/// @tparam Array 数组类型，需要提供resize与data，默认为std::vector
+	/// @return 转换后的数组，可以使用NBT_Type中对应的数组类型得到可以放入NBT_Node的对象
+	template<typename Array = std::vector<T>>
+	Array ToArray(void) const
+	{
+		Array tArray{};
+		tArray.resize(szSize);
+		Decode(0, szSize, tArray.data());
+		return tArray;
+	}
+
+	/// @brief 比较两个视图的内容是否相同
+	/// @param _Right 要比较的视图
+	/// @return 元素个数与每个元素的值都相同时返回true
+	/// @note 字节序相同时直接比较原始数据，否则逐个比较元素的值
+	bool operator==(const NBT_BigEndianSpan &_Right) const noexcept
+	{
+		if (szSize != _Right.szSize)
+		{
+			return false;
+		}
+
+		if (sizeof(T) == 1 || enByteOrder == _Right.enByteOrder)
+		{
+			return szSize == 0 || memcmp(pData, _Right.pData, szSize * sizeof(T)) == 0;
+		}
+
+		for (size_t i = 0; i < szSize; ++i)
+		{
+			if (operator[](i) != _Right[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
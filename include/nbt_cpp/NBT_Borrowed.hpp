@@ -0,0 +1,1022 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <span>//std::span
+#include <vector>//std::vector
+#include <variant>//std::variant
+#include <stdexcept>//std::out_of_range
+#include <utility>//std::move
+#include <bit>//std::bit_cast
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <string.h>//memcpy
+
+#include "NBT_Print.hpp"//打印输出
+#include "NBT_Node.hpp"//nbt类型
+#include "NBT_Endian.hpp"//字节序
+#include "NBT_Format.hpp"//格式策略
+#include "NBT_IO.hpp"//IO流对象
+#include "NBT_Reader.hpp"//复用解析例程与错误处理
+#include "NBT_BigEndianSpan.hpp"//数组视图
+
+/// @file
+/// @brief 借用输入字节流的只读NBT树，字符串与数组直接指向输入数据
+
+class NBT_BorrowedNode;
+class NBT_BorrowedReader;
+
+template<typename Node>
+class NBT_BorrowedList;
+
+template<typename Node>
+class NBT_BorrowedCompound;
+
+/// @brief 借用模式下与NBT_Type一一对应的类型定义
+/// @note 列表与集合的模板需要在NBT_BorrowedNode完整之前引用这些类型，所以单独定义在节点类之外，
+/// 用户可以直接使用NBT_BorrowedNode中的同名类型
+struct NBT_BorrowedType
+{
+	using End		= NBT_Type::End;							///< 结束标记类型，无数据
+	using Byte		= NBT_Type::Byte;							///< 8位有符号整数
+	using Short		= NBT_Type::Short;							///< 16位有符号整数
+	using Int		= NBT_Type::Int;							///< 32位有符号整数
+	using Long		= NBT_Type::Long;							///< 64位有符号整数
+	using Float		= NBT_Type::Float;							///< 单精度浮点类型
+	using Double	= NBT_Type::Double;							///< 双精度浮点类型
+	using ByteArray	= NBT_BigEndianSpan<NBT_Type::Byte>;		///< 指向输入数据的 8位有符号整数数组
+	using String	= NBT_Type::String::View;					///< 指向输入数据的字符串
+	using List		= NBT_BorrowedList<NBT_BorrowedNode>;		///< 只读列表
+	using Compound	= NBT_BorrowedCompound<NBT_BorrowedNode>;	///< 只读集合
+	using IntArray	= NBT_BigEndianSpan<NBT_Type::Int>;			///< 指向输入数据的32位有符号整数数组
+	using LongArray	= NBT_BigEndianSpan<NBT_Type::Long>;		///< 指向输入数据的64位有符号整数数组
+};
+
+/// @brief 借用模式的只读列表，用法与NBT_List一致，但只提供读取接口
+/// @tparam Node 元素类型，也就是NBT_BorrowedNode
+/// @note 用户不应自行实例化此类，请使用NBT_BorrowedNode::List
+template<typename Node>
+class NBT_BorrowedList
+{
+	friend class NBT_BorrowedReader;
+
+private:
+	std::vector<Node> vElement{};
+	NBT_TAG enElementTag = NBT_TAG::End;
+
+public:
+	/// @brief 获取列表元素的类型
+	/// @return 元素类型，空列表返回NBT_TAG::End
+	NBT_TAG GetElementTag(void) const noexcept
+	{
+		return enElementTag;
+	}
+
+	/// @brief 获取元素个数
+	/// @return 元素个数
+	size_t Size(void) const noexcept
+	{
+		return vElement.size();
+	}
+
+	/// @brief 检查是否为空
+	/// @return 没有任何元素时返回true
+	bool Empty(void) const noexcept
+	{
+		return vElement.empty();
+	}
+
+	/// @brief 获取指定位置的元素
+	/// @param szPos 位置索引
+	/// @return 元素的常量引用
+	/// @note 如果位置不存在则抛出异常，具体请参考std::vector关于at的说明
+	const Node &Get(size_t szPos) const
+	{
+		return vElement.at(szPos);
+	}
+
+	/// @brief 获取指定位置的元素
+	/// @param szPos 位置索引
+	/// @return 位置存在时返回元素的指针，否则返回nullptr
+	const Node *Has(size_t szPos) const noexcept
+	{
+		return szPos < vElement.size()
+			? &vElement[szPos]
+			: nullptr;
+	}
+
+	/// @brief 获取起始迭代器
+	/// @return 指向第一个元素的迭代器
+	auto begin(void) const noexcept
+	{
+		return vElement.begin();
+	}
+
+	/// @brief 获取末尾迭代器
+	/// @return 指向最后一个元素之后的迭代器
+	auto end(void) const noexcept
+	{
+		return vElement.end();
+	}
+
+
+/// @def TYPE_GET_FUNC(type)
+/// @brief 不同类型名接口生成宏
+/// @note 用户不应该使用此宏（实际上宏已在使用后取消定义），标注仅为消除doxygen警告
+#define TYPE_GET_FUNC(type)\
+/**
+ @brief 获取指定位置的 type 类型数据
+ @param szPos 位置索引
+ @return type 类型数据的常量引用
+ @note 如果位置不存在或类型不匹配则抛出异常，
+ 具体请参考std::vector关于at的说明与std::get的说明
+ */\
+const NBT_BorrowedType::type &Get##type(size_t szPos) const\
+{\
+	return vElement.at(szPos).Get##type();\
+}\
+\
+/**
+ @brief 获取指定位置的 type 类型数据
+ @param szPos 位置索引
+ @return type 类型数据的指针，如果位置不存在或类型不对则返回nullptr
+ */\
+const NBT_BorrowedType::type *Has##type(size_t szPos) const noexcept\
+{\
+	auto *p = Has(szPos);\
+	return p != nullptr\
+		? p->GetIf##type()\
+		: nullptr;\
+}
+
+	/// @name 针对每种类型提供一个方便使用的函数，由宏批量生成
+	/// @brief 具体作用说明：
+	/// - Get开头+类型名的函数：直接获取指定位置且对应类型的常量引用，位置或类型不匹配时抛出异常
+	/// - Has开头 + 类型名的函数：位置存在且类型匹配时返回对应指针，否则返回nullptr指针
+	/// @{
+
+	TYPE_GET_FUNC(Byte);
+	TYPE_GET_FUNC(Short);
+	TYPE_GET_FUNC(Int);
+	TYPE_GET_FUNC(Long);
+	TYPE_GET_FUNC(Float);
+	TYPE_GET_FUNC(Double);
+	TYPE_GET_FUNC(ByteArray);
+	TYPE_GET_FUNC(IntArray);
+	TYPE_GET_FUNC(LongArray);
+	TYPE_GET_FUNC(String);
+	TYPE_GET_FUNC(List);
+	TYPE_GET_FUNC(Compound);
+
+	/// @}
+
+#undef TYPE_GET_FUNC
+};
+
+/// @brief 借用模式的只读集合，按输入中的顺序保存条目
+/// @tparam Node 值类型，也就是NBT_BorrowedNode
+/// @note 用户不应自行实例化此类，请使用NBT_BorrowedNode::Compound。
+/// 条目保存在连续数组中，查找为从后往前的线性查找，同名条目以后出现的为准，与NBT_Reader的行为一致。
+/// 查找接口接受MUTF8_String_View，所以NBT_Type::String、NBT_Type::String::View（MU8STR、MU8STRV）都可以直接传入。
+template<typename Node>
+class NBT_BorrowedCompound
+{
+	friend class NBT_BorrowedReader;
+
+public:
+	/// @brief 集合条目
+	struct Entry
+	{
+		NBT_BorrowedType::String sName;	///< 条目名称，指向输入数据
+		Node nodeValue;					///< 条目的值
+	};
+
+private:
+	std::vector<Entry> vEntry{};
+
+public:
+	/// @brief 获取条目数量
+	/// @return 条目数量（包括同名条目）
+	size_t Size(void) const noexcept
+	{
+		return vEntry.size();
+	}
+
+	/// @brief 检查是否为空
+	/// @return 没有任何条目时返回true
+	bool Empty(void) const noexcept
+	{
+		return vEntry.empty();
+	}
+
+	/// @brief 清空所有条目
+	void Clear(void) noexcept
+	{
+		vEntry.clear();
+	}
+
+	/// @brief 获取起始迭代器，按输入中的顺序遍历条目
+	/// @return 指向第一个条目的迭代器
+	auto begin(void) const noexcept
+	{
+		return vEntry.begin();
+	}
+
+	/// @brief 获取末尾迭代器
+	/// @return 指向最后一个条目之后的迭代器
+	auto end(void) const noexcept
+	{
+		return vEntry.end();
+	}
+
+	/// @brief 搜索标签是否存在
+	/// @param sTagName 要搜索的标签名
+	/// @return 如果找到，则返回指向标签名对应的值的指针，否则返回nullptr指针
+	const Node *Has(const MUTF8_String_View &sTagName) const noexcept
+	{
+		for (auto it = vEntry.rbegin(); it != vEntry.rend(); ++it)
+		{
+			if (it->sName == sTagName)
+			{
+				return &it->nodeValue;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/// @brief 根据标签名获取对应的值
+	/// @param sTagName 要查找的标签名
+	/// @return 标签名对应的值的常量引用
+	/// @note 如果标签不存在则抛出std::out_of_range
+	const Node &Get(const MUTF8_String_View &sTagName) const
+	{
+		const Node *pNode = Has(sTagName);
+		if (pNode == nullptr)
+		{
+			throw std::out_of_range("NBT_BorrowedCompound::Get: tag name not found");
+		}
+
+		return *pNode;
+	}
+
+	/// @brief 检查是否包含指定标签
+	/// @param sTagName 要检查的标签名
+	/// @return 如果包含指定标签返回true，否则返回false
+	bool Contains(const MUTF8_String_View &sTagName) const noexcept
+	{
+		return Has(sTagName) != nullptr;
+	}
+
+
+/// @def TYPE_GET_FUNC(type)
+/// @brief 不同类型名接口生成宏
+/// @note 用户不应该使用此宏（实际上宏已在使用后取消定义），标注仅为消除doxygen警告
+#define TYPE_GET_FUNC(type)\
+/**
+ @brief 检查是否包含指定标签名的 type 类型数据
+ @param sTagName 要检查的标签名
+ @return 如果包含指定标签名，且对应的值的类型匹配，则返回true，否则返回false
+ */\
+bool Contains##type(const MUTF8_String_View &sTagName) const noexcept\
+{\
+	auto *p = Has(sTagName);\
+	return p != nullptr && p->Is##type();\
+}\
+\
+/**
+ @brief 获取指定标签名的 type 类型数据
+ @param sTagName 标签名
+ @return type 类型数据的常量引用
+ @note 如果标签不存在或类型不匹配则抛出异常，具体请参考Get的说明与std::get的说明
+ */\
+const NBT_BorrowedType::type &Get##type(const MUTF8_String_View &sTagName) const\
+{\
+	return Get(sTagName).Get##type();\
+}\
+\
+/**
+ @brief 安全检查并获取指定标签名的 type 类型数据
+ @param sTagName 标签名
+ @return 如果存在且对应值的类型为 type 则返回指向数据的指针，否则返回nullptr
+ */\
+const NBT_BorrowedType::type *Has##type(const MUTF8_String_View &sTagName) const noexcept\
+{\
+	auto *p = Has(sTagName);\
+	return p != nullptr\
+		? p->GetIf##type()\
+		: nullptr;\
+}
+
+	/// @name 针对每种类型提供一个方便使用的函数，由宏批量生成
+	/// @brief 具体作用说明：
+	/// - Contains开头+类型名的函数：判断指定标签名是否存在且为指定类型
+	/// - Get开头+类型名的函数：直接获取指定标签名且对应类型的常量引用，不存在或类型不匹配时抛出异常
+	/// - Has开头 + 类型名的函数：指定标签名存在且类型匹配时返回对应指针，否则返回nullptr指针
+	/// @{
+
+	TYPE_GET_FUNC(Byte);
+	TYPE_GET_FUNC(Short);
+	TYPE_GET_FUNC(Int);
+	TYPE_GET_FUNC(Long);
+	TYPE_GET_FUNC(Float);
+	TYPE_GET_FUNC(Double);
+	TYPE_GET_FUNC(ByteArray);
+	TYPE_GET_FUNC(IntArray);
+	TYPE_GET_FUNC(LongArray);
+	TYPE_GET_FUNC(String);
+	TYPE_GET_FUNC(List);
+	TYPE_GET_FUNC(Compound);
+
+	/// @}
+
+#undef TYPE_GET_FUNC
+};
+
+/// @brief 借用模式的只读NBT节点，由NBT_BorrowedReader从字节流解析得到
+/// @note 与NBT_Node的区别在于：字符串是指向输入数据的NBT_Type::String::View，
+/// 三种数组是指向输入数据的NBT_BigEndianSpan，访问时才转换字节序，其余类型按值保存。
+/// 所以整棵树都不持有输入数据，调用者需要保证输入数据在树的使用期间有效且不被修改。
+/// 类型访问接口与NBT_Node_View<true>一致（GetTag、Is/Get/GetIf + 类型名），只是各类型被替换为本类中的同名类型。
+/// 需要修改或长期保存时，通过NBT_BorrowedReader::Materialize转换为普通的NBT对象。
+class NBT_BorrowedNode
+{
+	friend class NBT_BorrowedReader;
+
+public:
+	/// @name 借用模式下与NBT_Type一一对应的类型，具体请参考NBT_BorrowedType
+	/// @{
+
+	using End		= NBT_BorrowedType::End;		///< 结束标记类型，无数据
+	using Byte		= NBT_BorrowedType::Byte;		///< 8位有符号整数
+	using Short		= NBT_BorrowedType::Short;		///< 16位有符号整数
+	using Int		= NBT_BorrowedType::Int;		///< 32位有符号整数
+	using Long		= NBT_BorrowedType::Long;		///< 64位有符号整数
+	using Float		= NBT_BorrowedType::Float;		///< 单精度浮点类型
+	using Double	= NBT_BorrowedType::Double;		///< 双精度浮点类型
+	using ByteArray	= NBT_BorrowedType::ByteArray;	///< 指向输入数据的 8位有符号整数数组
+	using String	= NBT_BorrowedType::String;		///< 指向输入数据的字符串
+	using List		= NBT_BorrowedType::List;		///< 只读列表
+	using Compound	= NBT_BorrowedType::Compound;	///< 只读集合
+	using IntArray	= NBT_BorrowedType::IntArray;	///< 指向输入数据的32位有符号整数数组
+	using LongArray	= NBT_BorrowedType::LongArray;	///< 指向输入数据的64位有符号整数数组
+
+	/// @}
+
+	/// @brief 变体类型，下标与NBT_TAG一一对应
+	using VariantData = std::variant<End, Byte, Short, Int, Long, Float, Double, ByteArray, String, List, Compound, IntArray, LongArray>;
+
+private:
+	VariantData data{};
+
+public:
+	/// @brief 默认构造，得到End类型的节点
+	NBT_BorrowedNode(void) = default;
+	/// @brief 默认析构
+	~NBT_BorrowedNode(void) = default;
+	/// @brief 拷贝构造
+	NBT_BorrowedNode(const NBT_BorrowedNode &) = default;
+	/// @brief 移动构造
+	NBT_BorrowedNode(NBT_BorrowedNode &&) noexcept = default;
+	/// @brief 拷贝赋值
+	NBT_BorrowedNode &operator=(const NBT_BorrowedNode &) = default;
+	/// @brief 移动赋值
+	NBT_BorrowedNode &operator=(NBT_BorrowedNode &&) noexcept = default;
+
+	/// @brief 获取当前存储的数据类型
+	/// @return 数据类型对应的NBT_TAG
+	NBT_TAG GetTag(void) const noexcept
+	{
+		return (NBT_TAG)(NBT_TAG_RAW_TYPE)data.index();
+	}
+
+	/// @brief 获取底层变体数据
+	/// @return 变体数据的常量引用
+	const VariantData &GetData(void) const noexcept
+	{
+		return data;
+	}
+
+
+/// @def TYPE_GET_FUNC(type)
+/// @brief 不同类型名接口生成宏
+/// @note 用户不应该使用此宏（实际上宏已在使用后取消定义），标注仅为消除doxygen警告
+#define TYPE_GET_FUNC(type)\
+/**
+ @brief 获取当前节点的 type 类型的数据
+ @return 对 type 类型数据的常量引用
+ @note 如果当前存储的不是 type 类型，则抛出异常，具体请参考std::get的说明
+ */\
+const type &Get##type(void) const\
+{\
+	return std::get<type>(data);\
+}\
+\
+/**
+ @brief 获取当前节点的 type 类型数据的指针
+ @return 对 type 类型数据的常量指针，如果当前存储的不是 type 类型，则返回nullptr
+ */\
+const type *GetIf##type(void) const noexcept\
+{\
+	return std::get_if<type>(&data);\
+}\
+\
+/**
+ @brief 检查当前节点是否存储 type 类型的数据
+ @return 是否存储 type 类型
+ */\
+bool Is##type(void) const noexcept\
+{\
+	return std::holds_alternative<type>(data);\
+}
+
+	/// @name 针对每种类型提供一个方便使用的函数，由宏批量生成
+	/// @brief 具体作用说明：
+	/// - Get开头+类型名的函数：直接获取对应类型的常量引用，类型不匹配时抛出异常
+	/// - GetIf开头+类型名的函数：类型匹配时返回对应指针，否则返回nullptr指针
+	/// - Is开头+类型名的函数：判断当前节点是否存储对应类型
+	/// @{
+
+	TYPE_GET_FUNC(End);
+	TYPE_GET_FUNC(Byte);
+	TYPE_GET_FUNC(Short);
+	TYPE_GET_FUNC(Int);
+	TYPE_GET_FUNC(Long);
+	TYPE_GET_FUNC(Float);
+	TYPE_GET_FUNC(Double);
+	TYPE_GET_FUNC(ByteArray);
+	TYPE_GET_FUNC(IntArray);
+	TYPE_GET_FUNC(LongArray);
+	TYPE_GET_FUNC(String);
+	TYPE_GET_FUNC(List);
+	TYPE_GET_FUNC(Compound);
+
+	/// @}
+
+#undef TYPE_GET_FUNC
+};
+
+/// @brief 借用模式的反序列化工具，把NBT二进制数据解析为NBT_BorrowedNode树
+/// @note 解析过程不拷贝任何字符串或数组数据，也不转换数组的字节序，只为列表与集合分配元素数组，
+/// 适用于数据已经位于内存映射（NBT_IO::MappedFile）或其它长期存在的缓冲区中、只需要读取分析的情况。
+/// 解析例程、错误码与错误信息输出复用NBT_Reader的实现，所以错误信息的格式（数据预览与栈回溯）与NBT_Reader::ReadNBT相同。例如：
+/// @code
+/// NBT_IO::MappedFile mfFile("level.nbt");
+/// NBT_BorrowedNode::Compound cpdRoot;
+/// if (NBT_BorrowedReader::ReadNBT(mfFile, 0, cpdRoot))
+/// {
+/// 	const NBT_BorrowedNode::Compound &cpdData = cpdRoot.GetCompound(MU8STRV("")).GetCompound(MU8STRV("Data"));
+/// 	NBT_Type::Int iVersion = cpdData.GetInt(MU8STRV("DataVersion"));
+/// 	NBT_BorrowedNode::String sName = cpdData.GetString(MU8STRV("LevelName"));
+/// }
+/// @endcode
+class NBT_BorrowedReader :protected NBT_Reader
+{
+	/// @brief 禁止构造
+	NBT_BorrowedReader(void) = delete;
+	/// @brief 禁止析构
+	~NBT_BorrowedReader(void) = delete;
+
+private:
+///@cond
+	using InputStream = NBT_IO::DefaultInputStream<std::span<const uint8_t>>;
+
+#define _RP___FUNCTION__ __FUNCTION__//用于编译过程二次替换达到函数内部
+
+#define _RP___LINE__ _RP_STRLING(__LINE__)
+#define _RP_STRLING(l) STRLING(l)
+#define STRLING(l) #l
+
+#define STACK_TRACEBACK(fmt, ...) funcInfo(NBT_Print_Level::Err, "In [{}] Line:[" _RP___LINE__ "]: \n" fmt "\n\n", _RP___FUNCTION__ __VA_OPT__(,) __VA_ARGS__);
+#define CHECK_STACK_DEPTH(depth) \
+if((depth) == 0)\
+{\
+	eRet = Error(StackDepthExceeded, tData, funcInfo, "{}: NBT nesting depth exceeded maximum call stack limit", _RP___FUNCTION__);\
+	STACK_TRACEBACK(#depth " == 0");\
+	return eRet;\
+}
+
+#define MYTRY \
+try\
+{
+
+#define MYCATCH \
+}\
+catch(const std::bad_alloc &e)\
+{\
+	ErrCode eRet = Error(OutOfMemoryError, tData, funcInfo, "{}: Info:[{}]", _RP___FUNCTION__, e.what());\
+	STACK_TRACEBACK("catch(std::bad_alloc)");\
+	return eRet;\
+}\
+catch(const std::exception &e)\
+{\
+	ErrCode eRet = Error(StdException, tData, funcInfo, "{}: Info:[{}]", _RP___FUNCTION__, e.what());\
+	STACK_TRACEBACK("catch(std::exception)");\
+	return eRet;\
+}\
+catch(...)\
+{\
+	ErrCode eRet =  Error(UnknownError, tData, funcInfo, "{}: Info:[Unknown Exception]", _RP___FUNCTION__);\
+	STACK_TRACEBACK("catch(...)");\
+	return eRet;\
+}
+
+	//与NBT_Reader::GetName相同，但是只引用流中的数据
+	template<typename Format, typename InfoFunc>
+	static ErrCode GetStringView(InputStream &tData, NBT_BorrowedNode::String &sString, InfoFunc &funcInfo) noexcept
+	{
+		ErrCode eRet = AllOk;
+		//读取2字节的无符号名称长度
+		NBT_Type::StringLength wStringLength = 0;//w->word=2*byte
+		eRet = ReadValue<Format>(tData, wStringLength, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("wStringLength Read");
+			return eRet;
+		}
+
+		//验证完成，类型转换
+		using ValueType = NBT_Type::String::value_type;
+		size_t szStringLength = (size_t)wStringLength;
+		size_t szStringSize = szStringLength * sizeof(ValueType);
+
+		//判断长度是否超过
+		if (!tData.HasAvailData(szStringSize))
+		{
+			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\n(Index[{}] + szStringLength[{}])[{}] > DataSize[{}]", __FUNCTION__,
+				tData.Index(), szStringLength, tData.Index() + szStringSize, tData.Size());
+			STACK_TRACEBACK("HasAvailData Test");
+			return eRet;
+		}
+
+		//直接引用流中的数据
+		sString = NBT_BorrowedNode::String((const ValueType *)tData.CurrentData(), szStringLength);
+		tData.SkipData(szStringSize);
+
+		return eRet;
+	}
+
+	//与NBT_Reader::GetArrayType相同，但是只引用流中的数据，数组视图记录流的字节序
+	template<typename Format, typename T, typename InfoFunc>
+	static ErrCode GetArraySpan(InputStream &tData, NBT_BigEndianSpan<T> &spanArray, InfoFunc &funcInfo) noexcept
+	{
+		ErrCode eRet = AllOk;
+
+		//获取4字节有符号数，代表数组元素个数
+		NBT_Type::ArrayLength iArrayLength = 0;//4byte
+		eRet = ReadValue<Format>(tData, iArrayLength, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("iArrayLength Read");
+			return eRet;
+		}
+
+		//检查有符号数大小范围
+		if (iArrayLength < 0)
+		{
+			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\niArrayLength[{}] < 0", __FUNCTION__, iArrayLength);
+			STACK_TRACEBACK("iArrayLength Test");
+			return eRet;
+		}
+
+		//验证完成，类型转换
+		size_t szArrayLength = (size_t)iArrayLength;
+		size_t szArraySize = szArrayLength * sizeof(T);
+
+		//判断长度是否超过
+		if (!tData.HasAvailData(szArraySize))
+		{
+			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\n(Index[{}] + szArraySize[{}])[{}] > DataSize[{}]", __FUNCTION__,
+				tData.Index(), szArraySize, tData.Index() + szArraySize, tData.Size());
+			STACK_TRACEBACK("HasAvailData Test");
+			return eRet;
+		}
+
+		spanArray = NBT_BigEndianSpan<T>(tData.CurrentData(), szArrayLength, Format::enByteOrder);
+		tData.SkipData(szArraySize);
+
+		return eRet;
+	}
+
+	template<typename Format, bool bUnwrapMixedList, typename InfoFunc>
+	static ErrCode GetBorrowedList(InputStream &tData, NBT_BorrowedNode::List &tList, size_t szStackDepth, InfoFunc &funcInfo) noexcept
+	{
+	MYTRY;
+		ErrCode eRet = AllOk;
+		CHECK_STACK_DEPTH(szStackDepth);
+
+		//读取1字节的列表元素类型
+		NBT_TAG_RAW_TYPE u8ListElementTag = 0;//b=byte
+		eRet = ReadValue<Format>(tData, u8ListElementTag, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("u8ListElementTag Read");
+			return eRet;
+		}
+
+		//错误的列表元素类型
+		if (u8ListElementTag >= NBT_TAG::ENUM_END)
+		{
+			eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nList NBT Type:Unknown Type Tag[0x{:02X}({})]", __FUNCTION__,
+				(NBT_TAG_RAW_TYPE)u8ListElementTag, (NBT_TAG_RAW_TYPE)u8ListElementTag);
+			STACK_TRACEBACK("u8ListElementTag Test");
+			return eRet;
+		}
+
+		//验证完成，类型转换
+		NBT_TAG enListElementTag = (NBT_TAG)u8ListElementTag;
+
+		//读取4字节的有符号列表长度
+		NBT_Type::ListLength iListLength = 0;//4byte
+		eRet = ReadValue<Format>(tData, iListLength, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("iListLength Read");
+			return eRet;
+		}
+
+		//检查有符号数大小范围
+		if (iListLength < 0)
+		{
+			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\niListLength[{}] < 0", __FUNCTION__, iListLength);
+			STACK_TRACEBACK("iListLength Test");
+			return eRet;
+		}
+
+		//验证完成，类型转换
+		size_t szListLength = (size_t)iListLength;
+
+		//防止重复N个结束标签，带有结束标签的必须是空列表
+		if (enListElementTag == NBT_TAG::End && szListLength != 0)
+		{
+			eRet = Error(ListElementTypeError, tData, funcInfo, "{}:\nThe list with TAG_End[0x00] tag must be empty, but [{}] elements were found", __FUNCTION__,
+				szListLength);
+			STACK_TRACEBACK("enListElementTag And szListLength Test");
+			return eRet;
+		}
+
+		//与NBT_Reader一致，空列表的元素类型总是End
+		tList.enElementTag = szListLength == 0 ? NBT_TAG::End : enListElementTag;
+
+		//每个元素至少占用1字节（除了数组外都大于等于1），用剩余数据大小限制预分配，防止恶意的长度导致大量分配
+		tList.vElement.reserve(std::min(szListLength, tData.Size() - tData.Index()));
+
+		for (size_t i = 0; i < szListLength; ++i)
+		{
+			NBT_BorrowedNode &nodeElement = tList.vElement.emplace_back();
+			eRet = GetBorrowedSwitch<Format, bUnwrapMixedList>(tData, nodeElement, enListElementTag, szStackDepth - 1, funcInfo);
+			if (eRet != AllOk)
+			{
+				STACK_TRACEBACK("GetBorrowedSwitch Error, Size: [{}] Index: [{}]", szListLength, i);
+				return eRet;
+			}
+
+			//解包只有一个无名条目的集合，与NBT_Reader一致
+			if constexpr (bUnwrapMixedList)
+			{
+				if (enListElementTag == NBT_TAG::Compound)
+				{
+					NBT_BorrowedNode::Compound &cpdElement = std::get<NBT_BorrowedNode::Compound>(nodeElement.data);
+					if (cpdElement.vEntry.size() == 1 && cpdElement.vEntry[0].sName.empty())
+					{
+						NBT_BorrowedNode nodeInner = std::move(cpdElement.vEntry[0].nodeValue);
+						nodeElement = std::move(nodeInner);
+					}
+				}
+			}
+		}
+
+		return eRet;
+	MYCATCH;
+	}
+
+	//如果是非根部，有额外检测
+	template<typename Format, bool bRoot, bool bUnwrapMixedList, typename InfoFunc>
+	static ErrCode GetBorrowedCompound(InputStream &tData, NBT_BorrowedNode::Compound &tCompound, size_t szStackDepth, InfoFunc &funcInfo) noexcept
+	{
+	MYTRY;
+		ErrCode eRet = AllOk;
+		CHECK_STACK_DEPTH(szStackDepth);
+
+		//读取
+		while (true)
+		{
+			//处理末尾情况
+			if (!tData.HasAvailData(sizeof(NBT_TAG_RAW_TYPE)))
+			{
+				if constexpr (!bRoot)//非根部情况遇到末尾，则报错
+				{
+					eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\nIndex[{}] >= DataSize()[{}]", __FUNCTION__,
+						tData.Index(), tData.Size());
+					STACK_TRACEBACK("HasAvailData Test");
+				}
+
+				return eRet;//否则直接返回（默认值AllOk）
+			}
+
+			//先读取一下类型
+			NBT_TAG_RAW_TYPE u8CompoundEntryTag = (NBT_TAG_RAW_TYPE)tData.GetNext();
+			if (u8CompoundEntryTag == NBT_TAG::End)//处理End情况
+			{
+				return eRet;//直接返回（默认值AllOk）
+			}
+
+			if (u8CompoundEntryTag >= NBT_TAG::ENUM_END)//确认在范围内
+			{
+				eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nNBT Tag switch default: Unknown Type Tag[0x{:02X}({})]", __FUNCTION__,
+					u8CompoundEntryTag, u8CompoundEntryTag);
+				STACK_TRACEBACK("u8CompoundEntryTag Test");
+				return eRet;//超出范围立刻返回
+			}
+
+			//验证完成，类型转换
+			NBT_TAG enCompoundEntryTag = (NBT_TAG)u8CompoundEntryTag;
+
+			//同名条目全部保留，由NBT_BorrowedCompound的查找保证以后出现的为准
+			auto &eEntry = tCompound.vEntry.emplace_back();
+			eRet = GetStringView<Format>(tData, eEntry.sName, funcInfo);
+			if (eRet != AllOk)
+			{
+				STACK_TRACEBACK("GetStringView Error, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
+				return eRet;//名称读取失败立刻返回
+			}
+
+			eRet = GetBorrowedSwitch<Format, bUnwrapMixedList>(tData, eEntry.nodeValue, enCompoundEntryTag, szStackDepth - 1, funcInfo);
+			if (eRet != AllOk)
+			{
+				STACK_TRACEBACK("GetBorrowedSwitch Error, Name: \"{}\", Type: [NBT_Type::{}]", NBT_Type::String(eEntry.sName).ToCharTypeUTF8(), NBT_Type::GetTypeName(enCompoundEntryTag));//注意这里ToCharTypeUTF8可能抛异常
+				return eRet;
+			}
+		}
+
+		return eRet;//返回错误码
+	MYCATCH;
+	}
+
+	//选择函数不检查递归层，由函数调用的函数检查
+	template<typename Format, bool bUnwrapMixedList, typename InfoFunc>
+	static ErrCode GetBorrowedSwitch(InputStream &tData, NBT_BorrowedNode &nodeBorrowed, NBT_TAG tagNbt, size_t szStackDepth, InfoFunc &funcInfo) noexcept
+	{
+		ErrCode eRet = AllOk;
+		auto &data = nodeBorrowed.data;
+
+		switch (tagNbt)
+		{
+		case NBT_TAG::Byte:
+			eRet = GetBuiltInType<Format>(tData, data.emplace<NBT_BorrowedNode::Byte>(), funcInfo);
+			break;
+		case NBT_TAG::Short:
+			eRet = GetBuiltInType<Format>(tData, data.emplace<NBT_BorrowedNode::Short>(), funcInfo);
+			break;
+		case NBT_TAG::Int:
+			eRet = GetBuiltInType<Format>(tData, data.emplace<NBT_BorrowedNode::Int>(), funcInfo);
+			break;
+		case NBT_TAG::Long:
+			eRet = GetBuiltInType<Format>(tData, data.emplace<NBT_BorrowedNode::Long>(), funcInfo);
+			break;
+		case NBT_TAG::Float:
+			eRet = GetBuiltInType<Format>(tData, data.emplace<NBT_BorrowedNode::Float>(), funcInfo);
+			break;
+		case NBT_TAG::Double:
+			eRet = GetBuiltInType<Format>(tData, data.emplace<NBT_BorrowedNode::Double>(), funcInfo);
+			break;
+		case NBT_TAG::ByteArray:
+			eRet = GetArraySpan<Format>(tData, data.emplace<NBT_BorrowedNode::ByteArray>(), funcInfo);
+			break;
+		case NBT_TAG::String:
+			eRet = GetStringView<Format>(tData, data.emplace<NBT_BorrowedNode::String>(), funcInfo);
+			break;
+		case NBT_TAG::List://需要递归调用，列表开头给出标签ID和长度，后续都为一系列同类型标签的有效负载（无标签 ID 或名称）
+			eRet = GetBorrowedList<Format, bUnwrapMixedList>(tData, data.emplace<NBT_BorrowedNode::List>(), szStackDepth, funcInfo);
+			break;
+		case NBT_TAG::Compound://需要递归调用
+			eRet = GetBorrowedCompound<Format, false, bUnwrapMixedList>(tData, data.emplace<NBT_BorrowedNode::Compound>(), szStackDepth, funcInfo);
+			break;
+		case NBT_TAG::IntArray:
+			eRet = GetArraySpan<Format>(tData, data.emplace<NBT_BorrowedNode::IntArray>(), funcInfo);
+			break;
+		case NBT_TAG::LongArray:
+			eRet = GetArraySpan<Format>(tData, data.emplace<NBT_BorrowedNode::LongArray>(), funcInfo);
+			break;
+		case NBT_TAG::End://不应该在任何时候遇到此标签，Compound会读取到并消耗掉，不会传入，List遇到此标签不会调用读取，所以遇到即为错误
+			{
+				eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nNBT Tag switch error: Unexpected Type Tag NBT_TAG::End[0x00(0)]", __FUNCTION__);
+			}
+			break;
+		default://数据出错
+			{
+				eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nNBT Tag switch error: Unknown Type Tag[0x{:02X}({})]", __FUNCTION__,
+					(NBT_TAG_RAW_TYPE)tagNbt, (NBT_TAG_RAW_TYPE)tagNbt);
+			}
+			break;
+		}
+
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("Tag[0x{:02X}({})] read error!",
+				(NBT_TAG_RAW_TYPE)tagNbt, (NBT_TAG_RAW_TYPE)tagNbt);
+		}
+
+		return eRet;
+	}
+
+	//以下函数可能因为内存不足抛出异常，由Materialize统一处理
+	static void MaterializeSwitch(const NBT_BorrowedNode &nodeBorrowed, NBT_Node &nodeOut)
+	{
+		switch (nodeBorrowed.GetTag())
+		{
+		case NBT_TAG::Byte:
+			nodeOut.Set<NBT_Type::Byte>(nodeBorrowed.GetByte());
+			break;
+		case NBT_TAG::Short:
+			nodeOut.Set<NBT_Type::Short>(nodeBorrowed.GetShort());
+			break;
+		case NBT_TAG::Int:
+			nodeOut.Set<NBT_Type::Int>(nodeBorrowed.GetInt());
+			break;
+		case NBT_TAG::Long:
+			nodeOut.Set<NBT_Type::Long>(nodeBorrowed.GetLong());
+			break;
+		case NBT_TAG::Float:
+			nodeOut.Set<NBT_Type::Float>(nodeBorrowed.GetFloat());
+			break;
+		case NBT_TAG::Double:
+			nodeOut.Set<NBT_Type::Double>(nodeBorrowed.GetDouble());
+			break;
+		case NBT_TAG::ByteArray:
+			nodeOut.Set<NBT_Type::ByteArray>(nodeBorrowed.GetByteArray().ToArray<NBT_Type::ByteArray>());
+			break;
+		case NBT_TAG::String:
+			{
+				const NBT_BorrowedNode::String &sView = nodeBorrowed.GetString();
+				nodeOut.Set<NBT_Type::String>(sView.data(), sView.size());
+			}
+			break;
+		case NBT_TAG::List:
+			{
+				const NBT_BorrowedNode::List &lstBorrowed = nodeBorrowed.GetList();
+				NBT_Type::List &lstOut = nodeOut.Set<NBT_Type::List>();
+				lstOut.Reserve(lstBorrowed.Size());
+				for (const NBT_BorrowedNode &nodeElement : lstBorrowed)
+				{
+					MaterializeSwitch(nodeElement, lstOut.AddBack(NBT_Node{}));
+				}
+			}
+			break;
+		case NBT_TAG::Compound:
+			MaterializeCompound(nodeBorrowed.GetCompound(), nodeOut.Set<NBT_Type::Compound>());
+			break;
+		case NBT_TAG::IntArray:
+			nodeOut.Set<NBT_Type::IntArray>(nodeBorrowed.GetIntArray().ToArray<NBT_Type::IntArray>());
+			break;
+		case NBT_TAG::LongArray:
+			nodeOut.Set<NBT_Type::LongArray>(nodeBorrowed.GetLongArray().ToArray<NBT_Type::LongArray>());
+			break;
+		default:
+			nodeOut.Set<NBT_Type::End>();
+			break;
+		}
+	}
+
+	static void MaterializeCompound(const NBT_BorrowedNode::Compound &cpdBorrowed, NBT_Type::Compound &cpdOut)
+	{
+		for (const auto &eEntry : cpdBorrowed)
+		{
+			NBT_Node nodeValue{};
+			MaterializeSwitch(eEntry.nodeValue, nodeValue);
+
+			//同名条目以后出现的为准
+			cpdOut.Put(NBT_Type::String(eEntry.sName.data(), eEntry.sName.size()), std::move(nodeValue));
+		}
+	}
+
+	//Materialize没有输入流可供预览，只输出与Error相同格式的错误码与扩展信息
+	template<typename InfoFunc>
+	static void MaterializeError(ErrCode code, InfoFunc &funcInfo, const char *pFuncName, const char *pWhat) noexcept
+	{
+		funcInfo(NBT_Print_Level::Err, "Read Err[{}]: {}\n", (uint8_t)code, errReason[code]);
+		funcInfo(NBT_Print_Level::Err, "Extra Info: \"{}: Info:[{}]\"\n\n", pFuncName, pWhat);
+	}
+
+#undef MYTRY
+#undef MYCATCH
+#undef CHECK_STACK_DEPTH
+#undef STACK_TRACEBACK
+#undef STRLING
+#undef _RP_STRLING
+#undef _RP___LINE__
+#undef _RP___FUNCTION__
+///@endcond
+
+public:
+	/// @brief 从字节流中以借用模式读取NBT数据
+	/// @tparam bUnwrapMixedList 是否自动解包列表中的打包Compound，请参考NBT_Reader::ReadNBT的说明
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式，不支持VarInt格式
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param spanData NBT二进制数据，调用者需要保证在得到的树使用期间数据有效且不被修改
+	/// @param szStartIdx 数据起始索引，会忽略前szStartIdx字节的数据
+	/// @param[out] tCompound 用于返回读取结果的对象
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	/// @note 与NBT_Reader::ReadNBT一样，数据被视作一个无名的根集合，直到数据末尾或遇到End标签为止，
+	/// 同样不会清空tCompound，读取的条目追加在原有条目之后。失败时tCompound中保留出错之前已经读取的部分。
+	/// 数组视图记录Format的字节序，读取元素时再转换，所以小端格式（基岩版存档）同样不需要拷贝数组。
+	/// VarInt格式的Int与Long数组元素是变长编码，无法直接引用，所以不能以借用模式读取。
+	template<bool bUnwrapMixedList = true, typename Format = NBT_Format::BigEndian, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format> && (!Format::bVarInt)
+	static bool ReadNBT(std::span<const uint8_t> spanData, size_t szStartIdx, NBT_BorrowedNode::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		//输入流不检查起始索引，越界时以数据末尾作为预览位置报告错误
+		InputStream tData(spanData, szStartIdx <= spanData.size() ? szStartIdx : spanData.size());
+		if (szStartIdx > spanData.size())
+		{
+			Error(OutOfRangeError, tData, funcInfo, "{}:\nszStartIdx[{}] > DataSize[{}]", __FUNCTION__, szStartIdx, spanData.size());
+			return false;
+		}
+
+		return GetBorrowedCompound<Format, true, bUnwrapMixedList>(tData, tCompound, szStackDepth, funcInfo) == AllOk;
+	}
+
+	/// @brief 从连续的数据容器中以借用模式读取NBT数据
+	/// @tparam bUnwrapMixedList 是否自动解包列表中的打包Compound，请参考NBT_Reader::ReadNBT的说明
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式，不支持VarInt格式
+	/// @tparam DataType 数据容器类型，需要提供data与size，例如std::vector<uint8_t>或NBT_IO::MappedFile
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param tDataInput 输入数据容器，调用者需要保证在得到的树使用期间容器有效且不被修改
+	/// @param szStartIdx 数据起始索引，会忽略前szStartIdx字节的数据
+	/// @param[out] tCompound 用于返回读取结果的对象
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	/// @note 此函数是ReadNBT的容器版本，其它信息请参考ReadNBT(std::span)版本的详细说明
+	template<bool bUnwrapMixedList = true, typename Format = NBT_Format::BigEndian, typename DataType, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format> && (!Format::bVarInt) && (!std::is_convertible_v<const DataType &, std::span<const uint8_t>>)
+	static bool ReadNBT(const DataType &tDataInput, size_t szStartIdx, NBT_BorrowedNode::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		std::span<const uint8_t> spanData((const uint8_t *)tDataInput.data(), tDataInput.size() * sizeof(typename DataType::value_type));
+		return ReadNBT<bUnwrapMixedList, Format>(spanData, szStartIdx, tCompound, szStackDepth, std::move(funcInfo));
+	}
+
+	/// @brief 把借用模式的集合转换为普通的NBT_Type::Compound
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param cpdBorrowed 借用模式的集合
+	/// @param[out] tCompound 用于返回结果的对象，与NBT_Reader::ReadNBT一样不会清空原有数据
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 成功返回true，内存不足等原因失败返回false
+	/// @note 转换后的对象拷贝了所有字符串与数组，不再依赖输入数据
+	template<typename InfoFunc = NBT_Print>
+	static bool Materialize(const NBT_BorrowedNode::Compound &cpdBorrowed, NBT_Type::Compound &tCompound, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		try
+		{
+			MaterializeCompound(cpdBorrowed, tCompound);
+			return true;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			MaterializeError(OutOfMemoryError, funcInfo, __FUNCTION__, e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			MaterializeError(StdException, funcInfo, __FUNCTION__, e.what());
+			return false;
+		}
+		catch (...)
+		{
+			MaterializeError(UnknownError, funcInfo, __FUNCTION__, "Unknown Exception");
+			return false;
+		}
+	}
+
+	/// @brief 把借用模式的节点转换为普通的NBT_Node
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param nodeBorrowed 借用模式的节点
+	/// @param[out] nodeOut 用于返回结果的对象，原有数据会被替换
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 成功返回true，内存不足等原因失败返回false
+	template<typename InfoFunc = NBT_Print>
+	static bool Materialize(const NBT_BorrowedNode &nodeBorrowed, NBT_Node &nodeOut, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		try
+		{
+			MaterializeSwitch(nodeBorrowed, nodeOut);
+			return true;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			MaterializeError(OutOfMemoryError, funcInfo, __FUNCTION__, e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			MaterializeError(StdException, funcInfo, __FUNCTION__, e.what());
+			return false;
+		}
+		catch (...)
+		{
+			MaterializeError(UnknownError, funcInfo, __FUNCTION__, "Unknown Exception");
+			return false;
+		}
+	}
+};
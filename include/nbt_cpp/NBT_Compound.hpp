@@ -16,7 +16,7 @@ class NBT_Writer;
 class NBT_Helper;
 
 /// @brief 继承自标准库std::unordered_map的代理类，用于存储和管理NBT键值对
-/// @tparam Compound 继承的父类，也就是std::unordered_map
+/// @tparam Compound 继承的父类，也就是std::unordered_map（定义CJF2_NBT_CPP_USE_FLAT_COMPOUND时为NBT_FlatMap）
 /// @note 用户不应自行实例化此类，请使用NBT_Type::Compound来访问此类实例化类型
 template<typename Compound>
 class NBT_Compound :protected Compound//Compound is Map
@@ -261,6 +261,10 @@ public:
 
 	/// @}
 
+	/// @brief 获取底层容器使用的分配器
+	/// @note 定义CJF2_NBT_CPP_USE_ARENA_ALLOCATOR时可以通过它得到容器所在的内存资源
+	using Compound::get_allocator;
+
 	//简化map查询
 
 	/// @brief 根据标签名获取对应的NBT值
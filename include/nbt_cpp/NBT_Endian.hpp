@@ -3,10 +3,13 @@
 #include <bit>//字节序
 #include <stdint.h>//定义
 #include <stddef.h>//size_t
+#include <string.h>//memmove
+#include <array>//std::array
 #include <utility>//std::index_sequence
 #include <type_traits>//std::make_unsigned_t
 
 #include "Compiler_Define.h"//编译器类型判断
+#include "SIMD_Define.h"//指令集判断
 
 /// @file
 /// @brief 端序工具集
@@ -234,4 +237,211 @@ public:
 		//当前是big，little转换到big
 		return AutoByteSwap(data);
 	}
+
+	//------------------------------------------------------//
+
+private:
+	/// @brief 生成字节重排掩码，用于按元素颠倒每个128位通道内的字节
+	/// @tparam szElementSize 元素字节数
+	/// @return 32字节的重排掩码（两个128位通道内容相同）
+	template<size_t szElementSize>
+	constexpr static std::array<uint8_t, 32> MakeByteSwapMask(void) noexcept
+	{
+		std::array<uint8_t, 32> arrMask{};
+		for (size_t i = 0; i < arrMask.size(); ++i)
+		{
+			size_t szLaneIdx = i % 16;
+			arrMask[i] = (uint8_t)(szLaneIdx / szElementSize * szElementSize + (szElementSize - 1 - szLaneIdx % szElementSize));
+		}
+		return arrMask;
+	}
+
+public:
+	/// @brief 批量颠倒数组中每个元素的字节序
+	/// @tparam T 任意整数类型
+	/// @param pDest 目标数组
+	/// @param pSrc 源数组
+	/// @param szCount 元素个数
+	/// @note pDest可以与pSrc相同（原地转换），但不能部分重叠。
+	/// 根据编译期可用的指令集选择AVX2/SSE2/NEON向量化实现，剩余部分与不支持的情况落到标量实现AutoByteSwap
+	template<typename T>
+	requires std::integral<T>
+	static void ByteSwapArray(T *pDest, const T *pSrc, size_t szCount) noexcept
+	{
+		//如果大小是1只需要拷贝
+		if constexpr (sizeof(T) == 1)
+		{
+			if (pDest != pSrc && szCount != 0)
+			{
+				memmove(pDest, pSrc, szCount);
+			}
+			return;
+		}
+		else
+		{
+			size_t i = 0;
+
+			//仅对常见的2、4、8字节进行向量化
+			if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+			{
+				[[maybe_unused]] const uint8_t *pSrcByte = (const uint8_t *)pSrc;
+				[[maybe_unused]] uint8_t *pDestByte = (uint8_t *)pDest;
+
+#if CJF2_NBT_CPP_SIMD_AVX2
+				{
+					constexpr size_t szStep = 32 / sizeof(T);
+					constexpr auto arrMask = MakeByteSwapMask<sizeof(T)>();
+					const __m256i vMask = _mm256_loadu_si256((const __m256i *)arrMask.data());
+
+					for (; i + szStep <= szCount; i += szStep)
+					{
+						__m256i v = _mm256_loadu_si256((const __m256i *)&pSrcByte[i * sizeof(T)]);
+						v = _mm256_shuffle_epi8(v, vMask);
+						_mm256_storeu_si256((__m256i *)&pDestByte[i * sizeof(T)], v);
+					}
+				}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_SSE2
+				{
+					//SSE2没有字节重排指令，先按16位字重排，再交换每个字内的两个字节
+					constexpr size_t szStep = 16 / sizeof(T);
+
+					for (; i + szStep <= szCount; i += szStep)
+					{
+						__m128i v = _mm_loadu_si128((const __m128i *)&pSrcByte[i * sizeof(T)]);
+
+						if constexpr (sizeof(T) == 4)
+						{
+							v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+							v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+						}
+						else if constexpr (sizeof(T) == 8)
+						{
+							v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+							v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+						}
+
+						v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+						_mm_storeu_si128((__m128i *)&pDestByte[i * sizeof(T)], v);
+					}
+				}
+#endif
+
+#if CJF2_NBT_CPP_SIMD_NEON
+				{
+					constexpr size_t szStep = 16 / sizeof(T);
+
+					for (; i + szStep <= szCount; i += szStep)
+					{
+						uint8x16_t v = vld1q_u8(&pSrcByte[i * sizeof(T)]);
+
+						if constexpr (sizeof(T) == 2)
+						{
+							v = vrev16q_u8(v);
+						}
+						else if constexpr (sizeof(T) == 4)
+						{
+							v = vrev32q_u8(v);
+						}
+						else if constexpr (sizeof(T) == 8)
+						{
+							v = vrev64q_u8(v);
+						}
+
+						vst1q_u8(&pDestByte[i * sizeof(T)], v);
+					}
+				}
+#endif
+			}
+
+			//剩余部分使用标量实现
+			for (; i < szCount; ++i)
+			{
+				pDest[i] = AutoByteSwap(pSrc[i]);
+			}
+		}
+	}
+
+	/// @brief 批量从大端字节序转换到当前平台字节序（原地转换）
+	/// @tparam T 任意整数类型
+	/// @param pData 数组
+	/// @param szCount 元素个数
+	/// @note 如果平台字节序与大端相同，则什么也不做
+	template<typename T>
+	requires std::integral<T>
+	static void BigToNativeArray(T *pData, size_t szCount) noexcept
+	{
+		if constexpr (IsBigEndian())//当前也是big
+		{
+			return;
+		}
+
+		//当前是little，big转换到little
+		ByteSwapArray(pData, pData, szCount);
+	}
+
+	/// @brief 批量从当前平台字节序转换到大端字节序
+	/// @tparam T 任意整数类型
+	/// @param pDest 目标数组
+	/// @param pSrc 源数组
+	/// @param szCount 元素个数
+	/// @note pDest可以与pSrc相同（原地转换），但不能部分重叠。如果平台字节序与大端相同，则仅拷贝
+	template<typename T>
+	requires std::integral<T>
+	static void NativeToBigArray(T *pDest, const T *pSrc, size_t szCount) noexcept
+	{
+		if constexpr (IsBigEndian())//当前也是big
+		{
+			if (pDest != pSrc && szCount != 0)
+			{
+				memmove(pDest, pSrc, szCount * sizeof(T));
+			}
+			return;
+		}
+
+		//当前是little，little转换到big
+		ByteSwapArray(pDest, pSrc, szCount);
+	}
+
+	/// @brief 批量从小端字节序转换到当前平台字节序（原地转换）
+	/// @tparam T 任意整数类型
+	/// @param pData 数组
+	/// @param szCount 元素个数
+	/// @note 如果平台字节序与小端相同，则什么也不做
+	template<typename T>
+	requires std::integral<T>
+	static void LittleToNativeArray(T *pData, size_t szCount) noexcept
+	{
+		if constexpr (IsLittleEndian())//当前也是little
+		{
+			return;
+		}
+
+		//当前是big，little转换到big
+		ByteSwapArray(pData, pData, szCount);
+	}
+
+	/// @brief 批量从当前平台字节序转换到小端字节序
+	/// @tparam T 任意整数类型
+	/// @param pDest 目标数组
+	/// @param pSrc 源数组
+	/// @param szCount 元素个数
+	/// @note pDest可以与pSrc相同（原地转换），但不能部分重叠。如果平台字节序与小端相同，则仅拷贝
+	template<typename T>
+	requires std::integral<T>
+	static void NativeToLittleArray(T *pDest, const T *pSrc, size_t szCount) noexcept
+	{
+		if constexpr (IsLittleEndian())//当前也是little
+		{
+			if (pDest != pSrc && szCount != 0)
+			{
+				memmove(pDest, pSrc, szCount * sizeof(T));
+			}
+			return;
+		}
+
+		//当前是big，big转换到little
+		ByteSwapArray(pDest, pSrc, szCount);
+	}
 };
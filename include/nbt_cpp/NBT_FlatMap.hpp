@@ -0,0 +1,896 @@
+﻿#pragma once
+
+#include <stdint.h>
+#include <stddef.h>//size_t
+#include <vector>
+#include <utility>//std::pair std::piecewise_construct
+#include <tuple>//std::forward_as_tuple
+#include <memory>//std::allocator std::allocator_traits
+#include <functional>//std::hash std::equal_to
+#include <optional>
+#include <stdexcept>//std::out_of_range std::length_error
+#include <initializer_list>
+#include <bit>//std::countr_zero
+#include <iterator>//std::forward_iterator_tag
+#include <type_traits>//std::conditional_t
+
+#include "SIMD_Define.h"//指令集判断
+
+/// @file
+/// @brief 开放寻址的平铺哈希表，可作为NBT_Compound的底层容器
+///
+/// 定义宏CJF2_NBT_CPP_USE_FLAT_COMPOUND后，NBT_Type::Compound会使用NBT_FlatMap代替std::unordered_map，
+/// NBT_Compound的接口保持不变，NBT_Reader、NBT_Writer与NBT_Helper无需任何修改。
+/// 未定义此宏时，本文件中的类型仍然可以单独使用，但是不会影响NBT_Type。
+
+/// @brief 开放寻址的平铺哈希表
+/// @tparam Key 键类型
+/// @tparam Value 值类型
+/// @tparam Hash 哈希仿函数类型，必须是无状态的
+/// @tparam KeyEqual 键比较仿函数类型，必须是无状态的
+/// @tparam Allocator 元素分配器类型，内部会重新绑定到实际使用的类型
+/// @note 实现说明：
+/// - 所有键值对按插入顺序连续存放在一个std::vector中，遍历就是顺序访问这个数组
+/// - 内部以std::pair<Key, Value>存放（删除时需要移动键），迭代器对外只提供std::pair<const Key, Value>的视图，
+///   与libc++及abseil的哈希表相同，依赖两者布局一致（已通过static_assert检查）
+/// - 元素数量不超过szSmallSize时不建立索引，查找直接线性比较键（大部分NBT集合只有几个条目，这样完全不需要计算哈希）
+/// - 超过以后建立开放寻址索引：每个槽位一个控制字节（空、已删除或哈希值的低7位）与一个元素下标，
+///   每16个槽位为一组，查找时通过SSE2或NEON一次比较一整组的控制字节，只有低7位相同的槽位才会比较键
+/// - 删除元素时把最后一个元素移动到被删除的位置，所以删除会改变遍历顺序，并且使指向最后一个元素的迭代器失效
+///
+/// 与std::unordered_map的区别：
+/// - 插入可能导致所有迭代器、指针与引用失效（与std::vector相同）
+/// - 没有桶接口，local_iterator即普通迭代器
+/// - 元素数量上限为UINT32_MAX - 1
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class NBT_FlatMap
+{
+public:
+	/// @name 容器公开类型
+	/// @brief 与std::unordered_map对应，具体含义请参考标准库说明
+	/// @{
+
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<const Key, Value>;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+
+	/// @}
+
+protected:
+	using StorageType = std::pair<Key, Value>;	///< 内部存放的类型，键可以移动
+	using ValueVector = std::vector<StorageType, typename std::allocator_traits<Allocator>::template rebind_alloc<StorageType>>;
+	using CtrlVector = std::vector<uint8_t, typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>>;
+	using SlotVector = std::vector<uint32_t, typename std::allocator_traits<Allocator>::template rebind_alloc<uint32_t>>;
+
+public:
+	/// @name 迭代器类型
+	/// @{
+
+	/// @brief 前向迭代器，解引用得到std::pair<const Key, Value>
+	/// @tparam bConst 是否为常量迭代器
+	template<bool bConst>
+	class IteratorImpl
+	{
+		friend class NBT_FlatMap;
+		template<bool>
+		friend class IteratorImpl;
+
+	private:
+		using BaseIterator = std::conditional_t<bConst, typename ValueVector::const_iterator, typename ValueVector::iterator>;
+		BaseIterator itBase{};
+
+		explicit IteratorImpl(BaseIterator _itBase) noexcept :itBase(_itBase)
+		{}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename NBT_FlatMap::value_type;
+		using difference_type = ptrdiff_t;
+		using pointer = std::conditional_t<bConst, const value_type *, value_type *>;
+		using reference = std::conditional_t<bConst, const value_type &, value_type &>;
+
+		IteratorImpl(void) = default;
+
+		/// @brief 非常量迭代器可以隐式转换为常量迭代器
+		template<bool bOtherConst>
+		requires(bConst && !bOtherConst)
+		IteratorImpl(const IteratorImpl<bOtherConst> &_Other) noexcept :itBase(_Other.itBase)
+		{}
+
+		reference operator*(void) const noexcept
+		{
+			return *operator->();
+		}
+
+		pointer operator->(void) const noexcept
+		{
+			static_assert(sizeof(value_type) == sizeof(StorageType) && alignof(value_type) == alignof(StorageType));
+			return reinterpret_cast<pointer>(std::to_address(itBase));
+		}
+
+		IteratorImpl &operator++(void) noexcept
+		{
+			++itBase;
+			return *this;
+		}
+
+		IteratorImpl operator++(int) noexcept
+		{
+			IteratorImpl itRet = *this;
+			++itBase;
+			return itRet;
+		}
+
+		template<bool bOtherConst>
+		bool operator==(const IteratorImpl<bOtherConst> &_Right) const noexcept
+		{
+			return itBase == _Right.itBase;
+		}
+	};
+
+	using iterator = IteratorImpl<false>;
+	using const_iterator = IteratorImpl<true>;
+	using local_iterator = iterator;				///< 没有桶的概念，与普通迭代器相同
+	using const_local_iterator = const_iterator;	///< 没有桶的概念，与普通迭代器相同
+
+	/// @}
+
+	/// @brief 从容器中取出的节点，用于extract与insert
+	class node_type
+	{
+		friend class NBT_FlatMap;
+
+	private:
+		std::optional<StorageType> optValue{};
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using allocator_type = typename NBT_FlatMap::allocator_type;
+
+		node_type(void) = default;
+		~node_type(void) = default;
+		node_type(node_type &&) = default;
+		node_type &operator=(node_type &&) = default;
+		node_type(const node_type &) = delete;
+		node_type &operator=(const node_type &) = delete;
+
+		/// @brief 节点是否为空
+		bool empty(void) const noexcept
+		{
+			return !optValue.has_value();
+		}
+
+		/// @brief 节点是否不为空
+		explicit operator bool(void) const noexcept
+		{
+			return optValue.has_value();
+		}
+
+		/// @brief 获取节点的键，节点不能为空
+		key_type &key(void) const
+		{
+			return const_cast<key_type &>(optValue->first);//节点不在容器中，可以修改键
+		}
+
+		/// @brief 获取节点的值，节点不能为空
+		mapped_type &mapped(void) const
+		{
+			return const_cast<mapped_type &>(optValue->second);
+		}
+	};
+
+	/// @brief 插入节点的结果
+	struct insert_return_type
+	{
+		iterator position;	///< 插入的元素或阻止插入的元素
+		bool inserted;		///< 是否执行了插入
+		node_type node;		///< 插入失败时原样返回的节点
+	};
+
+protected:
+	static constexpr size_t szSmallSize = 8;		///< 不超过这个数量时不建立索引
+	static constexpr size_t szGroupSize = 16;		///< 一次比较的控制字节数量
+	static constexpr size_t szNotFound = (size_t)-1;
+
+	static constexpr uint8_t u8CtrlEmpty = 0x80;	///< 空槽位
+	static constexpr uint8_t u8CtrlDeleted = 0xFE;	///< 已删除的槽位
+	//其余控制字节最高位为0，低7位为哈希值的低7位
+
+#if CJF2_NBT_CPP_SIMD_NEON && !CJF2_NBT_CPP_SIMD_SSE2
+	static constexpr int iMaskShift = 2;//NEON的掩码每个字节占4位
+#else
+	static constexpr int iMaskShift = 0;
+#endif
+
+protected:
+	ValueVector vValue{};	///< 按插入顺序存放的所有元素
+	CtrlVector vCtrl{};		///< 每个槽位的控制字节，为空则表示没有建立索引
+	SlotVector vSlot{};		///< 每个槽位对应的元素下标
+	size_t szDeleted = 0;	///< 已删除的槽位数量
+
+protected:
+	static size_t H1(size_t szHash) noexcept
+	{
+		return szHash >> 7;
+	}
+
+	static uint8_t H2(size_t szHash) noexcept
+	{
+		return (uint8_t)(szHash & 0x7F);
+	}
+
+	/// @brief 获取一组中控制字节等于u8Ctrl的槽位掩码
+	static uint64_t MatchByte(const uint8_t *pGroup, uint8_t u8Ctrl) noexcept
+	{
+#if CJF2_NBT_CPP_SIMD_SSE2
+		__m128i vGroup = _mm_loadu_si128((const __m128i *)pGroup);
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(vGroup, _mm_set1_epi8((char)u8Ctrl)));
+#elif CJF2_NBT_CPP_SIMD_NEON
+		uint8x16_t vEq = vceqq_u8(vld1q_u8(pGroup), vdupq_n_u8(u8Ctrl));
+		uint64_t u64Mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vEq), 4)), 0);
+		return u64Mask & 0x8888888888888888ULL;
+#else
+		uint64_t u64Mask = 0;
+		for (size_t i = 0; i < szGroupSize; ++i)
+		{
+			u64Mask |= (uint64_t)(pGroup[i] == u8Ctrl) << i;
+		}
+		return u64Mask;
+#endif
+	}
+
+	/// @brief 获取一组中空或已删除的槽位掩码（控制字节最高位为1）
+	static uint64_t MatchNonFull(const uint8_t *pGroup) noexcept
+	{
+#if CJF2_NBT_CPP_SIMD_SSE2
+		return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)pGroup));
+#elif CJF2_NBT_CPP_SIMD_NEON
+		uint8x16_t vGe = vcgeq_u8(vld1q_u8(pGroup), vdupq_n_u8(0x80));
+		uint64_t u64Mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vGe), 4)), 0);
+		return u64Mask & 0x8888888888888888ULL;
+#else
+		uint64_t u64Mask = 0;
+		for (size_t i = 0; i < szGroupSize; ++i)
+		{
+			u64Mask |= (uint64_t)(pGroup[i] >> 7) << i;
+		}
+		return u64Mask;
+#endif
+	}
+
+	/// @brief 掩码中最低位的槽位在组内的下标
+	static size_t MaskIndex(uint64_t u64Mask) noexcept
+	{
+		return (size_t)std::countr_zero(u64Mask) >> iMaskShift;
+	}
+
+	/// @brief 计算容纳szCount个元素需要的槽位数量（16的2次幂倍，负载不超过7/8）
+	static size_t CapacityFor(size_t szCount) noexcept
+	{
+		size_t szCapacity = szGroupSize;
+		while (szCapacity * 7 < szCount * 8)
+		{
+			szCapacity *= 2;
+		}
+		return szCapacity;
+	}
+
+	/// @brief 查找键对应的元素下标
+	/// @param key 要查找的键
+	/// @param szHash 键的哈希值，仅在建立了索引时使用
+	/// @return 元素下标，不存在则返回szNotFound
+	size_t FindIndex(const key_type &key, size_t szHash) const noexcept
+	{
+		if (vCtrl.empty())
+		{
+			for (size_t i = 0; i < vValue.size(); ++i)
+			{
+				if (key_equal{}(vValue[i].first, key))
+				{
+					return i;
+				}
+			}
+			return szNotFound;
+		}
+
+		const uint8_t u8H2 = H2(szHash);
+		const size_t szGroupMask = vCtrl.size() / szGroupSize - 1;
+		size_t szGroup = H1(szHash) & szGroupMask;
+
+		//三角数探测，组数量为2的次幂时可以访问到所有组
+		for (size_t szStep = 1; szStep <= szGroupMask + 1; ++szStep)
+		{
+			const uint8_t *pGroup = &vCtrl[szGroup * szGroupSize];
+			for (uint64_t u64Mask = MatchByte(pGroup, u8H2); u64Mask != 0; u64Mask &= u64Mask - 1)
+			{
+				size_t szIndex = vSlot[szGroup * szGroupSize + MaskIndex(u64Mask)];
+				if (key_equal{}(vValue[szIndex].first, key))
+				{
+					return szIndex;
+				}
+			}
+
+			if (MatchByte(pGroup, u8CtrlEmpty) != 0)//遇到空槽位，说明键不存在
+			{
+				return szNotFound;
+			}
+
+			szGroup = (szGroup + szStep) & szGroupMask;
+		}
+
+		return szNotFound;
+	}
+
+	/// @brief 计算键的哈希值，没有建立索引时不计算
+	size_t HashIfIndexed(const key_type &key) const noexcept
+	{
+		return vCtrl.empty() ? 0 : hasher{}(key);
+	}
+
+	/// @brief 查找指向指定元素下标的槽位，元素必须存在
+	size_t FindSlot(size_t szHash, size_t szIndex) const noexcept
+	{
+		const uint8_t u8H2 = H2(szHash);
+		const size_t szGroupMask = vCtrl.size() / szGroupSize - 1;
+		size_t szGroup = H1(szHash) & szGroupMask;
+
+		for (size_t szStep = 1; ; ++szStep)
+		{
+			const uint8_t *pGroup = &vCtrl[szGroup * szGroupSize];
+			for (uint64_t u64Mask = MatchByte(pGroup, u8H2); u64Mask != 0; u64Mask &= u64Mask - 1)
+			{
+				size_t szSlot = szGroup * szGroupSize + MaskIndex(u64Mask);
+				if (vSlot[szSlot] == szIndex)
+				{
+					return szSlot;
+				}
+			}
+
+			szGroup = (szGroup + szStep) & szGroupMask;
+		}
+	}
+
+	/// @brief 把元素下标放入索引，调用前必须保证有空余槽位
+	void InsertSlot(size_t szHash, size_t szIndex) noexcept
+	{
+		const size_t szGroupMask = vCtrl.size() / szGroupSize - 1;
+		size_t szGroup = H1(szHash) & szGroupMask;
+
+		for (size_t szStep = 1; ; ++szStep)
+		{
+			uint64_t u64Mask = MatchNonFull(&vCtrl[szGroup * szGroupSize]);
+			if (u64Mask != 0)
+			{
+				size_t szSlot = szGroup * szGroupSize + MaskIndex(u64Mask);
+				if (vCtrl[szSlot] == u8CtrlDeleted)
+				{
+					--szDeleted;
+				}
+
+				vCtrl[szSlot] = H2(szHash);
+				vSlot[szSlot] = (uint32_t)szIndex;
+				return;
+			}
+
+			szGroup = (szGroup + szStep) & szGroupMask;
+		}
+	}
+
+	/// @brief 重建索引
+	/// @param szCapacity 新的槽位数量
+	/// @note 新索引分配成功后才会替换旧索引，失败时容器不变
+	void Rehash(size_t szCapacity)
+	{
+		CtrlVector vNewCtrl(szCapacity, u8CtrlEmpty, vCtrl.get_allocator());
+		SlotVector vNewSlot(szCapacity, 0, vSlot.get_allocator());
+		vCtrl.swap(vNewCtrl);
+		vSlot.swap(vNewSlot);
+		szDeleted = 0;
+
+		for (size_t i = 0; i < vValue.size(); ++i)
+		{
+			InsertSlot(hasher{}(vValue[i].first), i);
+		}
+	}
+
+	/// @brief 为插入一个新元素准备索引，必要时建立或扩展索引
+	void PrepareInsert(void)
+	{
+		const size_t szNewSize = vValue.size() + 1;
+		if (szNewSize >= (size_t)UINT32_MAX)
+		{
+			throw std::length_error("NBT_FlatMap too long");
+		}
+
+		if (vCtrl.empty())
+		{
+			if (szNewSize > szSmallSize)
+			{
+				Rehash(CapacityFor(szNewSize * 2));
+			}
+		}
+		else if ((szNewSize + szDeleted) * 8 > vCtrl.size() * 7)
+		{
+			Rehash(CapacityFor(szNewSize * 2));//删除较多时容量不变，仅清理已删除的槽位
+		}
+	}
+
+	/// @brief 在末尾构造一个不存在的新元素
+	/// @param bHashed szHash是否为键的有效哈希值
+	/// @param szHash 键的哈希值
+	template<typename... Args>
+	iterator EmplaceNew(bool bHashed, size_t szHash, Args&&... args)
+	{
+		PrepareInsert();
+		vValue.emplace_back(std::forward<Args>(args)...);
+
+		if (!vCtrl.empty())
+		{
+			InsertSlot(bHashed ? szHash : hasher{}(vValue.back().first), vValue.size() - 1);
+		}
+
+		return iterator(vValue.begin() + (vValue.size() - 1));
+	}
+
+	/// @brief 删除指定下标的元素，把最后一个元素移动过来
+	/// @param szIndex 元素下标
+	/// @param szHash 元素键的哈希值，仅在建立了索引时使用
+	void EraseIndex(size_t szIndex, size_t szHash)
+	{
+		const size_t szLast = vValue.size() - 1;
+
+		if (!vCtrl.empty())
+		{
+			vCtrl[FindSlot(szHash, szIndex)] = u8CtrlDeleted;
+			++szDeleted;
+
+			if (szIndex != szLast)
+			{
+				vSlot[FindSlot(hasher{}(vValue[szLast].first), szLast)] = (uint32_t)szIndex;
+			}
+		}
+
+		if (szIndex != szLast)
+		{
+			vValue[szIndex] = std::move(vValue[szLast]);
+		}
+		vValue.pop_back();
+	}
+
+	/// @brief 键不存在时插入
+	/// @param bHashed szHash是否为键的有效哈希值，为false时只在建立了索引时才计算
+	template<typename K, typename... Args>
+	std::pair<iterator, bool> TryEmplaceHashedImpl(bool bHashed, size_t szHash, K &&key, Args&&... args)
+	{
+		if (!bHashed)
+		{
+			bHashed = !vCtrl.empty();
+			szHash = HashIfIndexed(key);
+		}
+
+		const size_t szIndex = FindIndex(key, szHash);
+		if (szIndex != szNotFound)
+		{
+			return { iterator(vValue.begin() + szIndex),false };
+		}
+
+		return { EmplaceNew(bHashed, szHash, std::piecewise_construct,
+			std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...)),true };
+	}
+
+	template<typename K, typename... Args>
+	std::pair<iterator, bool> TryEmplaceImpl(K &&key, Args&&... args)
+	{
+		return TryEmplaceHashedImpl(false, 0, std::forward<K>(key), std::forward<Args>(args)...);
+	}
+
+	template<typename K, typename M>
+	std::pair<iterator, bool> InsertOrAssignImpl(K &&key, M &&obj)
+	{
+		const size_t szHash = HashIfIndexed(key);
+		const size_t szIndex = FindIndex(key, szHash);
+		if (szIndex != szNotFound)
+		{
+			vValue[szIndex].second = std::forward<M>(obj);
+			return { iterator(vValue.begin() + szIndex),false };
+		}
+
+		return { EmplaceNew(!vCtrl.empty(), szHash, std::forward<K>(key), std::forward<M>(obj)),true };
+	}
+
+public:
+	/// @brief 默认构造
+	NBT_FlatMap(void) = default;
+	/// @brief 默认析构
+	~NBT_FlatMap(void) = default;
+
+	/// @brief 使用指定分配器构造
+	/// @param alloc 分配器
+	explicit NBT_FlatMap(const allocator_type &alloc) :vValue(alloc), vCtrl(alloc), vSlot(alloc)
+	{}
+
+	/// @brief 从迭代器范围构造，重复的键只保留第一个
+	template<typename InputIt>
+	NBT_FlatMap(InputIt itBeg, InputIt itEnd)
+	{
+		insert(itBeg, itEnd);
+	}
+
+	/// @brief 从初始化列表构造，重复的键只保留第一个
+	NBT_FlatMap(std::initializer_list<value_type> init)
+	{
+		insert(init);
+	}
+
+	/// @brief 拷贝构造
+	NBT_FlatMap(const NBT_FlatMap &_Copy) = default;
+
+	/// @brief 移动构造
+	NBT_FlatMap(NBT_FlatMap &&_Move) noexcept :
+		vValue(std::move(_Move.vValue)),
+		vCtrl(std::move(_Move.vCtrl)),
+		vSlot(std::move(_Move.vSlot)),
+		szDeleted(_Move.szDeleted)
+	{
+		_Move.clear();
+	}
+
+	/// @brief 拷贝赋值
+	NBT_FlatMap &operator=(const NBT_FlatMap &_Copy) = default;
+
+	/// @brief 移动赋值
+	NBT_FlatMap &operator=(NBT_FlatMap &&_Move) noexcept
+	{
+		if (this != &_Move)
+		{
+			vValue = std::move(_Move.vValue);
+			vCtrl = std::move(_Move.vCtrl);
+			vSlot = std::move(_Move.vSlot);
+			szDeleted = _Move.szDeleted;
+			_Move.clear();
+		}
+		return *this;
+	}
+
+	/// @brief 从初始化列表赋值
+	NBT_FlatMap &operator=(std::initializer_list<value_type> init)
+	{
+		clear();
+		insert(init);
+		return *this;
+	}
+
+	/// @name 迭代器
+	/// @{
+
+	iterator begin(void) noexcept { return iterator(vValue.begin()); }
+	iterator end(void) noexcept { return iterator(vValue.end()); }
+	const_iterator begin(void) const noexcept { return const_iterator(vValue.begin()); }
+	const_iterator end(void) const noexcept { return const_iterator(vValue.end()); }
+	const_iterator cbegin(void) const noexcept { return const_iterator(vValue.cbegin()); }
+	const_iterator cend(void) const noexcept { return const_iterator(vValue.cend()); }
+
+	/// @}
+
+	/// @name 容量
+	/// @{
+
+	bool empty(void) const noexcept { return vValue.empty(); }
+	size_type size(void) const noexcept { return vValue.size(); }
+	size_type max_size(void) const noexcept { return (size_type)UINT32_MAX - 1; }
+
+	/// @}
+
+	/// @brief 预留至少能容纳szCount个元素的空间
+	void reserve(size_type szCount)
+	{
+		if (szCount > szSmallSize && vCtrl.size() < CapacityFor(szCount))
+		{
+			Rehash(CapacityFor(szCount));
+		}
+		vValue.reserve(szCount);
+	}
+
+	/// @brief 清空所有元素，同时释放索引回到线性查找
+	void clear(void) noexcept
+	{
+		vValue.clear();
+		vCtrl = CtrlVector(vCtrl.get_allocator());
+		vSlot = SlotVector(vSlot.get_allocator());
+		szDeleted = 0;
+	}
+
+	/// @name 插入
+	/// @{
+
+	std::pair<iterator, bool> insert(const value_type &value)
+	{
+		return TryEmplaceImpl(value.first, value.second);
+	}
+
+	std::pair<iterator, bool> insert(value_type &&value)
+	{
+		return TryEmplaceImpl(value.first, std::move(value.second));//键为const，只能拷贝
+	}
+
+	template<typename InputIt>
+	void insert(InputIt itBeg, InputIt itEnd)
+	{
+		for (; itBeg != itEnd; ++itBeg)
+		{
+			TryEmplaceImpl(itBeg->first, itBeg->second);
+		}
+	}
+
+	void insert(std::initializer_list<value_type> init)
+	{
+		insert(init.begin(), init.end());
+	}
+
+	/// @brief 插入节点，节点为空或键已存在时不插入
+	insert_return_type insert(node_type &&node)
+	{
+		if (node.empty())
+		{
+			return { end(),false,node_type{} };
+		}
+
+		auto [it, bInserted] = TryEmplaceImpl(std::move(node.optValue->first), std::move(node.optValue->second));
+		if (!bInserted)
+		{
+			return { it,false,std::move(node) };
+		}
+
+		node.optValue.reset();
+		return { it,true,node_type{} };
+	}
+
+	template<typename M>
+	std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj)
+	{
+		return InsertOrAssignImpl(key, std::forward<M>(obj));
+	}
+
+	template<typename M>
+	std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj)
+	{
+		return InsertOrAssignImpl(std::move(key), std::forward<M>(obj));
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> emplace(Args&&... args)
+	{
+		StorageType value(std::forward<Args>(args)...);//键不是const，可以移动进容器
+		return TryEmplaceImpl(std::move(value.first), std::move(value.second));
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(const key_type &key, Args&&... args)
+	{
+		return TryEmplaceImpl(key, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(key_type &&key, Args&&... args)
+	{
+		return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+	}
+
+	/// @brief 与try_emplace相同，但是使用调用者已经计算好的哈希值
+	/// @param szHash 键的哈希值，必须等于hasher{}(key)，否则之后的查找结果未定义
+	/// @note 用于键的哈希值已经保存在别处的情况（例如NBT_KeyPool），建立了索引的容器插入时不再对键计算哈希
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace_hashed(size_t szHash, key_type &&key, Args&&... args)
+	{
+		return TryEmplaceHashedImpl(true, szHash, std::move(key), std::forward<Args>(args)...);
+	}
+
+	/// @}
+
+	/// @name 删除
+	/// @note 删除时最后一个元素会移动到被删除的位置
+	/// @{
+
+	/// @brief 删除迭代器指向的元素
+	/// @return 指向同一位置的迭代器（此时为原先的最后一个元素），因此it = erase(it)的循环仍然会访问到所有元素
+	iterator erase(const_iterator pos)
+	{
+		const size_t szIndex = (size_t)(pos.itBase - vValue.cbegin());
+		EraseIndex(szIndex, HashIfIndexed(vValue[szIndex].first));
+		return iterator(vValue.begin() + szIndex);
+	}
+
+	/// @copydoc erase(const_iterator)
+	iterator erase(iterator pos)
+	{
+		return erase(const_iterator(pos));
+	}
+
+	/// @brief 删除指定键的元素
+	/// @return 删除的元素数量（0或1）
+	size_type erase(const key_type &key)
+	{
+		const size_t szHash = HashIfIndexed(key);
+		const size_t szIndex = FindIndex(key, szHash);
+		if (szIndex == szNotFound)
+		{
+			return 0;
+		}
+
+		EraseIndex(szIndex, szHash);
+		return 1;
+	}
+
+	/// @brief 取出指定键的元素
+	/// @return 包含元素的节点，不存在则返回空节点
+	node_type extract(const key_type &key)
+	{
+		node_type node{};
+
+		const size_t szHash = HashIfIndexed(key);
+		const size_t szIndex = FindIndex(key, szHash);
+		if (szIndex != szNotFound)
+		{
+			node.optValue.emplace(std::move(vValue[szIndex]));
+			EraseIndex(szIndex, szHash);//键已被移走，此处必须使用之前计算的哈希值
+		}
+
+		return node;
+	}
+
+	/// @}
+
+	void swap(NBT_FlatMap &_Other) noexcept
+	{
+		vValue.swap(_Other.vValue);
+		vCtrl.swap(_Other.vCtrl);
+		vSlot.swap(_Other.vSlot);
+		std::swap(szDeleted, _Other.szDeleted);
+	}
+
+	friend void swap(NBT_FlatMap &_Left, NBT_FlatMap &_Right) noexcept
+	{
+		_Left.swap(_Right);
+	}
+
+	/// @brief 把源容器中当前容器没有的键移动过来，已有的键留在源容器中
+	void merge(NBT_FlatMap &_Source)
+	{
+		if (&_Source == this)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < _Source.vValue.size();)
+		{
+			const size_t szHash = HashIfIndexed(_Source.vValue[i].first);
+			if (FindIndex(_Source.vValue[i].first, szHash) != szNotFound)
+			{
+				++i;
+				continue;
+			}
+
+			const size_t szSourceHash = _Source.HashIfIndexed(_Source.vValue[i].first);
+			EmplaceNew(!vCtrl.empty(), szHash, std::move(_Source.vValue[i]));
+			_Source.EraseIndex(i, szSourceHash);//最后一个元素移到了i，不增加i
+		}
+	}
+
+	/// @copydoc merge(NBT_FlatMap &)
+	void merge(NBT_FlatMap &&_Source)
+	{
+		merge(_Source);
+	}
+
+	/// @brief 把源容器中当前容器没有的键拷贝过来
+	void merge(const NBT_FlatMap &_Source)
+	{
+		if (&_Source == this)
+		{
+			return;
+		}
+
+		for (const auto &it : _Source.vValue)
+		{
+			TryEmplaceImpl(it.first, it.second);
+		}
+	}
+
+	/// @name 查找
+	/// @{
+
+	mapped_type &at(const key_type &key)
+	{
+		size_t szIndex = FindIndex(key, HashIfIndexed(key));
+		if (szIndex == szNotFound)
+		{
+			throw std::out_of_range("NBT_FlatMap::at: key not found");
+		}
+		return vValue[szIndex].second;
+	}
+
+	const mapped_type &at(const key_type &key) const
+	{
+		size_t szIndex = FindIndex(key, HashIfIndexed(key));
+		if (szIndex == szNotFound)
+		{
+			throw std::out_of_range("NBT_FlatMap::at: key not found");
+		}
+		return vValue[szIndex].second;
+	}
+
+	mapped_type &operator[](const key_type &key)
+	{
+		return TryEmplaceImpl(key).first->second;
+	}
+
+	mapped_type &operator[](key_type &&key)
+	{
+		return TryEmplaceImpl(std::move(key)).first->second;
+	}
+
+	iterator find(const key_type &key) noexcept
+	{
+		size_t szIndex = FindIndex(key, HashIfIndexed(key));
+		return iterator(szIndex == szNotFound ? vValue.end() : vValue.begin() + szIndex);
+	}
+
+	const_iterator find(const key_type &key) const noexcept
+	{
+		size_t szIndex = FindIndex(key, HashIfIndexed(key));
+		return const_iterator(szIndex == szNotFound ? vValue.cend() : vValue.cbegin() + szIndex);
+	}
+
+	size_type count(const key_type &key) const noexcept
+	{
+		return FindIndex(key, HashIfIndexed(key)) == szNotFound ? 0 : 1;
+	}
+
+	bool contains(const key_type &key) const noexcept
+	{
+		return FindIndex(key, HashIfIndexed(key)) != szNotFound;
+	}
+
+	/// @}
+
+	/// @name 观察器
+	/// @{
+
+	hasher hash_function(void) const { return hasher{}; }
+	key_equal key_eq(void) const { return key_equal{}; }
+	allocator_type get_allocator(void) const noexcept { return vValue.get_allocator(); }
+
+	/// @}
+
+	/// @brief 相等比较，与顺序无关
+	/// @param _Right 要比较的右操作数
+	/// @return 键集合相同且每个键对应的值相等时返回true
+	bool operator==(const NBT_FlatMap &_Right) const
+	{
+		if (size() != _Right.size())
+		{
+			return false;
+		}
+
+		for (const auto &it : vValue)
+		{
+			size_t szIndex = _Right.FindIndex(it.first, _Right.HashIfIndexed(it.first));
+			if (szIndex == szNotFound || !(_Right.vValue[szIndex].second == it.second))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
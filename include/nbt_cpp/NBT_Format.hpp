@@ -0,0 +1,481 @@
+﻿#pragma once
+
+#include <bit>//std::endian std::countr_zero std::popcount
+#include <limits>//std::numeric_limits
+#include <concepts>//std::integral
+#include <algorithm>//std::max
+#include <type_traits>//std::make_unsigned_t
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <string.h>//memcpy
+
+#include "NBT_Endian.hpp"//字节序
+
+/// @file
+/// @brief NBT二进制格式策略
+
+/// @brief NBT二进制格式策略集合，作为NBT_Reader、NBT_Writer与NBT_Scanner的编译期模板参数，
+/// 决定二进制流中定长数值、长度与数组元素的编码方式
+/// @note 每个策略都提供相同的静态接口：
+/// ToNative/FromNative用于单个值，ToNativeArray/FromNativeArray用于批量转换，
+/// bNativeOrder表示流中字节序与当前平台一致，此时读写可以直接整块拷贝而无需转换。
+/// bVarInt表示策略中存在以VarInt编码的字段，bVarIntField<T>判断类型为T的字段是否以VarInt编码，
+/// 这类字段不能整块拷贝，需要通过策略的ReadField、EncodeField与SkipVarInt逐个处理。
+class NBT_Format
+{
+	/// @brief 禁止构造
+	NBT_Format(void) = delete;
+	/// @brief 禁止析构
+	~NBT_Format(void) = delete;
+
+public:
+	/// @brief 大端序格式，Java版文件与区域文件使用的格式，也是所有读写例程的默认格式
+	struct BigEndian
+	{
+		/// @brief 流中的字节序
+		constexpr static inline std::endian enByteOrder = std::endian::big;
+		/// @brief 流中字节序是否与当前平台一致
+		constexpr static inline bool bNativeOrder = NBT_Endian::IsBigEndian();
+		/// @brief 所有字段都是定长编码
+		constexpr static inline bool bVarInt = false;
+		/// @brief 判断类型为T的字段是否以VarInt编码
+		template<typename T>
+		constexpr static inline bool bVarIntField = false;
+
+		/// @brief 从流字节序转换到当前平台字节序
+		/// @tparam T 任意整数类型
+		/// @param tVal 流字节序的值
+		/// @return 平台字节序的值
+		template<typename T>
+		requires std::integral<T>
+		static T ToNative(T tVal) noexcept
+		{
+			return NBT_Endian::BigToNativeAny(tVal);
+		}
+
+		/// @brief 从当前平台字节序转换到流字节序
+		/// @tparam T 任意整数类型
+		/// @param tVal 平台字节序的值
+		/// @return 流字节序的值
+		template<typename T>
+		requires std::integral<T>
+		static T FromNative(T tVal) noexcept
+		{
+			return NBT_Endian::NativeToBigAny(tVal);
+		}
+
+		/// @brief 批量从流字节序转换到当前平台字节序（原地转换）
+		/// @tparam T 任意整数类型
+		/// @param pData 数组
+		/// @param szCount 元素个数
+		template<typename T>
+		requires std::integral<T>
+		static void ToNativeArray(T *pData, size_t szCount) noexcept
+		{
+			NBT_Endian::BigToNativeArray(pData, szCount);
+		}
+
+		/// @brief 批量从当前平台字节序转换到流字节序
+		/// @tparam T 任意整数类型
+		/// @param pDest 目标数组
+		/// @param pSrc 源数组
+		/// @param szCount 元素个数
+		/// @note pDest可以与pSrc相同（原地转换），但不能部分重叠
+		template<typename T>
+		requires std::integral<T>
+		static void FromNativeArray(T *pDest, const T *pSrc, size_t szCount) noexcept
+		{
+			NBT_Endian::NativeToBigArray(pDest, pSrc, szCount);
+		}
+	};
+
+	/// @brief 小端序格式，基岩版存档（LevelDB值与level.dat）使用的格式
+	/// @note 在小端平台上，读写数值与数组时不需要任何字节序转换
+	struct LittleEndian
+	{
+		/// @brief 流中的字节序
+		constexpr static inline std::endian enByteOrder = std::endian::little;
+		/// @brief 流中字节序是否与当前平台一致
+		constexpr static inline bool bNativeOrder = NBT_Endian::IsLittleEndian();
+		/// @brief 所有字段都是定长编码
+		constexpr static inline bool bVarInt = false;
+		/// @brief 判断类型为T的字段是否以VarInt编码
+		template<typename T>
+		constexpr static inline bool bVarIntField = false;
+
+		/// @brief 从流字节序转换到当前平台字节序
+		/// @tparam T 任意整数类型
+		/// @param tVal 流字节序的值
+		/// @return 平台字节序的值
+		template<typename T>
+		requires std::integral<T>
+		static T ToNative(T tVal) noexcept
+		{
+			return NBT_Endian::LittleToNativeAny(tVal);
+		}
+
+		/// @brief 从当前平台字节序转换到流字节序
+		/// @tparam T 任意整数类型
+		/// @param tVal 平台字节序的值
+		/// @return 流字节序的值
+		template<typename T>
+		requires std::integral<T>
+		static T FromNative(T tVal) noexcept
+		{
+			return NBT_Endian::NativeToLittleAny(tVal);
+		}
+
+		/// @brief 批量从流字节序转换到当前平台字节序（原地转换）
+		/// @tparam T 任意整数类型
+		/// @param pData 数组
+		/// @param szCount 元素个数
+		template<typename T>
+		requires std::integral<T>
+		static void ToNativeArray(T *pData, size_t szCount) noexcept
+		{
+			NBT_Endian::LittleToNativeArray(pData, szCount);
+		}
+
+		/// @brief 批量从当前平台字节序转换到流字节序
+		/// @tparam T 任意整数类型
+		/// @param pDest 目标数组
+		/// @param pSrc 源数组
+		/// @param szCount 元素个数
+		/// @note pDest可以与pSrc相同（原地转换），但不能部分重叠
+		template<typename T>
+		requires std::integral<T>
+		static void FromNativeArray(T *pDest, const T *pSrc, size_t szCount) noexcept
+		{
+			NBT_Endian::NativeToLittleArray(pDest, pSrc, szCount);
+		}
+	};
+
+	/// @brief 基岩版网络协议格式：Int、Long以及数组与列表长度使用zigzag编码的VarInt，
+	/// 字符串长度使用无符号VarInt，其余定长字段（Short、Float、Double）使用小端序
+	/// @note IntArray与LongArray的元素、Int与Long列表的元素同样逐个以zigzag VarInt编码，
+	/// ByteArray与其余数值列表与小端序格式相同。
+	/// 解码时一次读取8字节，通过结束字节的位掩码确定长度并一次性拼接数据位，不逐字节分支；
+	/// 跳过连续的VarInt时只统计结束字节的个数，不拼接数值。
+	struct VarInt : LittleEndian
+	{
+		/// @brief 存在VarInt编码的字段
+		constexpr static inline bool bVarInt = true;
+		/// @brief 判断类型为T的字段是否以VarInt编码：有符号32/64位整数使用zigzag编码，16位无符号整数（字符串长度）直接编码
+		template<typename T>
+		constexpr static inline bool bVarIntField =
+			std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> || std::is_same_v<T, uint16_t>;
+
+		/// @brief 无符号整数类型编码后的最大字节数
+		template<typename T>
+		requires std::unsigned_integral<T>
+		constexpr static inline size_t szMaxVarIntSize = (sizeof(T) * 8 + 6) / 7;
+
+		/// @brief 任意VarInt字段编码后的最大字节数，可用作编码缓冲区大小
+		constexpr static inline size_t szMaxFieldSize = szMaxVarIntSize<uint64_t>;
+
+		/// @brief zigzag编码，把有符号数映射到无符号数，使绝对值小的负数也能用较少的字节表示
+		/// @tparam T 有符号整数类型
+		/// @param tVal 有符号数
+		/// @return 编码后的无符号数
+		template<typename T>
+		requires std::signed_integral<T>
+		constexpr static std::make_unsigned_t<T> ZigZagEncode(T tVal) noexcept
+		{
+			using U = std::make_unsigned_t<T>;
+			return ((U)tVal << 1) ^ (U)(tVal >> (sizeof(T) * 8 - 1));
+		}
+
+		/// @brief zigzag解码
+		/// @tparam T 无符号整数类型
+		/// @param tVal 编码后的无符号数
+		/// @return 原始的有符号数
+		template<typename T>
+		requires std::unsigned_integral<T>
+		constexpr static std::make_signed_t<T> ZigZagDecode(T tVal) noexcept
+		{
+			return (std::make_signed_t<T>)((tVal >> 1) ^ ((T)0 - (tVal & 1)));
+		}
+
+		/// @brief 计算无符号数编码为VarInt后的字节数
+		/// @tparam T 无符号整数类型
+		/// @param tVal 无符号数
+		/// @return 字节数
+		template<typename T>
+		requires std::unsigned_integral<T>
+		constexpr static size_t VarIntSize(T tVal) noexcept
+		{
+			return ((size_t)std::bit_width((T)(tVal | 1)) + 6) / 7;
+		}
+
+		/// @brief 把无符号数编码为VarInt
+		/// @tparam T 无符号整数类型
+		/// @param tVal 无符号数
+		/// @param pOut 输出缓冲区，至少需要szMaxVarIntSize<T>字节
+		/// @return 写入的字节数
+		template<typename T>
+		requires std::unsigned_integral<T>
+		static size_t EncodeVarInt(T tVal, uint8_t *pOut) noexcept
+		{
+			size_t i = 0;
+			while (tVal >= 0x80)
+			{
+				pOut[i++] = (uint8_t)(tVal | 0x80);
+				tVal >>= 7;
+			}
+			pOut[i++] = (uint8_t)tVal;
+			return i;
+		}
+
+		/// @brief 从数据中解码一个VarInt，不检查数据边界
+		/// @tparam T 无符号整数类型
+		/// @param pData 数据起始位置，调用者保证至少有szDecodeWindow<T>字节可读（结束字节之后的内容不影响结果）
+		/// @param[out] tVal 解码结果，超出T的高位被截断
+		/// @return 消耗的字节数，VarInt超过szMaxVarIntSize<T>字节时返回0
+		template<typename T>
+		requires std::unsigned_integral<T>
+		static size_t DecodeVarInt(const uint8_t *pData, T &tVal) noexcept
+		{
+			uint64_t u64Word = 0;
+			memcpy(&u64Word, pData, sizeof(u64Word));
+			u64Word = NBT_Endian::LittleToNativeAny(u64Word);
+
+			//最高位为0的字节是结束字节
+			uint64_t u64Stop = ~u64Word & 0x8080808080808080ull;
+			if (u64Stop == 0)//前8字节都没有结束
+			{
+				if constexpr (szMaxVarIntSize<T> <= 8)
+				{
+					return 0;
+				}
+				else
+				{
+					uint64_t u64Low = CompactBits(u64Word & 0x7F7F7F7F7F7F7F7Full);//56位
+					if ((pData[8] & 0x80) == 0)
+					{
+						tVal = (T)(u64Low | ((uint64_t)pData[8] << 56));
+						return 9;
+					}
+					if ((pData[9] & 0x80) != 0)
+					{
+						return 0;
+					}
+					tVal = (T)(u64Low | ((uint64_t)(pData[8] & 0x7F) << 56) | ((uint64_t)pData[9] << 63));
+					return 10;
+				}
+			}
+
+			size_t szSize = ((size_t)std::countr_zero(u64Stop) >> 3) + 1;
+			if constexpr (szMaxVarIntSize<T> < 8)
+			{
+				if (szSize > szMaxVarIntSize<T>)
+				{
+					return 0;
+				}
+			}
+
+			//只保留结束字节及之前的数据位，然后拼接
+			uint64_t u64Keep = u64Stop ^ (u64Stop - 1);
+			tVal = (T)CompactBits(u64Word & u64Keep & 0x7F7F7F7F7F7F7F7Full);
+			return szSize;
+		}
+
+		/// @brief DecodeVarInt需要的可读字节数
+		template<typename T>
+		requires std::unsigned_integral<T>
+		constexpr static inline size_t szDecodeWindow = std::max<size_t>(8, szMaxVarIntSize<T>);
+
+		/// @brief 从输入流中读取一个VarInt
+		/// @tparam T 无符号整数类型
+		/// @tparam InputStream 输入流类型
+		/// @param tData 输入流
+		/// @param[out] tVal 读取结果
+		/// @return 成功返回true，数据不足或VarInt过长返回false
+		/// @note 流提供CurrentData且剩余数据足够时直接在流上解码，否则逐字节读到补零的缓冲区后用同一例程解码
+		template<typename T, typename InputStream>
+		requires std::unsigned_integral<T>
+		static bool ReadVarInt(InputStream &tData, T &tVal) noexcept
+		{
+			if constexpr (requires { tData.CurrentData(); })
+			{
+				if (tData.HasAvailData(szDecodeWindow<T>))
+				{
+					size_t szSize = DecodeVarInt((const uint8_t *)tData.CurrentData(), tVal);
+					if (szSize == 0)
+					{
+						return false;
+					}
+					tData.SkipData(szSize);
+					return true;
+				}
+			}
+
+			uint8_t arrBuf[szDecodeWindow<T>] = {};
+			for (size_t i = 0; i < szMaxVarIntSize<T>; ++i)
+			{
+				if (!tData.HasAvailData(1))
+				{
+					return false;
+				}
+
+				arrBuf[i] = (uint8_t)tData.GetNext();
+				if ((arrBuf[i] & 0x80) == 0)
+				{
+					return DecodeVarInt(arrBuf, tVal) != 0;
+				}
+			}
+
+			return false;//超过最大长度
+		}
+
+		/// @brief 跳过输入流中连续的szCount个VarInt，不解码数值
+		/// @tparam InputStream 输入流类型
+		/// @param tData 输入流
+		/// @param szCount VarInt个数
+		/// @return 成功返回true，数据不足返回false
+		/// @note 流提供CurrentData时每次检查8个字节，统计其中结束字节的个数
+		template<typename InputStream>
+		static bool SkipVarInt(InputStream &tData, size_t szCount) noexcept
+		{
+			if constexpr (requires { tData.CurrentData(); })
+			{
+				while (szCount != 0 && tData.HasAvailData(sizeof(uint64_t)))
+				{
+					uint64_t u64Word = 0;
+					memcpy(&u64Word, tData.CurrentData(), sizeof(u64Word));
+					u64Word = NBT_Endian::LittleToNativeAny(u64Word);
+
+					uint64_t u64Stop = ~u64Word & 0x8080808080808080ull;
+					size_t szStop = (size_t)std::popcount(u64Stop);
+					if (szStop < szCount)
+					{
+						szCount -= szStop;
+						tData.SkipData(sizeof(u64Word));
+						continue;
+					}
+
+					//最后一个需要跳过的结束字节在当前8字节内
+					for (size_t i = 1; i < szCount; ++i)
+					{
+						u64Stop &= u64Stop - 1;
+					}
+					tData.SkipData(((size_t)std::countr_zero(u64Stop) >> 3) + 1);
+					return true;
+				}
+			}
+
+			while (szCount != 0)
+			{
+				if (!tData.HasAvailData(1))
+				{
+					return false;
+				}
+
+				if (((uint8_t)tData.GetNext() & 0x80) == 0)
+				{
+					--szCount;
+				}
+			}
+
+			return true;
+		}
+
+		/// @brief 计算字段编码后的字节数
+		/// @tparam T 字段类型，必须满足bVarIntField<T>
+		/// @param tVal 字段值
+		/// @return 字节数
+		template<typename T>
+		requires bVarIntField<T>
+		constexpr static size_t FieldSize(T tVal) noexcept
+		{
+			if constexpr (std::is_unsigned_v<T>)
+			{
+				return VarIntSize(tVal);
+			}
+			else
+			{
+				return VarIntSize(ZigZagEncode(tVal));
+			}
+		}
+
+		/// @brief 编码字段
+		/// @tparam T 字段类型，必须满足bVarIntField<T>
+		/// @param tVal 字段值
+		/// @param pOut 输出缓冲区，至少需要szMaxFieldSize字节
+		/// @return 写入的字节数
+		template<typename T>
+		requires bVarIntField<T>
+		static size_t EncodeField(T tVal, uint8_t *pOut) noexcept
+		{
+			if constexpr (std::is_unsigned_v<T>)
+			{
+				return EncodeVarInt(tVal, pOut);
+			}
+			else
+			{
+				return EncodeVarInt(ZigZagEncode(tVal), pOut);
+			}
+		}
+
+		/// @brief 从输入流中读取字段
+		/// @tparam T 字段类型，必须满足bVarIntField<T>
+		/// @tparam InputStream 输入流类型
+		/// @param tData 输入流
+		/// @param[out] tVal 读取结果
+		/// @return 成功返回true，数据不足、VarInt过长或超出T的范围（仅无符号字段）返回false
+		template<typename T, typename InputStream>
+		requires bVarIntField<T>
+		static bool ReadField(InputStream &tData, T &tVal) noexcept
+		{
+			using U = std::conditional_t<sizeof(T) == sizeof(uint64_t), uint64_t, uint32_t>;
+			U uRaw = 0;
+			if (!ReadVarInt(tData, uRaw))
+			{
+				return false;
+			}
+
+			if constexpr (std::is_unsigned_v<T>)
+			{
+				if (uRaw > (U)std::numeric_limits<T>::max())
+				{
+					return false;
+				}
+				tVal = (T)uRaw;
+			}
+			else
+			{
+				tVal = (T)ZigZagDecode(uRaw);
+			}
+
+			return true;
+		}
+
+	private:
+		//把每个字节的低7位拼接到一起（最多8字节，56位）
+		constexpr static uint64_t CompactBits(uint64_t u64Bits) noexcept
+		{
+			u64Bits = (u64Bits & 0x007F007F007F007Full) | ((u64Bits & 0x7F007F007F007F00ull) >> 1);
+			u64Bits = (u64Bits & 0x00003FFF00003FFFull) | ((u64Bits & 0x3FFF00003FFF0000ull) >> 2);
+			u64Bits = (u64Bits & 0x000000000FFFFFFFull) | ((u64Bits & 0x0FFFFFFF00000000ull) >> 4);
+			return u64Bits;
+		}
+	};
+};
+
+/// @brief 判断类型是否满足NBT二进制格式策略的接口
+/// @tparam T 要判断的类型
+template<typename T>
+concept IsLookLike_NBT_Format = requires(int32_t *pData, const int32_t *pSrc, int32_t iVal)
+{
+	{ T::enByteOrder } -> std::convertible_to<std::endian>;
+	{ T::bNativeOrder } -> std::convertible_to<bool>;
+	{ T::bVarInt } -> std::convertible_to<bool>;
+	{ T::template bVarIntField<int32_t> } -> std::convertible_to<bool>;
+	{ T::ToNative(iVal) } -> std::same_as<int32_t>;
+	{ T::FromNative(iVal) } -> std::same_as<int32_t>;
+	T::ToNativeArray(pData, (size_t)0);
+	T::FromNativeArray(pData, pSrc, (size_t)0);
+};
+
+static_assert(IsLookLike_NBT_Format<NBT_Format::BigEndian>, "NBT_Format::BigEndian does not satisfy IsLookLike_NBT_Format");
+static_assert(IsLookLike_NBT_Format<NBT_Format::LittleEndian>, "NBT_Format::LittleEndian does not satisfy IsLookLike_NBT_Format");
+static_assert(IsLookLike_NBT_Format<NBT_Format::VarInt>, "NBT_Format::VarInt does not satisfy IsLookLike_NBT_Format");
@@ -4,6 +4,10 @@
 #include <concepts>
 #include <iterator>
 #include <algorithm>
+#include <array>
+#include <span>//std::span
+#include <charconv>//std::to_chars
+#include <string.h>//memcpy
 
 #include "NBT_Print.hpp"//打印输出
 #include "NBT_Endian.hpp"
@@ -68,15 +72,36 @@ public:
 	/// @tparam bSnbtType 是否对输出为SNBT格式（SNBT下强制为十进制值，忽略bHexNumType参数）
 	/// @param nRoot 任意NBT_Type中的类型，仅初始化为视图
 	/// @return 返回序列化的结果
-	/// @note 注意并非序列化为snbt，一般用于小NBT对象的附加信息输出
+	/// @note 注意并非序列化为snbt，一般用于小NBT对象的附加信息输出，较大的对象请使用写入输出流的版本
 	template<typename SortPolicy = DefaultCompoundSort<true>, bool bHexNumType = true, bool bSnbtType = false>
 	static std::conditional_t<bSnbtType, NBT_Type::String, std::string> Serialize(const NBT_Node_View<true> nRoot)
 	{
 		std::conditional_t<bSnbtType, NBT_Type::String, std::string> sRet{};
-		SerializeSwitch<true, SortPolicy, bHexNumType, bSnbtType>(nRoot, sRet);
+		StringOutputStream<decltype(sRet)> sosRet(sRet);
+		Serialize<SortPolicy, bHexNumType, bSnbtType>(nRoot, sosRet);
 		return sRet;
 	}
 
+	/// @brief 序列化并写入输出流，格式与返回String的版本相同
+	/// @tparam SortPolicy 用于进行Compound写出前排序的可调用类型，或不进行排序的提示标签类型
+	/// @tparam bHexNumType 是否使用十六进制无损输出值
+	/// @tparam bSnbtType 是否对输出为SNBT格式（SNBT下强制为十进制值，忽略bHexNumType参数）
+	/// @tparam OutputStream 输出流类型，只需要提供DefaultOutputStream中的ValueType（单字节）与PutRange，
+	/// 例如NBT_IO::DefaultOutputStream或NBT_IO::DeflateOutputStream
+	/// @param nRoot 任意NBT_Type中的类型，仅初始化为视图
+	/// @param tStream 输出流对象
+	/// @note 内部使用栈上的固定大小缓冲区，满后整块写入输出流，内存占用与输出大小无关，
+	/// 可以直接把整个区域输出到文件或压缩流中。数值使用std::to_chars格式化，浮点数输出为可以无损读回的最短形式。
+	/// 字符串中的引号、反斜杠与控制字符会被转义，SNBT输出可以通过NBT_SNBT_Reader读回。
+	/// 输出流抛出的异常会直接传递给调用者，此时已写出的部分数据不会撤销。
+	template<typename SortPolicy = DefaultCompoundSort<true>, bool bHexNumType = true, bool bSnbtType = false, typename OutputStream>
+	static void Serialize(const NBT_Node_View<true> nRoot, OutputStream &tStream)
+	{
+		SerializeBuffer<OutputStream> bufOut(tStream);
+		SerializeSwitch<true, SortPolicy, bHexNumType, bSnbtType>(nRoot, bufOut);
+		bufOut.Flush();
+	}
+
 #ifdef CJF2_NBT_CPP_USE_XXHASH
 	/// @brief 用于插入哈希的示例函数
 	/// @param nbtHash 哈希对象，可以向内部添加数据，具体请参考NBT_Hash
@@ -140,69 +165,260 @@ protected:
 		}
 	}
 
-	template<typename T>
-	requires(std::is_arithmetic_v<T>)
-	static void NumericToHexString(const T &value, std::string &result)
+	//序列化用的固定大小缓冲区，写满后整块写入输出流，内存占用与输出总大小无关
+	template<typename OutputStream>
+	class SerializeBuffer
 	{
-		//映射
-		static constexpr char hex_chars[] = "0123456789ABCDEF";
+	public:
+		static constexpr size_t BUFFER_SIZE = 16 * 1024;
+
+	private:
+		using ValueType = typename OutputStream::ValueType;
+		static_assert(sizeof(ValueType) == 1, "Error ValueType Size");
+
+		OutputStream &tStream;
+		size_t szUsed = 0;
+		char cBuffer[BUFFER_SIZE];
+
+	public:
+		SerializeBuffer(OutputStream &_tStream) :tStream(_tStream)
+		{}
 
-		//前缀
-		result += "0x";
+		SerializeBuffer(const SerializeBuffer &) = delete;
+		SerializeBuffer &operator=(const SerializeBuffer &) = delete;
 
-		//按照原始字节序处理
-		using Raw_T = decltype([](void) -> auto
+		void Flush(void)
 		{
-			if constexpr (NBT_Type::IsNumericType_V<T>)
+			if (szUsed != 0)
 			{
-				return NBT_Type::BuiltinRawType_T<T>{};
+				tStream.PutRange((const ValueType *)cBuffer, szUsed);
+				szUsed = 0;
 			}
-			else
+		}
+
+		//获取至少szSize字节的连续空间，写入后通过Commit提交，szSize不能超过缓冲区大小
+		char *Reserve(size_t szSize)
+		{
+			if (BUFFER_SIZE - szUsed < szSize)
 			{
-				return T{};
+				Flush();
 			}
-		}());
-		Raw_T uintVal = std::bit_cast<Raw_T>(value);
+			return &cBuffer[szUsed];
+		}
 
-		for (size_t i = 0; i < sizeof(T); ++i)
+		void Commit(size_t szSize) noexcept
 		{
-			uint8_t u8Byte = (uintVal >> 8 * (sizeof(T) - i - 1)) & 0xFF;//遍历字节，从高到低
+			szUsed += szSize;
+		}
 
-			result += hex_chars[(u8Byte >> 4) & 0x0F];//高4
-			result += hex_chars[(u8Byte >> 0) & 0x0F];//低4
+		void Put(char c)
+		{
+			if (szUsed == BUFFER_SIZE)
+			{
+				Flush();
+			}
+			cBuffer[szUsed++] = c;
+		}
+
+		void Put(const char *pData, size_t szSize)
+		{
+			if (BUFFER_SIZE - szUsed < szSize)
+			{
+				Flush();
+				if (szSize >= BUFFER_SIZE)//大块数据直接写出
+				{
+					tStream.PutRange((const ValueType *)pData, szSize);
+					return;
+				}
+			}
+
+			memcpy(&cBuffer[szUsed], pData, szSize);
+			szUsed += szSize;
 		}
-	}
 
-	template<typename T, typename STR_T>
-	requires(NBT_Type::IsNumericType_V<T> && (std::is_same_v<STR_T, NBT_Type::String> || std::is_same_v<STR_T, std::string>))
-	static void NumericToDecString(const T &value, STR_T &result)
+		template<size_t N>
+		void Put(const char(&strLiteral)[N])
+		{
+			Put(strLiteral, N - 1);
+		}
+	};
+
+	//字符串输出流，仅用于Serialize返回字符串的版本
+	template<typename STR_T>
+	class StringOutputStream
 	{
-		std::string tmp{};
-		if constexpr (NBT_Type::IsFloatingType_V<T>)
+	public:
+		using ValueType = typename STR_T::value_type;
+
+	private:
+		STR_T &sOut;
+
+	public:
+		StringOutputStream(STR_T &_sOut) :sOut(_sOut)
+		{}
+
+		void PutRange(const ValueType *pData, size_t szSize)
 		{
-			tmp = std::format("{:.{}g}", value, std::numeric_limits<T>::max_digits10);
+			sOut.append(pData, szSize);
 		}
-		else if constexpr (NBT_Type::IsIntegerType_V<T>)
+	};
+
+	//十六进制按原始字节从高到低输出，十进制使用std::to_chars（浮点数为可以无损读回的最短形式）
+	template<bool bHexNumType, typename T, typename Buffer>
+	static void WriteNumber(Buffer &bufOut, const T &value)
+	{
+		if constexpr (bHexNumType)
 		{
-			tmp = std::format("{:d}", value);
+			static constexpr char hex_chars[] = "0123456789ABCDEF";
+
+			using Raw_T = std::make_unsigned_t<decltype([](void) -> auto
+			{
+				if constexpr (NBT_Type::IsNumericType_V<T>)
+				{
+					return NBT_Type::BuiltinRawType_T<T>{};
+				}
+				else
+				{
+					return T{};
+				}
+			}())>;
+			Raw_T uintVal = std::bit_cast<Raw_T>(value);
+
+			char *pOut = bufOut.Reserve(2 + sizeof(T) * 2);
+			pOut[0] = '0';
+			pOut[1] = 'x';
+			for (size_t i = 0; i < sizeof(T); ++i)
+			{
+				uint8_t u8Byte = (uintVal >> 8 * (sizeof(T) - i - 1)) & 0xFF;//遍历字节，从高到低
+
+				pOut[2 + i * 2 + 0] = hex_chars[(u8Byte >> 4) & 0x0F];//高4
+				pOut[2 + i * 2 + 1] = hex_chars[(u8Byte >> 0) & 0x0F];//低4
+			}
+			bufOut.Commit(2 + sizeof(T) * 2);
 		}
 		else
 		{
-			static_assert(false,"T type unknown");
+			constexpr size_t szMaxLength = 32;//足够容纳任意整数或浮点数的最短形式
+			char *pOut = bufOut.Reserve(szMaxLength);
+			auto [pEnd, ec] = std::to_chars(pOut, pOut + szMaxLength, value);
+			bufOut.Commit((size_t)(pEnd - pOut));
 		}
+	}
 
-		if constexpr (std::is_same_v<STR_T, NBT_Type::String>)
+	//查表转义引号、反斜杠与控制字符，0表示不需要转义
+	template<typename Buffer>
+	static void WriteEscaped(Buffer &bufOut, const char *pData, size_t szSize)
+	{
+		static constexpr std::array<char, 256> arrEscape = [](void) -> std::array<char, 256>
 		{
-			result += (NBT_Type::String)tmp;//转换为NBT字符串
+			std::array<char, 256> arrTable{};
+			for (size_t i = 0; i < 0x20; ++i)
+			{
+				arrTable[i] = 'x';
+			}
+			arrTable[0x7F] = 'x';
+			arrTable['\n'] = 'n';
+			arrTable['\r'] = 'r';
+			arrTable['\t'] = 't';
+			arrTable['\b'] = 'b';
+			arrTable['\f'] = 'f';
+			arrTable['"'] = '"';
+			arrTable['\\'] = '\\';
+			return arrTable;
+		}();
+
+		static constexpr char hex_chars[] = "0123456789ABCDEF";
+
+		size_t szSegment = 0;
+		for (size_t i = 0; i < szSize; ++i)
+		{
+			const char cEscape = arrEscape[(uint8_t)pData[i]];
+			if (cEscape == 0)
+			{
+				continue;
+			}
+
+			bufOut.Put(&pData[szSegment], i - szSegment);//之前不需要转义的部分整段写出
+			if (cEscape == 'x')
+			{
+				char *pOut = bufOut.Reserve(4);
+				pOut[0] = '\\';
+				pOut[1] = 'x';
+				pOut[2] = hex_chars[((uint8_t)pData[i] >> 4) & 0x0F];
+				pOut[3] = hex_chars[((uint8_t)pData[i] >> 0) & 0x0F];
+				bufOut.Commit(4);
+			}
+			else
+			{
+				char *pOut = bufOut.Reserve(2);
+				pOut[0] = '\\';
+				pOut[1] = cEscape;
+				bufOut.Commit(2);
+			}
+			szSegment = i + 1;
 		}
-		else if constexpr(std::is_same_v<STR_T, std::string>)
+		bufOut.Put(&pData[szSegment], szSize - szSegment);
+	}
+
+	//SNBT直接输出M-UTF-8，否则转换为UTF-8，
+	//M-UTF-8只有空字符（0xC0 0x80）与代理对（0xED开头）与UTF-8不同，不包含这两个字节的字符串无需转换
+	template<bool bSnbtType, typename Buffer>
+	static void WriteQuotedString(Buffer &bufOut, const NBT_Type::String &sString)
+	{
+		bufOut.Put('"');
+
+		const char *pData = (const char *)sString.data();
+		const size_t szSize = sString.size();
+		if constexpr (bSnbtType)
 		{
-			result += tmp;
+			WriteEscaped(bufOut, pData, szSize);
 		}
 		else
 		{
-			static_assert(false, "STR_T type unknown");
+			bool bNeedConvert = false;
+			for (size_t i = 0; i < szSize; ++i)
+			{
+				if ((uint8_t)pData[i] == 0xC0 || (uint8_t)pData[i] == 0xED)
+				{
+					bNeedConvert = true;
+					break;
+				}
+			}
+
+			if (bNeedConvert)
+			{
+				auto sUTF8 = sString.ToCharTypeUTF8();
+				WriteEscaped(bufOut, sUTF8.data(), sUTF8.size());
+			}
+			else
+			{
+				WriteEscaped(bufOut, pData, szSize);
+			}
 		}
+
+		bufOut.Put('"');
+	}
+
+	template<bool bHexNumType, typename ArrayType, typename Buffer, size_t N>
+	static void WriteArray(Buffer &bufOut, const char(&strBegin)[N], const ArrayType &arr)
+	{
+		bufOut.Put(strBegin);
+
+		bool bFirst = true;
+		for (const auto &it : arr)
+		{
+			if (bFirst)
+			{
+				bFirst = false;
+			}
+			else
+			{
+				bufOut.Put(',');
+			}
+			WriteNumber<bHexNumType>(bufOut, it);
+		}
+
+		bufOut.Put(']');
 	}
 ///@endcond
 
@@ -300,7 +516,7 @@ protected:
 				funcPrint("[");
 
 				bool bFirst = true;
-				for (const auto &it : list)
+				for (const auto &it : list)//常量迭代不会展开打包的列表，打包的元素临时构造为节点
 				{
 					if (bFirst)
 					{
@@ -387,283 +603,135 @@ protected:
 	}
 
 	//首次调用默认为true，二次调用开始内部主动变为false
-	template<bool bRoot, typename SortPolicy, bool bHexNumType, bool bSnbtType>//首次使用NBT_Node_View解包，后续直接使用NBT_Node引用免除额外初始化开销
-	static void SerializeSwitch(std::conditional_t<bRoot, const NBT_Node_View<true> &, const NBT_Node &>nRoot, std::conditional_t<bSnbtType, NBT_Type::String, std::string> &sRet)
+	template<bool bRoot, typename SortPolicy, bool bHexNumType, bool bSnbtType, typename Buffer>//首次使用NBT_Node_View解包，后续直接使用NBT_Node引用免除额外初始化开销
+	static void SerializeSwitch(std::conditional_t<bRoot, const NBT_Node_View<true> &, const NBT_Node &>nRoot, Buffer &bufOut)
 	{
+		constexpr bool bHexNum = bHexNumType && !bSnbtType;//snbt必须是dec
+
 		auto tag = nRoot.GetTag();
 		switch (tag)
 		{
 		case NBT_TAG::End:
 			{
-				if constexpr (bSnbtType)
-				{
-					sRet += MU8STR("[End]");
-				}
-				else
-				{
-					sRet += "[End]";
-				}
+				bufOut.Put("[End]");
 			}
 			break;
 		case NBT_TAG::Byte:
 			{
-				if constexpr (bSnbtType || !bHexNumType)//snbt必须是dec
-				{
-					NumericToDecString(nRoot.template Get<NBT_Type::Byte>(), sRet);
-				}
-				else
-				{
-					NumericToHexString(nRoot.template Get<NBT_Type::Byte>(), sRet);
-				}
-				sRet += 'B';
+				WriteNumber<bHexNum>(bufOut, nRoot.template Get<NBT_Type::Byte>());
+				bufOut.Put('B');
 			}
 			break;
 		case NBT_TAG::Short:
 			{
-				if constexpr (bSnbtType || !bHexNumType)
-				{
-					NumericToDecString(nRoot.template Get<NBT_Type::Short>(), sRet);
-				}
-				else
-				{
-					NumericToHexString(nRoot.template Get<NBT_Type::Short>(), sRet);
-				}
-				sRet += 'S';
+				WriteNumber<bHexNum>(bufOut, nRoot.template Get<NBT_Type::Short>());
+				bufOut.Put('S');
 			}
 			break;
 		case NBT_TAG::Int:
 			{
-				if constexpr (bSnbtType || !bHexNumType)
-				{
-					NumericToDecString(nRoot.template Get<NBT_Type::Int>(), sRet);
-				}
-				else
-				{
-					NumericToHexString(nRoot.template Get<NBT_Type::Int>(), sRet);
-				}
-				sRet += 'I';
+				WriteNumber<bHexNum>(bufOut, nRoot.template Get<NBT_Type::Int>());
+				bufOut.Put('I');
 			}
 			break;
 		case NBT_TAG::Long:
 			{
-				if constexpr (bSnbtType || !bHexNumType)
-				{
-					NumericToDecString(nRoot.template Get<NBT_Type::Long>(), sRet);
-				}
-				else
-				{
-					NumericToHexString(nRoot.template Get<NBT_Type::Long>(), sRet);
-				}
-				sRet += 'L';
+				WriteNumber<bHexNum>(bufOut, nRoot.template Get<NBT_Type::Long>());
+				bufOut.Put('L');
 			}
 			break;
 		case NBT_TAG::Float:
 			{
-				if constexpr (bSnbtType || !bHexNumType)
-				{
-					NumericToDecString(nRoot.template Get<NBT_Type::Float>(), sRet);
-				}
-				else
-				{
-					NumericToHexString(nRoot.template Get<NBT_Type::Float>(), sRet);
-				}
-				sRet += 'F';
+				WriteNumber<bHexNum>(bufOut, nRoot.template Get<NBT_Type::Float>());
+				bufOut.Put('F');
 			}
 			break;
 		case NBT_TAG::Double:
 			{
-				if constexpr (bSnbtType || !bHexNumType)
-				{
-					NumericToDecString(nRoot.template Get<NBT_Type::Double>(), sRet);
-				}
-				else
-				{
-					NumericToHexString(nRoot.template Get<NBT_Type::Double>(), sRet);
-				}
-				sRet += 'D';
+				WriteNumber<bHexNum>(bufOut, nRoot.template Get<NBT_Type::Double>());
+				bufOut.Put('D');
 			}
 			break;
 		case NBT_TAG::ByteArray:
 			{
-				const auto &arr = nRoot.template Get<NBT_Type::ByteArray>();
-
-				if constexpr (bSnbtType)
-				{
-					sRet += MU8STR("[B;");
-				}
-				else
-				{
-					sRet += "[B;";
-				}
-				
-				for (const auto &it : arr)
-				{
-					if constexpr (bSnbtType || !bHexNumType)
-					{
-						NumericToDecString(it, sRet);
-					}
-					else
-					{
-						NumericToHexString(it, sRet);
-					}
-					sRet += ',';
-				}
-				if (arr.size() != 0)
-				{
-					sRet.pop_back();//删掉最后一个逗号
-				}
-	
-				sRet += ']';
+				WriteArray<bHexNum>(bufOut, "[B;", nRoot.template Get<NBT_Type::ByteArray>());
 			}
 			break;
 		case NBT_TAG::IntArray:
 			{
-				const auto &arr = nRoot.template Get<NBT_Type::IntArray>();
-				
-				if constexpr (bSnbtType)
-				{
-					sRet += MU8STR("[I;");
-				}
-				else
-				{
-					sRet += "[I;";
-				}
-
-				for (const auto &it : arr)
-				{
-					if constexpr (bSnbtType || !bHexNumType)
-					{
-						NumericToDecString(it, sRet);
-					}
-					else
-					{
-						NumericToHexString(it, sRet);
-					}
-					sRet += ',';
-				}
-				if (arr.size() != 0)
-				{
-					sRet.pop_back();//删掉最后一个逗号
-				}
-	
-				sRet += ']';
+				WriteArray<bHexNum>(bufOut, "[I;", nRoot.template Get<NBT_Type::IntArray>());
 			}
 			break;
 		case NBT_TAG::LongArray:
 			{
-				const auto &arr = nRoot.template Get<NBT_Type::LongArray>();
-				
-				if constexpr (bSnbtType)
-				{
-					sRet += MU8STR("[L;");
-				}
-				else
-				{
-					sRet += "[L;";
-				}
-
-				for (const auto &it : arr)
-				{
-					if constexpr (bSnbtType || !bHexNumType)
-					{
-						NumericToDecString(it, sRet);
-					}
-					else
-					{
-						NumericToHexString(it, sRet);
-					}
-					sRet += ',';
-				}
-				if (arr.size() != 0)
-				{
-					sRet.pop_back();//删掉最后一个逗号
-				}
-	
-				sRet += ']';
+				WriteArray<bHexNum>(bufOut, "[L;", nRoot.template Get<NBT_Type::LongArray>());
 			}
 			break;
 		case NBT_TAG::String:
 			{
-				sRet += '\"';
-				if constexpr (bSnbtType)
-				{
-					sRet += nRoot.template Get<NBT_Type::String>();
-				}
-				else
-				{
-					sRet += nRoot.template Get<NBT_Type::String>().ToCharTypeUTF8();
-				}
-				sRet += '\"';
+				WriteQuotedString<bSnbtType>(bufOut, nRoot.template Get<NBT_Type::String>());
 			}
 			break;
 		case NBT_TAG::List:
 			{
 				const auto &list = nRoot.template Get<NBT_Type::List>();
-				sRet += '[';
-				for (const auto &it : list)
-				{
-					SerializeSwitch<false, SortPolicy, bHexNumType, bSnbtType>(it, sRet);
-					sRet += ',';
-				}
-	
-				if (list.Size() != 0)
+				bufOut.Put('[');
+
+				bool bFirst = true;
+				for (const auto &it : list)//常量迭代不会展开打包的列表，打包的元素临时构造为节点
 				{
-					sRet.pop_back();//删掉最后一个逗号
+					if (bFirst)
+					{
+						bFirst = false;
+					}
+					else
+					{
+						bufOut.Put(',');
+					}
+					SerializeSwitch<false, SortPolicy, bHexNumType, bSnbtType>(it, bufOut);
 				}
-				sRet += ']';
+
+				bufOut.Put(']');
 			}
 			break;
-		case NBT_TAG::Compound://需要打印缩进的地方
+		case NBT_TAG::Compound:
 			{
 				const auto &cpd = nRoot.template Get<NBT_Type::Compound>();
-				sRet += '{';
-	
+				bufOut.Put('{');
+
+				bool bFirst = true;
+				auto WriteEntry = [&](const NBT_Type::String &sKey, const NBT_Node &nodeVal) -> void
+				{
+					if (bFirst)
+					{
+						bFirst = false;
+					}
+					else
+					{
+						bufOut.Put(',');
+					}
+					WriteQuotedString<bSnbtType>(bufOut, sKey);
+					bufOut.Put(':');
+					SerializeSwitch<false, SortPolicy, bHexNumType, bSnbtType>(nodeVal, bufOut);
+				};
+
 				if constexpr (std::is_same_v<SortPolicy, NoSortCompound>)
 				{
 					for (const auto &it : cpd)
 					{
-						sRet += '\"';
-						if constexpr (bSnbtType)
-						{
-							sRet += it.first;
-							sRet += MU8STR("\":");
-						}
-						else
-						{
-							sRet += it.first.ToCharTypeUTF8();
-							sRet += "\":";
-						}
-						SerializeSwitch<false, SortPolicy, bHexNumType, bSnbtType>(it.second, sRet);
-						sRet += ',';
+						WriteEntry(it.first, it.second);
 					}
 				}
 				else
 				{
 					std::vector<NBT_Type::Compound::Const_Iterator> vSort = SortPolicy{}(cpd);
-
 					for (const auto &it : vSort)
 					{
-						sRet += '\"';
-						if constexpr (bSnbtType)
-						{
-							sRet += it->first;
-							sRet += MU8STR("\":");
-						}
-						else
-						{
-							sRet += it->first.ToCharTypeUTF8();
-							sRet += "\":";
-						}
-						SerializeSwitch<false, SortPolicy, bHexNumType, bSnbtType>(it->second, sRet);
-						sRet += ',';
+						WriteEntry(it->first, it->second);
 					}
 				}
-	
-				if (cpd.Size() != 0)
-				{
-					sRet.pop_back();//删掉最后一个逗号
-				}
-				sRet += '}';
+
+				bufOut.Put('}');
 			}
 			break;
 		default:
@@ -674,9 +742,9 @@ protected:
 				}
 				else
 				{
-					sRet += "[Unknown NBT Tag Type [";
-					NumericToHexString((NBT_TAG_RAW_TYPE)tag, sRet);
-					sRet += "]]";
+					bufOut.Put("[Unknown NBT Tag Type [");
+					WriteNumber<true>(bufOut, (NBT_TAG_RAW_TYPE)tag);
+					bufOut.Put("]]");
 				}
 			}
 			break;
@@ -684,6 +752,18 @@ protected:
 	}
 
 #ifdef CJF2_NBT_CPP_USE_XXHASH
+	//打包的列表直接从缓冲区计算，每个元素与HashSwitch处理数值节点一样先计算标签再计算值
+	template<typename T>
+	static void HashPackedList(std::span<const T> spanPacked, NBT_Hash &nbtHash)
+	{
+		const NBT_TAG tag = NBT_Type::TypeTag_V<T>;
+		for (const auto &it : spanPacked)
+		{
+			nbtHash.Update(tag);
+			nbtHash.Update(it);
+		}
+	}
+
 	template<bool bRoot, typename SortPolicy>//首次使用NBT_Node_View解包，后续直接使用NBT_Node引用免除额外初始化开销
 	static void HashSwitch(std::conditional_t<bRoot, const NBT_Node_View<true> &, const NBT_Node &>nRoot, NBT_Hash &nbtHash)
 	{
@@ -778,9 +858,22 @@ protected:
 		case NBT_TAG::List:
 			{
 				const auto &list = nRoot.template Get<NBT_Type::List>();
-				for (const auto &it : list)
-				{
-					HashSwitch<false, SortPolicy>(it, nbtHash);
+				switch (list.GetPackedTag())//不会展开打包的列表
+				{
+				case NBT_TAG::Byte:		HashPackedList(list.template GetPacked<NBT_Type::Byte>(), nbtHash);		break;
+				case NBT_TAG::Short:	HashPackedList(list.template GetPacked<NBT_Type::Short>(), nbtHash);	break;
+				case NBT_TAG::Int:		HashPackedList(list.template GetPacked<NBT_Type::Int>(), nbtHash);		break;
+				case NBT_TAG::Long:		HashPackedList(list.template GetPacked<NBT_Type::Long>(), nbtHash);		break;
+				case NBT_TAG::Float:	HashPackedList(list.template GetPacked<NBT_Type::Float>(), nbtHash);	break;
+				case NBT_TAG::Double:	HashPackedList(list.template GetPacked<NBT_Type::Double>(), nbtHash);	break;
+				default:
+					{
+						for (const auto &it : list)
+						{
+							HashSwitch<false, SortPolicy>(it, nbtHash);
+						}
+					}
+					break;
 				}
 			}
 			break;
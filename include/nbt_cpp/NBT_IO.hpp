@@ -5,11 +5,45 @@
 #include <stddef.h>//size_t
 #include <string.h>//memcpy
 #include <fstream>
+#include <string>
 #include <vector>
+#include <iterator>//std::istreambuf_iterator
+#include <algorithm>//std::min std::max
+#include <limits>//std::numeric_limits
+#include <functional>//std::function
+#include <stdexcept>//std::runtime_error
 #include <filesystem>
 
 #include "NBT_Print.hpp"//打印输出
 
+/*mmap*/
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+		#define CJF2_NBT_CPP_UNDEF_WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+		#define CJF2_NBT_CPP_UNDEF_NOMINMAX
+	#endif
+	#include <Windows.h>
+	#ifdef CJF2_NBT_CPP_UNDEF_WIN32_LEAN_AND_MEAN
+		#undef WIN32_LEAN_AND_MEAN
+		#undef CJF2_NBT_CPP_UNDEF_WIN32_LEAN_AND_MEAN
+	#endif
+	#ifdef CJF2_NBT_CPP_UNDEF_NOMINMAX
+		#undef NOMINMAX
+		#undef CJF2_NBT_CPP_UNDEF_NOMINMAX
+	#endif
+#elif defined(__unix__) || defined(__APPLE__)
+	#include <errno.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+/*mmap*/
+
 #include "vcpkg_config.h"//包含vcpkg生成的配置以确认库安装情况
 
 #ifdef CJF2_NBT_CPP_USE_ZLIB
@@ -105,6 +139,17 @@ public:
 			szIndex += szSize;
 		}
 
+		/// @brief 获取指向当前读取位置数据的指针
+		/// @return 当前读取位置的数据指针
+		/// @note 这个接口用于直接引用流中的连续数据而不拷贝（比如NBT_Scanner的视图模式），
+		/// 指针在容器数据不变的期间内有效，调用者保证先通过HasAvailData确认后续数据可用。
+		/// 仅在容器提供data()（数据连续存储）时可用
+		const ValueType *CurrentData() const noexcept
+		requires requires(const T &t) { t.data(); }
+		{
+			return tData.data() + szIndex;
+		}
+
 		/// @brief 回退一个字节的读取
 		/// @note 调用者保证不会导致范围溢出
 		void UnGet() noexcept
@@ -291,6 +336,1301 @@ public:
 		}
 	};
 
+	/// @brief 定长缓冲区输出流类，用于将数据直接写入到调用者持有的连续内存中
+	/// @note 这个类不持有也不会重新分配缓冲区，写入超出容量时抛出std::length_error异常。
+	/// 配合NBT_Writer的大小计算函数预先得到精确的序列化大小，调用者即可在网络包缓冲区中留出对应位置，
+	/// 然后直接写入，而无需经过中间容器拷贝。接口与DefaultOutputStream一致。
+	class BufferOutputStream
+	{
+	private:
+		uint8_t *pBuffer = NULL;
+		size_t szCapacity = 0;
+		size_t szIndex = 0;
+
+	public:
+		/// @brief 容器类型
+		using StreamType = uint8_t *;
+		/// @brief 容器值类型
+		using ValueType = uint8_t;
+
+		/// @brief 构造函数
+		/// @param _pBuffer 指向输出缓冲区的指针，调用者保证其生命周期长于此对象
+		/// @param _szCapacity 缓冲区容量（字节数）
+		BufferOutputStream(uint8_t *_pBuffer, size_t _szCapacity) noexcept :pBuffer(_pBuffer), szCapacity(_szCapacity), szIndex(0)
+		{}
+
+		/// @brief 默认析构函数
+		~BufferOutputStream(void) = default;
+		/// @brief 禁止拷贝构造
+		BufferOutputStream(const BufferOutputStream &) = delete;
+		/// @brief 禁止移动构造
+		BufferOutputStream(BufferOutputStream &&) = delete;
+		/// @brief 禁止拷贝赋值
+		BufferOutputStream &operator=(const BufferOutputStream &) = delete;
+		/// @brief 禁止移动赋值
+		BufferOutputStream &operator=(BufferOutputStream &&) = delete;
+
+		/// @brief 下标访问运算符
+		/// @param szIndex 索引位置
+		/// @return 对应位置的常量引用
+		/// @note 这个接口一般用于随机访问流中的数据，而不修改流，调用者保证访问范围合法
+		const ValueType &operator[](size_t szIndex) const noexcept
+		{
+			return pBuffer[szIndex];
+		}
+
+		/// @brief 向流中写入写入单个值
+		/// @tparam V 元素类型，必须可构造为ValueType
+		/// @param c 要写入的元素
+		/// @note 缓冲区已满时抛出std::length_error异常
+		template<typename V>
+		requires(std::is_constructible_v<ValueType, V &&>)
+		void PutOnce(V &&c)
+		{
+			if (szIndex >= szCapacity)
+			{
+				throw std::length_error("BufferOutputStream: buffer overflow");
+			}
+			pBuffer[szIndex++] = ValueType(std::forward<V>(c));
+		}
+
+		/// @brief 向流中写入一段数据
+		/// @param pData 指向要写入数据的缓冲区的指针
+		/// @param szSize 要写入的数据大小（字节数）
+		/// @note 剩余容量不足时抛出std::length_error异常，且不写入任何数据
+		void PutRange(const ValueType *pData, size_t szSize)
+		{
+			if (szCapacity - szIndex < szSize)
+			{
+				throw std::length_error("BufferOutputStream: buffer overflow");
+			}
+			memcpy(&pBuffer[szIndex], &pData[0], szSize);
+			szIndex += szSize;
+		}
+
+		/// @brief 预分配额外容量
+		/// @param szAddSize 要额外分配的容量大小（字节数）
+		/// @note 缓冲区容量固定，此接口不做任何事。预分配大小只是提示，可能大于实际写入的大小
+		///（比如VarInt格式），所以不能用于检查剩余容量，容量不足由写入接口报告。
+		void AddReserve(size_t szAddSize) noexcept
+		{
+			(void)szAddSize;
+		}
+
+		/// @brief 删除（撤销）最后一个写入的字节
+		/// @note 调用者保证不会导致范围溢出
+		void UnPut(void) noexcept
+		{
+			--szIndex;
+		}
+
+		/// @brief 删除（撤销）最后szSize个写入的字节
+		/// @param szSize 要删除的字节数
+		/// @return 删除后的新大小
+		/// @note 调用者保证不会导致范围溢出
+		size_t RemoveData(size_t szSize) noexcept
+		{
+			szIndex -= szSize;
+			return szIndex;
+		}
+
+		/// @brief 获取当前已经写入的数据大小
+		/// @return 数据大小，以字节数计
+		size_t Size(void) const noexcept
+		{
+			return szIndex;
+		}
+
+		/// @brief 获取缓冲区总容量
+		/// @return 容量大小，以字节数计
+		size_t Capacity(void) const noexcept
+		{
+			return szCapacity;
+		}
+
+		/// @brief 重置流，从缓冲区开头重新写入
+		void Reset(void) noexcept
+		{
+			szIndex = 0;
+		}
+	};
+
+	/// @brief 只读文件映射类，把整个文件映射到内存中，并以类似标准库顺序容器的方式访问
+	/// @note Windows使用CreateFileMapping，类Unix系统使用mmap，其它平台退化为把文件完整读入内部缓冲区。
+	/// 这个类提供value_type、data、size、empty与operator[]，可以直接作为DefaultInputStream的容器类型，
+	/// 或者传给DecompressData等要求字节流顺序容器的函数，从而避免把文件拷贝到std::vector中。
+	/// 映射是只读的，文件在映射期间被其它程序修改或截断时的行为由操作系统决定。
+	class MappedFile
+	{
+	public:
+		/// @brief 容器值类型
+		using value_type = uint8_t;
+
+		/// @brief 访问方式提示，用于告知操作系统如何预读映射的数据
+		enum class AccessHint
+		{
+			Normal,		///< 不提供提示
+			Sequential,	///< 从头到尾顺序访问，并尽早预读整个文件
+			Random,		///< 随机访问，不进行预读
+		};
+
+	private:
+		const uint8_t *pData = NULL;
+		size_t szSize = 0;
+		std::string strErrorInfo{};
+
+#if defined(_WIN32)
+		HANDLE hFile = INVALID_HANDLE_VALUE;
+		HANDLE hMapping = NULL;
+#elif defined(__unix__) || defined(__APPLE__)
+		//映射自身即保存了所需信息，无需额外成员
+#else
+		std::vector<uint8_t> vFallback{};
+#endif
+
+	private:
+		void SetError(std::string strInfo) noexcept
+		{
+			Close();
+			strErrorInfo = std::move(strInfo);
+		}
+
+		void MoveFrom(MappedFile &_Move) noexcept
+		{
+			pData = _Move.pData;
+			szSize = _Move.szSize;
+			strErrorInfo = std::move(_Move.strErrorInfo);
+#if defined(_WIN32)
+			hFile = _Move.hFile;
+			hMapping = _Move.hMapping;
+			_Move.hFile = INVALID_HANDLE_VALUE;
+			_Move.hMapping = NULL;
+#elif defined(__unix__) || defined(__APPLE__)
+#else
+			vFallback = std::move(_Move.vFallback);
+#endif
+			_Move.pData = NULL;
+			_Move.szSize = 0;
+		}
+
+	public:
+		/// @brief 默认构造，不映射任何文件
+		MappedFile(void) = default;
+
+		/// @brief 构造并映射文件
+		/// @param pathFileName 文件名
+		/// @param enHint 访问方式提示
+		/// @note 映射失败时不会抛出异常，此时IsOpen返回false，可以通过GetErrorInfo获取错误信息
+		MappedFile(const std::filesystem::path &pathFileName, AccessHint enHint = AccessHint::Sequential) noexcept
+		{
+			Open(pathFileName, enHint);
+		}
+
+		/// @brief 析构函数，解除映射并关闭文件
+		~MappedFile(void) noexcept
+		{
+			Close();
+		}
+
+		/// @brief 禁止拷贝构造
+		MappedFile(const MappedFile &) = delete;
+		/// @brief 禁止拷贝赋值
+		MappedFile &operator=(const MappedFile &) = delete;
+
+		/// @brief 移动构造
+		/// @param _Move 要移动的对象，移动后不再持有映射
+		MappedFile(MappedFile &&_Move) noexcept
+		{
+			MoveFrom(_Move);
+		}
+
+		/// @brief 移动赋值
+		/// @param _Move 要移动的对象，移动后不再持有映射
+		/// @return 自身引用
+		MappedFile &operator=(MappedFile &&_Move) noexcept
+		{
+			if (this != &_Move)
+			{
+				Close();
+				MoveFrom(_Move);
+			}
+			return *this;
+		}
+
+		/// @brief 映射文件，如果已经映射了其它文件则先解除
+		/// @param pathFileName 文件名
+		/// @param enHint 访问方式提示
+		/// @return 映射是否成功
+		/// @note 文件必须是常规文件。空文件可以成功映射，此时size返回0
+		bool Open(const std::filesystem::path &pathFileName, AccessHint enHint = AccessHint::Sequential) noexcept
+		{
+			Close();
+			strErrorInfo.clear();
+
+			try
+			{
+				std::error_code ec;
+				bool bRegularFile = std::filesystem::is_regular_file(pathFileName, ec);
+				if (ec || !bRegularFile)//必须是普通文件
+				{
+					SetError(ec ? "Failed to check file type: " + ec.message() : "Not a regular file");
+					return false;
+				}
+
+#if defined(_WIN32)
+				DWORD dwFlags = FILE_ATTRIBUTE_NORMAL;
+				if (enHint == AccessHint::Sequential)
+				{
+					dwFlags |= FILE_FLAG_SEQUENTIAL_SCAN;
+				}
+				else if (enHint == AccessHint::Random)
+				{
+					dwFlags |= FILE_FLAG_RANDOM_ACCESS;
+				}
+
+				hFile = CreateFileW(pathFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, dwFlags, NULL);
+				if (hFile == INVALID_HANDLE_VALUE)
+				{
+					SetError("Failed to open file");
+					return false;
+				}
+
+				LARGE_INTEGER liSize{};
+				if (!GetFileSizeEx(hFile, &liSize))
+				{
+					SetError("Failed to get file size");
+					return false;
+				}
+
+				if ((uint64_t)liSize.QuadPart > (uint64_t)std::numeric_limits<size_t>::max())
+				{
+					SetError("File is too large to map");
+					return false;
+				}
+
+				szSize = (size_t)liSize.QuadPart;
+				if (szSize == 0)//空文件无法映射，保持data为NULL
+				{
+					return true;
+				}
+
+				hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+				if (hMapping == NULL)
+				{
+					SetError("Failed to create file mapping");
+					return false;
+				}
+
+				pData = (const uint8_t *)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+				if (pData == NULL)
+				{
+					SetError("Failed to map view of file");
+					return false;
+				}
+#elif defined(__unix__) || defined(__APPLE__)
+				int iFd = ::open(pathFileName.c_str(), O_RDONLY | O_CLOEXEC);
+				if (iFd < 0)
+				{
+					SetError(std::string("Failed to open file: ") + strerror(errno));
+					return false;
+				}
+
+				struct stat stFile {};
+				if (::fstat(iFd, &stFile) != 0)
+				{
+					SetError(std::string("Failed to get file size: ") + strerror(errno));
+					::close(iFd);
+					return false;
+				}
+
+				if ((uintmax_t)stFile.st_size > (uintmax_t)std::numeric_limits<size_t>::max())
+				{
+					SetError("File is too large to map");
+					::close(iFd);
+					return false;
+				}
+
+				size_t szFileSize = (size_t)stFile.st_size;
+				if (szFileSize == 0)//空文件无法映射，保持data为NULL
+				{
+					::close(iFd);
+					return true;
+				}
+
+				void *pMap = ::mmap(NULL, szFileSize, PROT_READ, MAP_PRIVATE, iFd, 0);
+				::close(iFd);//映射建立后文件描述符不再需要
+				if (pMap == MAP_FAILED)
+				{
+					SetError(std::string("Failed to map file: ") + strerror(errno));
+					return false;
+				}
+
+				pData = (const uint8_t *)pMap;
+				szSize = szFileSize;
+
+				//预读提示，失败不影响使用
+				if (enHint == AccessHint::Sequential)
+				{
+					::madvise(pMap, szSize, MADV_SEQUENTIAL);
+					::madvise(pMap, szSize, MADV_WILLNEED);
+				}
+				else if (enHint == AccessHint::Random)
+				{
+					::madvise(pMap, szSize, MADV_RANDOM);
+				}
+#else
+				//不支持映射的平台，退化为读入内部缓冲区
+				std::ifstream fRead(pathFileName, std::ios_base::binary | std::ios_base::in);
+				if (!fRead)
+				{
+					SetError("Failed to open file");
+					return false;
+				}
+
+				vFallback.assign(std::istreambuf_iterator<char>(fRead), std::istreambuf_iterator<char>());
+				pData = vFallback.data();
+				szSize = vFallback.size();
+#endif
+				return true;
+			}
+			catch (...)
+			{
+				SetError("Failed to open file: exception");
+				return false;
+			}
+		}
+
+		/// @brief 解除映射并关闭文件，未映射时什么也不做
+		void Close(void) noexcept
+		{
+#if defined(_WIN32)
+			if (pData != NULL)
+			{
+				UnmapViewOfFile(pData);
+			}
+			if (hMapping != NULL)
+			{
+				CloseHandle(hMapping);
+				hMapping = NULL;
+			}
+			if (hFile != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(hFile);
+				hFile = INVALID_HANDLE_VALUE;
+			}
+#elif defined(__unix__) || defined(__APPLE__)
+			if (pData != NULL)
+			{
+				::munmap((void *)pData, szSize);
+			}
+#else
+			vFallback.clear();
+			vFallback.shrink_to_fit();
+#endif
+			pData = NULL;
+			szSize = 0;
+		}
+
+		/// @brief 检查是否成功映射了文件
+		/// @return 映射成功（包括空文件）返回true，否则返回false
+		bool IsOpen(void) const noexcept
+		{
+			return strErrorInfo.empty() && (pData != NULL || szSize == 0);
+		}
+
+		/// @brief 获取错误信息
+		/// @return 错误信息，没有错误时为空
+		const std::string &GetErrorInfo(void) const noexcept
+		{
+			return strErrorInfo;
+		}
+
+		/// @brief 获取映射数据的起始指针
+		/// @return 起始指针，空文件或未映射时为NULL
+		const value_type *data(void) const noexcept
+		{
+			return pData;
+		}
+
+		/// @brief 获取映射数据的大小
+		/// @return 数据大小，以字节数计
+		size_t size(void) const noexcept
+		{
+			return szSize;
+		}
+
+		/// @brief 检查映射数据是否为空
+		/// @return 为空返回true，否则返回false
+		bool empty(void) const noexcept
+		{
+			return szSize == 0;
+		}
+
+		/// @brief 下标访问运算符
+		/// @param szIndex 索引位置
+		/// @return 对应位置的常量引用
+		/// @note 调用者保证访问范围合法
+		const value_type &operator[](size_t szIndex) const noexcept
+		{
+			return pData[szIndex];
+		}
+	};
+
+private:
+	/// @cond
+	//先于DefaultInputStream基类构造的映射持有者（base-from-member）
+	struct MappedFileHolder
+	{
+		MappedFile mfFile;
+	};
+	/// @endcond
+
+public:
+	/// @brief 内存映射输入流类，直接在只读文件映射上提供DefaultInputStream的全部接口
+	/// @note 用于读取未压缩的NBT文件，省去把文件拷贝到std::vector中的开销，
+	/// 也避免了页缓存与用户缓冲区中各存一份数据。默认使用顺序访问提示，让操作系统尽早预读。
+	/// 打开失败时流的大小为0，可以通过IsOpen与GetErrorInfo检查。
+	class MmapInputStream : private MappedFileHolder, public DefaultInputStream<MappedFile>
+	{
+	public:
+		/// @brief 构造并映射文件
+		/// @param pathFileName 文件名
+		/// @param szStartIdx 起始读取索引位置
+		/// @param enHint 访问方式提示
+		MmapInputStream(const std::filesystem::path &pathFileName, size_t szStartIdx = 0, MappedFile::AccessHint enHint = MappedFile::AccessHint::Sequential) noexcept :
+			MappedFileHolder{ MappedFile(pathFileName, enHint) },
+			DefaultInputStream<MappedFile>(mfFile, szStartIdx)
+		{}
+
+		/// @brief 默认析构函数
+		~MmapInputStream(void) = default;
+
+		/// @brief 检查是否成功映射了文件
+		/// @return 映射成功返回true，否则返回false
+		bool IsOpen(void) const noexcept
+		{
+			return mfFile.IsOpen();
+		}
+
+		/// @brief 获取错误信息
+		/// @return 错误信息，没有错误时为空
+		const std::string &GetErrorInfo(void) const noexcept
+		{
+			return mfFile.GetErrorInfo();
+		}
+
+		/// @brief 获取底层的文件映射
+		/// @return 文件映射的常量引用
+		const MappedFile &GetMappedFile(void) const noexcept
+		{
+			return mfFile;
+		}
+	};
+
+#ifdef CJF2_NBT_CPP_USE_ZLIB
+
+	/// @brief 流式解压输入流类，从内存或文件中边解压边读取Zlib或Gzip数据
+	/// @note 这个类实现了DefaultInputStream的接口，可以直接传给NBT_Reader::ReadNBT与NBT_Scanner::ScanNBT的流重载。
+	/// 内部只保留一个固定大小的解压窗口，按需从zlib补充数据，因此内存占用与解压后的总大小无关。
+	/// 如果单次请求的数据（比如一个很大的数组）超过窗口大小，窗口会扩容到能容纳这次请求为止，扩容后不会缩小。
+	/// 与DefaultInputStream的区别：
+	/// - 无法提前得知解压后的总大小，Size()返回目前为止已解压出的数据量
+	/// - HasAvailData会按需解压，因此不是const的
+	/// - operator[]只能访问窗口内保留的数据（至少保留当前读取位置之前的HISTORY_SIZE个字节），范围外返回0，仅用于错误预览
+	/// - 提供TrySkipData，跳过数据时边解压边丢弃，不会为被跳过的数据扩容窗口
+	/// 
+	/// 解压或读取出错时HasAvailData返回false，此后可以通过IsGood与GetErrorInfo获取错误信息。
+	class InflateInputStream
+	{
+	public:
+		/// @brief 容器值类型
+		using ValueType = uint8_t;
+
+		/// @brief 默认解压窗口大小
+		static constexpr size_t DEFAULT_WINDOW_SIZE = 64 * 1024;
+		/// @brief 最小解压窗口大小
+		static constexpr size_t MIN_WINDOW_SIZE = 256;
+		/// @brief 补充数据时在当前读取位置之前保留的字节数，用于错误预览与回退
+		static constexpr size_t HISTORY_SIZE = 64;
+		/// @brief 从文件读取压缩数据时的输入缓冲区大小
+		static constexpr size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+	private:
+		//zlib状态
+		z_stream zs{};
+		bool bInit = false;
+		bool bStreamEnd = false;
+		bool bGood = true;
+		std::string strErrorInfo{};
+
+		//压缩数据来源：内存
+		const uint8_t *pInData = NULL;
+		size_t szInRemain = 0;
+
+		//压缩数据来源：文件
+		std::ifstream fIn{};
+		std::vector<uint8_t> vInBuffer{};
+		bool bFileSource = false;
+
+		//解压窗口，[0, szWinEnd)为有效数据，窗口第0字节对应流中的szWinBase位置
+		std::vector<uint8_t> vWindow{};
+		size_t szWinBase = 0;
+		size_t szWinEnd = 0;
+
+		//当前读取位置（流中的绝对位置）
+		size_t szIndex = 0;
+
+	private:
+		void Init(size_t szWindowSize) noexcept
+		{
+			try
+			{
+				vWindow.resize(std::max(szWindowSize, MIN_WINDOW_SIZE));
+			}
+			catch (...)
+			{
+				SetError("Failed to allocate inflate window");
+				return;
+			}
+
+			if (inflateInit2(&zs, 32 + 15) != Z_OK)//32+15自动判断是gzip还是zlib
+			{
+				SetError("Failed to initialize zlib decompression");
+				return;
+			}
+
+			bInit = true;
+		}
+
+		void SetError(const char *pInfo) noexcept
+		{
+			bGood = false;
+			bStreamEnd = true;//出错后不再继续解压
+
+			try
+			{
+				strErrorInfo = pInfo;
+				if (zs.msg != NULL)
+				{
+					strErrorInfo += ": ";
+					strErrorInfo += zs.msg;
+				}
+			}
+			catch (...)
+			{
+				//忽略错误信息构造失败
+			}
+		}
+
+		//为zlib补充输入，返回是否还有输入
+		bool FeedInput(void) noexcept
+		{
+			if (zs.avail_in != 0)
+			{
+				return true;
+			}
+
+			if (!bFileSource)
+			{
+				constexpr uInt uIntMax = (uInt)-1;
+				uInt uFeed = szInRemain > (size_t)uIntMax ? uIntMax : (uInt)szInRemain;
+
+				zs.next_in = (z_const Bytef *)pInData;
+				zs.avail_in = uFeed;
+
+				pInData += uFeed;
+				szInRemain -= uFeed;
+			}
+			else
+			{
+				if (!fIn.read((char *)vInBuffer.data(), vInBuffer.size()) && !fIn.eof())
+				{
+					SetError("Failed to read compressed data from file");
+					return false;
+				}
+
+				zs.next_in = (z_const Bytef *)vInBuffer.data();
+				zs.avail_in = (uInt)fIn.gcount();
+			}
+
+			return zs.avail_in != 0;
+		}
+
+		//保证当前读取位置之后至少有szNeed字节可用，bAllowGrow为false时调用者保证szNeed不超过窗口容量的一半
+		bool Refill(size_t szNeed, bool bAllowGrow) noexcept
+		{
+			size_t szPos = szIndex - szWinBase;
+			if (szWinEnd - szPos >= szNeed)
+			{
+				return true;
+			}
+
+			if (bStreamEnd)
+			{
+				return false;
+			}
+
+			//丢弃已读取的数据，仅保留HISTORY_SIZE个字节
+			size_t szKeep = szPos > HISTORY_SIZE ? szPos - HISTORY_SIZE : 0;
+			if (szKeep != 0)
+			{
+				memmove(vWindow.data(), &vWindow.data()[szKeep], szWinEnd - szKeep);
+				szWinBase += szKeep;
+				szWinEnd -= szKeep;
+				szPos -= szKeep;
+			}
+
+			//解压直到满足需求
+			while (szWinEnd - szPos < szNeed)
+			{
+				//窗口已满但仍不足以容纳本次请求则扩容
+				//随解压出的数据逐步倍增，而不是直接扩容到szNeed，防止错误的长度值导致巨大的分配
+				if (szWinEnd == vWindow.size())
+				{
+					if (!bAllowGrow)
+					{
+						return false;
+					}
+
+					try
+					{
+						vWindow.resize(std::min(szPos + szNeed, vWindow.size() * 2));
+					}
+					catch (...)
+					{
+						SetError("Failed to grow inflate window");
+						return false;
+					}
+				}
+
+				if (!FeedInput())
+				{
+					if (bGood)
+					{
+						SetError("Unexpected end of compressed data");
+					}
+					return false;
+				}
+
+				size_t szOut = vWindow.size() - szWinEnd;
+				constexpr uInt uIntMax = (uInt)-1;
+				zs.next_out = (Bytef *)&vWindow.data()[szWinEnd];
+				zs.avail_out = szOut > (size_t)uIntMax ? uIntMax : (uInt)szOut;
+
+				int iRet = inflate(&zs, Z_NO_FLUSH);
+				szWinEnd += (szOut > (size_t)uIntMax ? (size_t)uIntMax : szOut) - zs.avail_out;
+
+				if (iRet == Z_STREAM_END)
+				{
+					bStreamEnd = true;
+					break;
+				}
+				else if (iRet != Z_OK && iRet != Z_BUF_ERROR)
+				{
+					SetError("Zlib decompression failed");
+					return false;
+				}
+			}
+
+			return szWinEnd - szPos >= szNeed;
+		}
+
+	public:
+		/// @brief 禁止使用临时对象构造
+		template<typename T>
+		requires (sizeof(typename T::value_type) == 1 && requires(const T &t) { t.data(); t.size(); })
+		InflateInputStream(const T &&_tData, size_t szStartIdx = 0, size_t szWindowSize = DEFAULT_WINDOW_SIZE) = delete;
+
+		/// @brief 从内存中的压缩数据构造
+		/// @tparam T 数据容器类型，value_type的大小必须为1字节且可平凡复制
+		/// @param _tData 压缩数据容器的常量引用，流的生命周期内必须保持有效且不能修改
+		/// @param szStartIdx 压缩数据在容器中的起始位置
+		/// @param szWindowSize 解压窗口大小
+		template<typename T>
+		requires (sizeof(typename T::value_type) == 1 && std::is_trivially_copyable_v<typename T::value_type> && requires(const T &t) { t.data(); t.size(); })
+		InflateInputStream(const T &_tData, size_t szStartIdx = 0, size_t szWindowSize = DEFAULT_WINDOW_SIZE) noexcept
+		{
+			if (szStartIdx < _tData.size())
+			{
+				pInData = (const uint8_t *)&_tData.data()[szStartIdx];
+				szInRemain = _tData.size() - szStartIdx;
+			}
+
+			Init(szWindowSize);
+		}
+
+		/// @brief 从文件中的压缩数据构造
+		/// @param pathFileName 文件名
+		/// @param szWindowSize 解压窗口大小
+		/// @note 文件打开失败时不会抛出异常，此时IsGood返回false，任何读取都会失败
+		InflateInputStream(const std::filesystem::path &pathFileName, size_t szWindowSize = DEFAULT_WINDOW_SIZE) noexcept
+		{
+			bFileSource = true;
+
+			try
+			{
+				fIn.open(pathFileName, std::ios_base::binary | std::ios_base::in);
+				vInBuffer.resize(FILE_BUFFER_SIZE);
+			}
+			catch (...)
+			{
+				SetError("Failed to open file");
+				return;
+			}
+
+			if (!fIn)
+			{
+				SetError("Failed to open file");
+				return;
+			}
+
+			Init(szWindowSize);
+		}
+
+		/// @brief 析构函数，释放zlib资源
+		~InflateInputStream(void) noexcept
+		{
+			if (bInit)
+			{
+				inflateEnd(&zs);
+			}
+		}
+
+		/// @brief 禁止拷贝构造
+		InflateInputStream(const InflateInputStream &) = delete;
+		/// @brief 禁止移动构造
+		InflateInputStream(InflateInputStream &&) = delete;
+		/// @brief 禁止拷贝赋值
+		InflateInputStream &operator=(const InflateInputStream &) = delete;
+		/// @brief 禁止移动赋值
+		InflateInputStream &operator=(InflateInputStream &&) = delete;
+
+		/// @brief 下标访问运算符
+		/// @param szIndex 索引位置
+		/// @return 对应位置的常量引用，如果位置不在窗口内则返回0
+		/// @note 这个接口一般用于错误预览，不改变当前读取位置
+		const ValueType &operator[](size_t szIndex) const noexcept
+		{
+			static constexpr ValueType vZero = 0;
+
+			if (szIndex < szWinBase || szIndex - szWinBase >= szWinEnd)
+			{
+				return vZero;
+			}
+
+			return vWindow[szIndex - szWinBase];
+		}
+
+		/// @brief 获取下一个字节并推进读取位置
+		/// @return 下一个字节的常量引用
+		/// @note 调用者保证先通过HasAvailData确认数据可用
+		const ValueType &GetNext() noexcept
+		{
+			return vWindow[szIndex++ - szWinBase];
+		}
+
+		/// @brief 从流中读取一段数据
+		/// @param pDest 指向要读取数据的目标缓冲区的指针
+		/// @param szSize 要读取的数据大小（字节数）
+		/// @note 调用者保证先通过HasAvailData确认数据可用
+		void GetRange(void *pDest, size_t szSize) noexcept
+		{
+			if (szSize != 0)
+			{
+				memcpy(pDest, &vWindow.data()[szIndex - szWinBase], szSize);
+				szIndex += szSize;
+			}
+		}
+
+		/// @brief 回退一个字节的读取
+		/// @note 调用者保证回退位置仍在窗口内
+		void UnGet() noexcept
+		{
+			--szIndex;
+		}
+
+		/// @brief 跳过一段数据
+		/// @param szSize 要跳过的字节数
+		/// @return 跳过后的新读取位置
+		/// @note 调用者保证先通过HasAvailData确认数据可用
+		size_t SkipData(size_t szSize) noexcept
+		{
+			return szIndex += szSize;
+		}
+
+		/// @brief 检查数据是否足够，如果足够则跳过，边解压边丢弃，不会为跳过的数据扩容窗口
+		/// @param szSize 要跳过的字节数
+		/// @return 数据足够并成功跳过返回true，否则返回false
+		bool TrySkipData(size_t szSize) noexcept
+		{
+			while (szSize != 0)
+			{
+				size_t szAvail = szWinEnd - (szIndex - szWinBase);
+				if (szAvail == 0)
+				{
+					if (!Refill(std::min(szSize, vWindow.size() / 2), false))
+					{
+						return false;
+					}
+					continue;
+				}
+
+				size_t szStep = std::min(szAvail, szSize);
+				szIndex += szStep;
+				szSize -= szStep;
+			}
+
+			return true;
+		}
+
+		/// @brief 回退一段数据
+		/// @param szSize 要回退的字节数
+		/// @return 回退后的新读取位置
+		/// @note 调用者保证回退位置仍在窗口内
+		size_t RewindData(size_t szSize) noexcept
+		{
+			return szIndex -= szSize;
+		}
+
+		/// @brief 检查是否已到达流末尾
+		/// @return 如果已到达流末尾（或出错）则返回true，否则返回false
+		bool IsEnd() noexcept
+		{
+			return !HasAvailData(1);
+		}
+
+		/// @brief 获取目前为止已解压出的数据量
+		/// @return 已解压的数据大小，以字节数计
+		size_t Size() const noexcept
+		{
+			return szWinBase + szWinEnd;
+		}
+
+		/// @brief 检查是否还有足够的数据可供读取，不足时按需解压
+		/// @param szSize 需要读取的数据大小
+		/// @return 如果剩余数据足够则返回true，否则返回false
+		bool HasAvailData(size_t szSize) noexcept
+		{
+			return Refill(szSize, true);
+		}
+
+		/// @brief 获取当前读取位置（只读）
+		/// @return 当前读取位置索引，为解压后数据流中的绝对位置
+		const size_t &Index() const noexcept
+		{
+			return szIndex;
+		}
+
+		/// @brief 检查流是否没有发生错误
+		/// @return 没有错误返回true，否则返回false
+		/// @note 正常读取到解压数据末尾不算作错误
+		bool IsGood() const noexcept
+		{
+			return bGood;
+		}
+
+		/// @brief 获取错误信息
+		/// @return 错误信息，没有错误时为空
+		const std::string &GetErrorInfo() const noexcept
+		{
+			return strErrorInfo;
+		}
+	};
+
+	/// @brief 流式压缩输出流类，边写入边压缩，并把压缩结果直接输出到文件或用户提供的接收函数
+	/// @note 这个类实现了DefaultOutputStream中NBT_Writer用到的接口，可以直接传给NBT_Writer::WriteNBT的流重载。
+	/// 内部只使用固定大小的输入暂存区与压缩输出缓冲区，内存占用与写出的总大小无关。
+	/// 与DefaultOutputStream的区别：
+	/// - 写出的数据无法撤销，因此不提供UnPut、RemoveData与Reset
+	/// - AddReserve不做任何事
+	/// - operator[]只能访问最近写入的HISTORY_SIZE个字节，范围外返回0，仅用于错误预览
+	/// - 写出完成后必须调用Finish（或FinishNoThrow）输出压缩流的结尾，析构时如果尚未结束会自动调用并忽略错误
+	/// 
+	/// 压缩或输出出错时，写入函数抛出std::runtime_error异常（NBT_Writer会捕获并转换为错误码），此后可以通过IsGood与GetErrorInfo获取错误信息。
+	class DeflateOutputStream
+	{
+	public:
+		/// @brief 容器值类型
+		using ValueType = uint8_t;
+		/// @brief 压缩数据接收函数类型，返回false代表输出失败
+		using SinkFunc = std::function<bool(const uint8_t *pData, size_t szSize)>;
+
+		/// @brief 默认缓冲区大小
+		static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+		/// @brief 最小缓冲区大小
+		static constexpr size_t MIN_BUFFER_SIZE = 256;
+		/// @brief 保留最近写入的字节数，用于错误预览
+		static constexpr size_t HISTORY_SIZE = 128;
+
+	private:
+		//zlib状态
+		z_stream zs{};
+		bool bInit = false;
+		bool bFinished = false;
+		bool bGood = true;
+		std::string strErrorInfo{};
+
+		//压缩数据去向
+		SinkFunc funcSink{};
+		std::ofstream fOut{};
+
+		//输入暂存区与压缩输出缓冲区
+		std::vector<uint8_t> vInBuffer{};
+		size_t szInUsed = 0;
+		std::vector<uint8_t> vOutBuffer{};
+
+		//已写入的未压缩数据总量与最近写入的数据
+		size_t szTotalIn = 0;
+		uint8_t u8History[HISTORY_SIZE] = {};
+
+	private:
+		void Init(int iLevel, bool bGzip, size_t szBufferSize)
+		{
+			szBufferSize = std::max(szBufferSize, MIN_BUFFER_SIZE);
+			vInBuffer.resize(szBufferSize);
+			vOutBuffer.resize(szBufferSize);
+
+			if (deflateInit2(&zs, iLevel, Z_DEFLATED, bGzip ? 16 + 15 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)//16+15使用gzip（mojang默认格式），15使用zlib
+			{
+				SetError("Failed to initialize zlib compression");
+				return;
+			}
+
+			bInit = true;
+		}
+
+		void SetError(const char *pInfo) noexcept
+		{
+			bGood = false;
+
+			try
+			{
+				strErrorInfo = pInfo;
+				if (zs.msg != NULL)
+				{
+					strErrorInfo += ": ";
+					strErrorInfo += zs.msg;
+				}
+			}
+			catch (...)
+			{
+				//忽略错误信息构造失败
+			}
+		}
+
+		[[noreturn]] void ThrowError(const char *pInfo)
+		{
+			SetError(pInfo);
+			throw std::runtime_error(strErrorInfo.empty() ? std::string(pInfo) : strErrorInfo);
+		}
+
+		void CheckState(void)
+		{
+			if (!bGood)
+			{
+				throw std::runtime_error(strErrorInfo);
+			}
+
+			if (bFinished)
+			{
+				ThrowError("Stream already finished");
+			}
+		}
+
+		//输出压缩后的数据
+		void Emit(const uint8_t *pData, size_t szSize)
+		{
+			if (funcSink)
+			{
+				if (!funcSink(pData, szSize))
+				{
+					ThrowError("Sink function failed");
+				}
+			}
+			else
+			{
+				if (!fOut.write((const char *)pData, szSize))
+				{
+					ThrowError("Failed to write compressed data to file");
+				}
+			}
+		}
+
+		//压缩一段数据并输出所有已产生的压缩结果
+		void Deflate(const uint8_t *pData, size_t szSize, int iFlush)
+		{
+			constexpr uInt uIntMax = (uInt)-1;
+			zs.next_in = (z_const Bytef *)pData;
+
+			do
+			{
+				//对于大于uint_max的数据，分块输入
+				uInt uFeed = szSize > (size_t)uIntMax ? uIntMax : (uInt)szSize;
+				zs.avail_in = uFeed;
+				szSize -= uFeed;
+
+				int iCurFlush = szSize != 0 ? Z_NO_FLUSH : iFlush;
+				int iRet = Z_OK;
+				do
+				{
+					zs.next_out = (Bytef *)vOutBuffer.data();
+					zs.avail_out = (uInt)vOutBuffer.size();
+
+					iRet = deflate(&zs, iCurFlush);
+					if (iRet == Z_STREAM_ERROR)
+					{
+						ThrowError("Zlib compression failed");
+					}
+
+					size_t szHave = vOutBuffer.size() - zs.avail_out;
+					if (szHave != 0)
+					{
+						Emit(vOutBuffer.data(), szHave);
+					}
+				} while (zs.avail_out == 0 || (iCurFlush == Z_FINISH && iRet != Z_STREAM_END));
+			} while (szSize != 0);
+		}
+
+		//压缩暂存区中的数据
+		void FlushInput(void)
+		{
+			if (szInUsed != 0)
+			{
+				Deflate(vInBuffer.data(), szInUsed, Z_NO_FLUSH);
+				szInUsed = 0;
+			}
+		}
+
+		//记录最近写入的数据
+		void RecordHistory(const uint8_t *pData, size_t szSize) noexcept
+		{
+			size_t szRecord = std::min(szSize, HISTORY_SIZE);
+			size_t szBeg = szTotalIn + szSize - szRecord;
+			for (size_t i = 0; i < szRecord; ++i)
+			{
+				u8History[(szBeg + i) % HISTORY_SIZE] = pData[szSize - szRecord + i];
+			}
+		}
+
+	public:
+		/// @brief 构造并输出到用户提供的接收函数
+		/// @param _funcSink 压缩数据接收函数，每次调用传入一段压缩后的数据，返回false代表失败
+		/// @param iLevel 压缩等级
+		/// @param bGzip 为true输出Gzip格式（NBT文件的标准压缩格式），否则输出Zlib格式
+		/// @param szBufferSize 输入暂存区与输出缓冲区的大小
+		DeflateOutputStream(SinkFunc _funcSink, int iLevel = Z_DEFAULT_COMPRESSION, bool bGzip = true, size_t szBufferSize = DEFAULT_BUFFER_SIZE) :
+			funcSink(std::move(_funcSink))
+		{
+			if (!funcSink)
+			{
+				SetError("Sink function is empty");
+				return;
+			}
+
+			Init(iLevel, bGzip, szBufferSize);
+		}
+
+		/// @brief 构造并输出到文件
+		/// @param pathFileName 文件名，如果文件已存在则直接清空并覆盖，未存在则创建文件
+		/// @param iLevel 压缩等级
+		/// @param bGzip 为true输出Gzip格式（NBT文件的标准压缩格式），否则输出Zlib格式
+		/// @param szBufferSize 输入暂存区与输出缓冲区的大小
+		/// @note 文件打开失败时不会抛出异常，此时IsGood返回false，任何写入都会失败
+		DeflateOutputStream(const std::filesystem::path &pathFileName, int iLevel = Z_DEFAULT_COMPRESSION, bool bGzip = true, size_t szBufferSize = DEFAULT_BUFFER_SIZE)
+		{
+			fOut.open(pathFileName, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+			if (!fOut)
+			{
+				SetError("Failed to open file");
+				return;
+			}
+
+			Init(iLevel, bGzip, szBufferSize);
+		}
+
+		/// @brief 析构函数，如果尚未结束则结束压缩流并忽略错误，然后释放zlib资源
+		~DeflateOutputStream(void) noexcept
+		{
+			if (bInit)
+			{
+				if (!bFinished && bGood)
+				{
+					try
+					{
+						Finish();
+					}
+					catch (...)
+					{
+						//析构中忽略错误
+					}
+				}
+
+				deflateEnd(&zs);
+			}
+		}
+
+		/// @brief 禁止拷贝构造
+		DeflateOutputStream(const DeflateOutputStream &) = delete;
+		/// @brief 禁止移动构造
+		DeflateOutputStream(DeflateOutputStream &&) = delete;
+		/// @brief 禁止拷贝赋值
+		DeflateOutputStream &operator=(const DeflateOutputStream &) = delete;
+		/// @brief 禁止移动赋值
+		DeflateOutputStream &operator=(DeflateOutputStream &&) = delete;
+
+		/// @brief 下标访问运算符
+		/// @param szIndex 索引位置
+		/// @return 对应位置的常量引用，如果不是最近写入的HISTORY_SIZE个字节则返回0
+		/// @note 这个接口一般用于错误预览
+		const ValueType &operator[](size_t szIndex) const noexcept
+		{
+			static constexpr ValueType vZero = 0;
+
+			if (szIndex >= szTotalIn || szTotalIn - szIndex > HISTORY_SIZE)
+			{
+				return vZero;
+			}
+
+			return u8History[szIndex % HISTORY_SIZE];
+		}
+
+		/// @brief 向流中写入写入单个值
+		/// @tparam V 元素类型，必须可构造为ValueType
+		/// @param c 要写入的元素
+		template<typename V>
+		requires(std::is_constructible_v<ValueType, V &&>)
+		void PutOnce(V &&c)
+		{
+			CheckState();
+
+			if (szInUsed == vInBuffer.size())
+			{
+				FlushInput();
+			}
+
+			ValueType u8Val(std::forward<V>(c));
+			vInBuffer[szInUsed++] = u8Val;
+			RecordHistory(&u8Val, 1);
+			++szTotalIn;
+		}
+
+		/// @brief 向流中写入一段数据
+		/// @param pData 指向要写入数据的缓冲区的指针
+		/// @param szSize 要写入的数据大小（字节数）
+		/// @note 小块数据先进入暂存区合并后再压缩，不小于暂存区大小的数据直接压缩
+		void PutRange(const ValueType *pData, size_t szSize)
+		{
+			CheckState();
+
+			if (szSize == 0)
+			{
+				return;
+			}
+
+			if (vInBuffer.size() - szInUsed < szSize)
+			{
+				FlushInput();
+			}
+
+			if (szSize >= vInBuffer.size())
+			{
+				Deflate(pData, szSize, Z_NO_FLUSH);
+			}
+			else
+			{
+				memcpy(&vInBuffer.data()[szInUsed], pData, szSize);
+				szInUsed += szSize;
+			}
+
+			RecordHistory(pData, szSize);
+			szTotalIn += szSize;
+		}
+
+		/// @brief 预分配额外容量
+		/// @param szAddSize 要额外分配的容量大小（字节数）
+		/// @note 压缩流不需要预分配，什么也不做
+		void AddReserve(size_t szAddSize) noexcept
+		{
+			return;
+		}
+
+		/// @brief 获取已写入的未压缩数据大小
+		/// @return 数据大小，以字节数计
+		size_t Size(void) const noexcept
+		{
+			return szTotalIn;
+		}
+
+		/// @brief 结束压缩流，输出所有剩余数据与压缩流结尾，如果输出到文件则关闭文件
+		/// @note 失败时抛出std::runtime_error异常。结束后不能再写入，重复调用不做任何事
+		void Finish(void)
+		{
+			if (bFinished)
+			{
+				return;
+			}
+
+			CheckState();
+			FlushInput();
+			Deflate(NULL, 0, Z_FINISH);
+			bFinished = true;
+
+			if (!funcSink)
+			{
+				fOut.close();
+				if (!fOut)
+				{
+					ThrowError("Failed to close file");
+				}
+			}
+		}
+
+		/// @brief 结束压缩流，但是不抛出异常，而是通过funcInfo打印异常信息并返回成功与否
+		/// @tparam InfoFunc 打印异常信息的仿函数类型
+		/// @param funcInfo 打印异常信息的仿函数
+		/// @return 操作是否成功
+		template<typename InfoFunc = NBT_Print>
+		bool FinishNoThrow(InfoFunc funcInfo = InfoFunc{}) noexcept
+		{
+			try
+			{
+				Finish();
+				return true;
+			}
+			catch (const std::bad_alloc &e)
+			{
+				funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+				return false;
+			}
+			catch (const std::exception &e)
+			{
+				funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+				return false;
+			}
+			catch (...)
+			{
+				funcInfo(NBT_Print_Level::Err, "Unknown Error\n");
+				return false;
+			}
+		}
+
+		/// @brief 检查流是否没有发生错误
+		/// @return 没有错误返回true，否则返回false
+		bool IsGood() const noexcept
+		{
+			return bGood;
+		}
+
+		/// @brief 获取错误信息
+		/// @return 错误信息，没有错误时为空
+		const std::string &GetErrorInfo() const noexcept
+		{
+			return strErrorInfo;
+		}
+	};
+
+#endif
+
 
 public:
 	/// @brief 从任意顺序容器写出字节流数据到指定文件名的文件中
@@ -539,7 +1879,7 @@ public:
 			  sizeof(typename O::value_type) == 1 && std::is_trivially_copyable_v<typename O::value_type>)
 	static void DecompressData(O &oData, const I &iData)
 	{
-		if (std::addressof(oData) == std::addressof(iData))
+		if ((const void *)std::addressof(oData) == (const void *)std::addressof(iData))
 		{
 			throw std::runtime_error("The oData object cannot be the iData object");
 		}
@@ -658,7 +1998,7 @@ public:
 			  sizeof(typename O::value_type) == 1 && std::is_trivially_copyable_v<typename O::value_type>)
 	static void CompressData(O &oData, const I &iData, int iLevel = Z_DEFAULT_COMPRESSION)
 	{
-		if (std::addressof(oData) == std::addressof(iData))
+		if ((const void *)std::addressof(oData) == (const void *)std::addressof(iData))
 		{
 			throw std::runtime_error("The oData object cannot be the iData object");
 		}
@@ -0,0 +1,245 @@
+﻿#pragma once
+
+#include <stdint.h>
+#include <stddef.h>//size_t
+#include <deque>
+#include <vector>
+#include <string_view>
+#include <functional>//std::hash
+
+#include "NBT_Node.hpp"//nbt类型
+
+#ifdef CJF2_NBT_CPP_USE_ARENA_ALLOCATOR
+#include "NBT_Allocator.hpp"
+#endif
+
+/// @file
+/// @brief 集合键名的驻留池
+
+/// @brief 集合键名的驻留池，解析时重复出现的键只需要查找一次
+/// @note 在NBT_KeyPoolScope作用域内，NBT_Reader读取集合条目名称时会先在当前线程的驻留池中查找，
+/// 命中时直接拷贝池中已经构造好的键，不命中时插入池中，之后同一次或后续的解析都可以复用。
+/// 当前线程的池在每个集合开始读取时获取一次，而不是每个键获取一次。
+/// 池中的每个键都保存了预先计算的哈希值（与std::hash<NBT_Type::String>的结果一致），
+/// 池自身扩容时不需要重新计算任何键的哈希；使用NBT_FlatMap作为集合底层容器（CJF2_NBT_CPP_USE_FLAT_COMPOUND）时，
+/// 这个哈希值还会直接用于集合的插入，集合不再对键计算哈希。std::unordered_map没有接受哈希值的接口，插入时仍然会重新计算。
+///
+/// NBT_Type::String是值类型，所以树中的每个键仍然持有自己的缓冲区，池不能消除这次拷贝：
+/// 不超过短字符串优化长度的键（绝大部分键）拷贝时不分配内存，
+/// 更长的键拷贝时会进行一次精确大小的分配（在NBT_ArenaScope内则从竞技场资源中分配）。
+/// 池不是线程安全的，每个线程应使用自己的池。
+class NBT_KeyPool
+{
+public:
+	using ValueType = NBT_Type::String::value_type;	///< 键的字符类型
+
+	static constexpr size_t szMaxKeyLength = 64;	///< 超过此长度的键不会进入池，按普通方式读取
+
+private:
+	/// @brief 池中的一个键
+	struct Entry
+	{
+		NBT_Type::String sKey;	///< 驻留的键
+		size_t szHash;			///< 键的哈希值
+	};
+
+	std::deque<Entry> dqEntry{};		///< 所有键，使用deque保证插入后地址不变
+	std::vector<uint32_t> vSlot{};		///< 开放寻址的索引，0为空，否则为dqEntry下标+1
+	size_t szMaxEntries = 0;			///< 池中最多保存的键数量
+	size_t szHitCount = 0;				///< 命中次数
+	size_t szMissCount = 0;				///< 未命中次数
+
+	static inline thread_local NBT_KeyPool *pCurrent = NULL;
+
+private:
+	static size_t HashOf(const ValueType *pData, size_t szLength) noexcept
+	{
+		return std::hash<std::string_view>{}(std::string_view((const char *)pData, szLength * sizeof(ValueType)));
+	}
+
+	/// @brief 扩容并使用保存的哈希值重建索引
+	void Grow(void)
+	{
+		std::vector<uint32_t> vNewSlot(vSlot.empty() ? 64 : vSlot.size() * 2, 0);
+		const size_t szMask = vNewSlot.size() - 1;
+
+		for (size_t i = 0; i < dqEntry.size(); ++i)
+		{
+			size_t szPos = dqEntry[i].szHash & szMask;
+			while (vNewSlot[szPos] != 0)
+			{
+				szPos = (szPos + 1) & szMask;
+			}
+			vNewSlot[szPos] = (uint32_t)(i + 1);
+		}
+
+		vSlot.swap(vNewSlot);
+	}
+
+public:
+	/// @brief 构造
+	/// @param _szMaxEntries 池中最多保存的键数量，达到后不再插入新键（已有的键仍然可以命中），
+	/// 防止恶意数据中大量不重复的键使池无限增长
+	NBT_KeyPool(size_t _szMaxEntries = 4096) :szMaxEntries(_szMaxEntries)
+	{}
+
+	/// @brief 默认析构
+	~NBT_KeyPool(void) = default;
+
+	/// @brief 禁止拷贝构造
+	NBT_KeyPool(const NBT_KeyPool &) = delete;
+	/// @brief 禁止拷贝赋值
+	NBT_KeyPool &operator=(const NBT_KeyPool &) = delete;
+
+	/// @brief 查找或插入一个键
+	/// @param pData 键的M-UTF-8数据
+	/// @param szLength 键的长度
+	/// @return 池中的键，池已满且键不存在时返回NULL
+	/// @note 返回的指针在池析构或Clear之前一直有效。
+	/// 内存不足时抛出std::bad_alloc。
+	const NBT_Type::String *Intern(const ValueType *pData, size_t szLength)
+	{
+		size_t szHash = 0;
+		return Intern(pData, szLength, szHash);
+	}
+
+	/// @brief 查找或插入一个键，同时返回键的哈希值
+	/// @param pData 键的M-UTF-8数据
+	/// @param szLength 键的长度
+	/// @param szHash 返回键的哈希值（与std::hash<NBT_Type::String>的结果一致），即使返回NULL也有效
+	/// @return 池中的键，池已满且键不存在时返回NULL
+	/// @note 返回的指针在池析构或Clear之前一直有效。
+	/// 内存不足时抛出std::bad_alloc。
+	const NBT_Type::String *Intern(const ValueType *pData, size_t szLength, size_t &szHash)
+	{
+		szHash = HashOf(pData, szLength);
+
+		if (!vSlot.empty())
+		{
+			const size_t szMask = vSlot.size() - 1;
+			for (size_t szPos = szHash & szMask; vSlot[szPos] != 0; szPos = (szPos + 1) & szMask)
+			{
+				const Entry &stEntry = dqEntry[vSlot[szPos] - 1];
+				if (stEntry.szHash == szHash &&
+					stEntry.sKey.size() == szLength &&
+					NBT_Type::String::traits_type::compare(stEntry.sKey.data(), pData, szLength) == 0)
+				{
+					++szHitCount;
+					return &stEntry.sKey;
+				}
+			}
+		}
+
+		++szMissCount;
+		if (dqEntry.size() >= szMaxEntries)
+		{
+			return NULL;
+		}
+
+		if ((dqEntry.size() + 1) * 2 > vSlot.size())//负载不超过1/2
+		{
+			Grow();
+		}
+
+		{
+#ifdef CJF2_NBT_CPP_USE_ARENA_ALLOCATOR
+			//池中的键可能比当前作用域的竞技场活得更久，所以总是从默认资源分配
+			NBT_ArenaScope asDefault(NULL);
+#endif
+			dqEntry.push_back(Entry{ NBT_Type::String(pData, szLength), szHash });
+		}
+
+		const size_t szMask = vSlot.size() - 1;
+		size_t szPos = szHash & szMask;
+		while (vSlot[szPos] != 0)
+		{
+			szPos = (szPos + 1) & szMask;
+		}
+		vSlot[szPos] = (uint32_t)dqEntry.size();
+
+		return &dqEntry.back().sKey;
+	}
+
+	/// @brief 清空池中所有的键与统计
+	void Clear(void) noexcept
+	{
+		dqEntry.clear();
+		vSlot.clear();
+		szHitCount = 0;
+		szMissCount = 0;
+	}
+
+	/// @brief 获取池中键的数量
+	size_t Size(void) const noexcept
+	{
+		return dqEntry.size();
+	}
+
+	/// @brief 获取命中次数
+	size_t GetHitCount(void) const noexcept
+	{
+		return szHitCount;
+	}
+
+	/// @brief 获取未命中次数（包括池已满时没有插入的键）
+	size_t GetMissCount(void) const noexcept
+	{
+		return szMissCount;
+	}
+
+	/// @brief 获取当前线程使用的池
+	/// @return 当前线程的池，未设置时返回NULL
+	static NBT_KeyPool *GetCurrent(void) noexcept
+	{
+		return pCurrent;
+	}
+
+	/// @brief 设置当前线程使用的池
+	/// @param pPool 新的池，为NULL则不使用池
+	/// @return 之前设置的池（可能为NULL）
+	static NBT_KeyPool *SetCurrent(NBT_KeyPool *pPool) noexcept
+	{
+		NBT_KeyPool *pOld = pCurrent;
+		pCurrent = pPool;
+		return pOld;
+	}
+};
+
+/// @brief 作用域内把当前线程的键池设置为指定的池，离开作用域时恢复
+/// @note 例如：
+/// @code
+/// NBT_KeyPool kpKeys{};
+/// for (const auto &vData : vChunkData)
+/// {
+/// 	NBT_KeyPoolScope kpsScope(&kpKeys);
+/// 	NBT_Type::Compound cpd;
+/// 	NBT_Reader::ReadNBT(vData, 0, cpd);
+/// 	//使用cpd...
+/// }
+/// @endcode
+class NBT_KeyPoolScope
+{
+private:
+	NBT_KeyPool *pOld;
+
+public:
+	/// @brief 构造并设置当前线程的键池
+	/// @param pPool 键池
+	NBT_KeyPoolScope(NBT_KeyPool *pPool) noexcept :pOld(NBT_KeyPool::SetCurrent(pPool))
+	{}
+
+	/// @brief 析构并恢复之前的键池
+	~NBT_KeyPoolScope(void) noexcept
+	{
+		NBT_KeyPool::SetCurrent(pOld);
+	}
+
+	/// @brief 禁止拷贝构造
+	NBT_KeyPoolScope(const NBT_KeyPoolScope &) = delete;
+	/// @brief 禁止移动构造
+	NBT_KeyPoolScope(NBT_KeyPoolScope &&) = delete;
+	/// @brief 禁止拷贝赋值
+	NBT_KeyPoolScope &operator=(const NBT_KeyPoolScope &) = delete;
+	/// @brief 禁止移动赋值
+	NBT_KeyPoolScope &operator=(NBT_KeyPoolScope &&) = delete;
+};
@@ -0,0 +1,665 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <span>//std::span
+#include <memory>//std::unique_ptr std::shared_ptr
+#include <functional>//std::function
+#include <string_view>//std::string_view
+#include <vector>//字节流
+#include <format>//std::format_string
+#include <stdexcept>//std::out_of_range
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <string.h>//memcmp
+#include <utility>//std::move
+
+#include "NBT_Print.hpp"//打印输出
+#include "NBT_Node.hpp"//nbt类型
+#include "NBT_IO.hpp"//IO流对象
+#include "NBT_Reader.hpp"//反序列化
+#include "NBT_Scanner.hpp"//跳过数据
+
+/// @file
+/// @brief 按需解析的NBT集合
+
+
+/// @brief 按需解析的NBT集合，解析时只建立索引，子节点在首次访问时才反序列化
+/// @note Parse只记录每个条目的类型、名称与值在字节流中的范围（通过NBT_Scanner的跳过例程确定边界，同时完成格式校验），
+/// 不会构造任何NBT_Node、字符串或数组。通过Get/Has访问某个条目时，才会把这个条目完整地反序列化为NBT_Node并缓存，
+/// 之后的访问直接返回缓存结果。对于集合类型的条目，还可以通过GetLazyCompound/HasLazyCompound得到同样按需解析的子集合，
+/// 以便只解析深层结构中需要的部分。
+///
+/// 对象本身持有字节流的所有权（Parse），或者引用调用者的字节流（ParseBorrowed，调用者需要保证数据在对象销毁前有效），
+/// 所有子集合共享同一份字节流。同名条目以后出现的为准，与NBT_Reader的行为一致。
+/// 访问接口会修改内部缓存，所以对同一个对象的并发访问是不安全的。例如只读取区块中的少数字段：
+/// @code
+/// std::vector<uint8_t> vData;
+/// rfRegion.ReadChunkData(x, z, vData);
+/// NBT_LazyCompound lcChunk;
+/// if (lcChunk.Parse(std::move(vData)))
+/// {
+/// 	NBT_LazyCompound &lcRoot = lcChunk.GetLazyCompound(MU8STR(""));
+/// 	NBT_Type::Int iDataVersion = lcRoot.GetInt(MU8STR("DataVersion"));
+/// 	const NBT_Type::String *pStatus = lcRoot.HasString(MU8STR("Status"));
+/// }
+/// @endcode
+class NBT_LazyCompound
+{
+private:
+	struct Entry
+	{
+		NBT_TAG enTag = NBT_TAG::End;
+		size_t szNameBeg = 0;
+		size_t szNameSize = 0;
+		size_t szValueBeg = 0;
+		size_t szValueEnd = 0;
+		std::unique_ptr<NBT_Node> pNode{};
+		std::unique_ptr<NBT_LazyCompound> pLazy{};
+	};
+
+	//把NBT_Scanner跳过例程的错误信息转发给funcInfo
+	template<typename InfoFunc>
+	class ErrorVisitor
+	{
+	private:
+		InfoFunc &funcInfo;
+
+	public:
+		ErrorVisitor(InfoFunc &_funcInfo) noexcept :funcInfo(_funcInfo)
+		{}
+
+		template<typename... Args>
+		void VisitError(NBT_Print_Level lvl, const std::format_string<Args...> fmt, Args&&... args) noexcept
+		{
+			funcInfo(lvl, std::move(fmt), std::forward<Args>(args)...);
+		}
+	};
+
+	//Parse时保存的调用者funcInfo（类型擦除），按需反序列化时的信息先格式化为字符串再转发给它
+	class StoredInfo
+	{
+	private:
+		using PrintFunc = std::function<void(NBT_Print_Level, std::string_view)>;
+		std::shared_ptr<const PrintFunc> pFunc{};
+
+	public:
+		StoredInfo(void) = default;
+
+		template<typename InfoFunc>
+		static StoredInfo Make(InfoFunc funcInfo)//可能抛出std::bad_alloc
+		{
+			StoredInfo siRet{};
+			siRet.pFunc = std::make_shared<const PrintFunc>(
+				[funcInfo = std::move(funcInfo)](NBT_Print_Level lvl, std::string_view svInfo) mutable noexcept -> void
+				{
+					funcInfo(lvl, "{}", svInfo);
+				});
+			return siRet;
+		}
+
+		template<typename... Args>
+		void operator()(NBT_Print_Level lvl, const std::format_string<Args...> fmt, Args&&... args) noexcept
+		{
+			if (pFunc == nullptr)//未保存时退回默认输出
+			{
+				NBT_Print{}(lvl, std::move(fmt), std::forward<Args>(args)...);
+				return;
+			}
+
+			try
+			{
+				auto tmp = std::format(std::move(fmt), std::forward<Args>(args)...);
+				(*pFunc)(lvl, tmp);
+			}
+			catch (...)
+			{
+				//与NBT_Print一致，信息输出本身不能抛出异常
+			}
+		}
+	};
+
+	using InputStream = NBT_IO::DefaultInputStream<std::span<const uint8_t>>;
+
+private:
+	std::shared_ptr<const std::vector<uint8_t>> pOwner{};
+	StoredInfo funcStoredInfo{};
+	std::span<const uint8_t> spanData{};
+	std::vector<Entry> vEntry{};
+	size_t szStackDepth = 0;
+	bool bUnwrapMixedList = true;
+
+private:
+	//为[szBeg, szEnd)范围内的集合建立索引，bRoot为true时允许数据在没有End标签的情况下结束
+	template<bool bRoot, typename InfoFunc>
+	bool BuildIndex(size_t szBeg, size_t szEnd, InfoFunc &funcInfo) noexcept
+	{
+		vEntry.clear();
+
+		if (szStackDepth == 0)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: NBT nesting depth exceeded maximum call stack limit.\n");
+			return false;
+		}
+
+		try
+		{
+			std::span<const uint8_t> spanRange = spanData.first(szEnd);
+			InputStream IptStream(spanRange, szBeg);
+			ErrorVisitor<InfoFunc> tVisitor(funcInfo);
+
+			while (true)
+			{
+				//处理末尾情况
+				if (!IptStream.HasAvailData(sizeof(NBT_TAG_RAW_TYPE)))
+				{
+					if constexpr (bRoot)
+					{
+						return true;
+					}
+					else
+					{
+						funcInfo(NBT_Print_Level::Err, "Error: Unexpected end of compound data at index [{}].\n", IptStream.Index());
+						return false;
+					}
+				}
+
+				NBT_TAG_RAW_TYPE u8EntryTag = (NBT_TAG_RAW_TYPE)IptStream.GetNext();
+				if (u8EntryTag == NBT_TAG::End)
+				{
+					return true;
+				}
+
+				if (u8EntryTag >= NBT_TAG::ENUM_END)
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Unknown Type Tag[0x{:02X}({})] at index [{}].\n",
+						u8EntryTag, u8EntryTag, IptStream.Index() - 1);
+					return false;
+				}
+
+				Entry eEntry{};
+				eEntry.enTag = (NBT_TAG)u8EntryTag;
+
+				//只记录名称的位置，不构造字符串
+				NBT_Type::StringLength wNameLength = 0;
+				if (!NBT_Scanner::ReadEndian<NBT_Format::BigEndian>(IptStream, wNameLength, tVisitor))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Failed to read entry name length, Type: [NBT_Type::{}].\n", NBT_Type::GetTypeName(eEntry.enTag));
+					return false;
+				}
+
+				eEntry.szNameBeg = IptStream.Index();
+				eEntry.szNameSize = (size_t)wNameLength * sizeof(NBT_Type::String::value_type);
+				if (!NBT_Scanner::TrySkipData(IptStream, eEntry.szNameSize))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Entry name out of range at index [{}], name size [{}], data size [{}].\n",
+						eEntry.szNameBeg, eEntry.szNameSize, IptStream.Size());
+					return false;
+				}
+
+				//跳过值并记录范围
+				eEntry.szValueBeg = IptStream.Index();
+				if (!NBT_Scanner::SkipSwitch<NBT_Format::BigEndian>(IptStream, eEntry.enTag, tVisitor, szStackDepth - 1))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Failed to skip entry value, Type: [NBT_Type::{}].\n", NBT_Type::GetTypeName(eEntry.enTag));
+					return false;
+				}
+				eEntry.szValueEnd = IptStream.Index();
+
+				vEntry.push_back(std::move(eEntry));
+			}
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			return false;
+		}
+	}
+
+	template<bool bRoot, typename InfoFunc>
+	bool ParseImpl(size_t szStartIdx, InfoFunc &funcInfo) noexcept
+	{
+		if (szStartIdx > spanData.size())
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Start index [{}] out of range, data size [{}].\n", szStartIdx, spanData.size());
+			vEntry.clear();
+			return false;
+		}
+
+		return BuildIndex<bRoot>(szStartIdx, spanData.size(), funcInfo);
+	}
+
+	const Entry *FindEntry(const NBT_Type::String &sTagName) const noexcept
+	{
+		//从后往前查找，同名条目以后出现的为准
+		for (auto it = vEntry.rbegin(); it != vEntry.rend(); ++it)
+		{
+			if (it->szNameSize == sTagName.size() &&
+				memcmp(spanData.data() + it->szNameBeg, sTagName.data(), it->szNameSize) == 0)
+			{
+				return &*it;
+			}
+		}
+
+		return NULL;
+	}
+
+	Entry *FindEntry(const NBT_Type::String &sTagName) noexcept
+	{
+		return const_cast<Entry *>(((const NBT_LazyCompound *)this)->FindEntry(sTagName));
+	}
+
+	NBT_Node *MaterializeNode(Entry &eEntry) noexcept
+	{
+		if (eEntry.pNode != nullptr)
+		{
+			return eEntry.pNode.get();
+		}
+
+		StoredInfo &funcInfo = funcStoredInfo;
+		try
+		{
+			auto pNode = std::make_unique<NBT_Node>();
+			std::span<const uint8_t> spanRange = spanData.first(eEntry.szValueEnd);
+			InputStream IptStream(spanRange, eEntry.szValueBeg);
+
+			//索引时已经校验过格式，此处只会因为内存不足等原因失败
+			NBT_Reader::ErrCode eRet = bUnwrapMixedList
+				? NBT_Reader::GetSwitch<NBT_Format::BigEndian, true>(IptStream, *pNode, eEntry.enTag, szStackDepth - 1, funcInfo)
+				: NBT_Reader::GetSwitch<NBT_Format::BigEndian, false>(IptStream, *pNode, eEntry.enTag, szStackDepth - 1, funcInfo);
+			if (eRet != NBT_Reader::AllOk)
+			{
+				return nullptr;
+			}
+
+			eEntry.pNode = std::move(pNode);
+			return eEntry.pNode.get();
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return nullptr;
+		}
+	}
+
+	NBT_LazyCompound *MaterializeLazy(Entry &eEntry) noexcept
+	{
+		if (eEntry.enTag != NBT_TAG::Compound)
+		{
+			return nullptr;
+		}
+
+		if (eEntry.pLazy != nullptr)
+		{
+			return eEntry.pLazy.get();
+		}
+
+		StoredInfo &funcInfo = funcStoredInfo;
+		try
+		{
+			auto pLazy = std::make_unique<NBT_LazyCompound>();
+			pLazy->pOwner = pOwner;
+			pLazy->funcStoredInfo = funcStoredInfo;
+			pLazy->spanData = spanData;
+			pLazy->szStackDepth = szStackDepth - 1;
+			pLazy->bUnwrapMixedList = bUnwrapMixedList;
+
+			if (!pLazy->BuildIndex<false>(eEntry.szValueBeg, eEntry.szValueEnd, funcInfo))
+			{
+				return nullptr;
+			}
+
+			eEntry.pLazy = std::move(pLazy);
+			return eEntry.pLazy.get();
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return nullptr;
+		}
+	}
+
+public:
+	/// @brief 默认构造，得到一个空集合
+	NBT_LazyCompound(void) = default;
+	/// @brief 默认析构
+	~NBT_LazyCompound(void) = default;
+	/// @brief 禁止拷贝构造
+	NBT_LazyCompound(const NBT_LazyCompound &) = delete;
+	/// @brief 移动构造
+	NBT_LazyCompound(NBT_LazyCompound &&) = default;
+	/// @brief 禁止拷贝赋值
+	NBT_LazyCompound &operator=(const NBT_LazyCompound &) = delete;
+	/// @brief 移动赋值
+	NBT_LazyCompound &operator=(NBT_LazyCompound &&) = default;
+
+	/// @brief 取得字节流的所有权并建立索引
+	/// @tparam bUnwrapMixedList_ 是否解包混合列表，请参考NBT_Reader::ReadNBT的说明
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param vData NBT二进制数据，对象会持有这份数据直到销毁或重新解析
+	/// @param szStartIdx 数据起始索引，会忽略vData中前szStartIdx字节的数据
+	/// @param _szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数，会复制一份保存，之后按需反序列化（包括所有子集合）的错误信息同样由它输出
+	/// @return 成功返回true，失败返回false，失败时对象为空
+	/// @note 与NBT_Reader::ReadNBT一样，数据被视作一个无名的根集合，直到数据末尾或遇到End标签为止。
+	/// 所有条目的值都会在解析时完整跳过一次以校验格式，但不会分配任何NBT对象。
+	template<bool bUnwrapMixedList_ = true, typename InfoFunc = NBT_Print>
+	bool Parse(std::vector<uint8_t> vData, size_t szStartIdx = 0, size_t _szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		Clear();
+		try
+		{
+			pOwner = std::make_shared<const std::vector<uint8_t>>(std::move(vData));
+			funcStoredInfo = StoredInfo::Make(funcInfo);
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+
+		spanData = std::span<const uint8_t>(pOwner->data(), pOwner->size());
+		szStackDepth = _szStackDepth;
+		bUnwrapMixedList = bUnwrapMixedList_;
+
+		if (!ParseImpl<true>(szStartIdx, funcInfo))
+		{
+			Clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	/// @brief 引用调用者的字节流并建立索引
+	/// @tparam bUnwrapMixedList_ 是否解包混合列表，请参考NBT_Reader::ReadNBT的说明
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param _spanData NBT二进制数据，调用者需要保证在本对象（以及得到的所有子集合）销毁或重新解析之前数据有效且不被修改
+	/// @param szStartIdx 数据起始索引，会忽略前szStartIdx字节的数据
+	/// @param _szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数，会复制一份保存，之后按需反序列化（包括所有子集合）的错误信息同样由它输出
+	/// @return 成功返回true，失败返回false，失败时对象为空
+	/// @note 适合数据已经位于内存映射（NBT_IO::MappedFile）或其它长期存在的缓冲区中的情况，其它行为与Parse相同。
+	template<bool bUnwrapMixedList_ = true, typename InfoFunc = NBT_Print>
+	bool ParseBorrowed(std::span<const uint8_t> _spanData, size_t szStartIdx = 0, size_t _szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		Clear();
+		try
+		{
+			funcStoredInfo = StoredInfo::Make(funcInfo);
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+
+		spanData = _spanData;
+		szStackDepth = _szStackDepth;
+		bUnwrapMixedList = bUnwrapMixedList_;
+
+		if (!ParseImpl<true>(szStartIdx, funcInfo))
+		{
+			Clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	/// @brief 清空对象，释放索引、缓存与持有的字节流
+	void Clear(void) noexcept
+	{
+		vEntry.clear();
+		spanData = {};
+		pOwner.reset();
+		funcStoredInfo = {};
+		szStackDepth = 0;
+	}
+
+	/// @brief 获取条目数量
+	/// @return 条目数量（包括同名条目）
+	size_t Size(void) const noexcept
+	{
+		return vEntry.size();
+	}
+
+	/// @brief 检查是否为空
+	/// @return 没有任何条目时返回true
+	bool Empty(void) const noexcept
+	{
+		return vEntry.empty();
+	}
+
+	/// @brief 检查是否包含指定标签，不会反序列化
+	/// @param sTagName 要检查的标签名
+	/// @return 如果包含指定标签返回true，否则返回false
+	bool Contains(const NBT_Type::String &sTagName) const noexcept
+	{
+		return FindEntry(sTagName) != NULL;
+	}
+
+	/// @brief 获取指定标签的类型，不会反序列化
+	/// @param sTagName 标签名
+	/// @return 标签的类型，不存在时返回NBT_TAG::End
+	NBT_TAG GetTag(const NBT_Type::String &sTagName) const noexcept
+	{
+		const Entry *pEntry = FindEntry(sTagName);
+		return pEntry != NULL ? pEntry->enTag : NBT_TAG::End;
+	}
+
+	/// @brief 检查指定标签是否已经反序列化
+	/// @param sTagName 标签名
+	/// @return 标签存在且已经通过Get/Has反序列化为NBT_Node时返回true
+	bool IsMaterialized(const NBT_Type::String &sTagName) const noexcept
+	{
+		const Entry *pEntry = FindEntry(sTagName);
+		return pEntry != NULL && pEntry->pNode != nullptr;
+	}
+
+	/// @brief 获取指定标签的值在字节流中的原始数据，不会反序列化
+	/// @param sTagName 标签名
+	/// @return 值的原始二进制数据（不包括类型与名称），不存在时返回空范围
+	/// @note 返回的数据与本对象引用同一份字节流，可以用于原样转发未修改的子树
+	std::span<const uint8_t> GetRawValue(const NBT_Type::String &sTagName) const noexcept
+	{
+		const Entry *pEntry = FindEntry(sTagName);
+		return pEntry != NULL
+			? spanData.subspan(pEntry->szValueBeg, pEntry->szValueEnd - pEntry->szValueBeg)
+			: std::span<const uint8_t>{};
+	}
+
+	/// @brief 根据标签名获取对应的NBT值，首次访问时反序列化
+	/// @param sTagName 要查找的标签名
+	/// @return 标签名对应的值的引用
+	/// @note 如果标签不存在则抛出std::out_of_range，反序列化失败则抛出std::runtime_error
+	NBT_Node &Get(const NBT_Type::String &sTagName)
+	{
+		Entry *pEntry = FindEntry(sTagName);
+		if (pEntry == NULL)
+		{
+			throw std::out_of_range("NBT_LazyCompound::Get: tag name not found");
+		}
+
+		NBT_Node *pNode = MaterializeNode(*pEntry);
+		if (pNode == nullptr)
+		{
+			throw std::runtime_error("NBT_LazyCompound::Get: failed to materialize node");
+		}
+
+		return *pNode;
+	}
+
+	/// @brief 搜索标签是否存在，存在则在首次访问时反序列化
+	/// @param sTagName 要搜索的标签名
+	/// @return 如果找到，则返回指向标签名对应的值的指针，否则（或反序列化失败时）返回nullptr指针
+	NBT_Node *Has(const NBT_Type::String &sTagName) noexcept
+	{
+		Entry *pEntry = FindEntry(sTagName);
+		return pEntry != NULL
+			? MaterializeNode(*pEntry)
+			: nullptr;
+	}
+
+	/// @brief 获取按需解析的子集合
+	/// @param sTagName 标签名
+	/// @return 子集合的引用，子集合与本对象共享字节流
+	/// @note 如果标签不存在或不是集合类型则抛出std::out_of_range，索引失败则抛出std::runtime_error。
+	/// 子集合与Get得到的NBT_Node互相独立，修改其中一个不会影响另一个。
+	NBT_LazyCompound &GetLazyCompound(const NBT_Type::String &sTagName)
+	{
+		Entry *pEntry = FindEntry(sTagName);
+		if (pEntry == NULL || pEntry->enTag != NBT_TAG::Compound)
+		{
+			throw std::out_of_range("NBT_LazyCompound::GetLazyCompound: compound tag not found");
+		}
+
+		NBT_LazyCompound *pLazy = MaterializeLazy(*pEntry);
+		if (pLazy == nullptr)
+		{
+			throw std::runtime_error("NBT_LazyCompound::GetLazyCompound: failed to index compound");
+		}
+
+		return *pLazy;
+	}
+
+	/// @brief 搜索按需解析的子集合
+	/// @param sTagName 标签名
+	/// @return 标签存在且为集合类型时返回子集合的指针，否则（或索引失败时）返回nullptr指针
+	NBT_LazyCompound *HasLazyCompound(const NBT_Type::String &sTagName) noexcept
+	{
+		Entry *pEntry = FindEntry(sTagName);
+		return pEntry != NULL
+			? MaterializeLazy(*pEntry)
+			: nullptr;
+	}
+
+	/// @brief 把所有条目反序列化到一个NBT_Type::Compound中
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param[out] tCompound 用于返回结果的对象，与NBT_Reader::ReadNBT一样不会清空原有数据
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 成功返回true，失败返回false
+	/// @note 已经反序列化的条目会被拷贝，其它条目直接从字节流解析，不会填充本对象的缓存。
+	/// 通过Get得到并修改过的值会反映在结果中。
+	template<typename InfoFunc = NBT_Print>
+	bool Materialize(NBT_Type::Compound &tCompound, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		try
+		{
+			for (const Entry &eEntry : vEntry)
+			{
+				NBT_Type::String sName{};
+				sName.resize(eEntry.szNameSize);
+				memcpy(sName.data(), spanData.data() + eEntry.szNameBeg, eEntry.szNameSize);
+
+				NBT_Node nodeValue{};
+				if (eEntry.pNode != nullptr)
+				{
+					nodeValue = *eEntry.pNode;
+				}
+				else
+				{
+					std::span<const uint8_t> spanRange = spanData.first(eEntry.szValueEnd);
+					InputStream IptStream(spanRange, eEntry.szValueBeg);
+					NBT_Reader::ErrCode eRet = bUnwrapMixedList
+						? NBT_Reader::GetSwitch<NBT_Format::BigEndian, true>(IptStream, nodeValue, eEntry.enTag, szStackDepth - 1, funcInfo)
+						: NBT_Reader::GetSwitch<NBT_Format::BigEndian, false>(IptStream, nodeValue, eEntry.enTag, szStackDepth - 1, funcInfo);
+					if (eRet != NBT_Reader::AllOk)
+					{
+						funcInfo(NBT_Print_Level::Err, "Error: Failed to materialize entry, Type: [NBT_Type::{}].\n", NBT_Type::GetTypeName(eEntry.enTag));
+						return false;
+					}
+				}
+
+				tCompound.Put(std::move(sName), std::move(nodeValue));
+			}
+
+			return true;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			return false;
+		}
+	}
+
+
+//针对每种类型生成一个方便的函数
+//通过宏定义批量生成
+
+/// @def TYPE_GET_FUNC(type)
+/// @brief 不同类型名接口生成宏
+/// @note 用户不应该使用此宏（实际上宏已在使用后取消定义），标注仅为消除doxygen警告
+#define TYPE_GET_FUNC(type)\
+/**
+ @brief 检查是否包含指定标签名的 type 类型数据，不会反序列化
+ @param sTagName 要检查的标签名
+ @return 如果包含指定标签名，且对应的值的类型匹配，则返回true，否则返回false
+ */\
+bool Contains##type(const NBT_Type::String &sTagName) const noexcept\
+{\
+	return GetTag(sTagName) == NBT_TAG::type;\
+}\
+\
+/**
+ @brief 获取指定标签名的 type 类型数据，首次访问时反序列化
+ @param sTagName 标签名
+ @return type 类型数据的引用
+ @note 如果标签不存在、反序列化失败或类型不匹配则抛出异常，具体请参考Get的说明与std::get的说明
+ */\
+typename NBT_Type::type &Get##type(const NBT_Type::String &sTagName)\
+{\
+	return Get(sTagName).Get##type();\
+}\
+\
+/**
+ @brief 安全检查并获取指定标签名的 type 类型数据，首次访问时反序列化
+ @param sTagName 标签名
+ @return 如果存在且对应值的类型为 type 则返回指向数据的指针，否则返回nullptr
+ @note 类型不匹配时不会反序列化
+ */\
+typename NBT_Type::type *Has##type(const NBT_Type::String &sTagName) noexcept\
+{\
+	if (GetTag(sTagName) != NBT_TAG::type)\
+	{\
+		return nullptr;\
+	}\
+	auto *p = Has(sTagName);\
+	return p != nullptr\
+		? p->GetIf##type()\
+		: nullptr;\
+}
+
+	/// @name 针对每种类型提供一个方便使用的函数，由宏批量生成
+	/// @brief 具体作用说明：
+	/// - Contains开头+类型名的函数：只通过索引判断指定标签名是否存在且为指定类型，不会反序列化
+	/// - Get开头+类型名的函数：直接获取指定标签名且对应类型的引用，首次访问时反序列化
+	/// - Has开头 + 类型名的函数：判断指定标签名是否存在，且标签名对应的类型是否是指定类型，都符合则反序列化并返回对应指针，否则返回nullptr指针
+	/// @{
+
+	TYPE_GET_FUNC(Byte);
+	TYPE_GET_FUNC(Short);
+	TYPE_GET_FUNC(Int);
+	TYPE_GET_FUNC(Long);
+	TYPE_GET_FUNC(Float);
+	TYPE_GET_FUNC(Double);
+	TYPE_GET_FUNC(ByteArray);
+	TYPE_GET_FUNC(IntArray);
+	TYPE_GET_FUNC(LongArray);
+	TYPE_GET_FUNC(String);
+	TYPE_GET_FUNC(List);
+	TYPE_GET_FUNC(Compound);
+
+	/// @}
+
+#undef TYPE_GET_FUNC
+};
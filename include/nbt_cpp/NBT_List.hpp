@@ -5,6 +5,11 @@
 #include <type_traits>
 #include <initializer_list>
 #include <stdexcept>
+#include <variant>
+#include <span>
+#include <memory>
+#include <utility>
+#include <algorithm>
 
 #include "NBT_Type.hpp"
 
@@ -17,7 +22,16 @@ class NBT_Helper;
 
 /// @brief 继承自标准库容器的代理类，用于存储和管理NBT列表
 /// @tparam List 继承的父类，也就是std::vector
-/// @note 用户不应自行实例化此类，请使用NBT_Type::List来访问此类实例化类型
+/// @note 用户不应自行实例化此类，请使用NBT_Type::List来访问此类实例化类型。
+/// 
+/// 列表有一种打包状态：元素全部是同一种定长数值类型（Byte、Short、Int、Long、Float、Double）时，
+/// 可以通过Pack或在NBT_PackedListScope作用域内读取，把元素保存在连续的同类型缓冲区中，而不是每个元素一个NBT_Node，
+/// 例如实体的Pos、Motion或者上千个Int组成的列表，内存占用只有元素本身的大小，NBT_Writer也直接从缓冲区批量写出。
+/// 打包状态下，Size、Empty、GetPacked、Clear、ShrinkToFit以及按类型访问的Get、Has、Front、Back系列函数直接访问缓冲区。
+/// 常量接口永远不会展开列表：常量迭代器解引用时为打包的元素临时构造节点，
+/// 而返回节点引用的常量接口（GetData、Get、Has、Front、Back、下标）只能看到节点数组，打包时节点数组为空。
+/// 非常量的节点接口（迭代器、下标、Front、Back、GetData、所有修改接口等）会先把列表展开为普通的节点数组，
+/// 展开后列表不再是打包状态，之前通过GetPacked或按类型访问得到的指针和引用全部失效。
 template <typename List>
 class NBT_List :protected List
 {
@@ -26,6 +40,10 @@ class NBT_List :protected List
 	friend class NBT_Helper;
 	
 public:
+	/// @brief 常量迭代器的前置声明，定义与说明见迭代器接口部分
+	template<bool bReverse>
+	class ConstIterator;
+
 	/// @brief 父类类型
 	using Super = List;
 
@@ -43,19 +61,248 @@ public:
 	using Pointer =					typename List::pointer;					///< 标准库容器公开类型映射
 	using Const_Pointer =			typename List::const_pointer;			///< 标准库容器公开类型映射
 	using Iterator =				typename List::iterator;				///< 标准库容器公开类型映射
-	using Const_Iterator =			typename List::const_iterator;			///< 标准库容器公开类型映射
+	using Const_Iterator =			ConstIterator<false>;					///< 常量迭代器，打包的元素解引用时临时构造节点
 	using Reverse_Iterator =		typename List::reverse_iterator;		///< 标准库容器公开类型映射
-	using Const_Reverse_Iterator =	typename List::const_reverse_iterator;	///< 标准库容器公开类型映射
+	using Const_Reverse_Iterator =	ConstIterator<true>;					///< 常量反向迭代器，打包的元素解引用时临时构造节点
 
 	/// @}
 
+	/// @brief 判断类型是否可以打包保存
+	/// @tparam T 元素类型
+	template<typename T>
+	static constexpr bool IsPackableType_V =
+		std::is_same_v<T, NBT_Type::Byte> ||
+		std::is_same_v<T, NBT_Type::Short> ||
+		std::is_same_v<T, NBT_Type::Int> ||
+		std::is_same_v<T, NBT_Type::Long> ||
+		std::is_same_v<T, NBT_Type::Float> ||
+		std::is_same_v<T, NBT_Type::Double>;
+
+private:
+	template<typename T>
+	using PackedAllocator = typename std::allocator_traits<typename List::allocator_type>::template rebind_alloc<T>;
+
+	template<typename T>
+	using PackedVector = std::vector<T, PackedAllocator<T>>;
+
+	//打包缓冲区，索引顺序与NBT_TAG中Byte到Double的顺序一致
+	using PackedData = std::variant
+	<
+		PackedVector<NBT_Type::Byte>,
+		PackedVector<NBT_Type::Short>,
+		PackedVector<NBT_Type::Int>,
+		PackedVector<NBT_Type::Long>,
+		PackedVector<NBT_Type::Float>,
+		PackedVector<NBT_Type::Double>
+	>;
+
+	//只保存一个指针，不让列表本身（进而NBT_Node）变大；打包时父类数组总是空的
+	PackedData *pPacked = NULL;
+
+	template<typename... Args>
+	PackedData *NewPacked(Args&&... args) const
+	{
+		using Traits = std::allocator_traits<PackedAllocator<PackedData>>;
+
+		PackedAllocator<PackedData> alloc(List::get_allocator());
+		PackedData *pNew = Traits::allocate(alloc, 1);
+		try
+		{
+			Traits::construct(alloc, pNew, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			Traits::deallocate(alloc, pNew, 1);
+			throw;
+		}
+
+		return pNew;
+	}
+
+	void DeletePacked(PackedData *pData) const noexcept
+	{
+		using Traits = std::allocator_traits<PackedAllocator<PackedData>>;
+
+		PackedAllocator<PackedData> alloc(List::get_allocator());
+		Traits::destroy(alloc, pData);
+		Traits::deallocate(alloc, pData, 1);
+	}
+
+	void FreePacked(void) noexcept
+	{
+		if (pPacked != NULL)
+		{
+			DeletePacked(pPacked);
+			pPacked = NULL;
+		}
+	}
+
+	//替换为空的T类型缓冲区，由NBT_Reader在空列表上调用后直接填充
+	template<typename T>
+	PackedVector<T> &EmplacePacked(void)
+	{
+		PackedData *pNew = NewPacked(std::in_place_type<PackedVector<T>>, PackedAllocator<T>(List::get_allocator()));
+		FreePacked();
+		pPacked = pNew;
+		return std::get<PackedVector<T>>(*pPacked);
+	}
+
+	template<typename T>
+	bool PackAs(void)
+	{
+		for (const auto &it : (const List &)*this)
+		{
+			if (it.GetTag() != NBT_Type::TypeTag_V<T>)
+			{
+				return false;
+			}
+		}
+
+		PackedData *pNew = NewPacked(std::in_place_type<PackedVector<T>>, PackedAllocator<T>(List::get_allocator()));
+		try
+		{
+			PackedVector<T> &vPacked = std::get<PackedVector<T>>(*pNew);
+			vPacked.reserve(List::size());
+			for (const auto &it : (const List &)*this)
+			{
+				vPacked.push_back(it.template Get<T>());
+			}
+		}
+		catch (...)
+		{
+			DeletePacked(pNew);
+			throw;
+		}
+
+		//换出节点数组以释放内存，clear不会释放容量
+		List lstEmpty(List::get_allocator());
+		List::swap(lstEmpty);
+		pPacked = pNew;
+		return true;
+	}
+
+	//展开为普通的节点数组，只有reserve可能失败，此时列表保持打包状态
+	//只有非常量接口会调用，常量接口永远不修改列表
+	void Expand(void)
+	{
+		if (pPacked == NULL)
+		{
+			return;
+		}
+
+		List &lstNodes = *this;
+		std::visit([&lstNodes](const auto &vPacked) -> void
+		{
+			lstNodes.reserve(vPacked.size());
+			for (const auto &tValue : vPacked)
+			{
+				lstNodes.emplace_back(tValue);
+			}
+		}, *pPacked);
+
+		FreePacked();
+	}
+
+	List &Nodes(void)
+	{
+		Expand();
+		return *this;
+	}
+
+	template<typename T>
+	const T *PackedAt(typename List::size_type szPos) const noexcept
+	{
+		if constexpr (IsPackableType_V<T>)
+		{
+			if (pPacked != NULL)
+			{
+				const PackedVector<T> *pVector = std::get_if<PackedVector<T>>(pPacked);
+				if (pVector != NULL && szPos < pVector->size())
+				{
+					return &(*pVector)[szPos];
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	template<typename T>
+	T *PackedAt(typename List::size_type szPos) noexcept
+	{
+		return const_cast<T *>(std::as_const(*this).template PackedAt<T>(szPos));
+	}
+
+	//打包时按类型取元素，越界与类型不匹配时抛出与节点数组的at、节点的Get一致的异常
+	template<typename T>
+	const T &PackedGet(typename List::size_type szPos) const
+	{
+		const T *pValue = PackedAt<T>(szPos);
+		if (pValue == nullptr)
+		{
+			if (szPos >= Size())
+			{
+				throw std::out_of_range("NBT_List::Get: index out of range");
+			}
+			throw std::bad_variant_access();
+		}
+
+		return *pValue;
+	}
+
+	template<typename T>
+	T &PackedGet(typename List::size_type szPos)
+	{
+		return const_cast<T &>(std::as_const(*this).template PackedGet<T>(szPos));
+	}
+
+	//以节点访问元素，打包的元素临时构造一个节点，不会展开列表
+	template<typename Func>
+	auto VisitElement(typename List::size_type szPos, Func &&func) const noexcept
+	{
+		if (pPacked == NULL)
+		{
+			return func(List::operator[](szPos));
+		}
+
+		return std::visit([&](const auto &vPacked) noexcept
+		{
+			return func(typename List::value_type(vPacked[szPos]));
+		}, *pPacked);
+	}
+
+	//至少一侧打包时逐个元素比较
+	std::partial_ordering CompareElements(const NBT_List &_Right) const noexcept
+	{
+		typename List::size_type szCommon = std::min(Size(), _Right.Size());
+		for (typename List::size_type i = 0; i < szCommon; ++i)
+		{
+			std::partial_ordering cmp = VisitElement(i, [&](const auto &nodeLeft) noexcept
+			{
+				return _Right.VisitElement(i, [&](const auto &nodeRight) noexcept
+				{
+					return nodeLeft <=> nodeRight;
+				});
+			});
+
+			if (cmp != 0)
+			{
+				return cmp;
+			}
+		}
+
+		return Size() <=> _Right.Size();
+	}
+
 public:
 	//完美转发、初始化列表代理构造
 
 	/// @brief 构造函数
 	/// @tparam Args 变长构造参数类型包
 	/// @param args 变长构造参数列表
+	/// @note 参数为NBT_List自身时不参与重载，由拷贝或移动构造函数处理打包状态
 	template<typename... Args>
+	requires(!(sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, NBT_List> && ...)))
 	NBT_List(Args&&... args) : List(std::forward<Args>(args)...)
 	{}
 
@@ -67,20 +314,32 @@ public:
 	/// @brief 默认构造函数
 	NBT_List(void) = default;
 	/// @brief 析构函数
-	~NBT_List(void) = default;
+	~NBT_List(void)
+	{
+		FreePacked();
+	}
 
 	/// @brief 移动构造函数
 	/// @param _Move 要移动的源对象
-	NBT_List(NBT_List &&_Move) noexcept :List(std::move(_Move))
-	{}
+	NBT_List(NBT_List &&_Move) noexcept :List(std::move(_Move)), pPacked(_Move.pPacked)
+	{
+		_Move.pPacked = NULL;
+	}
 
 	/// @brief 拷贝构造函数
 	/// @param _Copy 要拷贝的源对象
+	/// @note 打包的列表拷贝后仍然是打包的
 	NBT_List(const NBT_List &_Copy) :List(_Copy)
-	{}
+	{
+		if (_Copy.pPacked != NULL)
+		{
+			pPacked = NewPacked(*_Copy.pPacked);
+		}
+	}
 
 	/// @brief 获取底层容器数据的常量引用
 	/// @return 底层容器数据的常量引用
+	/// @note 不会展开列表，打包的列表节点数组为空，请通过GetPacked访问元素
 	const List &GetData(void) const noexcept
 	{
 		return *this;
@@ -88,9 +347,10 @@ public:
 
 	/// @brief 获取底层容器数据的引用
 	/// @return 底层容器数据的引用
-	List &GetData(void) noexcept
+	/// @note 打包的列表会先展开
+	List &GetData(void)
 	{
-		return *this;
+		return Nodes();
 	}
 
 	/// @brief 移动赋值运算符
@@ -98,7 +358,13 @@ public:
 	/// @return 当前对象的引用
 	NBT_List &operator=(NBT_List &&_Move) noexcept
 	{
-		List::operator=(std::move(_Move));
+		if (this != &_Move)
+		{
+			FreePacked();//使用赋值前的分配器释放
+			List::operator=(std::move(_Move));
+			pPacked = _Move.pPacked;
+			_Move.pPacked = NULL;
+		}
 		return *this;
 	}
 
@@ -107,16 +373,45 @@ public:
 	/// @return 当前对象的引用
 	NBT_List &operator=(const NBT_List &_Copy)
 	{
-		List::operator=(_Copy);
+		if (this != &_Copy)
+		{
+			PackedData *pNew = _Copy.pPacked != NULL ? NewPacked(*_Copy.pPacked) : NULL;
+			try
+			{
+				List::operator=(_Copy);
+			}
+			catch (...)
+			{
+				if (pNew != NULL)
+				{
+					DeletePacked(pNew);
+				}
+				throw;
+			}
+
+			FreePacked();
+			pPacked = pNew;
+		}
 		return *this;
 	}
 
 	/// @brief 相等比较运算符
 	/// @param _Right 要比较的右操作数
 	/// @return 是否相等
+	/// @note 打包与否不影响比较结果，也不会展开列表
 	bool operator==(const NBT_List &_Right) const noexcept
 	{
-		return (const List &)*this == (const List &)_Right;
+		if (pPacked == NULL && _Right.pPacked == NULL)
+		{
+			return (const List &)*this == (const List &)_Right;
+		}
+
+		if (pPacked != NULL && _Right.pPacked != NULL)
+		{
+			return *pPacked == *_Right.pPacked;
+		}
+
+		return Size() == _Right.Size() && CompareElements(_Right) == 0;
 	}
 
 	/// @brief 不等比较运算符
@@ -124,30 +419,243 @@ public:
 	/// @return 是否不相等
 	bool operator!=(const NBT_List &_Right) const noexcept
 	{
-		return (const List &)*this != (const List &)_Right;
+		return !(*this == _Right);
 	}
 
 	/// @brief 三路比较运算符
 	/// @param _Right 要比较的右操作数
 	/// @return 比较结果，通过std::partial_ordering返回
+	/// @note 打包与否不影响比较结果，也不会展开列表
 	std::partial_ordering operator<=>(const NBT_List &_Right) const noexcept
 	{
-		return (const List &)*this <=> (const List &)_Right;
+		if (pPacked == NULL && _Right.pPacked == NULL)
+		{
+			return (const List &)*this <=> (const List &)_Right;
+		}
+
+		return CompareElements(_Right);
 	}
 
-	/// @name 暴露父类迭代器接口
-	/// @brief 继承底层容器的迭代器和访问接口
+	/// @brief 常量迭代器
+	/// @tparam bReverse 是否为反向迭代器
+	/// @note 普通列表解引用得到节点数组中元素的引用；打包的列表解引用时在迭代器内临时构造节点，
+	/// 得到的引用在迭代器递增或销毁后失效，所以只满足输入迭代器的要求
+	template<bool bReverse>
+	class ConstIterator
+	{
+		friend class NBT_List;
+
+	public:
+		using iterator_category = std::input_iterator_tag;				///< 迭代器类别
+		using value_type = typename List::value_type;					///< 元素类型
+		using difference_type = typename List::difference_type;			///< 距离类型
+		using pointer = const typename List::value_type *;				///< 元素指针类型
+		using reference = const typename List::value_type &;			///< 元素引用类型
+
+	private:
+		const NBT_List *pList = NULL;
+		typename List::size_type szIndex = 0;//反向迭代器保存当前元素的位置加一，与std::reverse_iterator一致
+		mutable typename List::value_type nodeTemp{};//打包元素的临时节点，只属于当前迭代器
+
+		ConstIterator(const NBT_List *_pList, typename List::size_type _szIndex) noexcept :pList(_pList), szIndex(_szIndex)
+		{}
+
+	public:
+		/// @brief 默认构造函数
+		ConstIterator(void) = default;
+
+		/// @brief 拷贝构造函数，不拷贝临时节点
+		/// @param _Copy 要拷贝的源对象
+		ConstIterator(const ConstIterator &_Copy) noexcept :pList(_Copy.pList), szIndex(_Copy.szIndex)
+		{}
+
+		/// @brief 拷贝赋值运算符，不拷贝临时节点
+		/// @param _Copy 要拷贝的源对象
+		/// @return 当前对象的引用
+		ConstIterator &operator=(const ConstIterator &_Copy) noexcept
+		{
+			pList = _Copy.pList;
+			szIndex = _Copy.szIndex;
+			return *this;
+		}
+
+		/// @brief 解引用
+		/// @return 元素的常量引用，打包的元素返回临时节点的引用
+		reference operator*(void) const noexcept
+		{
+			typename List::size_type szPos = bReverse ? szIndex - 1 : szIndex;
+			if (pList->pPacked == NULL)
+			{
+				return static_cast<const List &>(*pList)[szPos];
+			}
+
+			std::visit([this, szPos](const auto &vPacked) noexcept -> void
+			{
+				nodeTemp = vPacked[szPos];
+			}, *pList->pPacked);
+			return nodeTemp;
+		}
+
+		/// @brief 成员访问
+		/// @return 元素的常量指针，打包的元素返回临时节点的指针
+		pointer operator->(void) const noexcept
+		{
+			return &**this;
+		}
+
+		/// @brief 前置递增
+		/// @return 当前对象的引用
+		ConstIterator &operator++(void) noexcept
+		{
+			if constexpr (bReverse)
+			{
+				--szIndex;
+			}
+			else
+			{
+				++szIndex;
+			}
+			return *this;
+		}
+
+		/// @brief 后置递增
+		/// @return 递增前的迭代器
+		ConstIterator operator++(int) noexcept
+		{
+			ConstIterator itOld(*this);
+			++*this;
+			return itOld;
+		}
+
+		/// @brief 相等比较运算符
+		/// @param _Right 要比较的右操作数
+		/// @return 是否指向同一个位置
+		bool operator==(const ConstIterator &_Right) const noexcept
+		{
+			return pList == _Right.pList && szIndex == _Right.szIndex;
+		}
+	};
+
+	/// @name 迭代器接口
+	/// @brief 非常量迭代器与下标访问会先展开打包的列表，常量迭代器不会展开，详见ConstIterator
 	/// @{
 
-	using List::begin;
-	using List::end;
-	using List::cbegin;
-	using List::cend;
-	using List::rbegin;
-	using List::rend;
-	using List::crbegin;
-	using List::crend;
-	using List::operator[];
+	/// @brief 获取指向开头的迭代器
+	typename List::iterator begin(void) { return Nodes().begin(); }
+	/// @brief 获取指向开头的常量迭代器
+	Const_Iterator begin(void) const noexcept { return Const_Iterator(this, 0); }
+	/// @brief 获取指向末尾的迭代器
+	typename List::iterator end(void) { return Nodes().end(); }
+	/// @brief 获取指向末尾的常量迭代器
+	Const_Iterator end(void) const noexcept { return Const_Iterator(this, Size()); }
+	/// @brief 获取指向开头的常量迭代器
+	Const_Iterator cbegin(void) const noexcept { return begin(); }
+	/// @brief 获取指向末尾的常量迭代器
+	Const_Iterator cend(void) const noexcept { return end(); }
+	/// @brief 获取指向末尾的反向迭代器
+	typename List::reverse_iterator rbegin(void) { return Nodes().rbegin(); }
+	/// @brief 获取指向末尾的常量反向迭代器
+	Const_Reverse_Iterator rbegin(void) const noexcept { return Const_Reverse_Iterator(this, Size()); }
+	/// @brief 获取指向开头的反向迭代器
+	typename List::reverse_iterator rend(void) { return Nodes().rend(); }
+	/// @brief 获取指向开头的常量反向迭代器
+	Const_Reverse_Iterator rend(void) const noexcept { return Const_Reverse_Iterator(this, 0); }
+	/// @brief 获取指向末尾的常量反向迭代器
+	Const_Reverse_Iterator crbegin(void) const noexcept { return rbegin(); }
+	/// @brief 获取指向开头的常量反向迭代器
+	Const_Reverse_Iterator crend(void) const noexcept { return rend(); }
+	/// @brief 下标访问，不检查范围
+	typename List::reference operator[](typename List::size_type szPos) { return Nodes()[szPos]; }
+	/// @brief 下标访问，不检查范围（常量版本），只访问节点数组，打包的列表请使用按类型访问的接口
+	typename List::const_reference operator[](typename List::size_type szPos) const noexcept { return List::operator[](szPos); }
+
+	/// @}
+
+	/// @brief 获取底层容器使用的分配器
+	/// @note 定义CJF2_NBT_CPP_USE_ARENA_ALLOCATOR时可以通过它得到容器所在的内存资源
+	using List::get_allocator;
+
+	/// @name 打包接口
+	/// @brief 定长数值类型列表的打包存储，详见类说明
+	/// @{
+
+	/// @brief 检查列表是否处于打包状态
+	/// @return 打包时返回true
+	bool IsPacked(void) const noexcept
+	{
+		return pPacked != NULL;
+	}
+
+	/// @brief 获取打包元素的类型
+	/// @return 打包元素的类型，列表没有打包时返回NBT_TAG::End
+	NBT_TAG GetPackedTag(void) const noexcept
+	{
+		if (pPacked == NULL)
+		{
+			return NBT_TAG::End;
+		}
+
+		return std::visit([](const auto &vPacked) noexcept -> NBT_TAG
+		{
+			return NBT_Type::TypeTag_V<typename std::decay_t<decltype(vPacked)>::value_type>;
+		}, *pPacked);
+	}
+
+	/// @brief 获取打包的元素（常量版本）
+	/// @tparam T 元素类型
+	/// @return 指向打包缓冲区的视图，列表没有以T类型打包时返回空视图
+	template<typename T>
+	requires IsPackableType_V<T>
+	std::span<const T> GetPacked(void) const noexcept
+	{
+		const PackedVector<T> *pVector = pPacked != NULL ? std::get_if<PackedVector<T>>(pPacked) : NULL;
+		return pVector != NULL ? std::span<const T>(pVector->data(), pVector->size()) : std::span<const T>{};
+	}
+
+	/// @brief 获取打包的元素，可以原地修改元素的值
+	/// @tparam T 元素类型
+	/// @return 指向打包缓冲区的视图，列表没有以T类型打包时返回空视图
+	template<typename T>
+	requires IsPackableType_V<T>
+	std::span<T> GetPacked(void) noexcept
+	{
+		PackedVector<T> *pVector = pPacked != NULL ? std::get_if<PackedVector<T>>(pPacked) : NULL;
+		return pVector != NULL ? std::span<T>(pVector->data(), pVector->size()) : std::span<T>{};
+	}
+
+	/// @brief 尝试把列表转换为打包状态
+	/// @return 转换成功或已经是打包状态时返回true；列表为空，或元素不全是同一种定长数值类型时返回false且列表不变
+	/// @note 内存不足时抛出异常，列表不变
+	bool Pack(void)
+	{
+		if (pPacked != NULL)
+		{
+			return true;
+		}
+
+		if (List::empty())
+		{
+			return false;
+		}
+
+		switch (List::front().GetTag())
+		{
+		case NBT_TAG::Byte:		return PackAs<NBT_Type::Byte>();
+		case NBT_TAG::Short:	return PackAs<NBT_Type::Short>();
+		case NBT_TAG::Int:		return PackAs<NBT_Type::Int>();
+		case NBT_TAG::Long:		return PackAs<NBT_Type::Long>();
+		case NBT_TAG::Float:	return PackAs<NBT_Type::Float>();
+		case NBT_TAG::Double:	return PackAs<NBT_Type::Double>();
+		default:				return false;
+		}
+	}
+
+	/// @brief 把打包的列表展开为普通的节点数组，没有打包时什么也不做
+	/// @note 内存不足时抛出异常，列表保持打包状态
+	void Unpack(void)
+	{
+		Expand();
+	}
 
 	/// @}
 
@@ -161,13 +669,14 @@ public:
 	/// @note 如果位置不存在则抛出异常，请参考std::vector对于at的描述
 	typename List::value_type &Get(const typename List::size_type &szPos)
 	{
-		return List::at(szPos);
+		return Nodes().at(szPos);
 	}
 
 	/// @brief 根据位置获取值（常量版本）
 	/// @param szPos 要查找的位置
 	/// @return 位置对应的值的常量引用
-	/// @note 如果位置不存在则抛出异常，请参考std::vector对于at的描述
+	/// @note 如果位置不存在则抛出异常，请参考std::vector对于at的描述。
+	/// 不会展开列表，打包的列表没有节点，总是抛出异常，请使用按类型访问的接口
 	const typename List::value_type &Get(const typename List::size_type &szPos) const
 	{
 		return List::at(szPos);
@@ -176,16 +685,18 @@ public:
 	/// @brief 根据位置查找值
 	/// @param szPos 要查找的位置
 	/// @return 位置对应的值的指针，如果值不存在则为nullptr
-	typename List::value_type *Has(const typename List::size_type &szPos) noexcept
+	typename List::value_type *Has(const typename List::size_type &szPos)
 	{
-		return szPos < List::size()
-			? &List::operator[](szPos)
+		List &lstNodes = Nodes();
+		return szPos < lstNodes.size()
+			? &lstNodes[szPos]
 			: nullptr;
 	}
 
 	/// @brief 根据位置查找值（常量版本）
 	/// @param szPos 要查找的位置
 	/// @return 位置对应的值的指针，如果值不存在则为nullptr
+	/// @note 不会展开列表，打包的列表没有节点，总是返回nullptr，请使用按类型访问的接口
 	const typename List::value_type *Has(const typename List::size_type &szPos) const noexcept
 	{
 		return szPos < List::size()
@@ -196,14 +707,15 @@ public:
 	/// @brief 获取列表开头的元素
 	/// @return 开头的元素的引用
 	/// @note 如果当前列表为空，行为未定义，请参考std::vector对于front的描述
-	typename List::value_type &Front(void) noexcept
+	typename List::value_type &Front(void)
 	{
-		return List::front();
+		return Nodes().front();
 	}
 
 	/// @brief 获取列表开头的元素（常量版本）
 	/// @return 开头的元素的常量引用
-	/// @note 如果当前列表为空，行为未定义，请参考std::vector对于front的描述
+	/// @note 如果当前列表为空，行为未定义，请参考std::vector对于front的描述。
+	/// 不会展开列表，打包的列表没有节点，请使用按类型访问的接口
 	const typename List::value_type &Front(void) const noexcept
 	{
 		return List::front();
@@ -212,14 +724,15 @@ public:
 	/// @brief 获取列表最后的元素
 	/// @return 最后的元素的引用
 	/// @note 如果当前列表为空，行为未定义，请参考std::vector对于back的描述
-	typename List::value_type &Back(void) noexcept
+	typename List::value_type &Back(void)
 	{
-		return List::back();
+		return Nodes().back();
 	}
 
 	/// @brief 获取列表最后的元素（常量版本）
 	/// @return 最后的元素的引用
-	/// @note 如果当前列表为空，行为未定义，请参考std::vector对于back的描述
+	/// @note 如果当前列表为空，行为未定义，请参考std::vector对于back的描述。
+	/// 不会展开列表，打包的列表没有节点，请使用按类型访问的接口
 	const typename List::value_type &Back(void) const noexcept
 	{
 		return List::back();
@@ -229,6 +742,7 @@ public:
 
 	/// @name 修改接口
 	/// @brief 提供一组接口用于对list进行元素编辑
+	/// @note 打包的列表会先展开
 	/// @{
 	
 	/// @brief 在指定位置的前面插入元素
@@ -240,7 +754,8 @@ public:
 	template <typename V>
 	typename List::value_type &Add(typename List::size_type szPos, V &&vTagVal)
 	{
-		return *List::emplace(List::begin() + szPos, std::forward<V>(vTagVal));//插入
+		List &lstNodes = Nodes();
+		return *lstNodes.emplace(lstNodes.begin() + szPos, std::forward<V>(vTagVal));//插入
 	}
 
 	/// @brief 在列表头部插入元素
@@ -250,7 +765,8 @@ public:
 	template <typename V>
 	typename List::value_type &AddFront(V &&vTagVal)
 	{
-		return *List::emplace(List::begin(), std::forward<V>(vTagVal));//插入
+		List &lstNodes = Nodes();
+		return *lstNodes.emplace(lstNodes.begin(), std::forward<V>(vTagVal));//插入
 	}
 
 	/// @brief 在列表末尾插入元素
@@ -260,7 +776,7 @@ public:
 	template <typename V>
 	typename List::value_type &AddBack(V &&vTagVal)
 	{
-		return List::emplace_back(std::forward<V>(vTagVal));
+		return Nodes().emplace_back(std::forward<V>(vTagVal));
 	}
 
 	/// @brief 设置（替换）指定位置的元素
@@ -272,20 +788,22 @@ public:
 	template <typename V>
 	typename List::value_type &Set(typename List::size_type szPos, V &&vTagVal)
 	{
-		return List::operator[](szPos) = std::forward<V>(vTagVal);
+		return Nodes()[szPos] = std::forward<V>(vTagVal);
 	}
 
 	/// @brief 删除指定位置的元素
 	/// @param szPos 要删除的位置
 	void Remove(typename List::size_type szPos)
 	{
-		List::erase(List::begin() + szPos);//这个没必要返回结果，直接丢弃
+		List &lstNodes = Nodes();
+		lstNodes.erase(lstNodes.begin() + szPos);//这个没必要返回结果，直接丢弃
 	}
 
 	/// @brief 清空所有元素
-	/// @note 元素清空后，列表允许直接插入任意类型的元素
+	/// @note 元素清空后，列表允许直接插入任意类型的元素，打包的列表不需要展开
 	void Clear(void)
 	{
+		FreePacked();
 		List::clear();
 	}
 
@@ -293,7 +811,7 @@ public:
 	/// @param szNewSize 新的容器大小
 	void Resize(typename List::size_type szNewSize)
 	{
-		return List::resize(szNewSize);
+		return Nodes().resize(szNewSize);
 	}
 
 	/// @brief 调整容器大小，如果大小大于当前大小，那么使用val填充新增空间，否则删除多余元素
@@ -301,21 +819,25 @@ public:
 	/// @param value （可能）需要重复的元素
 	void Resize(typename List::size_type szNewSize, const typename List::value_type &value)
 	{
-		return List::resize(szNewSize, value);
+		return Nodes().resize(szNewSize, value);
 	}
 
 	/// @brief 拷贝合并另一个NBT_List的内容
 	/// @param _Copy 要合并的源对象
 	void Merge(const NBT_List &_Copy)
 	{
-		List::insert(List::end(), _Copy.begin(), _Copy.end());
+		List &lstNodes = Nodes();
+		lstNodes.reserve(lstNodes.size() + _Copy.Size());
+		lstNodes.insert(lstNodes.end(), _Copy.begin(), _Copy.end());//源列表打包时逐个构造节点，不会展开源列表
 	}
 
 	/// @brief 移动合并另一个NBT_List的内容
 	/// @param _Move 要合并的源对象
 	void Merge(NBT_List &&_Move)
 	{
-		List::insert(List::end(), std::make_move_iterator(_Move.begin()), std::make_move_iterator(_Move.end()));
+		List &lstMove = _Move.Nodes();
+		List &lstNodes = Nodes();
+		lstNodes.insert(lstNodes.end(), std::make_move_iterator(lstMove.begin()), std::make_move_iterator(lstMove.end()));
 	}
 
 	/// @brief 在指定位置插入一个元素（拷贝构造）
@@ -324,7 +846,7 @@ public:
 	/// @return 指向新插入元素的迭代器
 	typename List::iterator Insert(typename List::const_iterator itPos, const typename List::value_type &value)
 	{
-		return List::insert(itPos, value);
+		return Nodes().insert(itPos, value);
 	}
 
 	/// @brief 在指定位置插入一个元素（移动构造）
@@ -333,7 +855,7 @@ public:
 	/// @return 指向新插入元素的迭代器
 	typename List::iterator Insert(typename List::const_iterator itPos, typename List::value_type &&value)
 	{
-		return List::insert(itPos, std::move(value));
+		return Nodes().insert(itPos, std::move(value));
 	}
 
 	/// @brief 在指定位置插入count个相同的元素
@@ -343,7 +865,7 @@ public:
 	/// @return 指向第一个新插入元素的迭代器
 	typename List::iterator Insert(typename List::const_iterator itPos, typename List::size_type szCount, const typename List::value_type &value)
 	{
-		return List::insert(itPos, szCount, value);
+		return Nodes().insert(itPos, szCount, value);
 	}
 
 	/// @brief 在指定位置插入一个范围内的元素
@@ -354,7 +876,7 @@ public:
 	template<typename InputIt>
 	typename List::iterator Insert(typename List::const_iterator itPos, InputIt itFirst, InputIt itLast)
 	{
-		return List::insert(itPos, itFirst, itLast);
+		return Nodes().insert(itPos, itFirst, itLast);
 	}
 
 	/// @brief 在指定位置插入初始化列表中的元素
@@ -363,7 +885,7 @@ public:
 	/// @return 指向第一个新插入元素的迭代器
 	typename List::iterator Insert(typename List::const_iterator itPos, std::initializer_list<typename List::value_type> ilistValue)
 	{
-		return List::insert(itPos, ilistValue);
+		return Nodes().insert(itPos, ilistValue);
 	}
 
 	///@}
@@ -372,35 +894,64 @@ public:
 	/// @return 如果容器为空返回true，否则返回false
 	bool Empty(void) const noexcept
 	{
-		return List::empty();
+		return Size() == 0;
 	}
 
 	/// @brief 获取容器中元素的数量
 	/// @return 容器中元素的数量
 	typename List::size_type Size(void) const noexcept
 	{
+		if (pPacked != NULL)
+		{
+			return std::visit([](const auto &vPacked) noexcept -> typename List::size_type
+			{
+				return vPacked.size();
+			}, *pPacked);
+		}
+
 		return List::size();
 	}
 
 	/// @brief 预留存储空间
 	/// @param szNewCap 新的容量大小
+	/// @note 打包的列表会先展开
 	void Reserve(typename List::size_type szNewCap)
 	{
-		return List::reserve(szNewCap);
+		return Nodes().reserve(szNewCap);
 	}
 
 	/// @brief 缩减容器容量以匹配大小
+	/// @note 打包的列表缩减打包缓冲区的容量，不会展开
 	void ShrinkToFit(void)
 	{
+		if (pPacked != NULL)
+		{
+			std::visit([](auto &vPacked) -> void
+			{
+				vPacked.shrink_to_fit();
+			}, *pPacked);
+			return;
+		}
+
 		return List::shrink_to_fit();
 	}
 
 	/// @brief 检查是否包含指定元素
 	/// @param tValue 要检查的元素
 	/// @return 如果包含指定元素返回true，否则返回false
-	/// @note 与NBT_Compound进行哈希查找不同，这里是通过遍历实现的，请注意开销
+	/// @note 与NBT_Compound进行哈希查找不同，这里是通过遍历实现的，请注意开销。打包的列表直接在缓冲区中查找，不会展开
 	bool Contains(const typename List::value_type &tValue) const noexcept
 	{
+		if (pPacked != NULL)
+		{
+			return std::visit([&tValue](const auto &vPacked) noexcept -> bool
+			{
+				using T = typename std::decay_t<decltype(vPacked)>::value_type;
+				const T *pValue = tValue.template GetIf<T>();
+				return pValue != NULL && std::find(vPacked.begin(), vPacked.end(), *pValue) != vPacked.end();
+			}, *pPacked);
+		}
+
 		return std::find(List::begin(), List::end(), tValue) != List::end();
 	}
 
@@ -408,11 +959,19 @@ public:
 	/// @tparam Predicate 谓词仿函数类型，需要接受value_type并返回bool
 	/// @param pred 谓词仿函数对象
 	/// @return 如果存在满足条件的元素返回true，否则返回false
-	/// @note 与NBT_Compound进行哈希查找不同，这里是通过遍历实现的，请注意开销
+	/// @note 与NBT_Compound进行哈希查找不同，这里是通过遍历实现的，请注意开销。打包的元素逐个临时构造节点传给谓词，不会展开
 	template<typename Predicate>
 	bool ContainsIf(Predicate pred) const noexcept
 	{
-		return std::find_if(List::begin(), List::end(), pred) != List::end();
+		for (typename List::size_type i = 0, szSize = Size(); i < szSize; ++i)
+		{
+			if (VisitElement(i, [&pred](const auto &nodeElement) noexcept -> bool { return pred(nodeElement); }))
+			{
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 /// @def TYPE_GET_FUNC(type)
@@ -424,10 +983,14 @@ public:
  @param szPos 位置索引
  @return type 类型数据的常量引用
  @note 如果位置不存在或类型不匹配则抛出异常，
- 具体请参考std::vector关于at的说明与std::get的说明
+ 具体请参考std::vector关于at的说明与std::get的说明。打包的列表直接返回缓冲区中的元素，不会展开
  */\
 const typename NBT_Type::type &Get##type(const typename List::size_type &szPos) const\
 {\
+	if (pPacked != NULL)\
+	{\
+		return PackedGet<typename NBT_Type::type>(szPos);\
+	}\
 	return List::at(szPos).Get##type();\
 }\
 \
@@ -436,10 +999,14 @@ const typename NBT_Type::type &Get##type(const typename List::size_type &szPos)
  @param szPos 位置索引
  @return type 类型数据的引用
  @note 如果位置不存在或类型不匹配则抛出异常，
- 具体请参考std::vector关于at的说明与std::get的说明
+ 具体请参考std::vector关于at的说明与std::get的说明。打包的列表直接返回缓冲区中的元素，不会展开
  */\
 typename NBT_Type::type &Get##type(const typename List::size_type &szPos)\
 {\
+	if (pPacked != NULL)\
+	{\
+		return PackedGet<typename NBT_Type::type>(szPos);\
+	}\
 	return List::at(szPos).Get##type();\
 }\
 \
@@ -450,9 +1017,12 @@ typename NBT_Type::type &Get##type(const typename List::size_type &szPos)\
  */\
 const typename NBT_Type::type *Has##type(const typename List::size_type &szPos) const noexcept\
 {\
-	auto *p = Has(szPos);\
-	return p != nullptr\
-		? p->GetIf##type()\
+	if (pPacked != NULL)\
+	{\
+		return PackedAt<typename NBT_Type::type>(szPos);\
+	}\
+	return szPos < List::size()\
+		? List::operator[](szPos).GetIf##type()\
 		: nullptr;\
 }\
 \
@@ -463,9 +1033,12 @@ const typename NBT_Type::type *Has##type(const typename List::size_type &szPos)
  */\
 typename NBT_Type::type *Has##type(const typename List::size_type &szPos) noexcept\
 {\
-	auto *p = Has(szPos);\
-	return p != nullptr\
-		? p->GetIf##type()\
+	if (pPacked != NULL)\
+	{\
+		return PackedAt<typename NBT_Type::type>(szPos);\
+	}\
+	return szPos < List::size()\
+		? List::operator[](szPos).GetIf##type()\
 		: nullptr;\
 }\
 \
@@ -473,10 +1046,14 @@ typename NBT_Type::type *Has##type(const typename List::size_type &szPos) noexce
  @brief 获取列表第一个 type 类型数据（常量版本）
  @return type 类型数据的常量引用
  @note 如果列表为空则行为未定义，类型不匹配则抛出异常，
- 具体请参考std::vector关于front的说明与std::get的说明
+ 具体请参考std::vector关于front的说明与std::get的说明。打包的列表直接返回缓冲区中的元素，不会展开
  */\
 const typename NBT_Type::type &Front##type(void) const\
 {\
+	if (pPacked != NULL)\
+	{\
+		return PackedGet<typename NBT_Type::type>(0);\
+	}\
 	return List::front().Get##type();\
 }\
 \
@@ -484,10 +1061,14 @@ const typename NBT_Type::type &Front##type(void) const\
  @brief 获取列表第一个 type 类型数据
  @return type 类型数据的引用
  @note 如果列表为空则行为未定义，类型不匹配则抛出异常，
- 具体请参考std::vector关于front的说明与std::get的说明
+ 具体请参考std::vector关于front的说明与std::get的说明。打包的列表直接返回缓冲区中的元素，不会展开
  */\
 typename NBT_Type::type &Front##type(void)\
 {\
+	if (pPacked != NULL)\
+	{\
+		return PackedGet<typename NBT_Type::type>(0);\
+	}\
 	return List::front().Get##type();\
 }\
 \
@@ -498,7 +1079,9 @@ typename NBT_Type::type &Front##type(void)\
  */\
 const typename NBT_Type::type *FrontIf##type(void) const\
 {\
-	return List::front().GetIf##type();\
+	return pPacked != NULL\
+		? PackedAt<typename NBT_Type::type>(0)\
+		: List::front().GetIf##type();\
 }\
 \
 /**
@@ -508,17 +1091,23 @@ const typename NBT_Type::type *FrontIf##type(void) const\
  */\
 typename NBT_Type::type *FrontIf##type(void)\
 {\
-	return List::front().GetIf##type();\
+	return pPacked != NULL\
+		? PackedAt<typename NBT_Type::type>(0)\
+		: List::front().GetIf##type();\
 }\
 \
 /**
  @brief 获取列表最后一个 type 类型数据（常量版本）
  @return type 类型数据的常量引用
  @note 如果列表为空则行为未定义，类型不匹配则抛出异常，
- 具体请参考std::vector关于back的说明与std::get的说明
+ 具体请参考std::vector关于back的说明与std::get的说明。打包的列表直接返回缓冲区中的元素，不会展开
  */\
 const typename NBT_Type::type &Back##type(void) const\
 {\
+	if (pPacked != NULL)\
+	{\
+		return PackedGet<typename NBT_Type::type>(Size() - 1);\
+	}\
 	return List::back().Get##type();\
 }\
 \
@@ -526,10 +1115,14 @@ const typename NBT_Type::type &Back##type(void) const\
  @brief 获取列表最后一个 type 类型数据
  @return type 类型数据的引用
  @note 如果列表为空则行为未定义，类型不匹配则抛出异常，
- 具体请参考std::vector关于back的说明与std::get的说明
+ 具体请参考std::vector关于back的说明与std::get的说明。打包的列表直接返回缓冲区中的元素，不会展开
  */\
 typename NBT_Type::type &Back##type(void)\
 {\
+	if (pPacked != NULL)\
+	{\
+		return PackedGet<typename NBT_Type::type>(Size() - 1);\
+	}\
 	return List::back().Get##type();\
 }\
 \
@@ -540,7 +1133,9 @@ typename NBT_Type::type &Back##type(void)\
  */\
 const typename NBT_Type::type *BackIf##type(void) const\
 {\
-	return List::back().GetIf##type();\
+	return pPacked != NULL\
+		? PackedAt<typename NBT_Type::type>(Size() - 1)\
+		: List::back().GetIf##type();\
 }\
 \
 /**
@@ -550,7 +1145,9 @@ const typename NBT_Type::type *BackIf##type(void) const\
  */\
 typename NBT_Type::type *BackIf##type(void)\
 {\
-	return List::back().GetIf##type();\
+	return pPacked != NULL\
+		? PackedAt<typename NBT_Type::type>(Size() - 1)\
+		: List::back().GetIf##type();\
 }
 
  /// @name 针对每种类型提供一个方便使用的函数，由宏批量生成
@@ -701,3 +1298,50 @@ typename List::value_type &Set##type(typename List::size_type szPos, typename NB
 
 #undef TYPE_PUT_FUNC
 };
+
+/// @brief 作用域内NBT_Reader把当前线程读取的定长数值类型列表直接解码为打包状态，离开作用域时恢复
+/// @note 打包状态的说明请参考NBT_List。只有非空且元素为Byte、Short、Int、Long、Float、Double的列表会被打包。例如：
+/// @code
+/// NBT_Type::Compound cpd;
+/// {
+/// 	NBT_PackedListScope plsScope{};
+/// 	NBT_Reader::ReadNBT(vData, 0, cpd);
+/// }
+/// std::span<const NBT_Type::Double> spanPos = cpd.GetCompound(MU8STR("")).GetList(MU8STR("Pos")).GetPacked<NBT_Type::Double>();
+/// @endcode
+class NBT_PackedListScope
+{
+private:
+	static inline thread_local bool bCurrent = false;
+	bool bOld;
+
+public:
+	/// @brief 构造并设置当前线程是否打包读取
+	/// @param bPack 是否打包读取，传入false可以在嵌套的作用域内临时关闭
+	NBT_PackedListScope(bool bPack = true) noexcept :bOld(bCurrent)
+	{
+		bCurrent = bPack;
+	}
+
+	/// @brief 析构并恢复之前的设置
+	~NBT_PackedListScope(void) noexcept
+	{
+		bCurrent = bOld;
+	}
+
+	/// @brief 禁止拷贝构造
+	NBT_PackedListScope(const NBT_PackedListScope &) = delete;
+	/// @brief 禁止移动构造
+	NBT_PackedListScope(NBT_PackedListScope &&) = delete;
+	/// @brief 禁止拷贝赋值
+	NBT_PackedListScope &operator=(const NBT_PackedListScope &) = delete;
+	/// @brief 禁止移动赋值
+	NBT_PackedListScope &operator=(NBT_PackedListScope &&) = delete;
+
+	/// @brief 获取当前线程是否打包读取
+	/// @return 在NBT_PackedListScope作用域内返回构造时的设置，否则返回false
+	static bool GetCurrent(void) noexcept
+	{
+		return bCurrent;
+	}
+};
@@ -0,0 +1,893 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <string>//std::string
+#include <string_view>//std::string_view
+#include <vector>//std::vector
+#include <memory>//std::unique_ptr
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <utility>//std::move
+
+#include "NBT_Print.hpp"//打印输出
+#include "NBT_Node.hpp"//nbt类型
+#include "NBT_Visitor.hpp"//访问器
+
+/// @file
+/// @brief NBT路径表达式与按路径提取数据的访问器
+
+
+/// @brief 编译后的NBT路径表达式
+/// @note 路径由若干步组成，每一步匹配集合中的一个条目或列表中的一个元素：
+/// - 名称：直接书写，如Level、xPos，名称中不能包含 . [ ] < > " 与空白字符，否则需要用双引号括起，如"minecraft:stone"，
+/// 引号内可以用\\"与\\\\转义，空名称写作""
+/// - 任意名称：*，匹配集合中的所有条目
+/// - 列表下标：[n]，匹配列表中下标为n（从0开始）的元素
+/// - 任意下标：[*]，匹配列表中的所有元素
+/// - 类型过滤：在任意一步后追加<类型名>，只匹配对应类型的值，类型名与NBT_Type::GetTypeName一致，如<Int>、<LongArray>
+///
+/// 名称之间用.分隔，下标直接跟在前一步之后。路径从NBT_Reader::ReadNBT所说的默认根开始，
+/// 所以标准的区块文件（根部是一个无名Compound）中的路径需要以""开头，例如：
+/// @code
+/// "".Level.xPos
+/// "".sections[*].block_states.data<LongArray>
+/// "".sections[0].Y
+/// "".*<Int>
+/// @endcode
+class NBT_Path
+{
+public:
+	/// @brief 路径步的类型
+	enum class StepType : uint8_t
+	{
+		Name,		///< 匹配指定名称的集合条目
+		AnyName,	///< 匹配任意集合条目
+		Index,		///< 匹配指定下标的列表元素
+		AnyIndex,	///< 匹配任意列表元素
+	};
+
+	/// @brief 路径中的一步
+	struct Step
+	{
+		StepType enType = StepType::Name;		///< 步的类型
+		NBT_TAG enFilter = NBT_TAG::ENUM_END;	///< 类型过滤，NBT_TAG::ENUM_END表示不过滤
+		size_t szIndex = 0;						///< 列表下标，仅StepType::Index有效
+		NBT_Type::String sName{};				///< 条目名称，仅StepType::Name有效
+
+		/// @brief 检查是否匹配集合条目的步
+		/// @return 是集合条目的步返回true，否则返回false
+		bool IsCompoundStep(void) const noexcept
+		{
+			return enType == StepType::Name || enType == StepType::AnyName;
+		}
+
+		/// @brief 检查值的类型是否满足类型过滤
+		/// @param enTag 值的类型
+		/// @return 满足返回true，否则返回false
+		bool AcceptTag(NBT_TAG enTag) const noexcept
+		{
+			return enFilter == NBT_TAG::ENUM_END || enFilter == enTag;
+		}
+	};
+
+private:
+	std::vector<Step> vStep{};
+	std::string strSource{};
+
+private:
+	static bool IsBareNameChar(char c) noexcept
+	{
+		switch (c)
+		{
+		case '.':
+		case '[':
+		case ']':
+		case '<':
+		case '>':
+		case '"':
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			return false;
+		default:
+			return true;
+		}
+	}
+
+	template<typename InfoFunc>
+	bool ParseFilter(std::string_view svPath, size_t &szPos, Step &stStep, InfoFunc &funcInfo) const
+	{
+		if (szPos >= svPath.size() || svPath[szPos] != '<')
+		{
+			return true;//没有过滤
+		}
+
+		size_t szEnd = svPath.find('>', szPos);
+		if (szEnd == std::string_view::npos)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Unterminated type filter at position [{}] in path \"{}\".\n", szPos, svPath);
+			return false;
+		}
+
+		std::string_view svType = svPath.substr(szPos + 1, szEnd - szPos - 1);
+		for (NBT_TAG_RAW_TYPE i = 0; i < (NBT_TAG_RAW_TYPE)NBT_TAG::ENUM_END; ++i)
+		{
+			if (svType == NBT_Type::GetTypeName((NBT_TAG)i))
+			{
+				stStep.enFilter = (NBT_TAG)i;
+				szPos = szEnd + 1;
+				return true;
+			}
+		}
+
+		funcInfo(NBT_Print_Level::Err, "Error: Unknown type name \"{}\" at position [{}] in path \"{}\".\n", svType, szPos + 1, svPath);
+		return false;
+	}
+
+	template<typename InfoFunc>
+	bool ParseName(std::string_view svPath, size_t &szPos, Step &stStep, InfoFunc &funcInfo) const
+	{
+		if (szPos >= svPath.size())
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Expected a name at the end of path \"{}\".\n", svPath);
+			return false;
+		}
+
+		if (svPath[szPos] == '"')//引号名称
+		{
+			std::string strName{};
+			size_t i = szPos + 1;
+			for (; i < svPath.size() && svPath[i] != '"'; ++i)
+			{
+				if (svPath[i] == '\\')
+				{
+					if (i + 1 >= svPath.size() || (svPath[i + 1] != '"' && svPath[i + 1] != '\\'))
+					{
+						funcInfo(NBT_Print_Level::Err, "Error: Invalid escape at position [{}] in path \"{}\".\n", i, svPath);
+						return false;
+					}
+					++i;
+				}
+				strName.push_back(svPath[i]);
+			}
+
+			if (i >= svPath.size())
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Unterminated quoted name at position [{}] in path \"{}\".\n", szPos, svPath);
+				return false;
+			}
+
+			stStep.enType = StepType::Name;
+			stStep.sName = NBT_Type::String(std::string_view(strName));
+			szPos = i + 1;
+			return true;
+		}
+
+		size_t szEnd = szPos;
+		while (szEnd < svPath.size() && IsBareNameChar(svPath[szEnd]))
+		{
+			++szEnd;
+		}
+
+		if (szEnd == szPos)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Expected a name at position [{}] in path \"{}\".\n", szPos, svPath);
+			return false;
+		}
+
+		std::string_view svName = svPath.substr(szPos, szEnd - szPos);
+		if (svName == "*")
+		{
+			stStep.enType = StepType::AnyName;
+		}
+		else
+		{
+			stStep.enType = StepType::Name;
+			stStep.sName = NBT_Type::String(svName);
+		}
+
+		szPos = szEnd;
+		return true;
+	}
+
+	template<typename InfoFunc>
+	bool ParseIndex(std::string_view svPath, size_t &szPos, Step &stStep, InfoFunc &funcInfo) const
+	{
+		size_t szEnd = svPath.find(']', szPos);
+		if (szEnd == std::string_view::npos)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Unterminated index at position [{}] in path \"{}\".\n", szPos, svPath);
+			return false;
+		}
+
+		std::string_view svIndex = svPath.substr(szPos + 1, szEnd - szPos - 1);
+		if (svIndex == "*")
+		{
+			stStep.enType = StepType::AnyIndex;
+		}
+		else
+		{
+			if (svIndex.empty() || svIndex.size() > 10)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Invalid index \"{}\" at position [{}] in path \"{}\".\n", svIndex, szPos + 1, svPath);
+				return false;
+			}
+
+			size_t szIndex = 0;
+			for (char c : svIndex)
+			{
+				if (c < '0' || c > '9')
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Invalid index \"{}\" at position [{}] in path \"{}\".\n", svIndex, szPos + 1, svPath);
+					return false;
+				}
+				szIndex = szIndex * 10 + (size_t)(c - '0');
+			}
+
+			stStep.enType = StepType::Index;
+			stStep.szIndex = szIndex;
+		}
+
+		szPos = szEnd + 1;
+		return true;
+	}
+
+public:
+	/// @brief 默认构造，得到一个空路径
+	NBT_Path(void) = default;
+	/// @brief 默认析构
+	~NBT_Path(void) = default;
+	/// @brief 默认拷贝构造
+	NBT_Path(const NBT_Path &) = default;
+	/// @brief 默认移动构造
+	NBT_Path(NBT_Path &&) = default;
+	/// @brief 默认拷贝赋值
+	NBT_Path &operator=(const NBT_Path &) = default;
+	/// @brief 默认移动赋值
+	NBT_Path &operator=(NBT_Path &&) = default;
+
+	/// @brief 编译路径表达式
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param svPath UTF-8编码的路径表达式，语法请参考类的说明
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 成功返回true，失败返回false，失败时路径为空
+	template<typename InfoFunc = NBT_Print>
+	bool Compile(std::string_view svPath, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		vStep.clear();
+		strSource.clear();
+
+		try
+		{
+			size_t szPos = 0;
+			bool bFirst = true;
+			while (szPos < svPath.size() || bFirst)
+			{
+				Step stStep{};
+				if (!bFirst && svPath[szPos] == '[')
+				{
+					if (!ParseIndex(svPath, szPos, stStep, funcInfo))
+					{
+						vStep.clear();
+						return false;
+					}
+				}
+				else
+				{
+					if (!bFirst)
+					{
+						if (svPath[szPos] != '.')
+						{
+							funcInfo(NBT_Print_Level::Err, "Error: Unexpected character '{}' at position [{}] in path \"{}\".\n", svPath[szPos], szPos, svPath);
+							vStep.clear();
+							return false;
+						}
+						++szPos;
+					}
+
+					if (!ParseName(svPath, szPos, stStep, funcInfo))
+					{
+						vStep.clear();
+						return false;
+					}
+				}
+
+				if (!ParseFilter(svPath, szPos, stStep, funcInfo))
+				{
+					vStep.clear();
+					return false;
+				}
+
+				vStep.push_back(std::move(stStep));
+				bFirst = false;
+			}
+
+			strSource = svPath;
+			return true;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			vStep.clear();
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			vStep.clear();
+			return false;
+		}
+	}
+
+	/// @brief 获取所有步
+	/// @return 步的数组
+	const std::vector<Step> &GetSteps(void) const noexcept
+	{
+		return vStep;
+	}
+
+	/// @brief 获取编译时使用的路径表达式
+	/// @return 路径表达式
+	const std::string &GetSource(void) const noexcept
+	{
+		return strSource;
+	}
+
+	/// @brief 获取步数
+	/// @return 步数
+	size_t Size(void) const noexcept
+	{
+		return vStep.size();
+	}
+
+	/// @brief 检查路径是否为空
+	/// @return 为空（未编译或编译失败）返回true
+	bool Empty(void) const noexcept
+	{
+		return vStep.empty();
+	}
+
+	/// @brief 检查路径中是否存在通配符
+	/// @return 存在*或[*]时返回true
+	/// @note 不含通配符的路径最多只会匹配一个值（不考虑同一集合中出现重复名称的异常数据）
+	bool HasWildcard(void) const noexcept
+	{
+		for (const Step &stStep : vStep)
+		{
+			if (stStep.enType == StepType::AnyName || stStep.enType == StepType::AnyIndex)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+
+/// @brief 按路径提取数据的访问器，在一次扫描中同时求值多个NBT_Path
+/// @note 访问器维护每一层嵌套中仍然可能匹配的路径状态，不可能匹配任何路径的条目与元素直接返回NestingControl::Skip，
+/// 由NBT_Scanner跳过而不会读取其内容（集合条目甚至不会读取名称），也不会构建任何NBT_Type::Compound。
+/// 命中的值按路径分别保存为NBT_Node：数值、字符串与数组直接由扫描结果构造，
+/// 命中的集合或列表只会构建这个子树本身。结果在多次扫描之间累积，处理下一个文件之前可以调用ClearResult。
+///
+/// 默认情况下，如果所有路径都不含通配符，则在每个路径都得到一个结果后立刻停止扫描。
+/// 例如：
+/// @code
+/// NBT_Visitor_PathQuery vqQuery;
+/// size_t szPosX = vqQuery.AddPath("\"\".xPos");
+/// size_t szData = vqQuery.AddPath("\"\".sections[*].block_states.data<LongArray>");
+/// NBT_Scanner::ScanNBT(vData, 0, vqQuery);
+/// for (const NBT_Node &node : vqQuery.ViewResult(szData))
+/// {
+/// 	const NBT_Type::LongArray &laData = node.GetLongArray();
+/// }
+/// @endcode
+class NBT_Visitor_PathQuery
+{
+protected:
+	/// @brief 路径状态：路径下标与下一步要匹配的步下标
+	struct State
+	{
+		uint32_t u32Path;	///< 路径下标
+		uint32_t u32Step;	///< 下一步要匹配的步下标
+	};
+
+	/// @brief 正在构建的命中子树
+	struct Capture
+	{
+		size_t szPath = 0;						///< 路径下标
+		size_t szFrameDepth = 0;				///< 子树开始时的栈深度
+		NBT_Visitor_Collector vcCollector{};	///< 子树收集器
+	};
+
+protected:
+	std::vector<NBT_Path> vPath{};					///< 所有路径
+	std::vector<std::vector<NBT_Node>> vResult{};	///< 每个路径的结果
+	std::vector<size_t> vScanBegin{};				///< 本次扫描开始时每个路径已有的结果数量，用于判断本次扫描是否已经命中
+	std::vector<State> vStatePool{};				///< 所有栈帧的路径状态，按栈帧顺序连续存放
+	std::vector<size_t> vFrame{};					///< 每个栈帧在vStatePool中的起始位置
+	std::vector<State> vPending{};					///< 当前条目或元素匹配后的路径状态
+	std::vector<size_t> vPendingTerminal{};			///< 当前条目或元素完整匹配的路径
+	std::vector<std::unique_ptr<Capture>> vCapture{};	///< 正在构建的命中子树（收集器内部保存了根节点的地址，所以不能移动）
+	bool bStopWhenDone = true;						///< 所有路径都没有通配符时，是否在全部命中后停止
+
+protected:
+	/// @brief 计算当前栈帧中匹配一个条目或元素后的路径状态
+	/// @param enTag 条目或元素的类型
+	/// @param pName 条目名称，为nullptr则表示列表元素
+	/// @param szIndex 列表元素下标
+	void Advance(NBT_TAG enTag, const NBT_Type::String *pName, size_t szIndex)
+	{
+		vPending.clear();
+		vPendingTerminal.clear();
+
+		if (vFrame.empty())
+		{
+			return;
+		}
+
+		for (size_t i = vFrame.back(); i < vStatePool.size(); ++i)
+		{
+			const State &stState = vStatePool[i];
+			const std::vector<NBT_Path::Step> &vStep = vPath[stState.u32Path].GetSteps();
+			const NBT_Path::Step &stStep = vStep[stState.u32Step];
+
+			bool bMatch = false;
+			switch (stStep.enType)
+			{
+			case NBT_Path::StepType::Name:		bMatch = pName != nullptr && *pName == stStep.sName;	break;
+			case NBT_Path::StepType::AnyName:	bMatch = pName != nullptr;								break;
+			case NBT_Path::StepType::Index:		bMatch = pName == nullptr && szIndex == stStep.szIndex;	break;
+			case NBT_Path::StepType::AnyIndex:	bMatch = pName == nullptr;								break;
+			default:																					break;
+			}
+
+			if (!bMatch || !stStep.AcceptTag(enTag))
+			{
+				continue;
+			}
+
+			size_t szNext = (size_t)stState.u32Step + 1;
+			if (szNext == vStep.size())
+			{
+				vPendingTerminal.push_back(stState.u32Path);
+			}
+			else if (enTag == (vStep[szNext].IsCompoundStep() ? NBT_TAG::Compound : NBT_TAG::List))
+			{
+				vPending.push_back(State{ stState.u32Path, (uint32_t)szNext });
+			}
+		}
+	}
+
+	/// @brief 检查当前集合栈帧中是否有路径可能接受指定类型的条目（不需要名称）
+	bool MayAcceptEntryType(NBT_TAG enTag) const noexcept
+	{
+		if (vFrame.empty())
+		{
+			return false;
+		}
+
+		for (size_t i = vFrame.back(); i < vStatePool.size(); ++i)
+		{
+			const State &stState = vStatePool[i];
+			const std::vector<NBT_Path::Step> &vStep = vPath[stState.u32Path].GetSteps();
+			const NBT_Path::Step &stStep = vStep[stState.u32Step];
+
+			if (!stStep.IsCompoundStep() || !stStep.AcceptTag(enTag))
+			{
+				continue;
+			}
+
+			size_t szNext = (size_t)stState.u32Step + 1;
+			if (szNext == vStep.size() || enTag == (vStep[szNext].IsCompoundStep() ? NBT_TAG::Compound : NBT_TAG::List))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// @brief 检查当前列表栈帧中下标大于szIndex的元素是否还可能匹配
+	bool MayAcceptIndexAfter(size_t szIndex) const noexcept
+	{
+		if (vFrame.empty())
+		{
+			return false;
+		}
+
+		for (size_t i = vFrame.back(); i < vStatePool.size(); ++i)
+		{
+			const State &stState = vStatePool[i];
+			const NBT_Path::Step &stStep = vPath[stState.u32Path].GetSteps()[stState.u32Step];
+
+			if (stStep.enType == NBT_Path::StepType::AnyIndex ||
+				(stStep.enType == NBT_Path::StepType::Index && stStep.szIndex > szIndex))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// @brief 检查是否已经可以停止扫描
+	bool IsDone(void) const noexcept
+	{
+		if (!bStopWhenDone || !vCapture.empty() || vPath.empty())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < vPath.size(); ++i)
+		{
+			size_t szBegin = i < vScanBegin.size() ? vScanBegin[i] : 0;
+			if (vPath[i].HasWildcard() || vResult[i].size() <= szBegin)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// @brief 把匹配结果压入新的栈帧，并为完整匹配的路径开始构建子树
+	/// @tparam Func 开始回调的转发函数类型
+	/// @param funcBegin 对收集器调用开始回调的函数
+	template<typename Func>
+	void PushFrame(NBT_TAG enTag, Func funcBegin)
+	{
+		for (size_t szPath : vPendingTerminal)
+		{
+			Capture &stCapture = *vCapture.emplace_back(std::make_unique<Capture>());
+			stCapture.szPath = szPath;
+			stCapture.szFrameDepth = vFrame.size();
+			stCapture.vcCollector.VisitBegin();
+			stCapture.vcCollector.VisitCompoundEntryBegin(enTag, NBT_Type::String{});
+			funcBegin(stCapture.vcCollector);
+		}
+		vPendingTerminal.clear();
+
+		vFrame.push_back(vStatePool.size());
+		vStatePool.insert(vStatePool.end(), vPending.begin(), vPending.end());
+		vPending.clear();
+	}
+
+	/// @brief 弹出栈帧，并完成在此栈帧开始的子树
+	void PopFrame(void)
+	{
+		if (vFrame.empty())
+		{
+			return;
+		}
+
+		vStatePool.resize(vFrame.back());
+		vFrame.pop_back();
+
+		while (!vCapture.empty() && vCapture.back()->szFrameDepth == vFrame.size())
+		{
+			Capture &stCapture = *vCapture.back();
+			NBT_Type::Compound cpdCaptured = stCapture.vcCollector.MoveRoot();
+			vResult[stCapture.szPath].push_back(std::move(cpdCaptured.Get(NBT_Type::String{})));
+			vCapture.pop_back();
+		}
+	}
+
+	/// @brief 把值保存到所有完整匹配的路径的结果中
+	template<typename T>
+	void EmitValue(T &&tVal)
+	{
+		for (size_t i = 0; i < vPendingTerminal.size(); ++i)
+		{
+			if (i + 1 == vPendingTerminal.size())
+			{
+				vResult[vPendingTerminal[i]].emplace_back(std::forward<T>(tVal));
+			}
+			else
+			{
+				vResult[vPendingTerminal[i]].emplace_back(tVal);
+			}
+		}
+		vPendingTerminal.clear();
+		vPending.clear();
+	}
+
+public:
+	NBT_Visitor_PathQuery(void) = default;
+	~NBT_Visitor_PathQuery(void) = default;
+
+	/// @brief 禁用拷贝构造函数
+	NBT_Visitor_PathQuery(const NBT_Visitor_PathQuery &) = delete;
+	/// @brief 默认移动构造函数
+	NBT_Visitor_PathQuery(NBT_Visitor_PathQuery &&) = default;
+	/// @brief 禁用拷贝赋值运算符
+	NBT_Visitor_PathQuery &operator=(const NBT_Visitor_PathQuery &) = delete;
+	/// @brief 默认移动赋值运算符
+	NBT_Visitor_PathQuery &operator=(NBT_Visitor_PathQuery &&) = default;
+
+public:
+	using ResultControl = NBT_Visitor_ResultControl;	///< 控制流返回码（普通回调），直接映射 NBT_Visitor_ResultControl
+	using NestingControl = NBT_Visitor_NestingControl;	///< 控制流返回码（嵌套结构入口回调），直接映射 NBT_Visitor_NestingControl
+
+	/// @brief 添加一个已经编译的路径
+	/// @param pathQuery 路径，空路径不会匹配任何值
+	/// @return 路径下标，用于获取结果
+	size_t AddPath(NBT_Path pathQuery)
+	{
+		vPath.push_back(std::move(pathQuery));
+		vResult.emplace_back();
+		return vPath.size() - 1;
+	}
+
+	/// @brief 编译并添加一个路径
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param svPath 路径表达式，语法请参考NBT_Path的说明
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 路径下标，用于获取结果，编译失败时同样会添加（空路径不会匹配任何值），以保证下标与调用顺序一致
+	template<typename InfoFunc = NBT_Print>
+	size_t AddPath(std::string_view svPath, InfoFunc funcInfo = InfoFunc{})
+	{
+		NBT_Path pathQuery{};
+		pathQuery.Compile(svPath, funcInfo);
+		return AddPath(std::move(pathQuery));
+	}
+
+	/// @brief 获取路径数量
+	/// @return 路径数量
+	size_t GetPathCount(void) const noexcept
+	{
+		return vPath.size();
+	}
+
+	/// @brief 获取路径
+	/// @param szPath 路径下标
+	/// @return 路径的常量引用
+	const NBT_Path &GetPath(size_t szPath) const noexcept
+	{
+		return vPath[szPath];
+	}
+
+	/// @brief 设置所有路径都没有通配符时，是否在全部命中后立刻停止扫描
+	/// @param _bStopWhenDone 为true则提前停止（默认），为false则总是扫描完整个数据
+	void SetStopWhenDone(bool _bStopWhenDone) noexcept
+	{
+		bStopWhenDone = _bStopWhenDone;
+	}
+
+	/// @brief 获取路径的结果
+	/// @param szPath 路径下标
+	/// @return 按出现顺序排列的命中值
+	const std::vector<NBT_Node> &ViewResult(size_t szPath) const noexcept
+	{
+		return vResult[szPath];
+	}
+
+	/// @brief 移动路径的结果（获取所有权）
+	/// @param szPath 路径下标
+	/// @return 按出现顺序排列的命中值的右值引用
+	std::vector<NBT_Node> &&MoveResult(size_t szPath) noexcept
+	{
+		return std::move(vResult[szPath]);
+	}
+
+	/// @brief 清除所有路径的结果，保留路径本身
+	void ClearResult(void) noexcept
+	{
+		for (auto &it : vResult)
+		{
+			it.clear();
+		}
+	}
+
+public:
+	/// @copydoc NBT_Visitor::VisitNumericResult
+	template<typename T>
+	requires(NBT_Type::IsNumericType_V<T>)
+	ResultControl VisitNumericResult(T tNumericResult)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitNumericResult(tNumericResult);
+		}
+
+		EmitValue(tNumericResult);
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitArrayResult
+	template<typename T>
+	requires(NBT_Type::IsArrayType_V<T> && !std::is_reference_v<T>)//防止引用折叠
+	ResultControl VisitArrayResult(T &&tArrayResult)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitArrayResult(T(tArrayResult));
+		}
+
+		EmitValue(std::move(tArrayResult));
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitStringResult
+	ResultControl VisitStringResult(NBT_Type::String &&strResult)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitStringResult(NBT_Type::String(strResult));
+		}
+
+		EmitValue(std::move(strResult));
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitEndResult
+	ResultControl VisitEndResult(void)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitEndResult();
+		}
+
+		EmitValue(NBT_Type::End{});
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitListBegin
+	ResultControl VisitListBegin(NBT_TAG enListElementTag, size_t szListLength)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitListBegin(enListElementTag, szListLength);
+		}
+
+		PushFrame(NBT_TAG::List, [&](NBT_Visitor_Collector &vcCollector) -> void
+			{
+				vcCollector.VisitListBegin(enListElementTag, szListLength);
+			});
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitListElementBegin
+	NestingControl VisitListElementBegin(NBT_TAG enListElementTag, size_t szListIndex)
+	{
+		if (IsDone())
+		{
+			return NestingControl::Stop;
+		}
+
+		Advance(enListElementTag, nullptr, szListIndex);
+		if (!vCapture.empty() || !vPending.empty() || !vPendingTerminal.empty())
+		{
+			return NestingControl::Enter;
+		}
+
+		return MayAcceptIndexAfter(szListIndex)
+			? NestingControl::Skip
+			: NestingControl::Break;
+	}
+
+	/// @copydoc NBT_Visitor::VisitListElementEnd
+	ResultControl VisitListElementEnd(NBT_TAG enListElementTag, size_t szListIndex)
+	{
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitListEnd
+	ResultControl VisitListEnd(void)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitListEnd();
+		}
+
+		PopFrame();
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitCompoundBegin
+	ResultControl VisitCompoundBegin(void)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitCompoundBegin();
+		}
+
+		PushFrame(NBT_TAG::Compound, [&](NBT_Visitor_Collector &vcCollector) -> void
+			{
+				vcCollector.VisitCompoundBegin();
+			});
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitCompoundNextEntryType
+	NestingControl VisitCompoundNextEntryType(NBT_TAG enCompoundEntryTag)
+	{
+		if (IsDone())
+		{
+			return NestingControl::Stop;
+		}
+
+		return !vCapture.empty() || MayAcceptEntryType(enCompoundEntryTag)
+			? NestingControl::Enter
+			: NestingControl::Skip;
+	}
+
+	/// @copydoc NBT_Visitor::VisitCompoundEntryBegin
+	NestingControl VisitCompoundEntryBegin(NBT_TAG enCompoundEntryTag, NBT_Type::String &&sName)
+	{
+		Advance(enCompoundEntryTag, &sName, 0);
+
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitCompoundEntryBegin(enCompoundEntryTag, NBT_Type::String(sName));
+		}
+
+		return !vCapture.empty() || !vPending.empty() || !vPendingTerminal.empty()
+			? NestingControl::Enter
+			: NestingControl::Skip;
+	}
+
+	/// @copydoc NBT_Visitor::VisitCompoundEntryEnd
+	ResultControl VisitCompoundEntryEnd(NBT_TAG enCompoundEntryTag, NBT_Type::String &&sName)
+	{
+		return ResultControl::Continue;
+	}
+
+	/// @copydoc NBT_Visitor::VisitCompoundEnd
+	ResultControl VisitCompoundEnd(void)
+	{
+		for (auto &pCapture : vCapture)
+		{
+			pCapture->vcCollector.VisitCompoundEnd();
+		}
+
+		PopFrame();
+		return ResultControl::Continue;
+	}
+
+	/// @brief 整体扫描开始：初始化根部的路径状态
+	/// @note 不会清除已有结果，多次扫描会累积结果。
+	void VisitBegin(void)
+	{
+		vStatePool.clear();
+		vFrame.clear();
+		vPending.clear();
+		vPendingTerminal.clear();
+		vCapture.clear();
+
+		//结果会在多次扫描之间累积，所以提前停止只看本次扫描新增的结果
+		vScanBegin.clear();
+		for (const auto &it : vResult)
+		{
+			vScanBegin.push_back(it.size());
+		}
+
+		vFrame.push_back(0);
+		for (size_t i = 0; i < vPath.size(); ++i)
+		{
+			if (!vPath[i].Empty())
+			{
+				vStatePool.push_back(State{ (uint32_t)i, 0 });
+			}
+		}
+		return;
+	}
+
+	/// @brief 整体扫描结束
+	void VisitEnd(void)
+	{
+		return;
+	}
+
+	/// @copydoc NBT_Visitor::VisitError
+	template<typename... Args>
+	void VisitError(NBT_Print_Level lvl, const std::format_string<Args...> fmt, Args&&... args) noexcept
+	{
+		NBT_Print{}(lvl, fmt, std::forward<Args>(args)...);
+		return;
+	}
+};
+
+static_assert(IsLookLike_NBT_Visitor<NBT_Visitor_PathQuery>);
@@ -8,11 +8,15 @@
 #include <stdlib.h>//byte swap
 #include <utility>//std::move
 #include <type_traits>//类型约束
+#include <algorithm>//std::min
+#include <optional>//std::optional
 
 #include "NBT_Print.hpp"//打印输出
 #include "NBT_Node.hpp"//nbt类型
 #include "NBT_Endian.hpp"//字节序
+#include "NBT_Format.hpp"//格式策略
 #include "NBT_IO.hpp"//IO流对象
+#include "NBT_KeyPool.hpp"//键驻留池
 
 /// @file
 /// @brief NBT类型二进制反序列化工具
@@ -26,6 +30,9 @@ class NBT_Reader
 	/// @brief 禁止析构
 	~NBT_Reader(void) = delete;
 
+	//按需解析时复用内部的解析与跳过例程
+	friend class NBT_LazyCompound;
+
 protected:
 ///@cond
 	enum ErrCode : uint8_t
@@ -232,10 +239,10 @@ catch(...)\
 	return eRet;\
 }
 
-	//读取大端序数值，bNoCheck为true则不进行任何检查
-	template<bool bNoCheck = false, typename T, typename InputStream, typename InfoFunc>
+	//按格式策略的字节序读取定长数值，bNoCheck为true则不进行任何检查
+	template<typename Format, bool bNoCheck = false, typename T, typename InputStream, typename InfoFunc>
 	requires std::integral<T>
-	static inline std::conditional_t<bNoCheck, void, ErrCode> ReadBigEndian(InputStream &tData, T &tVal, InfoFunc &funcInfo) noexcept
+	static inline std::conditional_t<bNoCheck, void, ErrCode> ReadEndian(InputStream &tData, T &tVal, InfoFunc &funcInfo) noexcept
 	{
 		if constexpr (!bNoCheck)
 		{
@@ -248,9 +255,9 @@ catch(...)\
 			}
 		}
 
-		T BigEndianVal{};
-		tData.GetRange((void *)&BigEndianVal, sizeof(BigEndianVal));
-		tVal = NBT_Endian::BigToNativeAny(BigEndianVal);
+		T RawVal{};
+		tData.GetRange((void *)&RawVal, sizeof(RawVal));
+		tVal = Format::ToNative(RawVal);
 
 		if constexpr (!bNoCheck)
 		{
@@ -258,14 +265,57 @@ catch(...)\
 		}
 	}
 
-	template<typename InputStream, typename InfoFunc>
-	static ErrCode GetName(InputStream &tData, NBT_Type::String &tName, InfoFunc &funcInfo) noexcept
+	//按格式策略读取字段：VarInt字段通过策略解码，其余字段与ReadEndian相同
+	template<typename Format, typename T, typename InputStream, typename InfoFunc>
+	requires std::integral<T>
+	static inline ErrCode ReadValue(InputStream &tData, T &tVal, InfoFunc &funcInfo) noexcept
+	{
+		if constexpr (Format::template bVarIntField<T>)
+		{
+			if (!Format::ReadField(tData, tVal))
+			{
+				ErrCode eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\nVarInt field truncated, too long or out of range, size [{}]", __FUNCTION__,
+					sizeof(T));
+				STACK_TRACEBACK("ReadField Test");
+				return eRet;
+			}
+
+			return AllOk;
+		}
+		else
+		{
+			return ReadEndian<Format>(tData, tVal, funcInfo);
+		}
+	}
+
+	//VarInt格式下的Int与Long数组和列表元素：每个元素至少1字节，先按此检查长度防止恶意长度导致过量分配，再逐个解码
+	template<typename Format, typename T, typename InputStream, typename InfoFunc>
+	static ErrCode GetVarIntElements(InputStream &tData, T *pElements, size_t szCount, InfoFunc &funcInfo) noexcept
+	{
+		for (size_t i = 0; i < szCount; ++i)
+		{
+			if (!Format::ReadField(tData, pElements[i]))
+			{
+				ErrCode eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\nVarInt element truncated or too long, Size: [{}] Index: [{}]", __FUNCTION__,
+					szCount, i);
+				STACK_TRACEBACK("ReadField Test");
+				return eRet;
+			}
+		}
+
+		return AllOk;
+	}
+
+	//pPool不为NULL时表示读取的是集合的键并通过池读取，此时如果键进入了池的查找，则通过pKeyHash返回键的哈希值
+	template<typename Format, typename InputStream, typename InfoFunc>
+	static ErrCode GetName(InputStream &tData, NBT_Type::String &tName, InfoFunc &funcInfo,
+		NBT_KeyPool *pPool = NULL, std::optional<size_t> *pKeyHash = NULL) noexcept
 	{
 	MYTRY;
 		ErrCode eRet = AllOk;
 		//读取2字节的无符号名称长度
 		NBT_Type::StringLength wStringLength = 0;//w->word=2*byte
-		eRet = ReadBigEndian(tData, wStringLength, funcInfo);
+		eRet = ReadValue<Format>(tData, wStringLength, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("wStringLength Read");
@@ -286,6 +336,31 @@ catch(...)\
 			return eRet;
 		}
 		
+		//键池中查找：较短的键先读到栈上，命中时拷贝池中的键，同时得到键的哈希值
+		if (pPool != NULL && szStringLength <= NBT_KeyPool::szMaxKeyLength)
+		{
+			ValueType arrKey[NBT_KeyPool::szMaxKeyLength];
+			tData.GetRange((void *)arrKey, szStringSize);
+
+			size_t szHash = 0;
+			const NBT_Type::String *pKey = pPool->Intern(arrKey, szStringLength, szHash);
+			if (pKey != NULL)
+			{
+				tName = *pKey;
+			}
+			else//池已满
+			{
+				tName.assign(arrKey, szStringLength);
+			}
+
+			if (pKeyHash != NULL)
+			{
+				*pKeyHash = szHash;
+			}
+
+			return eRet;
+		}
+
 		//解析出名称
 		tName.resize(szStringLength);//设置大小
 		tData.GetRange((void *)tName.data(), szStringSize);//构造string（如果长度为0则构造0长字符串，合法行为）
@@ -294,7 +369,7 @@ catch(...)\
 	MYCATCH;
 	}
 
-	template<typename T, typename InputStream, typename InfoFunc>
+	template<typename Format, typename T, typename InputStream, typename InfoFunc>
 	static ErrCode GetBuiltInType(InputStream &tData, T &tBuiltIn, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
@@ -304,7 +379,7 @@ catch(...)\
 
 		//临时存储，因为可能存在跨类型转换
 		RAW_DATA_T tTmpRawData = 0;
-		eRet = ReadBigEndian(tData, tTmpRawData, funcInfo);
+		eRet = ReadValue<Format>(tData, tTmpRawData, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("tTmpRawData Read");
@@ -316,7 +391,7 @@ catch(...)\
 		return eRet;
 	}
 
-	template<typename T, typename InputStream, typename InfoFunc>
+	template<typename Format, typename T, typename InputStream, typename InfoFunc>
 	static ErrCode GetArrayType(InputStream &tData, T &tArray, InfoFunc &funcInfo) noexcept
 	{
 	MYTRY;
@@ -324,7 +399,7 @@ catch(...)\
 
 		//获取4字节有符号数，代表数组元素个数
 		NBT_Type::ArrayLength iArrayLength = 0;//4byte
-		eRet = ReadBigEndian(tData, iArrayLength, funcInfo);
+		eRet = ReadValue<Format>(tData, iArrayLength, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("iArrayLength Read");
@@ -344,38 +419,168 @@ catch(...)\
 		size_t szArrayLength = (size_t)iArrayLength;
 		size_t szArraySize = szArrayLength * sizeof(ValueType);
 
+		//VarInt元素至少1字节
+		constexpr bool bVarIntElement = Format::template bVarIntField<ValueType>;
+		size_t szMinSize = bVarIntElement ? szArrayLength : szArraySize;
+
 		//判断长度是否超过
-		if (!tData.HasAvailData(szArraySize))//保证下方调用安全
+		if (!tData.HasAvailData(szMinSize))//保证下方调用安全
 		{
 			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\n(Index[{}] + szArraySize[{}])[{}] > DataSize[{}]", __FUNCTION__,
-				tData.Index(), szArrayLength, tData.Index() + szArraySize, tData.Size());
+				tData.Index(), szArrayLength, tData.Index() + szMinSize, tData.Size());
 			STACK_TRACEBACK("HasAvailData Test");
 			return eRet;
 		}
+
+		if constexpr (bVarIntElement)
+		{
+			tArray.resize(szArrayLength);
+			eRet = GetVarIntElements<Format>(tData, tArray.data(), szArrayLength, funcInfo);
+			if (eRet != AllOk)
+			{
+				STACK_TRACEBACK("GetVarIntElements Error");
+			}
+			return eRet;
+		}
 		
-		//数组保存
-		tArray.reserve(szArrayLength);//提前扩容
+		//一次性设置大小并批量读取原始数据
+		if (szArrayLength != 0)//空数组的data()可能为空指针，不进行读取
+		{
+			tArray.resize(szArrayLength);
+			tData.GetRange((void *)tArray.data(), szArraySize);//调用需要确保范围安全（已在前面检查）
+
+			//原地批量转换字节序
+			Format::ToNativeArray(tArray.data(), szArrayLength);
+		}
 
-		//读取dElementCount个元素
-		for (size_t i = 0; i < szArrayLength; ++i)
+		return eRet;
+	MYCATCH;
+	}
+
+	//定长数值类型的列表元素：整体检查长度后分块读取并批量转换字节序，再逐个构造节点
+	//在NBT_PackedListScope作用域内则直接追加到列表的打包缓冲区，不构造节点
+	template<typename Format, typename T, typename InputStream, typename InfoFunc>
+	static ErrCode GetNumericListElements(InputStream &tData, NBT_Type::List &tList, size_t szListLength, InfoFunc &funcInfo) noexcept
+	{
+	MYTRY;
+		ErrCode eRet = AllOk;
+
+		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//原始类型映射
+		size_t szListSize = szListLength * sizeof(RAW_DATA_T);
+
+		//VarInt元素至少1字节
+		constexpr bool bVarIntElement = Format::template bVarIntField<RAW_DATA_T>;
+		size_t szMinSize = bVarIntElement ? szListLength : szListSize;
+
+		//判断长度是否超过
+		if (!tData.HasAvailData(szMinSize))//保证下方调用安全
 		{
-			ValueType tTmpData{};
-			ReadBigEndian<true>(tData, tTmpData, funcInfo);//调用需要确保范围安全
-			tArray.emplace_back(std::move(tTmpData));//读取一个插入一个
+			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\n(Index[{}] + szListSize[{}])[{}] > DataSize[{}]", __FUNCTION__,
+				tData.Index(), szMinSize, tData.Index() + szMinSize, tData.Size());
+			STACK_TRACEBACK("HasAvailData Test");
+			return eRet;
+		}
+
+		//长度检查通过后再提前扩容，防止错误的长度导致大量分配
+		auto *pPacked = NBT_PackedListScope::GetCurrent() && szListLength != 0 ? &tList.EmplacePacked<T>() : nullptr;//与Pack一致，空列表不打包
+		if (pPacked != nullptr)
+		{
+			pPacked->reserve(szListLength);
+		}
+		else
+		{
+			tList.reserve(szListLength);
+		}
+
+		constexpr size_t szBufCount = 4096 / sizeof(RAW_DATA_T);//每块4KiB
+		RAW_DATA_T tBuf[szBufCount];
+
+		for (size_t i = 0; i < szListLength; i += szBufCount)
+		{
+			size_t szCurCount = std::min(szBufCount, szListLength - i);
+			if constexpr (bVarIntElement)
+			{
+				eRet = GetVarIntElements<Format>(tData, tBuf, szCurCount, funcInfo);
+				if (eRet != AllOk)
+				{
+					STACK_TRACEBACK("GetVarIntElements Error, Index: [{}]", i);
+					return eRet;
+				}
+			}
+			else
+			{
+				tData.GetRange((void *)tBuf, szCurCount * sizeof(RAW_DATA_T));//调用需要确保范围安全（已在前面检查）
+				Format::ToNativeArray(tBuf, szCurCount);
+			}
+
+			if (pPacked != nullptr)
+			{
+				for (size_t j = 0; j < szCurCount; ++j)
+				{
+					pPacked->push_back(std::bit_cast<T>(tBuf[j]));
+				}
+			}
+			else
+			{
+				for (size_t j = 0; j < szCurCount; ++j)
+				{
+					tList.emplace_back(std::bit_cast<T>(tBuf[j]));
+				}
+			}
 		}
 
 		return eRet;
 	MYCATCH;
 	}
 
+	template<typename Format, typename InputStream, typename InfoFunc>
+	static ErrCode GetNumericListSwitch(InputStream &tData, NBT_Type::List &tList, NBT_TAG enListElementTag, size_t szListLength, InfoFunc &funcInfo) noexcept
+	{
+		switch (enListElementTag)
+		{
+		case NBT_TAG::Byte:		return GetNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Byte>>(tData, tList, szListLength, funcInfo);
+		case NBT_TAG::Short:	return GetNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Short>>(tData, tList, szListLength, funcInfo);
+		case NBT_TAG::Int:		return GetNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Int>>(tData, tList, szListLength, funcInfo);
+		case NBT_TAG::Long:		return GetNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Long>>(tData, tList, szListLength, funcInfo);
+		case NBT_TAG::Float:	return GetNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Float>>(tData, tList, szListLength, funcInfo);
+		case NBT_TAG::Double:	return GetNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Double>>(tData, tList, szListLength, funcInfo);
+		default:
+			{
+				ErrCode eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nNot a numeric Tag[0x{:02X}({})]", __FUNCTION__,
+					(NBT_TAG_RAW_TYPE)enListElementTag, (NBT_TAG_RAW_TYPE)enListElementTag);
+				STACK_TRACEBACK("enListElementTag Test");
+				return eRet;
+			}
+		}
+	}
+
+	//插入集合条目，失败时sName与tmpNode不会被移动
+	//如果键池给出了键的哈希值，且底层容器可以直接使用（NBT_FlatMap），则跳过容器内的哈希计算
+	template<typename CompoundType>
+	static auto TryEmplaceEntry(CompoundType &tCompound, NBT_Type::String &sName, NBT_Node &tmpNode, const std::optional<size_t> &optNameHash)
+	{
+		if constexpr (requires{ tCompound.try_emplace_hashed(optNameHash.value(), std::move(sName), std::move(tmpNode)); })
+		{
+			if (optNameHash.has_value())
+			{
+				return tCompound.try_emplace_hashed(*optNameHash, std::move(sName), std::move(tmpNode));
+			}
+		}
+
+		return tCompound.try_emplace(std::move(sName), std::move(tmpNode));
+	}
+
 	//如果是非根部，有额外检测
-	template<bool bRoot, bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
+	template<typename Format, bool bRoot, bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
 	static ErrCode GetCompoundType(InputStream &tData, NBT_Type::Compound &tCompound, size_t szStackDepth, InfoFunc &funcInfo) noexcept
 	{
 	MYTRY;
 		ErrCode eRet = AllOk;
 		CHECK_STACK_DEPTH(szStackDepth);
 
+		//当前线程的键池，每个集合只获取一次
+		NBT_KeyPool *const pPool = NBT_KeyPool::GetCurrent();
+
 		//读取
 		while (true)
 		{
@@ -412,7 +617,8 @@ catch(...)\
 
 			//然后读取名称
 			NBT_Type::String sName{};
-			eRet = GetName(tData, sName, funcInfo);
+			std::optional<size_t> optNameHash{};
+			eRet = GetName<Format>(tData, sName, funcInfo, pPool, &optNameHash);
 			if (eRet != AllOk)
 			{
 				STACK_TRACEBACK("GetName Error, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
@@ -421,7 +627,7 @@ catch(...)\
 
 			//然后根据类型，调用对应的类型读取并返回到tmpNode
 			NBT_Node tmpNode{};
-			eRet = GetSwitch<bUnwrapMixedList>(tData, tmpNode, enCompoundEntryTag, szStackDepth - 1, funcInfo);
+			eRet = GetSwitch<Format, bUnwrapMixedList>(tData, tmpNode, enCompoundEntryTag, szStackDepth - 1, funcInfo);
 			if (eRet != AllOk)
 			{
 				STACK_TRACEBACK("GetSwitch Error, Name: \"{}\", Type: [NBT_Type::{}]", sName.ToCharTypeUTF8(), NBT_Type::GetTypeName(enCompoundEntryTag));//注意这里ToCharTypeUTF8可能抛异常
@@ -432,7 +638,7 @@ catch(...)\
 			//根据实际mc java代码得出，如果插入一个已经存在的键，会导致原先的值被替换并丢弃
 			//那么在失败后，手动从迭代器替换当前值，注意，此处必须是try_emplace，因为try_emplace失败后原先的值
 			//tmpNode不会被移动导致丢失，所以也无需拷贝插入以防止移动丢失问题
-			auto [it, bSuccess] = tCompound.try_emplace(std::move(sName), std::move(tmpNode));
+			auto [it, bSuccess] = TryEmplaceEntry(tCompound, sName, tmpNode, optNameHash);
 			if (!bSuccess)
 			{
 				//使用当前值替换掉阻止插入的原始值
@@ -455,13 +661,13 @@ catch(...)\
 	MYCATCH;
 	}
 
-	template<typename InputStream, typename InfoFunc>
+	template<typename Format, typename InputStream, typename InfoFunc>
 	static ErrCode GetStringType(InputStream &tData, NBT_Type::String &tString, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
 
 		//读取字符串
-		eRet = GetName(tData, tString, funcInfo);//因为string与name读取原理一致，直接借用实现
+		eRet = GetName<Format>(tData, tString, funcInfo);//因为string与name读取原理一致，直接借用实现
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("GetString");//因为是借用实现，所以这里小小的改个名，防止报错Name误导人
@@ -471,7 +677,7 @@ catch(...)\
 		return eRet;
 	}
 
-	template<bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
+	template<typename Format, bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
 	static ErrCode GetListType(InputStream &tData, NBT_Type::List &tList, size_t szStackDepth, InfoFunc &funcInfo) noexcept
 	{
 	MYTRY;
@@ -480,7 +686,7 @@ catch(...)\
 
 		//读取1字节的列表元素类型
 		NBT_TAG_RAW_TYPE u8ListElementTag = 0;//b=byte
-		eRet = ReadBigEndian(tData, u8ListElementTag, funcInfo);
+		eRet = ReadValue<Format>(tData, u8ListElementTag, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("u8ListElementTag Read");
@@ -501,7 +707,7 @@ catch(...)\
 
 		//读取4字节的有符号列表长度
 		NBT_Type::ListLength iListLength = 0;//4byte
-		eRet = ReadBigEndian(tData, iListLength, funcInfo);
+		eRet = ReadValue<Format>(tData, iListLength, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("iListLength Read");
@@ -534,6 +740,17 @@ catch(...)\
 			enListElementTag = NBT_TAG::End;
 		}
 
+		//定长数值类型像数组一样批量读取，由GetNumericListElements自行扩容
+		if (NBT_Type::IsNumericTag(enListElementTag))
+		{
+			eRet = GetNumericListSwitch<Format>(tData, tList, enListElementTag, szListLength, funcInfo);
+			if (eRet != AllOk)
+			{
+				STACK_TRACEBACK("GetNumericListSwitch Error, Size: [{}]", szListLength);
+			}
+			return eRet;
+		}
+
 		//提前扩容
 		tList.reserve(szListLength);//已知大小提前分配减少开销
 
@@ -541,7 +758,7 @@ catch(...)\
 		for (size_t i = 0; i < szListLength; ++i)
 		{
 			NBT_Node tmpNode{};//列表元素会直接赋值修改
-			eRet = GetSwitch<bUnwrapMixedList>(tData, tmpNode, enListElementTag, szStackDepth - 1, funcInfo);
+			eRet = GetSwitch<Format, bUnwrapMixedList>(tData, tmpNode, enListElementTag, szStackDepth - 1, funcInfo);
 			if (eRet != AllOk)//错误处理
 			{
 				STACK_TRACEBACK("GetSwitch Error, Size: [{}] Index: [{}]", szListLength, i);
@@ -588,7 +805,7 @@ catch(...)\
 	}
 
 	//这个函数拦截所有内部调用产生的异常并处理返回，所以此函数绝对不抛出异常，由此调用此函数的函数也可无需catch异常
-	template<bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
+	template<typename Format, bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
 	static ErrCode GetSwitch(InputStream &tData, NBT_Node &nodeNbt, NBT_TAG tagNbt, size_t szStackDepth, InfoFunc &funcInfo) noexcept//选择函数不检查递归层，由函数调用的函数检查
 	{
 		ErrCode eRet = AllOk;
@@ -598,73 +815,73 @@ catch(...)\
 		case NBT_TAG::Byte:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Byte>;
-				eRet = GetBuiltInType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetBuiltInType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Short:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Short>;
-				eRet = GetBuiltInType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetBuiltInType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Int:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Int>;
-				eRet = GetBuiltInType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetBuiltInType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Long:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Long>;
-				eRet = GetBuiltInType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetBuiltInType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Float:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Float>;
-				eRet = GetBuiltInType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetBuiltInType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Double:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Double>;
-				eRet = GetBuiltInType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetBuiltInType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::ByteArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::ByteArray>;
-				eRet = GetArrayType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetArrayType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::String:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::String>;
-				eRet = GetStringType(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetStringType<Format>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::List://需要递归调用，列表开头给出标签ID和长度，后续都为一系列同类型标签的有效负载（无标签 ID 或名称）
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::List>;
-				eRet = GetListType<bUnwrapMixedList>(tData, nodeNbt.Set<CurType>(), szStackDepth, funcInfo);//选择函数不减少递归层
+				eRet = GetListType<Format, bUnwrapMixedList>(tData, nodeNbt.Set<CurType>(), szStackDepth, funcInfo);//选择函数不减少递归层
 			}
 			break;
 		case NBT_TAG::Compound://需要递归调用
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Compound>;
-				eRet = GetCompoundType<false, bUnwrapMixedList>(tData, nodeNbt.Set<CurType>(), szStackDepth, funcInfo);//选择函数不减少递归层
+				eRet = GetCompoundType<Format, false, bUnwrapMixedList>(tData, nodeNbt.Set<CurType>(), szStackDepth, funcInfo);//选择函数不减少递归层
 			}
 			break;
 		case NBT_TAG::IntArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::IntArray>;
-				eRet = GetArrayType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetArrayType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::LongArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::LongArray>;
-				eRet = GetArrayType<CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
+				eRet = GetArrayType<Format, CurType>(tData, nodeNbt.Set<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::End://不应该在任何时候遇到此标签，Compound会读取到并消耗掉，不会传入，List遇到此标签不会调用读取，所以遇到即为错误
@@ -688,6 +905,49 @@ catch(...)\
 
 		return eRet;//传递返回值
 	}
+
+	//网络格式根部：根标签类型之后直接是负载，没有根名称
+	//End根表示空值，读取后nodeRoot为End类型
+	template<typename Format, bool bUnwrapMixedList, typename InputStream, typename InfoFunc>
+	static ErrCode GetNetworkRoot(InputStream &tData, NBT_Node &nodeRoot, size_t szStackDepth, InfoFunc &funcInfo) noexcept
+	{
+		ErrCode eRet = AllOk;
+
+		//读取根标签
+		if (!tData.HasAvailData(sizeof(NBT_TAG_RAW_TYPE)))
+		{
+			eRet = Error(OutOfRangeError, tData, funcInfo, "{}:\nIndex[{}] >= DataSize()[{}]", __FUNCTION__,
+				tData.Index(), tData.Size());
+			STACK_TRACEBACK("HasAvailData Test");
+			return eRet;
+		}
+
+		NBT_TAG_RAW_TYPE u8RootTag = (NBT_TAG_RAW_TYPE)tData.GetNext();
+		if (u8RootTag == NBT_TAG::End)//空值
+		{
+			nodeRoot.Clear();
+			return eRet;
+		}
+
+		if (u8RootTag >= NBT_TAG::ENUM_END)//确认在范围内
+		{
+			eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nNBT Tag switch default: Unknown Type Tag[0x{:02X}({})]", __FUNCTION__,
+				u8RootTag, u8RootTag);
+			STACK_TRACEBACK("u8RootTag Test");
+			return eRet;
+		}
+
+		//根据类型读取负载
+		NBT_TAG enRootTag = (NBT_TAG)u8RootTag;
+		eRet = GetSwitch<Format, bUnwrapMixedList>(tData, nodeRoot, enRootTag, szStackDepth, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("GetSwitch Error, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enRootTag));
+			return eRet;
+		}
+
+		return eRet;
+	}
 ///@endcond
 
 public:
@@ -713,6 +973,8 @@ public:
 
 	/// @brief 从输入流中读取NBT数据到NBT_Type::Compound对象中
 	/// @tparam bUnwrapMixedList 是否自动解包列表中的打包Compound
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式，读取基岩版存档数据时使用NBT_Format::LittleEndian，
+	/// 读取基岩版网络协议数据时使用NBT_Format::VarInt
 	/// @tparam InputStream 输入流类型，必须符合DefaultInputStream类型的接口
 	/// @tparam InfoFunc 错误信息输出仿函数类型
 	/// @param IptStream 输入流对象
@@ -723,14 +985,16 @@ public:
 	/// @note 错误与警告信息都输出到funcInfo，错误会导致函数结束剩下的写出任务，并进行栈回溯输出，最终返回false。警告则只会输出一次信息，然后继续执行，如果没有任何错误但是存在警告，函数仍将返回true。
 	/// 函数不会清除tCompound对象的数据，所以可以通过多次调用此函数，把多个NBT数据流合并到同一个tCompound对象内，
 	/// 但是如果多个流中有重复、同名的NBT键，则会产生冲突，为了保证键的唯一性，后来的值会替换原先的值，并通过funcInfo产生一个警告信息。
-	template<bool bUnwrapMixedList = true, typename InputStream, typename InfoFunc = NBT_Print>
+	template<bool bUnwrapMixedList = true, typename Format = NBT_Format::BigEndian, typename InputStream, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
 	static bool ReadNBT(InputStream &IptStream, NBT_Type::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept//从data中读取nbt
 	{
-		return GetCompoundType<true, bUnwrapMixedList>(IptStream, tCompound, szStackDepth, funcInfo) == AllOk;//从data中获取nbt数据到nRoot中，只有此调用为根部调用（模板true），用于处理特殊情况
+		return GetCompoundType<Format, true, bUnwrapMixedList>(IptStream, tCompound, szStackDepth, funcInfo) == AllOk;//从data中获取nbt数据到nRoot中，只有此调用为根部调用（模板true），用于处理特殊情况
 	}
 
 	/// @brief 从数据容器中读取NBT数据到NBT_Type::Compound对象中
 	/// @tparam bUnwrapMixedList 是否自动解包列表中的打包Compound
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
 	/// @tparam DataType 数据容器类型
 	/// @tparam InfoFunc 错误信息输出仿函数类型
 	/// @param tDataInput 输入数据容器
@@ -740,11 +1004,52 @@ public:
 	/// @param funcInfo 错误信息处理仿函数
 	/// @return 读取成功返回true，失败返回false
 	/// @note 此函数是ReadNBT的标准库容器版本，其它信息请参考ReadNBT(InputStream)版本的详细说明
-	template<bool bUnwrapMixedList = true, typename DataType = std::vector<uint8_t>, typename InfoFunc = NBT_Print>
+	template<bool bUnwrapMixedList = true, typename Format = NBT_Format::BigEndian, typename DataType = std::vector<uint8_t>, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
 	static bool ReadNBT(const DataType &tDataInput, size_t szStartIdx, NBT_Type::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept//从data中读取nbt
 	{
 		NBT_IO::DefaultInputStream<DataType> IptStream(tDataInput, szStartIdx);
-		return GetCompoundType<true, bUnwrapMixedList>(IptStream, tCompound, szStackDepth, funcInfo) == AllOk;
+		return GetCompoundType<Format, true, bUnwrapMixedList>(IptStream, tCompound, szStackDepth, funcInfo) == AllOk;
+	}
+
+	/// @brief 从输入流中以网络格式读取单个无名根标签
+	/// @tparam bUnwrapMixedList 是否自动解包列表中的打包Compound
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @tparam InputStream 输入流类型，必须符合DefaultInputStream类型的接口
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param IptStream 输入流对象
+	/// @param[out] nodeRoot 用于返回读取结果的对象，原有数据会被替换
+	/// @param szStackDepth 递归最大深度深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	/// @note Java版协议764起，网络包内的NBT只包含根标签类型与负载，没有根名称，根也不一定是Compound。
+	/// 根标签为End时表示空值，此时nodeRoot被重置为End类型并返回true。
+	/// 函数只读取一个根标签，读取后流停在根标签数据之后，调用者可以通过IptStream.Index()继续读取网络包中的后续字段。
+	template<bool bUnwrapMixedList = true, typename Format = NBT_Format::BigEndian, typename InputStream, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
+	static bool ReadNetworkNBT(InputStream &IptStream, NBT_Node &nodeRoot, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		return GetNetworkRoot<Format, bUnwrapMixedList>(IptStream, nodeRoot, szStackDepth, funcInfo) == AllOk;
+	}
+
+	/// @brief 从数据容器中以网络格式读取单个无名根标签
+	/// @tparam bUnwrapMixedList 是否自动解包列表中的打包Compound
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @tparam DataType 数据容器类型
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param tDataInput 输入数据容器
+	/// @param szStartIdx 数据起始索引，一般为网络包中NBT字段的偏移
+	/// @param[out] nodeRoot 用于返回读取结果的对象，原有数据会被替换
+	/// @param szStackDepth 递归最大深度深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	/// @note 此函数是ReadNetworkNBT的标准库容器版本，需要得到读取结束位置时请使用输入流版本，其它信息请参考ReadNetworkNBT(InputStream)版本的详细说明
+	template<bool bUnwrapMixedList = true, typename Format = NBT_Format::BigEndian, typename DataType = std::vector<uint8_t>, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
+	static bool ReadNetworkNBT(const DataType &tDataInput, size_t szStartIdx, NBT_Node &nodeRoot, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		NBT_IO::DefaultInputStream<DataType> IptStream(tDataInput, szStartIdx);
+		return GetNetworkRoot<Format, bUnwrapMixedList>(IptStream, nodeRoot, szStackDepth, funcInfo) == AllOk;
 	}
 
 #ifdef CJF2_NBT_CPP_USE_ZLIB
@@ -755,30 +1060,48 @@ public:
 	/// @param[out] tCompound 用于返回读取结果的对象
 	/// @param funcInfo 错误信息处理仿函数
 	/// @return 读取成功返回 true，失败返回 false
-	/// @note 本函数会读取整个文件内容，先尝试使用 Zlib 解压。若解压失败，则假定文件未压缩，直接使用原始数据。
-	/// 然后调用 ReadNBT 解析数据到 Compound 对象。如果文件不存在，则会失败。
+	/// @note 本函数会先以只读方式映射整个文件，若 NBT_IO::IsDataZipped 判断数据未压缩，则直接在映射上调用 ReadNBT，不产生任何文件数据拷贝；
+	/// 否则尝试使用 Zlib 解压，若解压失败，则假定文件未压缩，直接使用映射的原始数据。如果文件不存在，则会失败。
 	template <typename InfoFunc = NBT_Print>
 	static bool SimpleReadNbtFile(const std::filesystem::path &pathFileName, NBT_Type::Compound &tCompound, InfoFunc funcInfo = InfoFunc{}) noexcept
 	{
-		//读取文件
-		std::vector<uint8_t> vFileData;
-		if (!NBT_IO::ReadFile(pathFileName, vFileData, funcInfo))
+		//映射文件
+		NBT_IO::MappedFile mfFile(pathFileName, NBT_IO::MappedFile::AccessHint::Sequential);
+		if (!mfFile.IsOpen())
 		{
-			funcInfo(NBT_Print_Level::Err, "Error: Cannot read file [{}].\n", pathFileName.string());
+			funcInfo(NBT_Print_Level::Err, "Error: Cannot read file [{}]: {}\n", pathFileName.string(), mfFile.GetErrorInfo());
 			return false;
 		}
 
+		//未压缩则直接从映射读取
+		if (!NBT_IO::IsDataZipped(mfFile))
+		{
+			if (!ReadNBT(mfFile, 0, tCompound, 512, funcInfo))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: ReadNBT failed.\n");
+				return false;
+			}
+
+			return true;
+		}
+
 		//尝试解压，失败则视作未压缩数据
 		std::vector<uint8_t> vNbtData;
-		if (!NBT_IO::DecompressDataNoThrow(vNbtData, vFileData, funcInfo))
+		if (!NBT_IO::DecompressDataNoThrow(vNbtData, mfFile, funcInfo))
 		{
 			funcInfo(NBT_Print_Level::Warn, "Warning: Decompression failed, assuming uncompressed data.\n");
-			vNbtData = std::move(vFileData);
+
+			if (!ReadNBT(mfFile, 0, tCompound, 512, funcInfo))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: ReadNBT failed.\n");
+				return false;
+			}
+
+			return true;
 		}
 
-		//清理数据
-		vFileData.clear();
-		vFileData.shrink_to_fit();
+		//解压完成，提前解除映射
+		mfFile.Close();
 
 		//读取
 		if (!ReadNBT(vNbtData, 0, tCompound, 512, funcInfo))
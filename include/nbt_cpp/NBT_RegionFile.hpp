@@ -0,0 +1,774 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <span>//std::span
+#include <array>//std::array
+#include <mutex>//std::mutex
+#include <atomic>//std::atomic
+#include <thread>//std::thread
+#include <concepts>//std::invocable
+#include <string>//std::string
+#include <vector>//字节流
+#include <charconv>//std::from_chars
+#include <algorithm>//std::min std::max
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <string.h>//memcpy
+#include <utility>//std::move
+#include <type_traits>//std::is_same_v
+#include <filesystem>//std::filesystem::path
+
+#include "NBT_Print.hpp"//打印输出
+#include "NBT_Node.hpp"//nbt类型
+#include "NBT_Endian.hpp"//字节序
+#include "NBT_IO.hpp"//IO流对象
+#include "NBT_Reader.hpp"//反序列化
+#include "NBT_Scanner.hpp"//扫描
+
+/// @file
+/// @brief Anvil区域文件（.mca）读取工具
+
+
+/// @brief 这个类用于随机读取Minecraft的Anvil区域文件（.mca）中的单个区块
+/// @note 打开时以只读方式映射整个区域文件，并一次性解析8KiB的位置表与时间戳表，
+/// 之后按区块坐标读取时只会访问（并解压）对应区块所在的扇区，不会触碰其它区块的数据。
+/// 支持的压缩类型为1（Gzip）、2（Zlib）与3（未压缩），以及存放在同目录下c.X.Z.mcc文件中的外部超大区块。
+/// 区块坐标可以是区域内坐标（0~31），也可以是世界区块坐标，内部只取低5位。
+/// 读取例程不会抛出异常，失败时通过funcInfo输出错误信息并返回false。
+/// 对同一个对象的并发只读访问（读取不同或相同的区块）是安全的。
+/// 另外提供ReadAllChunks与ScanAllChunks，使用多个工作线程并行解压并解析区域内的所有区块。
+class NBT_RegionFile
+{
+public:
+	/// @brief 扇区大小，区域文件中所有偏移与长度都以扇区为单位
+	static constexpr size_t SECTOR_SIZE = 4096;
+	/// @brief 区域每一边的区块数
+	static constexpr int32_t CHUNK_PER_SIDE = 32;
+	/// @brief 区域内的区块总数
+	static constexpr size_t CHUNK_COUNT = (size_t)CHUNK_PER_SIDE * (size_t)CHUNK_PER_SIDE;
+	/// @brief 文件头大小（位置表与时间戳表）
+	static constexpr size_t HEADER_SIZE = SECTOR_SIZE * 2;
+	/// @brief 区块数据头大小（4字节长度与1字节压缩类型）
+	static constexpr size_t CHUNK_HEADER_SIZE = 5;
+	/// @brief 压缩类型中标记外部区块的位
+	static constexpr uint8_t EXTERNAL_FLAG = 0x80;
+
+	/// @brief 区块压缩类型
+	enum class CompressionType : uint8_t
+	{
+		GZip = 1,		///< Gzip压缩
+		Zlib = 2,		///< Zlib压缩
+		None = 3,		///< 未压缩
+		LZ4 = 4,		///< LZ4压缩（不支持）
+		Custom = 127,	///< 自定义压缩（不支持）
+	};
+
+	/// @brief 位置表与时间戳表中单个区块的信息
+	struct ChunkInfo
+	{
+		uint32_t u32SectorOffset = 0;///< 区块数据起始扇区
+		uint8_t u8SectorCount = 0;///< 区块数据占用的扇区数
+		uint32_t u32Timestamp = 0;///< 区块最后修改时间（Unix时间戳，秒）
+
+		/// @brief 区块是否存在
+		/// @return 存在返回true，否则返回false
+		bool Exists(void) const noexcept
+		{
+			return u32SectorOffset != 0 && u8SectorCount != 0;
+		}
+	};
+
+	/// @brief 区块的原始（未解压）数据
+	/// @note spanData指向区域文件映射（或外部区块文件映射）中的数据，
+	/// 对于区域文件内的区块，其生命周期与所属的NBT_RegionFile对象相同；对于外部区块，其生命周期与本对象相同。
+	struct ChunkPayload
+	{
+		CompressionType enType = CompressionType::None;///< 压缩类型（已去除外部区块标记）
+		bool bExternal = false;///< 是否为外部区块
+		std::span<const uint8_t> spanData{};///< 压缩后的区块数据
+		NBT_IO::MappedFile mfExternal{};///< 外部区块文件的映射，仅在bExternal为true时有效
+	};
+
+	/// @brief 并行读取时单个区块的结果
+	struct ChunkResult
+	{
+		int32_t i32ChunkX = 0;///< 区域内区块X坐标（0~31）
+		int32_t i32ChunkZ = 0;///< 区域内区块Z坐标（0~31）
+		bool bSuccess = false;///< 是否读取成功
+		NBT_Type::Compound cpdChunk{};///< 读取结果，失败时内容不确定
+	};
+
+private:
+	NBT_IO::MappedFile mfRegion{};
+	std::array<ChunkInfo, CHUNK_COUNT> arrChunkInfo{};
+	std::filesystem::path pathRegion{};
+	bool bHasRegionPos = false;
+	int32_t i32RegionX = 0;
+	int32_t i32RegionZ = 0;
+
+private:
+	static uint32_t ReadBigU32(const uint8_t *pData) noexcept
+	{
+		uint32_t u32Val = 0;
+		memcpy(&u32Val, pData, sizeof(u32Val));
+		return NBT_Endian::BigToNativeAny(u32Val);
+	}
+
+	//在已经准备好的原始数据上解压（如果需要）并调用处理函数，处理函数接受一个容器
+	//压缩的数据解压到vScratch中，vScratch可以在多次调用间复用以避免重复分配
+	template<typename Func, typename InfoFunc>
+	static bool ProcessPayload(const ChunkPayload &cpPayload, std::vector<uint8_t> &vScratch, Func &&funcProcess, InfoFunc &funcInfo) noexcept
+	{
+		switch (cpPayload.enType)
+		{
+		case CompressionType::None:
+			{
+				return funcProcess(cpPayload.spanData);
+			}
+			break;
+		case CompressionType::GZip:
+		case CompressionType::Zlib:
+			{
+#ifdef CJF2_NBT_CPP_USE_ZLIB
+				if (!NBT_IO::DecompressDataNoThrow(vScratch, cpPayload.spanData, funcInfo))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Failed to decompress chunk data.\n");
+					return false;
+				}
+
+				return funcProcess(vScratch);
+#else
+				funcInfo(NBT_Print_Level::Err, "Error: Zlib support is not enabled, cannot decompress chunk data.\n");
+				return false;
+#endif
+			}
+			break;
+		default:
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Unsupported chunk compression type [{}].\n", (uint32_t)cpPayload.enType);
+				return false;
+			}
+			break;
+		}
+	}
+
+	//使用给定的原始数据对象与暂存区读取区块
+	template<bool bUnwrapMixedList, typename InfoFunc>
+	bool ReadChunkWith(int32_t i32ChunkX, int32_t i32ChunkZ, ChunkPayload &cpPayload, std::vector<uint8_t> &vScratch, NBT_Type::Compound &tCompound, size_t szStackDepth, InfoFunc &funcInfo) const noexcept
+	{
+		if (!GetChunkPayload(i32ChunkX, i32ChunkZ, cpPayload, funcInfo))
+		{
+			return false;
+		}
+
+		return ProcessPayload(cpPayload, vScratch,
+			[&](const auto &tData) noexcept -> bool
+			{
+				if (!NBT_Reader::ReadNBT<bUnwrapMixedList>(tData, 0, tCompound, szStackDepth, funcInfo))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: ReadNBT failed for chunk [{}, {}].\n", i32ChunkX, i32ChunkZ);
+					return false;
+				}
+				return true;
+			}, funcInfo);
+	}
+
+	//使用给定的原始数据对象与暂存区扫描区块
+	template<typename Visitor, typename InfoFunc>
+	bool ScanChunkWith(int32_t i32ChunkX, int32_t i32ChunkZ, ChunkPayload &cpPayload, std::vector<uint8_t> &vScratch, Visitor &tVisitor, size_t szStackDepth, InfoFunc &funcInfo) const noexcept
+	{
+		if (!GetChunkPayload(i32ChunkX, i32ChunkZ, cpPayload, funcInfo))
+		{
+			return false;
+		}
+
+		return ProcessPayload(cpPayload, vScratch,
+			[&](const auto &tData) noexcept -> bool
+			{
+				if (!NBT_Scanner::ScanNBT(tData, 0, tVisitor, szStackDepth))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: ScanNBT failed for chunk [{}, {}].\n", i32ChunkX, i32ChunkZ);
+					return false;
+				}
+				return true;
+			}, funcInfo);
+	}
+
+	//多线程共享的信息输出仿函数，每次调用都在锁内转发
+	template<typename InfoFunc>
+	class LockedInfoFunc
+	{
+	private:
+		std::mutex &mtxInfo;
+		InfoFunc &funcInfo;
+
+	public:
+		LockedInfoFunc(std::mutex &_mtxInfo, InfoFunc &_funcInfo) noexcept :mtxInfo(_mtxInfo), funcInfo(_funcInfo)
+		{}
+
+		template<typename... Args>
+		void operator()(NBT_Print_Level lvl, const std::format_string<Args...> fmt, Args&&... args) const noexcept
+		{
+			std::lock_guard<std::mutex> lgInfo(mtxInfo);
+			funcInfo(lvl, std::move(fmt), std::forward<Args>(args)...);
+		}
+
+		template<typename... Args>
+		void operator()(const std::format_string<Args...> fmt, Args&&... args) const noexcept
+		{
+			std::lock_guard<std::mutex> lgInfo(mtxInfo);
+			funcInfo(std::move(fmt), std::forward<Args>(args)...);
+		}
+	};
+
+	//每个工作线程独占的可复用资源
+	struct WorkerState
+	{
+		ChunkPayload cpPayload{};
+		std::vector<uint8_t> vScratch{};
+	};
+
+	//收集所有存在的区块索引，按区块顺序排列，返回区块数
+	size_t CollectChunks(std::array<uint16_t, CHUNK_COUNT> &arrTask) const noexcept
+	{
+		size_t szTaskCount = 0;
+		for (size_t i = 0; i < CHUNK_COUNT; ++i)
+		{
+			if (arrChunkInfo[i].Exists())
+			{
+				arrTask[szTaskCount++] = (uint16_t)i;
+			}
+		}
+		return szTaskCount;
+	}
+
+	//使用szThreadCount个工作线程（包括当前线程）执行szTaskCount个任务，funcWork(szWorker, szTask)
+	//空闲的线程总是从共享游标处领取下一个未开始的任务，耗时不均的区块不会让某个线程独自拖尾
+	template<typename Work>
+	static void RunParallel(size_t szTaskCount, size_t szThreadCount, Work &funcWork) noexcept
+	{
+		std::atomic<size_t> szNextTask = 0;
+		auto funcLoop = [&](size_t szWorker) noexcept -> void
+		{
+			while (true)
+			{
+				size_t szTask = szNextTask.fetch_add(1, std::memory_order_relaxed);
+				if (szTask >= szTaskCount)
+				{
+					break;
+				}
+				funcWork(szWorker, szTask);
+			}
+		};
+
+		std::vector<std::thread> vThreads;
+		try
+		{
+			vThreads.reserve(szThreadCount - 1);
+			for (size_t szWorker = 1; szWorker < szThreadCount; ++szWorker)
+			{
+				vThreads.emplace_back(funcLoop, szWorker);
+			}
+		}
+		catch (...)
+		{
+			//线程创建失败时，由已创建的线程与当前线程完成剩余任务
+		}
+
+		funcLoop(0);
+
+		for (auto &it : vThreads)
+		{
+			it.join();
+		}
+	}
+
+public:
+	/// @brief 获取区块在位置表与时间戳表中的索引
+	/// @param i32ChunkX 区块X坐标，只取低5位
+	/// @param i32ChunkZ 区块Z坐标，只取低5位
+	/// @return 索引，范围为0~1023
+	static size_t ChunkIndex(int32_t i32ChunkX, int32_t i32ChunkZ) noexcept
+	{
+		return (size_t)(i32ChunkX & (CHUNK_PER_SIDE - 1)) + (size_t)(i32ChunkZ & (CHUNK_PER_SIDE - 1)) * (size_t)CHUNK_PER_SIDE;
+	}
+
+	/// @brief 从r.X.Z.mca格式的文件名中解析区域坐标
+	/// @param pathFileName 区域文件路径，只使用文件名部分
+	/// @param[out] i32X 区域X坐标
+	/// @param[out] i32Z 区域Z坐标
+	/// @return 文件名符合格式返回true，否则返回false
+	static bool ParseRegionPos(const std::filesystem::path &pathFileName, int32_t &i32X, int32_t &i32Z) noexcept
+	{
+		std::string strName;
+		try
+		{
+			strName = pathFileName.filename().string();
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		if (strName.size() < 2 || strName[0] != 'r' || strName[1] != '.')
+		{
+			return false;
+		}
+
+		const char *pBeg = strName.data() + 2;
+		const char *pEnd = strName.data() + strName.size();
+
+		auto [pNext, ec] = std::from_chars(pBeg, pEnd, i32X);
+		if (ec != std::errc{} || pNext == pEnd || *pNext != '.')
+		{
+			return false;
+		}
+
+		auto [pLast, ec2] = std::from_chars(pNext + 1, pEnd, i32Z);
+		if (ec2 != std::errc{} || pLast == pEnd || *pLast != '.')
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	/// @brief 获取外部区块文件（c.X.Z.mcc）的路径
+	/// @param pathRegionFile 区域文件路径，外部区块文件与其位于同一目录
+	/// @param i32RegionX 区域X坐标
+	/// @param i32RegionZ 区域Z坐标
+	/// @param i32ChunkX 区块X坐标，只取低5位
+	/// @param i32ChunkZ 区块Z坐标，只取低5位
+	/// @return 外部区块文件路径，文件名中的X与Z为世界区块坐标
+	/// @note 可能抛出std::bad_alloc异常
+	static std::filesystem::path GetExternalChunkPath(const std::filesystem::path &pathRegionFile, int32_t i32RegionX, int32_t i32RegionZ, int32_t i32ChunkX, int32_t i32ChunkZ)
+	{
+		int64_t i64WorldX = (int64_t)i32RegionX * CHUNK_PER_SIDE + (i32ChunkX & (CHUNK_PER_SIDE - 1));
+		int64_t i64WorldZ = (int64_t)i32RegionZ * CHUNK_PER_SIDE + (i32ChunkZ & (CHUNK_PER_SIDE - 1));
+		return pathRegionFile.parent_path() / ("c." + std::to_string(i64WorldX) + "." + std::to_string(i64WorldZ) + ".mcc");
+	}
+	/// @brief 默认构造，不打开任何文件
+	NBT_RegionFile(void) = default;
+	/// @brief 默认析构函数
+	~NBT_RegionFile(void) = default;
+	/// @brief 禁止拷贝构造
+	NBT_RegionFile(const NBT_RegionFile &) = delete;
+	/// @brief 禁止拷贝赋值
+	NBT_RegionFile &operator=(const NBT_RegionFile &) = delete;
+	/// @brief 默认移动构造
+	NBT_RegionFile(NBT_RegionFile &&) = default;
+	/// @brief 默认移动赋值
+	NBT_RegionFile &operator=(NBT_RegionFile &&) = default;
+
+	/// @brief 打开区域文件并解析文件头
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param pathFileName 区域文件路径
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 打开成功返回true，失败返回false
+	/// @note 如果文件名符合r.X.Z.mca格式，则同时解析区域坐标，用于定位外部区块文件。
+	/// 空文件视为不包含任何区块的区域。位置表中超出文件范围的条目会被视为不存在，并输出警告。
+	template<typename InfoFunc = NBT_Print>
+	bool Open(const std::filesystem::path &pathFileName, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		Close();
+
+		if (!mfRegion.Open(pathFileName, NBT_IO::MappedFile::AccessHint::Random))
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Cannot map region file [{}]: {}\n", pathFileName.string(), mfRegion.GetErrorInfo());
+			return false;
+		}
+
+		try
+		{
+			pathRegion = pathFileName;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			Close();
+			return false;
+		}
+
+		bHasRegionPos = ParseRegionPos(pathFileName, i32RegionX, i32RegionZ);
+
+		//空文件是合法的空区域
+		if (mfRegion.empty())
+		{
+			return true;
+		}
+
+		if (mfRegion.size() < HEADER_SIZE)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Region file [{}] is too small(size: [{}] bytes) to contain a header.\n", pathFileName.string(), mfRegion.size());
+			Close();
+			return false;
+		}
+
+		const uint8_t *pHeader = mfRegion.data();
+		size_t szFileSectors = (mfRegion.size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+		for (size_t i = 0; i < CHUNK_COUNT; ++i)
+		{
+			uint32_t u32Location = ReadBigU32(&pHeader[i * 4]);
+			ChunkInfo &ciCur = arrChunkInfo[i];
+			ciCur.u32SectorOffset = u32Location >> 8;
+			ciCur.u8SectorCount = (uint8_t)(u32Location & 0xFF);
+			ciCur.u32Timestamp = ReadBigU32(&pHeader[SECTOR_SIZE + i * 4]);
+
+			if (!ciCur.Exists())
+			{
+				continue;
+			}
+
+			//不能与文件头重叠，也不能超出文件
+			if (ciCur.u32SectorOffset < 2 || (size_t)ciCur.u32SectorOffset + (size_t)ciCur.u8SectorCount > szFileSectors)
+			{
+				funcInfo(NBT_Print_Level::Warn, "Warning: Chunk [{}, {}] has an invalid location(sector: [{}], count: [{}]), ignored.\n",
+					i % CHUNK_PER_SIDE, i / CHUNK_PER_SIDE, ciCur.u32SectorOffset, ciCur.u8SectorCount);
+				ciCur.u32SectorOffset = 0;
+				ciCur.u8SectorCount = 0;
+			}
+		}
+
+		return true;
+	}
+
+	/// @brief 关闭区域文件，解除映射并清空文件头信息
+	void Close(void) noexcept
+	{
+		mfRegion.Close();
+		arrChunkInfo.fill(ChunkInfo{});
+		pathRegion.clear();
+		bHasRegionPos = false;
+		i32RegionX = 0;
+		i32RegionZ = 0;
+	}
+
+	/// @brief 检查是否打开了区域文件
+	/// @return 打开返回true，否则返回false
+	bool IsOpen(void) const noexcept
+	{
+		return mfRegion.IsOpen() && !pathRegion.empty();
+	}
+
+	/// @brief 获取从文件名解析出的区域坐标
+	/// @param[out] i32X 区域X坐标
+	/// @param[out] i32Z 区域Z坐标
+	/// @return 文件名符合r.X.Z.mca格式返回true，否则返回false且不修改参数
+	bool GetRegionPos(int32_t &i32X, int32_t &i32Z) const noexcept
+	{
+		if (!bHasRegionPos)
+		{
+			return false;
+		}
+
+		i32X = i32RegionX;
+		i32Z = i32RegionZ;
+		return true;
+	}
+
+	/// @brief 设置区域坐标，用于文件名不符合r.X.Z.mca格式时定位外部区块文件
+	/// @param i32X 区域X坐标
+	/// @param i32Z 区域Z坐标
+	void SetRegionPos(int32_t i32X, int32_t i32Z) noexcept
+	{
+		bHasRegionPos = true;
+		i32RegionX = i32X;
+		i32RegionZ = i32Z;
+	}
+
+	/// @brief 获取区块在位置表与时间戳表中的信息
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @return 区块信息的常量引用
+	const ChunkInfo &GetChunkInfo(int32_t i32ChunkX, int32_t i32ChunkZ) const noexcept
+	{
+		return arrChunkInfo[ChunkIndex(i32ChunkX, i32ChunkZ)];
+	}
+
+	/// @brief 检查区块是否存在
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @return 存在返回true，否则返回false
+	bool HasChunk(int32_t i32ChunkX, int32_t i32ChunkZ) const noexcept
+	{
+		return GetChunkInfo(i32ChunkX, i32ChunkZ).Exists();
+	}
+
+	/// @brief 获取区块的原始（未解压）数据
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param[out] cpPayload 用于返回区块原始数据的对象
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 获取成功返回true，区块不存在或数据损坏返回false
+	/// @note 区域文件内的区块直接返回映射中的数据，不产生拷贝；外部区块会映射对应的c.X.Z.mcc文件。
+	template<typename InfoFunc = NBT_Print>
+	bool GetChunkPayload(int32_t i32ChunkX, int32_t i32ChunkZ, ChunkPayload &cpPayload, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		const ChunkInfo &ciChunk = GetChunkInfo(i32ChunkX, i32ChunkZ);
+		if (!ciChunk.Exists())
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Chunk [{}, {}] does not exist.\n", i32ChunkX, i32ChunkZ);
+			return false;
+		}
+
+		//区块数据头
+		size_t szOffset = (size_t)ciChunk.u32SectorOffset * SECTOR_SIZE;
+		if (mfRegion.size() - szOffset < CHUNK_HEADER_SIZE)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Chunk [{}, {}] header is out of file range.\n", i32ChunkX, i32ChunkZ);
+			return false;
+		}
+
+		const uint8_t *pChunk = &mfRegion.data()[szOffset];
+		uint32_t u32Length = ReadBigU32(pChunk);//包含压缩类型的1字节
+		uint8_t u8Type = pChunk[4];
+
+		cpPayload.bExternal = (u8Type & EXTERNAL_FLAG) != 0;
+		cpPayload.enType = (CompressionType)(u8Type & ~EXTERNAL_FLAG);
+		cpPayload.spanData = {};
+		cpPayload.mfExternal.Close();
+
+		if (!cpPayload.bExternal)
+		{
+			if (u32Length == 0 || (size_t)u32Length - 1 > mfRegion.size() - szOffset - CHUNK_HEADER_SIZE)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Chunk [{}, {}] has an invalid length [{}].\n", i32ChunkX, i32ChunkZ, u32Length);
+				return false;
+			}
+
+			cpPayload.spanData = std::span<const uint8_t>(&pChunk[CHUNK_HEADER_SIZE], (size_t)u32Length - 1);
+			return true;
+		}
+
+		//外部区块，数据存放在同目录下的c.X.Z.mcc文件中，X与Z为世界区块坐标
+		if (!bHasRegionPos)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Chunk [{}, {}] is stored externally, but the region position is unknown.\n", i32ChunkX, i32ChunkZ);
+			return false;
+		}
+
+		try
+		{
+			std::filesystem::path pathExternal = GetExternalChunkPath(pathRegion, i32RegionX, i32RegionZ, i32ChunkX, i32ChunkZ);
+
+			if (!cpPayload.mfExternal.Open(pathExternal, NBT_IO::MappedFile::AccessHint::Sequential))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Cannot map external chunk file [{}]: {}\n", pathExternal.string(), cpPayload.mfExternal.GetErrorInfo());
+				return false;
+			}
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			return false;
+		}
+
+		cpPayload.spanData = std::span<const uint8_t>(cpPayload.mfExternal.data(), cpPayload.mfExternal.size());
+		return true;
+	}
+
+	/// @brief 读取区块解压后的NBT二进制数据
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param[out] vNbtData 用于返回NBT二进制数据的容器，原有数据会被覆盖
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	template<typename InfoFunc = NBT_Print>
+	bool ReadChunkData(int32_t i32ChunkX, int32_t i32ChunkZ, std::vector<uint8_t> &vNbtData, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		ChunkPayload cpPayload;
+		if (!GetChunkPayload(i32ChunkX, i32ChunkZ, cpPayload, funcInfo))
+		{
+			return false;
+		}
+
+		//压缩的数据直接解压到vNbtData中
+		return ProcessPayload(cpPayload, vNbtData,
+			[&](const auto &tData) noexcept -> bool
+			{
+				if constexpr (!std::is_same_v<std::decay_t<decltype(tData)>, std::vector<uint8_t>>)
+				{
+					try
+					{
+						vNbtData.assign(tData.begin(), tData.end());
+					}
+					catch (const std::bad_alloc &e)
+					{
+						funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+						return false;
+					}
+				}
+				return true;
+			}, funcInfo);
+	}
+
+	/// @brief 读取区块并解析到 NBT_Type::Compound 对象中
+	/// @tparam bUnwrapMixedList 是否解包混合列表，请参考NBT_Reader::ReadNBT的说明
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param[out] tCompound 用于返回读取结果的对象
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	/// @note 未压缩的区块直接从映射中解析，压缩的区块先解压到临时缓冲区再解析。
+	template<bool bUnwrapMixedList = true, typename InfoFunc = NBT_Print>
+	bool ReadChunk(int32_t i32ChunkX, int32_t i32ChunkZ, NBT_Type::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		ChunkPayload cpPayload;
+		std::vector<uint8_t> vScratch;
+		return ReadChunkWith<bUnwrapMixedList>(i32ChunkX, i32ChunkZ, cpPayload, vScratch, tCompound, szStackDepth, funcInfo);
+	}
+
+	/// @brief 读取区块并通过访问器扫描
+	/// @tparam Visitor 访问器类型，必须符合 IsLookLike_NBT_ScanVisitor 概念
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param tVisitor 访问器对象
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 扫描成功返回true，失败返回false
+	template<typename Visitor, typename InfoFunc = NBT_Print>
+	requires(IsLookLike_NBT_ScanVisitor<Visitor>)
+	bool ScanChunk(int32_t i32ChunkX, int32_t i32ChunkZ, Visitor &tVisitor, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		ChunkPayload cpPayload;
+		std::vector<uint8_t> vScratch;
+		return ScanChunkWith(i32ChunkX, i32ChunkZ, cpPayload, vScratch, tVisitor, szStackDepth, funcInfo);
+	}
+
+	/// @brief 使用多个工作线程并行读取区域内所有存在的区块
+	/// @tparam bUnwrapMixedList 是否解包混合列表，请参考NBT_Reader::ReadNBT的说明
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param[out] vResult 用于返回读取结果的容器，原有内容会被清空，结果按区块索引（x + z * 32）顺序排列，只包含存在的区块
+	/// @param szThreadCount 工作线程数（包括调用线程），为0则使用硬件并发数，不会超过区块数
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数，会在锁内被多个线程调用
+	/// @return 所有区块都读取成功返回true，否则返回false，可以通过每个结果的bSuccess确认具体哪些区块失败
+	/// @note 空闲的线程总是领取下一个尚未开始的区块，每个线程的解压缓冲区在区块之间复用。
+	/// 单个区块的错误不会影响其它区块的读取。
+	template<bool bUnwrapMixedList = true, typename InfoFunc = NBT_Print>
+	bool ReadAllChunks(std::vector<ChunkResult> &vResult, size_t szThreadCount = 0, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		std::array<uint16_t, CHUNK_COUNT> arrTask;
+		size_t szTaskCount = CollectChunks(arrTask);
+
+		if (szThreadCount == 0)
+		{
+			szThreadCount = std::max((size_t)std::thread::hardware_concurrency(), (size_t)1);
+		}
+		szThreadCount = std::max(std::min(szThreadCount, szTaskCount), (size_t)1);
+
+		std::vector<WorkerState> vWorker;
+		try
+		{
+			vResult.clear();
+			vResult.resize(szTaskCount);
+			vWorker.resize(szThreadCount);
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+
+		std::mutex mtxInfo;
+		LockedInfoFunc<InfoFunc> funcLockedInfo(mtxInfo, funcInfo);
+		std::atomic<bool> bAllOk = true;
+
+		auto funcWork = [&](size_t szWorker, size_t szTask) noexcept -> void
+		{
+			ChunkResult &crCur = vResult[szTask];
+			WorkerState &wsCur = vWorker[szWorker];
+			crCur.i32ChunkX = arrTask[szTask] % CHUNK_PER_SIDE;
+			crCur.i32ChunkZ = arrTask[szTask] / CHUNK_PER_SIDE;
+			crCur.bSuccess = ReadChunkWith<bUnwrapMixedList>(crCur.i32ChunkX, crCur.i32ChunkZ, wsCur.cpPayload, wsCur.vScratch, crCur.cpdChunk, szStackDepth, funcLockedInfo);
+			if (!crCur.bSuccess)
+			{
+				bAllOk.store(false, std::memory_order_relaxed);
+			}
+		};
+
+		RunParallel(szTaskCount, szThreadCount, funcWork);
+		return bAllOk.load();
+	}
+
+	/// @brief 使用多个工作线程并行扫描区域内所有存在的区块，每个线程使用自己的访问器
+	/// @tparam Visitor 访问器类型，必须符合 IsLookLike_NBT_ScanVisitor 概念
+	/// @tparam ChunkFunc 区块完成回调类型
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param vVisitors 访问器列表，工作线程数等于访问器数量（不会超过区块数），第i个线程只使用第i个访问器
+	/// @param funcChunkDone 每个区块扫描结束后，在扫描它的线程上调用funcChunkDone(szWorker, tVisitor, i32ChunkX, i32ChunkZ, bSuccess)，
+	/// 可以在这里取走访问器中的结果并重置访问器。不同线程会并发调用此回调
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数，会在锁内被多个线程调用
+	/// @return 所有区块都扫描成功返回true，否则返回false
+	template<typename Visitor, typename ChunkFunc, typename InfoFunc = NBT_Print>
+	requires(IsLookLike_NBT_ScanVisitor<Visitor> && std::invocable<ChunkFunc &, size_t, Visitor &, int32_t, int32_t, bool>)
+	bool ScanAllChunks(std::vector<Visitor> &vVisitors, ChunkFunc funcChunkDone, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		if (vVisitors.empty())
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: At least one visitor is required.\n");
+			return false;
+		}
+
+		std::array<uint16_t, CHUNK_COUNT> arrTask;
+		size_t szTaskCount = CollectChunks(arrTask);
+		size_t szThreadCount = std::max(std::min(vVisitors.size(), szTaskCount), (size_t)1);
+
+		std::vector<WorkerState> vWorker;
+		try
+		{
+			vWorker.resize(szThreadCount);
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+
+		std::mutex mtxInfo;
+		LockedInfoFunc<InfoFunc> funcLockedInfo(mtxInfo, funcInfo);
+		std::atomic<bool> bAllOk = true;
+
+		auto funcWork = [&](size_t szWorker, size_t szTask) noexcept -> void
+		{
+			WorkerState &wsCur = vWorker[szWorker];
+			int32_t i32ChunkX = arrTask[szTask] % CHUNK_PER_SIDE;
+			int32_t i32ChunkZ = arrTask[szTask] / CHUNK_PER_SIDE;
+			bool bSuccess = ScanChunkWith(i32ChunkX, i32ChunkZ, wsCur.cpPayload, wsCur.vScratch, vVisitors[szWorker], szStackDepth, funcLockedInfo);
+			if (!bSuccess)
+			{
+				bAllOk.store(false, std::memory_order_relaxed);
+			}
+			funcChunkDone(szWorker, vVisitors[szWorker], i32ChunkX, i32ChunkZ, bSuccess);
+		};
+
+		RunParallel(szTaskCount, szThreadCount, funcWork);
+		return bAllOk.load();
+	}
+
+	/// @brief 使用多个工作线程并行扫描区域内所有存在的区块，每个线程使用自己的访问器
+	/// @tparam Visitor 访问器类型，必须符合 IsLookLike_NBT_ScanVisitor 概念
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param vVisitors 访问器列表，工作线程数等于访问器数量（不会超过区块数），第i个线程只使用第i个访问器
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数，会在锁内被多个线程调用
+	/// @return 所有区块都扫描成功返回true，否则返回false
+	/// @note 此函数是不需要区块完成回调的版本，其它信息请参考带回调的版本
+	template<typename Visitor, typename InfoFunc = NBT_Print>
+	requires(IsLookLike_NBT_ScanVisitor<Visitor>)
+	bool ScanAllChunks(std::vector<Visitor> &vVisitors, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) const noexcept
+	{
+		return ScanAllChunks(vVisitors, [](size_t, Visitor &, int32_t, int32_t, bool) noexcept -> void {}, szStackDepth, funcInfo);
+	}
+};
@@ -0,0 +1,683 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <span>//std::span
+#include <array>//std::array
+#include <ctime>//std::time
+#include <string>//std::string
+#include <vector>//字节流
+#include <fstream>//std::fstream
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <string.h>//memcpy
+#include <filesystem>//std::filesystem::path
+
+#include "NBT_Print.hpp"//打印输出
+#include "NBT_Node.hpp"//nbt类型
+#include "NBT_Endian.hpp"//字节序
+#include "NBT_IO.hpp"//IO流对象
+#include "NBT_Writer.hpp"//序列化
+#include "NBT_RegionFile.hpp"//区域文件格式定义
+
+/// @file
+/// @brief Anvil区域文件（.mca）写入工具
+
+
+/// @brief 这个类用于在Minecraft的Anvil区域文件（.mca）中原地写入、替换或删除单个区块
+/// @note 打开时只读取8KiB的位置表与时间戳表，并根据位置表建立扇区占用位图。
+/// 写入区块时优先原地覆盖原有扇区（新数据不大于原有扇区时），否则在位图中寻找第一段足够大的空闲扇区，
+/// 找不到则追加到文件末尾，然后释放原有扇区，最后只更新位置表与时间戳表中对应的8个字节。
+/// 因此更新一个区块只会写入与该区块大小相当的数据，而不会重写整个文件。
+/// 超过MAX_CHUNK_SECTORS个扇区（约1MiB）的区块会写入同目录下的c.X.Z.mcc外部文件，区域文件内只保留一个带外部标记的区块头。
+/// 写入例程不会抛出异常，失败时通过funcInfo输出错误信息并返回false。
+/// 这个类不是线程安全的，同一个区域文件也不应同时被多个写入对象打开。
+/// 写入的数据可能保留在流缓冲区中，需要调用Flush或Close后才能保证被其它对象（比如NBT_RegionFile）读取到。
+class NBT_RegionWriter
+{
+public:
+	/// @brief 扇区大小
+	static constexpr size_t SECTOR_SIZE = NBT_RegionFile::SECTOR_SIZE;
+	/// @brief 区域内的区块总数
+	static constexpr size_t CHUNK_COUNT = NBT_RegionFile::CHUNK_COUNT;
+	/// @brief 文件头大小（位置表与时间戳表）
+	static constexpr size_t HEADER_SIZE = NBT_RegionFile::HEADER_SIZE;
+	/// @brief 文件头占用的扇区数
+	static constexpr size_t HEADER_SECTORS = HEADER_SIZE / SECTOR_SIZE;
+	/// @brief 单个区块在区域文件内最多占用的扇区数，超过则写入外部文件
+	static constexpr size_t MAX_CHUNK_SECTORS = 255;
+	/// @brief 位置表中扇区偏移的最大值（3字节）
+	static constexpr size_t MAX_SECTOR_OFFSET = 0xFFFFFF;
+
+	/// @brief 区块压缩类型
+	using CompressionType = NBT_RegionFile::CompressionType;
+	/// @brief 位置表与时间戳表中单个区块的信息
+	using ChunkInfo = NBT_RegionFile::ChunkInfo;
+
+private:
+	std::fstream fRegion{};
+	std::filesystem::path pathRegion{};
+	bool bHasRegionPos = false;
+	int32_t i32RegionX = 0;
+	int32_t i32RegionZ = 0;
+
+	std::array<ChunkInfo, CHUNK_COUNT> arrChunkInfo{};
+	std::vector<bool> vSectorUsed{};//扇区占用位图，大小即文件的扇区数
+	std::vector<uint8_t> vPayload{};//序列化与压缩暂存区，在多次写入间复用
+
+private:
+	static uint32_t ReadBigU32(const uint8_t *pData) noexcept
+	{
+		uint32_t u32Val = 0;
+		memcpy(&u32Val, pData, sizeof(u32Val));
+		return NBT_Endian::BigToNativeAny(u32Val);
+	}
+
+	static void WriteBigU32(uint8_t *pData, uint32_t u32Val) noexcept
+	{
+		u32Val = NBT_Endian::NativeToBigAny(u32Val);
+		memcpy(pData, &u32Val, sizeof(u32Val));
+	}
+
+	bool WriteAt(uint64_t u64Pos, const void *pData, size_t szSize) noexcept
+	{
+		fRegion.seekp((std::streamoff)u64Pos);
+		fRegion.write((const char *)pData, (std::streamsize)szSize);
+		return (bool)fRegion;
+	}
+
+	bool ReadAt(uint64_t u64Pos, void *pData, size_t szSize) noexcept
+	{
+		fRegion.seekg((std::streamoff)u64Pos);
+		fRegion.read((char *)pData, (std::streamsize)szSize);
+		if (!fRegion)
+		{
+			fRegion.clear();//读取失败不影响后续写入
+			return false;
+		}
+		return true;
+	}
+
+	void MarkSectors(size_t szStart, size_t szCount, bool bUsed)
+	{
+		if (szStart + szCount > vSectorUsed.size())
+		{
+			vSectorUsed.resize(szStart + szCount, false);
+		}
+
+		for (size_t i = szStart; i < szStart + szCount; ++i)
+		{
+			vSectorUsed[i] = bUsed;
+		}
+	}
+
+	//首次适应查找连续空闲扇区，找不到则返回文件末尾
+	size_t FindFreeSectors(size_t szCount) const noexcept
+	{
+		size_t szRunStart = HEADER_SECTORS;
+		size_t szRunLength = 0;
+		for (size_t i = HEADER_SECTORS; i < vSectorUsed.size(); ++i)
+		{
+			if (vSectorUsed[i])
+			{
+				szRunStart = i + 1;
+				szRunLength = 0;
+				continue;
+			}
+
+			if (++szRunLength == szCount)
+			{
+				return szRunStart;
+			}
+		}
+
+		//末尾的空闲扇区可以与追加的扇区连在一起
+		return szRunStart;
+	}
+
+	//写出位置表与时间戳表中的一个条目
+	bool WriteHeaderEntry(size_t szIdx) noexcept
+	{
+		const ChunkInfo &ciChunk = arrChunkInfo[szIdx];
+
+		uint8_t u8Location[4];
+		WriteBigU32(u8Location, ciChunk.u32SectorOffset << 8 | ciChunk.u8SectorCount);
+		uint8_t u8Timestamp[4];
+		WriteBigU32(u8Timestamp, ciChunk.u32Timestamp);
+
+		return WriteAt(szIdx * 4, u8Location, sizeof(u8Location)) &&
+			WriteAt(SECTOR_SIZE + szIdx * 4, u8Timestamp, sizeof(u8Timestamp));
+	}
+
+	//检查已存在的区块是否存储在外部文件中
+	bool IsExternalChunk(size_t szIdx) noexcept
+	{
+		const ChunkInfo &ciChunk = arrChunkInfo[szIdx];
+		if (!ciChunk.Exists())
+		{
+			return false;
+		}
+
+		uint8_t u8Header[NBT_RegionFile::CHUNK_HEADER_SIZE];
+		if (!ReadAt((uint64_t)ciChunk.u32SectorOffset * SECTOR_SIZE, u8Header, sizeof(u8Header)))
+		{
+			return false;
+		}
+
+		return (u8Header[4] & NBT_RegionFile::EXTERNAL_FLAG) != 0;
+	}
+
+	template<typename InfoFunc>
+	void RemoveExternalFile(int32_t i32ChunkX, int32_t i32ChunkZ, InfoFunc &funcInfo) noexcept
+	{
+		if (!bHasRegionPos)
+		{
+			funcInfo(NBT_Print_Level::Warn, "Warning: Region position is unknown, external file of chunk [{}, {}] is not removed.\n", i32ChunkX, i32ChunkZ);
+			return;
+		}
+
+		try
+		{
+			std::filesystem::path pathExternal = NBT_RegionFile::GetExternalChunkPath(pathRegion, i32RegionX, i32RegionZ, i32ChunkX, i32ChunkZ);
+			std::error_code ec;
+			std::filesystem::remove(pathExternal, ec);
+			if (ec)
+			{
+				funcInfo(NBT_Print_Level::Warn, "Warning: Failed to remove external chunk file [{}]: {}\n", pathExternal.string(), ec.message());
+			}
+		}
+		catch (...)
+		{
+			funcInfo(NBT_Print_Level::Warn, "Warning: Failed to remove external chunk file.\n");
+		}
+	}
+
+public:
+	/// @brief 默认构造，不打开任何文件
+	NBT_RegionWriter(void) = default;
+	/// @brief 析构函数，关闭文件
+	~NBT_RegionWriter(void) noexcept
+	{
+		Close();
+	}
+	/// @brief 禁止拷贝构造
+	NBT_RegionWriter(const NBT_RegionWriter &) = delete;
+	/// @brief 禁止拷贝赋值
+	NBT_RegionWriter &operator=(const NBT_RegionWriter &) = delete;
+	/// @brief 默认移动构造
+	NBT_RegionWriter(NBT_RegionWriter &&) = default;
+	/// @brief 默认移动赋值
+	NBT_RegionWriter &operator=(NBT_RegionWriter &&) = default;
+
+	/// @brief 获取当前时间的Unix时间戳，用作区块的默认修改时间
+	/// @return Unix时间戳（秒）
+	static uint32_t CurrentTimestamp(void) noexcept
+	{
+		return (uint32_t)std::time(NULL);
+	}
+
+	/// @brief 打开区域文件用于写入，文件不存在或为空时创建一个空区域
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param pathFileName 区域文件路径
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 打开成功返回true，失败返回false
+	/// @note 如果文件名符合r.X.Z.mca格式，则同时解析区域坐标，用于定位外部区块文件。
+	/// 位置表中与文件头重叠、超出文件范围或与其它区块重叠的条目会被视为不存在，并输出警告。
+	template<typename InfoFunc = NBT_Print>
+	bool Open(const std::filesystem::path &pathFileName, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		Close();
+
+		try
+		{
+			std::error_code ec;
+			bool bExists = std::filesystem::exists(pathFileName, ec);
+			if (ec)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Failed to check existence of [{}]: {}\n", pathFileName.string(), ec.message());
+				return false;
+			}
+
+			if (bExists && !std::filesystem::is_regular_file(pathFileName, ec))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: [{}] exists but is not a regular file.\n", pathFileName.string());
+				return false;
+			}
+
+			//不存在则创建
+			if (!bExists)
+			{
+				std::ofstream fCreate(pathFileName, std::ios_base::binary | std::ios_base::out);
+				if (!fCreate)
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Cannot create file [{}].\n", pathFileName.string());
+					return false;
+				}
+			}
+
+			uintmax_t umFileSize = std::filesystem::file_size(pathFileName, ec);
+			if (ec)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Cannot get file size of [{}]: {}\n", pathFileName.string(), ec.message());
+				return false;
+			}
+
+			fRegion.open(pathFileName, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+			if (!fRegion)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Cannot open file [{}] for writing.\n", pathFileName.string());
+				return false;
+			}
+
+			pathRegion = pathFileName;
+			bHasRegionPos = NBT_RegionFile::ParseRegionPos(pathFileName, i32RegionX, i32RegionZ);
+
+			//空文件写入空文件头
+			if (umFileSize == 0)
+			{
+				std::vector<uint8_t> vHeader(HEADER_SIZE, 0);
+				if (!WriteAt(0, vHeader.data(), vHeader.size()))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Failed to write region header to [{}].\n", pathFileName.string());
+					Close();
+					return false;
+				}
+				umFileSize = HEADER_SIZE;
+			}
+			else if (umFileSize < HEADER_SIZE)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Region file [{}] is too small(size: [{}] bytes) to contain a header.\n", pathFileName.string(), umFileSize);
+				Close();
+				return false;
+			}
+
+			std::vector<uint8_t> vHeader(HEADER_SIZE);
+			if (!ReadAt(0, vHeader.data(), vHeader.size()))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Failed to read region header from [{}].\n", pathFileName.string());
+				Close();
+				return false;
+			}
+
+			//建立扇区占用位图
+			vSectorUsed.assign((size_t)((umFileSize + SECTOR_SIZE - 1) / SECTOR_SIZE), false);
+			MarkSectors(0, HEADER_SECTORS, true);
+
+			for (size_t i = 0; i < CHUNK_COUNT; ++i)
+			{
+				uint32_t u32Location = ReadBigU32(&vHeader[i * 4]);
+				ChunkInfo &ciCur = arrChunkInfo[i];
+				ciCur.u32SectorOffset = u32Location >> 8;
+				ciCur.u8SectorCount = (uint8_t)(u32Location & 0xFF);
+				ciCur.u32Timestamp = ReadBigU32(&vHeader[SECTOR_SIZE + i * 4]);
+
+				if (!ciCur.Exists())
+				{
+					continue;
+				}
+
+				bool bValid = ciCur.u32SectorOffset >= HEADER_SECTORS && (size_t)ciCur.u32SectorOffset + ciCur.u8SectorCount <= vSectorUsed.size();
+				for (size_t j = 0; bValid && j < ciCur.u8SectorCount; ++j)
+				{
+					bValid = !vSectorUsed[ciCur.u32SectorOffset + j];
+				}
+
+				if (!bValid)
+				{
+					funcInfo(NBT_Print_Level::Warn, "Warning: Chunk [{}, {}] has an invalid or overlapping location(sector: [{}], count: [{}]), ignored.\n",
+						i % NBT_RegionFile::CHUNK_PER_SIDE, i / NBT_RegionFile::CHUNK_PER_SIDE, ciCur.u32SectorOffset, ciCur.u8SectorCount);
+					ciCur = ChunkInfo{};
+					continue;
+				}
+
+				MarkSectors(ciCur.u32SectorOffset, ciCur.u8SectorCount, true);
+			}
+
+			return true;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			Close();
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			Close();
+			return false;
+		}
+	}
+
+	/// @brief 把缓冲区中的数据写入文件
+	/// @return 成功返回true，失败返回false
+	bool Flush(void) noexcept
+	{
+		fRegion.flush();
+		return (bool)fRegion;
+	}
+
+	/// @brief 关闭区域文件，清空文件头信息与扇区位图
+	void Close(void) noexcept
+	{
+		if (fRegion.is_open())
+		{
+			fRegion.close();
+		}
+		fRegion.clear();
+		pathRegion.clear();
+		bHasRegionPos = false;
+		i32RegionX = 0;
+		i32RegionZ = 0;
+		arrChunkInfo.fill(ChunkInfo{});
+		vSectorUsed.clear();
+	}
+
+	/// @brief 检查是否打开了区域文件
+	/// @return 打开返回true，否则返回false
+	bool IsOpen(void) const noexcept
+	{
+		return fRegion.is_open();
+	}
+
+	/// @brief 获取从文件名解析出的区域坐标
+	/// @param[out] i32X 区域X坐标
+	/// @param[out] i32Z 区域Z坐标
+	/// @return 文件名符合r.X.Z.mca格式返回true，否则返回false且不修改参数
+	bool GetRegionPos(int32_t &i32X, int32_t &i32Z) const noexcept
+	{
+		if (!bHasRegionPos)
+		{
+			return false;
+		}
+
+		i32X = i32RegionX;
+		i32Z = i32RegionZ;
+		return true;
+	}
+
+	/// @brief 设置区域坐标，用于文件名不符合r.X.Z.mca格式时定位外部区块文件
+	/// @param i32X 区域X坐标
+	/// @param i32Z 区域Z坐标
+	void SetRegionPos(int32_t i32X, int32_t i32Z) noexcept
+	{
+		bHasRegionPos = true;
+		i32RegionX = i32X;
+		i32RegionZ = i32Z;
+	}
+
+	/// @brief 获取区块在位置表与时间戳表中的信息
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @return 区块信息的常量引用
+	const ChunkInfo &GetChunkInfo(int32_t i32ChunkX, int32_t i32ChunkZ) const noexcept
+	{
+		return arrChunkInfo[NBT_RegionFile::ChunkIndex(i32ChunkX, i32ChunkZ)];
+	}
+
+	/// @brief 检查区块是否存在
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @return 存在返回true，否则返回false
+	bool HasChunk(int32_t i32ChunkX, int32_t i32ChunkZ) const noexcept
+	{
+		return GetChunkInfo(i32ChunkX, i32ChunkZ).Exists();
+	}
+
+	/// @brief 获取区域文件当前占用的扇区数（包括空闲扇区）
+	/// @return 扇区数
+	size_t GetSectorCount(void) const noexcept
+	{
+		return vSectorUsed.size();
+	}
+
+	/// @brief 写入已经压缩好的区块数据，替换原有区块
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param enType 数据的压缩类型
+	/// @param spanPayload 压缩后的区块数据
+	/// @param u32Timestamp 区块修改时间
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 写入成功返回true，失败返回false
+	/// @note 数据超过MAX_CHUNK_SECTORS个扇区时写入外部文件，此时必须已知区域坐标。
+	template<typename InfoFunc = NBT_Print>
+	bool WriteChunkPayload(int32_t i32ChunkX, int32_t i32ChunkZ, CompressionType enType, std::span<const uint8_t> spanPayload, uint32_t u32Timestamp = CurrentTimestamp(), InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		if (!IsOpen())
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Region file is not open.\n");
+			return false;
+		}
+
+		if (((uint8_t)enType & NBT_RegionFile::EXTERNAL_FLAG) != 0)
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Invalid chunk compression type [{}].\n", (uint32_t)enType);
+			return false;
+		}
+
+		try
+		{
+			size_t szIdx = NBT_RegionFile::ChunkIndex(i32ChunkX, i32ChunkZ);
+			ChunkInfo ciOld = arrChunkInfo[szIdx];
+			bool bOldExternal = IsExternalChunk(szIdx);
+
+			//区块头为4字节长度与1字节压缩类型，长度包含压缩类型的1字节
+			size_t szSectorCount = (NBT_RegionFile::CHUNK_HEADER_SIZE + spanPayload.size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+			bool bExternal = szSectorCount > MAX_CHUNK_SECTORS;
+
+			uint8_t u8Header[NBT_RegionFile::CHUNK_HEADER_SIZE];
+			if (bExternal)
+			{
+				if (!bHasRegionPos)
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Chunk [{}, {}] needs to be stored externally, but the region position is unknown.\n", i32ChunkX, i32ChunkZ);
+					return false;
+				}
+
+				std::filesystem::path pathExternal = NBT_RegionFile::GetExternalChunkPath(pathRegion, i32RegionX, i32RegionZ, i32ChunkX, i32ChunkZ);
+				if (!NBT_IO::WriteFile(pathExternal, spanPayload, funcInfo))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Cannot write external chunk file [{}].\n", pathExternal.string());
+					return false;
+				}
+
+				szSectorCount = 1;
+				WriteBigU32(u8Header, 1);
+				u8Header[4] = (uint8_t)enType | NBT_RegionFile::EXTERNAL_FLAG;
+			}
+			else
+			{
+				WriteBigU32(u8Header, (uint32_t)spanPayload.size() + 1);
+				u8Header[4] = (uint8_t)enType;
+			}
+
+			//分配扇区：原有扇区足够则原地覆盖，否则先分配新扇区，写入完成后再释放原有扇区
+			size_t szStart = 0;
+			bool bInPlace = ciOld.Exists() && ciOld.u8SectorCount >= szSectorCount;
+			if (bInPlace)
+			{
+				szStart = ciOld.u32SectorOffset;
+			}
+			else
+			{
+				szStart = FindFreeSectors(szSectorCount);
+				if (szStart + szSectorCount > MAX_SECTOR_OFFSET)
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Region file is full, cannot allocate [{}] sectors.\n", szSectorCount);
+					return false;
+				}
+			}
+
+			//写入区块数据，并补零到扇区边界
+			uint64_t u64Pos = (uint64_t)szStart * SECTOR_SIZE;
+			size_t szDataSize = bExternal ? sizeof(u8Header) : sizeof(u8Header) + spanPayload.size();
+			static constexpr uint8_t u8Zero[SECTOR_SIZE] = {};
+			if (!WriteAt(u64Pos, u8Header, sizeof(u8Header)) ||
+				(!bExternal && !spanPayload.empty() && !WriteAt(u64Pos + sizeof(u8Header), spanPayload.data(), spanPayload.size())) ||
+				!WriteAt(u64Pos + szDataSize, u8Zero, szSectorCount * SECTOR_SIZE - szDataSize))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Failed to write chunk [{}, {}] data.\n", i32ChunkX, i32ChunkZ);
+				return false;
+			}
+
+			//更新位图
+			if (bInPlace)
+			{
+				MarkSectors(szStart + szSectorCount, ciOld.u8SectorCount - szSectorCount, false);
+			}
+			else
+			{
+				MarkSectors(szStart, szSectorCount, true);
+				if (ciOld.Exists())
+				{
+					MarkSectors(ciOld.u32SectorOffset, ciOld.u8SectorCount, false);
+				}
+			}
+
+			//更新文件头
+			arrChunkInfo[szIdx] = ChunkInfo{ (uint32_t)szStart, (uint8_t)szSectorCount, u32Timestamp };
+			if (!WriteHeaderEntry(szIdx))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Failed to write chunk [{}, {}] location.\n", i32ChunkX, i32ChunkZ);
+				return false;
+			}
+
+			//原来是外部区块而现在不是，删除外部文件
+			if (bOldExternal && !bExternal)
+			{
+				RemoveExternalFile(i32ChunkX, i32ChunkZ, funcInfo);
+			}
+
+			return true;
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			return false;
+		}
+	}
+
+	/// @brief 序列化并压缩 NBT_Type::Compound 对象，然后写入区块，替换原有区块
+	/// @tparam SortPolicy 键排序策略，请参考NBT_Writer::WriteNBT的说明
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param tCompound 区块数据
+	/// @param enType 压缩类型，支持GZip、Zlib与None
+	/// @param iLevel 压缩等级，-1为zlib默认等级
+	/// @param u32Timestamp 区块修改时间
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 写入成功返回true，失败返回false
+	/// @note 序列化与压缩在同一遍内完成，使用的暂存区在多次写入间复用。
+	template<typename SortPolicy = NBT_Writer::DefaultCompoundSort<true>, typename InfoFunc = NBT_Print>
+	bool WriteChunk(int32_t i32ChunkX, int32_t i32ChunkZ, const NBT_Type::Compound &tCompound, CompressionType enType = CompressionType::Zlib, int iLevel = -1,
+		uint32_t u32Timestamp = CurrentTimestamp(), size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		vPayload.clear();
+
+		switch (enType)
+		{
+		case CompressionType::None:
+			{
+				if (!NBT_Writer::WriteNBT<SortPolicy>(vPayload, 0, tCompound, szStackDepth, funcInfo))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: WriteNBT failed for chunk [{}, {}].\n", i32ChunkX, i32ChunkZ);
+					return false;
+				}
+			}
+			break;
+		case CompressionType::GZip:
+		case CompressionType::Zlib:
+			{
+#ifdef CJF2_NBT_CPP_USE_ZLIB
+				try
+				{
+					NBT_IO::DeflateOutputStream OptStream(
+						[this](const uint8_t *pData, size_t szSize) -> bool
+						{
+							vPayload.insert(vPayload.end(), pData, pData + szSize);
+							return true;
+						}, iLevel, enType == CompressionType::GZip, SECTOR_SIZE * 4);
+
+					if (!NBT_Writer::WriteNBT<SortPolicy>(OptStream, tCompound, szStackDepth, funcInfo))
+					{
+						funcInfo(NBT_Print_Level::Err, "Error: WriteNBT failed for chunk [{}, {}].\n", i32ChunkX, i32ChunkZ);
+						return false;
+					}
+
+					if (!OptStream.FinishNoThrow(funcInfo))
+					{
+						funcInfo(NBT_Print_Level::Err, "Error: Failed to compress chunk [{}, {}].\n", i32ChunkX, i32ChunkZ);
+						return false;
+					}
+				}
+				catch (const std::bad_alloc &e)
+				{
+					funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+					return false;
+				}
+#else
+				funcInfo(NBT_Print_Level::Err, "Error: Zlib support is not enabled, cannot compress chunk data.\n");
+				return false;
+#endif
+			}
+			break;
+		default:
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Unsupported chunk compression type [{}].\n", (uint32_t)enType);
+				return false;
+			}
+			break;
+		}
+
+		return WriteChunkPayload(i32ChunkX, i32ChunkZ, enType, std::span<const uint8_t>(vPayload.data(), vPayload.size()), u32Timestamp, funcInfo);
+	}
+
+	/// @brief 删除区块，释放其占用的扇区，并清空位置表与时间戳表中的条目
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param i32ChunkX 区块X坐标
+	/// @param i32ChunkZ 区块Z坐标
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 删除成功（包括区块本来就不存在）返回true，失败返回false
+	/// @note 如果区块存储在外部文件中，外部文件也会被删除。区域文件的大小不会缩小。
+	template<typename InfoFunc = NBT_Print>
+	bool DeleteChunk(int32_t i32ChunkX, int32_t i32ChunkZ, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		if (!IsOpen())
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Region file is not open.\n");
+			return false;
+		}
+
+		size_t szIdx = NBT_RegionFile::ChunkIndex(i32ChunkX, i32ChunkZ);
+		ChunkInfo ciOld = arrChunkInfo[szIdx];
+		if (!ciOld.Exists())
+		{
+			return true;
+		}
+
+		bool bOldExternal = IsExternalChunk(szIdx);
+
+		arrChunkInfo[szIdx] = ChunkInfo{};
+		if (!WriteHeaderEntry(szIdx))
+		{
+			funcInfo(NBT_Print_Level::Err, "Error: Failed to write chunk [{}, {}] location.\n", i32ChunkX, i32ChunkZ);
+			return false;
+		}
+
+		MarkSectors(ciOld.u32SectorOffset, ciOld.u8SectorCount, false);
+
+		if (bOldExternal)
+		{
+			RemoveExternalFile(i32ChunkX, i32ChunkZ, funcInfo);
+		}
+
+		return true;
+	}
+};
@@ -0,0 +1,800 @@
+﻿#pragma once
+
+#include <new>//std::bad_alloc
+#include <string_view>//std::string_view
+#include <charconv>//std::from_chars
+#include <array>//std::array
+#include <algorithm>//std::min
+#include <stdint.h>//类型定义
+#include <stddef.h>//size_t
+#include <utility>//std::move
+
+#include "NBT_Print.hpp"//打印输出
+#include "NBT_Node.hpp"//nbt类型
+
+/// @file
+/// @brief SNBT（字符串形式的NBT）解析器
+
+/// @brief 把SNBT文本解析为NBT对象，与NBT_Helper::Serialize的SNBT输出互补
+/// @note 解析器对输入只扫描一遍，数值直接在输入上使用std::from_chars转换，
+/// 不含转义的字符串直接从输入构造，不产生任何中间缓冲区。支持的语法：
+/// - 集合：{key:value,...}，键可以是无引号或有引号的字符串，重复的键后来的值替换之前的值并产生一个警告
+/// - 列表：[value,...]，允许元素类型不同（与NBT_Type::List一致）
+/// - 数组：[B;...]、[I;...]、[L;...]，元素的后缀可以省略，但不能与数组类型不符
+/// - 有引号的字符串："..."或'...'，支持\\\\、\\"、\\'、\\n、\\t、\\r、\\b、\\f、\\s与\\xHH、\\uHHHH、\\UHHHHHHHH转义
+/// - 无引号的文本：由0-9 A-Z a-z _ - . +组成，按以下规则转换为值，都不符合时作为字符串：
+///   - 整数加后缀b、s、i、l（不区分大小写）为Byte、Short、Int、Long，无后缀为Int
+///   - 小数加后缀f、d（不区分大小写）为Float、Double，无后缀但包含小数点为Double
+///   - true与false为Byte的1与0
+///   - 数值超出对应类型的范围时作为字符串（与游戏的行为一致）
+///
+/// 输入默认为UTF-8编码（开头的BOM会被跳过），字符串会被转换为Modified-UTF-8；
+/// 如果输入本身就是Modified-UTF-8（例如NBT_Helper::Serialize的SNBT输出），
+/// 可以把模板参数bMUTF8Input设为true跳过转换，此时通过NBT_Type::String::GetCharTypeView传入即可。
+/// 大文件可以用NBT_IO::MappedFile映射后直接作为输入，不需要读入内存。
+class NBT_SNBT_Reader
+{
+	/// @brief 禁止构造
+	NBT_SNBT_Reader(void) = delete;
+	/// @brief 禁止析构
+	~NBT_SNBT_Reader(void) = delete;
+
+private:
+	using CharType = NBT_Type::String::value_type;
+
+	//解析状态，pBeg仅用于出错时计算行列号
+	struct ParseState
+	{
+		const char *pBeg;
+		const char *pCur;
+		const char *pEnd;
+	};
+
+	static constexpr std::array<bool, 256> MakeUnquotedCharTable(void) noexcept
+	{
+		std::array<bool, 256> arrTable{};
+		for (int c = '0'; c <= '9'; ++c)
+		{
+			arrTable[c] = true;
+		}
+		for (int c = 'A'; c <= 'Z'; ++c)
+		{
+			arrTable[c] = true;
+			arrTable[c - 'A' + 'a'] = true;
+		}
+		arrTable['_'] = true;
+		arrTable['-'] = true;
+		arrTable['.'] = true;
+		arrTable['+'] = true;
+		return arrTable;
+	}
+
+	static bool IsUnquotedChar(char c) noexcept
+	{
+		static constexpr std::array<bool, 256> arrUnquotedChar = MakeUnquotedCharTable();
+		return arrUnquotedChar[(uint8_t)c];
+	}
+
+	static bool IsDigit(char c) noexcept
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	static void SkipWhitespace(ParseState &ps) noexcept
+	{
+		while (ps.pCur != ps.pEnd && (*ps.pCur == ' ' || *ps.pCur == '\t' || *ps.pCur == '\n' || *ps.pCur == '\r'))
+		{
+			++ps.pCur;
+		}
+	}
+
+	//计算位置所在的行列号（从1开始），仅在出错时调用
+	static void GetLineColumn(const ParseState &ps, const char *pPos, size_t &szLine, size_t &szColumn) noexcept
+	{
+		szLine = 1;
+		const char *pLineBeg = ps.pBeg;
+		for (const char *p = ps.pBeg; p != pPos; ++p)
+		{
+			if (*p == '\n')
+			{
+				++szLine;
+				pLineBeg = p + 1;
+			}
+		}
+		szColumn = (size_t)(pPos - pLineBeg) + 1;
+	}
+
+	template<typename InfoFunc>
+	static bool ReportError(const ParseState &ps, const char *pPos, std::string_view svReason, InfoFunc &funcInfo) noexcept
+	{
+		size_t szLine = 0, szColumn = 0;
+		GetLineColumn(ps, pPos, szLine, szColumn);
+		std::string_view svNear(pPos, std::min((size_t)(ps.pEnd - pPos), (size_t)16));
+		funcInfo(NBT_Print_Level::Err, "Error: {} at line [{}] column [{}], near \"{}\".\n", svReason, szLine, szColumn, svNear);
+		return false;
+	}
+
+	//无引号的文本只包含ASCII字符，可以直接构造
+	static std::string_view ReadUnquoted(ParseState &ps) noexcept
+	{
+		const char *pStart = ps.pCur;
+		while (ps.pCur != ps.pEnd && IsUnquotedChar(*ps.pCur))
+		{
+			++ps.pCur;
+		}
+		return std::string_view(pStart, (size_t)(ps.pCur - pStart));
+	}
+
+	//追加一段原始文本，UTF-8输入只有包含0x00或4字节序列时才与Modified-UTF-8不同，需要转换
+	template<bool bMUTF8Input>
+	static void AppendRaw(NBT_Type::String &sOut, const char *pData, size_t szLength)
+	{
+		if constexpr (!bMUTF8Input)
+		{
+			for (size_t i = 0; i < szLength; ++i)
+			{
+				if (pData[i] == 0x00 || (uint8_t)pData[i] >= 0xF0)
+				{
+					sOut += NBT_Type::String(std::string_view(pData, szLength));
+					return;
+				}
+			}
+		}
+
+		sOut.append((const CharType *)pData, szLength);
+	}
+
+	//以Modified-UTF-8追加一个UTF-16码元（0也使用两字节形式）
+	static void AppendCodeUnit(NBT_Type::String &sOut, uint16_t u16Char)
+	{
+		if (u16Char != 0 && u16Char < 0x80)
+		{
+			sOut.push_back((CharType)u16Char);
+		}
+		else if (u16Char < 0x800)
+		{
+			sOut.push_back((CharType)(0xC0 | (u16Char >> 6)));
+			sOut.push_back((CharType)(0x80 | (u16Char & 0x3F)));
+		}
+		else
+		{
+			sOut.push_back((CharType)(0xE0 | (u16Char >> 12)));
+			sOut.push_back((CharType)(0x80 | ((u16Char >> 6) & 0x3F)));
+			sOut.push_back((CharType)(0x80 | (u16Char & 0x3F)));
+		}
+	}
+
+	template<bool bMUTF8Input, typename InfoFunc>
+	static bool ParseQuotedString(ParseState &ps, NBT_Type::String &sOut, InfoFunc &funcInfo)
+	{
+		const char *pStart = ps.pCur;
+		const char cQuote = *ps.pCur++;
+		const char *pSegment = ps.pCur;
+
+		while (true)
+		{
+			//跳过普通字符，一次性追加整段
+			while (ps.pCur != ps.pEnd && *ps.pCur != cQuote && *ps.pCur != '\\')
+			{
+				++ps.pCur;
+			}
+
+			if (ps.pCur == ps.pEnd)
+			{
+				return ReportError(ps, pStart, "Unterminated quoted string", funcInfo);
+			}
+
+			AppendRaw<bMUTF8Input>(sOut, pSegment, (size_t)(ps.pCur - pSegment));
+			if (*ps.pCur == cQuote)
+			{
+				++ps.pCur;
+				return true;
+			}
+
+			//处理转义
+			const char *pEscape = ps.pCur++;
+			if (ps.pCur == ps.pEnd)
+			{
+				return ReportError(ps, pStart, "Unterminated quoted string", funcInfo);
+			}
+
+			const char cEscape = *ps.pCur++;
+			switch (cEscape)
+			{
+			case '\\':
+			case '\'':
+			case '"':
+				sOut.push_back((CharType)cEscape);
+				break;
+			case 'n':
+				sOut.push_back((CharType)'\n');
+				break;
+			case 't':
+				sOut.push_back((CharType)'\t');
+				break;
+			case 'r':
+				sOut.push_back((CharType)'\r');
+				break;
+			case 'b':
+				sOut.push_back((CharType)'\b');
+				break;
+			case 'f':
+				sOut.push_back((CharType)'\f');
+				break;
+			case 's':
+				sOut.push_back((CharType)' ');
+				break;
+			case 'x':
+			case 'u':
+			case 'U':
+				{
+					const size_t szDigits = cEscape == 'x' ? 2 : (cEscape == 'u' ? 4 : 8);
+					uint32_t u32Char = 0;
+					if ((size_t)(ps.pEnd - ps.pCur) < szDigits ||
+						std::from_chars(ps.pCur, ps.pCur + szDigits, u32Char, 16).ptr != ps.pCur + szDigits ||
+						u32Char > 0x10FFFF)
+					{
+						return ReportError(ps, pEscape, "Invalid unicode escape", funcInfo);
+					}
+					ps.pCur += szDigits;
+
+					if (u32Char >= 0x10000)//拆分为代理对
+					{
+						u32Char -= 0x10000;
+						AppendCodeUnit(sOut, (uint16_t)(0xD800 + (u32Char >> 10)));
+						AppendCodeUnit(sOut, (uint16_t)(0xDC00 + (u32Char & 0x3FF)));
+					}
+					else
+					{
+						AppendCodeUnit(sOut, (uint16_t)u32Char);
+					}
+				}
+				break;
+			default:
+				return ReportError(ps, pEscape, "Invalid escape", funcInfo);
+			}
+
+			pSegment = ps.pCur;
+		}
+	}
+
+	template<bool bMUTF8Input, typename InfoFunc>
+	static bool ParseKey(ParseState &ps, NBT_Type::String &sKey, InfoFunc &funcInfo)
+	{
+		if (ps.pCur != ps.pEnd && (*ps.pCur == '"' || *ps.pCur == '\''))
+		{
+			return ParseQuotedString<bMUTF8Input>(ps, sKey, funcInfo);
+		}
+
+		std::string_view svKey = ReadUnquoted(ps);
+		if (svKey.empty())
+		{
+			return ReportError(ps, ps.pCur, "Expected a key", funcInfo);
+		}
+
+		sKey.assign((const CharType *)svKey.data(), svKey.size());
+		return true;
+	}
+
+	//[-+]?(0|[1-9][0-9]*)
+	static bool IsIntegerText(std::string_view svText) noexcept
+	{
+		size_t i = 0;
+		if (i < svText.size() && (svText[i] == '+' || svText[i] == '-'))
+		{
+			++i;
+		}
+
+		if (i == svText.size())
+		{
+			return false;
+		}
+
+		if (svText[i] == '0')//不允许前导0
+		{
+			return i + 1 == svText.size();
+		}
+
+		for (; i < svText.size(); ++i)
+		{
+			if (!IsDigit(svText[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//[-+]?([0-9]+[.]?|[0-9]*[.][0-9]+)(e[-+]?[0-9]+)?，bRequireDot为true时必须包含小数点
+	static bool IsFloatText(std::string_view svText, bool bRequireDot) noexcept
+	{
+		size_t i = 0;
+		const size_t szSize = svText.size();
+		if (i < szSize && (svText[i] == '+' || svText[i] == '-'))
+		{
+			++i;
+		}
+
+		size_t szDigits = 0;
+		while (i < szSize && IsDigit(svText[i]))
+		{
+			++i;
+			++szDigits;
+		}
+
+		bool bDot = false;
+		if (i < szSize && svText[i] == '.')
+		{
+			bDot = true;
+			++i;
+			while (i < szSize && IsDigit(svText[i]))
+			{
+				++i;
+				++szDigits;
+			}
+		}
+
+		if (szDigits == 0 || (bRequireDot && !bDot))
+		{
+			return false;
+		}
+
+		if (i < szSize && (svText[i] == 'e' || svText[i] == 'E'))
+		{
+			++i;
+			if (i < szSize && (svText[i] == '+' || svText[i] == '-'))
+			{
+				++i;
+			}
+
+			size_t szExpDigits = 0;
+			while (i < szSize && IsDigit(svText[i]))
+			{
+				++i;
+				++szExpDigits;
+			}
+
+			if (szExpDigits == 0)
+			{
+				return false;
+			}
+		}
+
+		return i == szSize;
+	}
+
+	//std::from_chars不接受正号
+	template<typename T>
+	static bool ParseNumber(std::string_view svText, T &tOut) noexcept
+	{
+		if (!svText.empty() && svText[0] == '+')
+		{
+			svText.remove_prefix(1);
+		}
+
+		auto [ptr, ec] = std::from_chars(svText.data(), svText.data() + svText.size(), tOut);
+		return ec == std::errc{} && ptr == svText.data() + svText.size();
+	}
+
+	template<typename T>
+	static bool TrySetInteger(std::string_view svText, NBT_Node &nodeOut)
+	{
+		T tVal{};
+		if (!IsIntegerText(svText) || !ParseNumber(svText, tVal))
+		{
+			return false;
+		}
+
+		nodeOut.Set<T>(tVal);
+		return true;
+	}
+
+	template<typename T>
+	static bool TrySetFloat(std::string_view svText, bool bRequireDot, NBT_Node &nodeOut)
+	{
+		T tVal{};
+		if (!IsFloatText(svText, bRequireDot) || !ParseNumber(svText, tVal))
+		{
+			return false;
+		}
+
+		nodeOut.Set<T>(tVal);
+		return true;
+	}
+
+	//把无引号的文本转换为数值、布尔或字符串
+	static void SetUnquotedValue(std::string_view svText, NBT_Node &nodeOut)
+	{
+		if (svText == "true")
+		{
+			nodeOut.Set<NBT_Type::Byte>((NBT_Type::Byte)1);
+			return;
+		}
+		else if (svText == "false")
+		{
+			nodeOut.Set<NBT_Type::Byte>((NBT_Type::Byte)0);
+			return;
+		}
+
+		if (svText.size() >= 2)
+		{
+			std::string_view svBody = svText.substr(0, svText.size() - 1);
+			switch (svText.back())
+			{
+			case 'b':
+			case 'B':
+				if (TrySetInteger<NBT_Type::Byte>(svBody, nodeOut))
+				{
+					return;
+				}
+				break;
+			case 's':
+			case 'S':
+				if (TrySetInteger<NBT_Type::Short>(svBody, nodeOut))
+				{
+					return;
+				}
+				break;
+			case 'i':
+			case 'I':
+				if (TrySetInteger<NBT_Type::Int>(svBody, nodeOut))
+				{
+					return;
+				}
+				break;
+			case 'l':
+			case 'L':
+				if (TrySetInteger<NBT_Type::Long>(svBody, nodeOut))
+				{
+					return;
+				}
+				break;
+			case 'f':
+			case 'F':
+				if (TrySetFloat<NBT_Type::Float>(svBody, false, nodeOut))
+				{
+					return;
+				}
+				break;
+			case 'd':
+			case 'D':
+				if (TrySetFloat<NBT_Type::Double>(svBody, false, nodeOut))
+				{
+					return;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		//无后缀
+		if (TrySetInteger<NBT_Type::Int>(svText, nodeOut) ||
+			TrySetFloat<NBT_Type::Double>(svText, true, nodeOut))
+		{
+			return;
+		}
+
+		nodeOut.Set<NBT_Type::String>((const CharType *)svText.data(), svText.size());
+	}
+
+	//数组元素的后缀可以省略，但必须与数组类型一致
+	template<typename ArrayType, typename InfoFunc>
+	static bool ParseArray(ParseState &ps, ArrayType &arrOut, char cSuffix, InfoFunc &funcInfo)
+	{
+		using ValueType = typename ArrayType::value_type;
+
+		SkipWhitespace(ps);
+		if (ps.pCur != ps.pEnd && *ps.pCur == ']')
+		{
+			++ps.pCur;
+			return true;
+		}
+
+		while (true)
+		{
+			SkipWhitespace(ps);
+			const char *pElement = ps.pCur;
+			std::string_view svElement = ReadUnquoted(ps);
+			if (svElement.size() >= 2 && (svElement.back() == cSuffix || svElement.back() == cSuffix - 'A' + 'a'))
+			{
+				svElement.remove_suffix(1);
+			}
+
+			ValueType tVal{};
+			if (!IsIntegerText(svElement) || !ParseNumber(svElement, tVal))
+			{
+				return ReportError(ps, pElement, "Invalid array element", funcInfo);
+			}
+			arrOut.push_back(tVal);
+
+			SkipWhitespace(ps);
+			if (ps.pCur == ps.pEnd)
+			{
+				return ReportError(ps, ps.pCur, "Unterminated array", funcInfo);
+			}
+			else if (*ps.pCur == ',')
+			{
+				++ps.pCur;
+			}
+			else if (*ps.pCur == ']')
+			{
+				++ps.pCur;
+				return true;
+			}
+			else
+			{
+				return ReportError(ps, ps.pCur, "Expected ',' or ']'", funcInfo);
+			}
+		}
+	}
+
+	template<bool bMUTF8Input, typename InfoFunc>
+	static bool ParseList(ParseState &ps, NBT_Type::List &listOut, size_t szStackDepth, InfoFunc &funcInfo)
+	{
+		if (szStackDepth == 0)
+		{
+			return ReportError(ps, ps.pCur, "Nesting depth exceeded", funcInfo);
+		}
+
+		SkipWhitespace(ps);
+		if (ps.pCur != ps.pEnd && *ps.pCur == ']')
+		{
+			++ps.pCur;
+			return true;
+		}
+
+		while (true)
+		{
+			//先放入空节点再原地解析，避免移动
+			NBT_Node &nodeElement = listOut.AddBack(NBT_Node{});
+			if (!ParseValue<bMUTF8Input>(ps, nodeElement, szStackDepth - 1, funcInfo))
+			{
+				return false;
+			}
+
+			SkipWhitespace(ps);
+			if (ps.pCur == ps.pEnd)
+			{
+				return ReportError(ps, ps.pCur, "Unterminated list", funcInfo);
+			}
+			else if (*ps.pCur == ',')
+			{
+				++ps.pCur;
+			}
+			else if (*ps.pCur == ']')
+			{
+				++ps.pCur;
+				return true;
+			}
+			else
+			{
+				return ReportError(ps, ps.pCur, "Expected ',' or ']'", funcInfo);
+			}
+		}
+	}
+
+	template<bool bMUTF8Input, typename InfoFunc>
+	static bool ParseCompound(ParseState &ps, NBT_Type::Compound &cpdOut, size_t szStackDepth, InfoFunc &funcInfo)
+	{
+		if (szStackDepth == 0)
+		{
+			return ReportError(ps, ps.pCur, "Nesting depth exceeded", funcInfo);
+		}
+
+		SkipWhitespace(ps);
+		if (ps.pCur != ps.pEnd && *ps.pCur == '}')
+		{
+			++ps.pCur;
+			return true;
+		}
+
+		while (true)
+		{
+			SkipWhitespace(ps);
+			const char *pKey = ps.pCur;
+			NBT_Type::String sKey{};
+			if (!ParseKey<bMUTF8Input>(ps, sKey, funcInfo))
+			{
+				return false;
+			}
+
+			SkipWhitespace(ps);
+			if (ps.pCur == ps.pEnd || *ps.pCur != ':')
+			{
+				return ReportError(ps, ps.pCur, "Expected ':'", funcInfo);
+			}
+			++ps.pCur;
+
+			//先放入空节点再原地解析，避免移动
+			auto [itEntry, bInserted] = cpdOut.TryPut(std::move(sKey), NBT_Node{});
+			if (!bInserted)
+			{
+				size_t szLine = 0, szColumn = 0;
+				GetLineColumn(ps, pKey, szLine, szColumn);
+				funcInfo(NBT_Print_Level::Warn, "Warning: Duplicate key \"{}\" at line [{}] column [{}], the new value will replace the old one.\n",
+					itEntry->first.ToCharTypeUTF8(), szLine, szColumn);
+				itEntry->second = NBT_Node{};
+			}
+
+			if (!ParseValue<bMUTF8Input>(ps, itEntry->second, szStackDepth - 1, funcInfo))
+			{
+				return false;
+			}
+
+			SkipWhitespace(ps);
+			if (ps.pCur == ps.pEnd)
+			{
+				return ReportError(ps, ps.pCur, "Unterminated compound", funcInfo);
+			}
+			else if (*ps.pCur == ',')
+			{
+				++ps.pCur;
+			}
+			else if (*ps.pCur == '}')
+			{
+				++ps.pCur;
+				return true;
+			}
+			else
+			{
+				return ReportError(ps, ps.pCur, "Expected ',' or '}'", funcInfo);
+			}
+		}
+	}
+
+	template<bool bMUTF8Input, typename InfoFunc>
+	static bool ParseValue(ParseState &ps, NBT_Node &nodeOut, size_t szStackDepth, InfoFunc &funcInfo)
+	{
+		SkipWhitespace(ps);
+		if (ps.pCur == ps.pEnd)
+		{
+			return ReportError(ps, ps.pCur, "Unexpected end of input", funcInfo);
+		}
+
+		switch (*ps.pCur)
+		{
+		case '{':
+			{
+				++ps.pCur;
+				return ParseCompound<bMUTF8Input>(ps, nodeOut.Set<NBT_Type::Compound>(), szStackDepth, funcInfo);
+			}
+			break;
+		case '[':
+			{
+				++ps.pCur;
+				if (ps.pEnd - ps.pCur >= 2 && ps.pCur[1] == ';')//类型数组
+				{
+					switch (ps.pCur[0])
+					{
+					case 'B':
+						ps.pCur += 2;
+						return ParseArray(ps, nodeOut.Set<NBT_Type::ByteArray>(), 'B', funcInfo);
+					case 'I':
+						ps.pCur += 2;
+						return ParseArray(ps, nodeOut.Set<NBT_Type::IntArray>(), 'I', funcInfo);
+					case 'L':
+						ps.pCur += 2;
+						return ParseArray(ps, nodeOut.Set<NBT_Type::LongArray>(), 'L', funcInfo);
+					default:
+						return ReportError(ps, ps.pCur, "Unknown array type", funcInfo);
+					}
+				}
+
+				return ParseList<bMUTF8Input>(ps, nodeOut.Set<NBT_Type::List>(), szStackDepth, funcInfo);
+			}
+			break;
+		case '"':
+		case '\'':
+			{
+				return ParseQuotedString<bMUTF8Input>(ps, nodeOut.Set<NBT_Type::String>(), funcInfo);
+			}
+			break;
+		default:
+			{
+				const char *pToken = ps.pCur;
+				std::string_view svToken = ReadUnquoted(ps);
+				if (svToken.empty())
+				{
+					return ReportError(ps, pToken, "Unexpected character", funcInfo);
+				}
+
+				SetUnquotedValue(svToken, nodeOut);
+				return true;
+			}
+			break;
+		}
+	}
+
+	template<bool bMUTF8Input>
+	static ParseState MakeState(std::string_view svSnbt) noexcept
+	{
+		ParseState ps{ svSnbt.data(), svSnbt.data(), svSnbt.data() + svSnbt.size() };
+		if constexpr (!bMUTF8Input)
+		{
+			if (svSnbt.starts_with("\xEF\xBB\xBF"))//跳过BOM
+			{
+				ps.pCur += 3;
+			}
+		}
+		return ps;
+	}
+
+	template<typename InfoFunc>
+	static bool CheckTrailing(ParseState &ps, InfoFunc &funcInfo) noexcept
+	{
+		SkipWhitespace(ps);
+		if (ps.pCur != ps.pEnd)
+		{
+			return ReportError(ps, ps.pCur, "Unexpected trailing data", funcInfo);
+		}
+		return true;
+	}
+
+public:
+	/// @brief 从SNBT文本中读取一个集合，并把其中的条目合并到tCompound中
+	/// @tparam bMUTF8Input 输入是否为Modified-UTF-8编码，为false则输入为UTF-8编码
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param svSnbt SNBT文本，最外层必须是一个集合
+	/// @param[out] tCompound 用于返回读取结果的对象
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	/// @note 与NBT_Reader::ReadNBT一致，函数不会清除tCompound对象的数据，重复的键后来的值会替换原先的值，并产生一个警告信息。
+	/// 出错时tCompound中可能留有已经解析的部分数据。
+	/// 对象经过NBT_Helper::Serialize输出SNBT后，可以通过此函数（bMUTF8Input为true）读回相同的对象。
+	template<bool bMUTF8Input = false, typename InfoFunc = NBT_Print>
+	static bool ReadSNBT(std::string_view svSnbt, NBT_Type::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		try
+		{
+			ParseState ps = MakeState<bMUTF8Input>(svSnbt);
+			SkipWhitespace(ps);
+			if (ps.pCur == ps.pEnd || *ps.pCur != '{')
+			{
+				return ReportError(ps, ps.pCur, "Expected '{'", funcInfo);
+			}
+			++ps.pCur;
+
+			return ParseCompound<bMUTF8Input>(ps, tCompound, szStackDepth, funcInfo) && CheckTrailing(ps, funcInfo);
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			return false;
+		}
+	}
+
+	/// @brief 从SNBT文本中读取任意一个值
+	/// @tparam bMUTF8Input 输入是否为Modified-UTF-8编码，为false则输入为UTF-8编码
+	/// @tparam InfoFunc 错误信息输出仿函数类型
+	/// @param svSnbt SNBT文本，例如命令参数中的单个值
+	/// @param[out] nodeOut 用于返回读取结果的对象，原有的值会被替换
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 读取成功返回true，失败返回false
+	template<bool bMUTF8Input = false, typename InfoFunc = NBT_Print>
+	static bool ReadSNBTValue(std::string_view svSnbt, NBT_Node &nodeOut, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		try
+		{
+			ParseState ps = MakeState<bMUTF8Input>(svSnbt);
+			return ParseValue<bMUTF8Input>(ps, nodeOut, szStackDepth, funcInfo) && CheckTrailing(ps, funcInfo);
+		}
+		catch (const std::bad_alloc &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			return false;
+		}
+	}
+};
@@ -3,9 +3,11 @@
 #include "NBT_Node.hpp"//nbt类型
 #include "NBT_Visitor.hpp"//鸭子类与部分实现
 #include "NBT_Endian.hpp"//字节序
+#include "NBT_Format.hpp"//格式策略
 #include "NBT_IO.hpp"//IO流对象
 
 #include <stdint.h>
+#include <concepts>//std::convertible_to
 
 /// @file
 /// @brief NBT类型二进制流扫描工具
@@ -21,6 +23,9 @@ class NBT_Scanner
 	/// @brief 禁止析构
 	~NBT_Scanner(void) = delete;
 
+	//按需解析时复用内部的解析与跳过例程
+	friend class NBT_LazyCompound;
+
 protected:
 	///@cond
 	enum class Control : uint8_t
@@ -209,9 +214,10 @@ catch(...)\
 	return ret;\
 }
 
-	template<bool bNoCheck = false, typename T, typename InputStream, typename Visitor>
+	//按格式策略的字节序读取定长数值，bNoCheck为true则不进行任何检查
+	template<typename Format, bool bNoCheck = false, typename T, typename InputStream, typename Visitor>
 	requires std::integral<T>
-	static inline std::conditional_t<bNoCheck, void, bool> ReadBigEndian(InputStream &tData, T &tVal, Visitor &tVisitor) noexcept
+	static inline std::conditional_t<bNoCheck, void, bool> ReadEndian(InputStream &tData, T &tVal, Visitor &tVisitor) noexcept
 	{
 		if constexpr (!bNoCheck)
 		{
@@ -224,9 +230,9 @@ catch(...)\
 			}
 		}
 
-		T BigEndianVal{};
-		tData.GetRange((void *)&BigEndianVal, sizeof(BigEndianVal));
-		tVal = NBT_Endian::BigToNativeAny(BigEndianVal);
+		T RawVal{};
+		tData.GetRange((void *)&RawVal, sizeof(RawVal));
+		tVal = Format::ToNative(RawVal);
 
 		if constexpr (!bNoCheck)
 		{
@@ -234,13 +240,50 @@ catch(...)\
 		}
 	}
 
-	template<typename InputStream, typename Visitor>
+	//按格式策略读取字段：VarInt字段通过策略解码，其余字段与ReadEndian相同
+	template<typename Format, typename T, typename InputStream, typename Visitor>
+	requires std::integral<T>
+	static inline bool ReadValue(InputStream &tData, T &tVal, Visitor &tVisitor) noexcept
+	{
+		if constexpr (Format::template bVarIntField<T>)
+		{
+			if (!Format::ReadField(tData, tVal))
+			{
+				Error(OutOfRangeError, tData, tVisitor, "{}:\nVarInt field truncated, too long or out of range, size [{}]", __FUNCTION__,
+					sizeof(T));
+				STACK_TRACEBACK("ReadField Test");
+				return false;
+			}
+
+			return true;
+		}
+		else
+		{
+			return ReadEndian<Format>(tData, tVal, tVisitor);
+		}
+	}
+
+	//跳过连续的VarInt元素
+	template<typename Format, typename InputStream, typename Visitor>
+	static bool SkipVarIntElements(InputStream &tData, size_t szCount, Visitor &tVisitor) noexcept
+	{
+		if (!Format::SkipVarInt(tData, szCount))
+		{
+			Error(OutOfRangeError, tData, tVisitor, "{}:\nVarInt elements truncated, Count: [{}]", __FUNCTION__, szCount);
+			STACK_TRACEBACK("SkipVarInt Test");
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename Format, typename InputStream, typename Visitor>
 	static bool GetName(InputStream &tData, NBT_Type::String &tName, Visitor &tVisitor) noexcept
 	{
 	MYTRY;
 		//读取长度
 		NBT_Type::StringLength wStringLength = 0;//w->word=2*byte
-		if (!ReadBigEndian(tData, wStringLength, tVisitor))
+		if (!ReadValue<Format>(tData, wStringLength, tVisitor))
 		{
 			STACK_TRACEBACK("wStringLength Read");
 			return false;
@@ -267,12 +310,83 @@ catch(...)\
 	MYCATCH(false);
 	}
 
-	template<typename InputStream, typename Visitor>
+	//访问器是否工作在视图模式：只接受视图而不接受字符串对象的访问器，键名与字符串结果以视图传递
+	template<typename Visitor>
+	static constexpr inline bool bViewVisitor = !IsLookLike_NBT_Visitor<Visitor> && IsLookLike_NBT_ViewVisitor<Visitor>;
+
+	//读取名称到视图
+	//如果流提供了CurrentData（数据连续存储），则视图直接指向流中的数据，不进行任何拷贝与分配，
+	//否则先读到sStorage中，再让视图指向sStorage，调用者需要在视图使用期间保持sStorage不变
+	template<typename Format, typename InputStream, typename Visitor>
+	static bool GetName(InputStream &tData, NBT_Type::String::View &viewName, NBT_Type::String &sStorage, Visitor &tVisitor) noexcept
+	{
+	MYTRY;
+		//读取长度
+		NBT_Type::StringLength wStringLength = 0;//w->word=2*byte
+		if (!ReadValue<Format>(tData, wStringLength, tVisitor))
+		{
+			STACK_TRACEBACK("wStringLength Read");
+			return false;
+		}
+
+		using ValueType = NBT_Type::String::value_type;
+		size_t szStringLength = (size_t)wStringLength;
+		size_t szStringSize = szStringLength * sizeof(ValueType);
+
+		//检查长度
+		if (!tData.HasAvailData(szStringSize))
+		{
+			Error(OutOfRangeError, tData, tVisitor, "{}:\n(Index[{}] + szStringLength[{}])[{}] > DataSize[{}]", __FUNCTION__,
+				tData.Index(), szStringLength, tData.Index() + szStringLength, tData.Size());
+			STACK_TRACEBACK("HasAvailData Test");
+			return false;
+		}
+
+		if constexpr (requires { tData.CurrentData(); })
+		{
+			//直接引用流中的数据
+			viewName = NBT_Type::String::View((const ValueType *)tData.CurrentData(), szStringLength);
+			tData.SkipData(szStringSize);
+		}
+		else
+		{
+			//读到复用的临时字符串中（短名称不会产生分配）
+			sStorage.resize(szStringLength);
+			tData.GetRange((void *)sStorage.data(), szStringSize);
+			viewName = NBT_Type::String::View(sStorage.data(), sStorage.size());
+		}
+
+		return true;
+	MYCATCH(false);
+	}
+
+	//检查并跳过一段数据
+	//如果流提供了TrySkipData（比如NBT_IO::InflateInputStream），则交由流自身处理，避免为了检查长度而物化被跳过的数据
+	template<typename InputStream>
+	static inline bool TrySkipData(InputStream &tData, size_t szSkipSize) noexcept
+	{
+		if constexpr (requires { { tData.TrySkipData(szSkipSize) } -> std::convertible_to<bool>; })
+		{
+			return tData.TrySkipData(szSkipSize);
+		}
+		else
+		{
+			if (!tData.HasAvailData(szSkipSize))
+			{
+				return false;
+			}
+
+			tData.SkipData(szSkipSize);
+			return true;
+		}
+	}
+
+	template<typename Format, typename InputStream, typename Visitor>
 	static bool SkipName(InputStream &tData, Visitor &tVisitor) noexcept
 	{
 		//读取长度
 		NBT_Type::StringLength wStringLength = 0;//w->word=2*byte
-		if (!ReadBigEndian(tData, wStringLength, tVisitor))
+		if (!ReadValue<Format>(tData, wStringLength, tVisitor))
 		{
 			STACK_TRACEBACK("wStringLength Read");
 			return false;
@@ -281,16 +395,14 @@ catch(...)\
 		size_t szSkipSize = (size_t)wStringLength * sizeof(NBT_Type::String::value_type);
 
 		//检查长度
-		if (!tData.HasAvailData(szSkipSize))
+		if (!TrySkipData(tData, szSkipSize))//检查并跳过数据
 		{
 			Error(OutOfRangeError, tData, tVisitor, "{}:\n(Index[{}] + szSkipSize[{}])[{}] > DataSize[{}]", __FUNCTION__,
 				tData.Index(), szSkipSize, tData.Index() + szSkipSize, tData.Size());
-			STACK_TRACEBACK("HasAvailData Test");
+			STACK_TRACEBACK("TrySkipData Test");
 			return false;
 		}
 
-		//跳过数据
-		tData.SkipData(szSkipSize);
 		return true;
 	}
 
@@ -309,12 +421,12 @@ catch(...)\
 		return true;
 	}
 
-	template<typename T, typename InputStream, typename Visitor>
+	template<typename Format, typename T, typename InputStream, typename Visitor>
 	static Control ScanBuiltInType(InputStream &tData, Visitor &tVisitor) noexcept
 	{
 		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//类型映射
 		RAW_DATA_T tTmpRawData = 0;
-		if (!ReadBigEndian(tData, tTmpRawData, tVisitor))
+		if (!ReadValue<Format>(tData, tTmpRawData, tVisitor))
 		{
 			STACK_TRACEBACK("tTmpRawData Read");
 			return Control::Error;
@@ -325,32 +437,35 @@ catch(...)\
 	MYCATCH(Control::Error);
 	}
 
-	template<typename T, typename InputStream, typename Visitor>
+	template<typename Format, typename T, typename InputStream, typename Visitor>
 	static bool SkipBuiltInType(InputStream &tData, Visitor &tVisitor) noexcept
 	{
 		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//类型映射
+		if constexpr (Format::template bVarIntField<RAW_DATA_T>)
+		{
+			return SkipVarIntElements<Format>(tData, 1, tVisitor);
+		}
+
 		size_t szSkipSize = sizeof(RAW_DATA_T);
 
-		if (!tData.HasAvailData(szSkipSize))
+		if (!TrySkipData(tData, szSkipSize))//检查并跳过数据
 		{
 			Error(OutOfRangeError, tData, tVisitor, "{}:\n(Index[{}] + szSkipSize[{}])[{}] > DataSize[{}]", __FUNCTION__,
 				tData.Index(), szSkipSize, tData.Index() + szSkipSize, tData.Size());
-			STACK_TRACEBACK("HasAvailData Test");
+			STACK_TRACEBACK("TrySkipData Test");
 			return false;
 		}
 
-		//跳过数据
-		tData.SkipData(szSkipSize);
 		return true;
 	}
 
-	template<typename T, typename InputStream, typename Visitor>
+	template<typename Format, typename T, typename InputStream, typename Visitor>
 	static Control ScanArrayType(InputStream &tData, Visitor &tVisitor) noexcept
 	{
 	MYTRY;
 		//获取4字节有符号数，代表数组元素个数
 		NBT_Type::ArrayLength iArrayLength = 0;//4byte
-		if (!ReadBigEndian(tData, iArrayLength, tVisitor))
+		if (!ReadValue<Format>(tData, iArrayLength, tVisitor))
 		{
 			STACK_TRACEBACK("iArrayLength Read");
 			return Control::Error;
@@ -369,37 +484,84 @@ catch(...)\
 		size_t szArrayLength = (size_t)iArrayLength;
 		size_t szArraySize = szArrayLength * sizeof(ValueType);
 
+		//VarInt元素至少1字节
+		constexpr bool bVarIntElement = Format::template bVarIntField<ValueType>;
+		size_t szMinSize = bVarIntElement ? szArrayLength : szArraySize;
+
 		//先进行合法性检查
-		if (!tData.HasAvailData(szArraySize))
+		if (!tData.HasAvailData(szMinSize))
 		{
 			Error(OutOfRangeError, tData, tVisitor, "{}:\n(Index[{}] + szArraySize[{}])[{}] > DataSize[{}]", __FUNCTION__,
-				tData.Index(), szArrayLength, tData.Index() + szArraySize, tData.Size());
+				tData.Index(), szArrayLength, tData.Index() + szMinSize, tData.Size());
 			STACK_TRACEBACK("HasAvailData Test");
 			return Control::Error;
 		}
 
-		//数组保存
-		T tArray{};
-		tArray.reserve(szArrayLength);
+		//VarInt元素逐个解码
+		if constexpr (bVarIntElement)
+		{
+			T tArray{};
+			tArray.resize(szArrayLength);
+			for (size_t i = 0; i < szArrayLength; ++i)
+			{
+				if (!ReadValue<Format>(tData, tArray[i], tVisitor))
+				{
+					STACK_TRACEBACK("Element Read, Size: [{}] Index: [{}]", szArrayLength, i);
+					return Control::Error;
+				}
+			}
 
-		//读取dElementCount个元素
-		for (size_t i = 0; i < szArrayLength; ++i)
+			CALL_FUNC_RET_CONTROL(tVisitor.VisitArrayResult<T>, tVisitor.template VisitArrayResult<T>(std::move(tArray)));
+		}
+		//访问器提供原始数据回调时，只传递视图，由访问器按需转换
+		//视图只描述大端序数据，其它字节序下仅单字节数组可以直接引用，其余数组走下方的转换路径
+		else if constexpr (IsLookLike_NBT_ArraySpanVisitor<Visitor> && (sizeof(ValueType) == 1 || Format::enByteOrder == std::endian::big))
 		{
-			ValueType tTmpData{};
-			ReadBigEndian<true>(tData, tTmpData, tVisitor);//调用需要确保范围安全（已在前面检查）
-			tArray.emplace_back(std::move(tTmpData));//读取一个插入一个
+			if constexpr (requires { tData.CurrentData(); })
+			{
+				//直接引用流中的数据
+				NBT_BigEndianSpan<ValueType> spanArray((const uint8_t *)tData.CurrentData(), szArrayLength);
+				tData.SkipData(szArraySize);
+
+				CALL_FUNC_RET_CONTROL(tVisitor.VisitArraySpanResult, tVisitor.VisitArraySpanResult(spanArray));
+			}
+			else
+			{
+				//无法直接引用，先读出原始数据
+				std::vector<uint8_t> vRawData(szArraySize);
+				if (szArraySize != 0)
+				{
+					tData.GetRange((void *)vRawData.data(), szArraySize);
+				}
+
+				NBT_BigEndianSpan<ValueType> spanArray(vRawData.data(), szArrayLength);
+				CALL_FUNC_RET_CONTROL(tVisitor.VisitArraySpanResult, tVisitor.VisitArraySpanResult(spanArray));
+			}
 		}
+		else
+		{
+			//一次性设置大小并批量读取原始数据
+			T tArray{};
+			if (szArrayLength != 0)//空数组的data()可能为空指针，不进行读取
+			{
+				tArray.resize(szArrayLength);
+				tData.GetRange((void *)tArray.data(), szArraySize);//调用需要确保范围安全（已在前面检查）
 
-		CALL_FUNC_RET_CONTROL(tVisitor.VisitArrayResult<T>, tVisitor.template VisitArrayResult<T>(std::move(tArray)));
+				//原地批量转换字节序
+				Format::ToNativeArray(tArray.data(), szArrayLength);
+			}
+
+			CALL_FUNC_RET_CONTROL(tVisitor.VisitArrayResult<T>, tVisitor.template VisitArrayResult<T>(std::move(tArray)));
+		}
 	MYCATCH(Control::Error);
 	}
 
-	template<typename T, typename InputStream, typename Visitor>
+	template<typename Format, typename T, typename InputStream, typename Visitor>
 	static bool SkipArrayType(InputStream &tData, Visitor &tVisitor) noexcept
 	{
 		//获取4字节有符号数，代表数组元素个数
 		NBT_Type::ArrayLength iArrayLength = 0;//4byte
-		if (!ReadBigEndian(tData, iArrayLength, tVisitor))
+		if (!ReadValue<Format>(tData, iArrayLength, tVisitor))
 		{
 			STACK_TRACEBACK("iArrayLength Read");
 			return false;
@@ -413,39 +575,60 @@ catch(...)\
 			return false;
 		}
 
+		//VarInt元素只统计结束字节，不解码
+		if constexpr (Format::template bVarIntField<typename T::value_type>)
+		{
+			return SkipVarIntElements<Format>(tData, (size_t)iArrayLength, tVisitor);
+		}
+
 		size_t szSkipSize = (size_t)iArrayLength * sizeof(typename T::value_type);
 
-		if (!tData.HasAvailData(szSkipSize))
+		if (!TrySkipData(tData, szSkipSize))//检查并跳过数据
 		{
 			Error(OutOfRangeError, tData, tVisitor, "{}:\n(Index[{}] + szSkipSize[{}])[{}] > DataSize[{}]", __FUNCTION__,
 				tData.Index(), szSkipSize, tData.Index() + szSkipSize, tData.Size());
-			STACK_TRACEBACK("HasAvailData Test");
+			STACK_TRACEBACK("TrySkipData Test");
 			return false;
 		}
 
-		tData.SkipData(szSkipSize);//直接递增索引跳过
 		return true;
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static Control ScanStringType(InputStream &tData, Visitor &tVisitor) noexcept
 	{
 		NBT_Type::String tString;
-		if (!GetName(tData, tString, tVisitor))//转发调用
+		if constexpr (bViewVisitor<Visitor>)
 		{
-			STACK_TRACEBACK("GetString");
-			return Control::Error;
+			NBT_Type::String::View viewString{};
+			if (!GetName<Format>(tData, viewString, tString, tVisitor))//转发调用
+			{
+				STACK_TRACEBACK("GetString");
+				return Control::Error;
+			}
+
+		MYTRY;
+			CALL_FUNC_RET_CONTROL(tVisitor.VisitStringResult, tVisitor.VisitStringResult(viewString));
+		MYCATCH(Control::Error);
 		}
+		else
+		{
+			if (!GetName<Format>(tData, tString, tVisitor))//转发调用
+			{
+				STACK_TRACEBACK("GetString");
+				return Control::Error;
+			}
 
-	MYTRY;
-		CALL_FUNC_RET_CONTROL(tVisitor.VisitStringResult, tVisitor.VisitStringResult(std::move(tString)));
-	MYCATCH(Control::Error);
+		MYTRY;
+			CALL_FUNC_RET_CONTROL(tVisitor.VisitStringResult, tVisitor.VisitStringResult(std::move(tString)));
+		MYCATCH(Control::Error);
+		}
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static bool SkipStringType(InputStream &tData, Visitor &tVisitor) noexcept
 	{
-		if (!SkipName(tData, tVisitor))//转发调用
+		if (!SkipName<Format>(tData, tVisitor))//转发调用
 		{
 			STACK_TRACEBACK("SkipString");
 			return false;
@@ -454,7 +637,7 @@ catch(...)\
 		return true;
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static Control ScanListType(InputStream &tData, Visitor &tVisitor, size_t szStackDepth) noexcept
 	{
 	MYTRY;
@@ -463,7 +646,7 @@ catch(...)\
 
 		//读取列表标签
 		NBT_TAG_RAW_TYPE u8ListElementTag = 0;//b=byte
-		if (!ReadBigEndian(tData, u8ListElementTag, tVisitor))
+		if (!ReadValue<Format>(tData, u8ListElementTag, tVisitor))
 		{
 			STACK_TRACEBACK("u8ListElementTag Read");
 			return Control::Error;
@@ -483,7 +666,7 @@ catch(...)\
 
 		//读取列表长度
 		NBT_Type::ListLength iListLength = 0;//4byte
-		if (!ReadBigEndian(tData, iListLength, tVisitor))
+		if (!ReadValue<Format>(tData, iListLength, tVisitor))
 		{
 			STACK_TRACEBACK("iListLength Read");
 			return Control::Error;
@@ -538,7 +721,7 @@ catch(...)\
 			case NBT_Visitor_NestingControl::Enter:	/*进入值（什么也不做）*/	break;
 			case NBT_Visitor_NestingControl::Skip:		//跳过当前元素
 				{
-					if (!SkipSwitch(tData, enListElementTag, tVisitor, szStackDepth - 1))
+					if (!SkipSwitch<Format>(tData, enListElementTag, tVisitor, szStackDepth - 1))
 					{
 						STACK_TRACEBACK("SkipSwitch Error, Size: [{}] Index: [{}]", szListLength, i);
 						return Control::Error;
@@ -554,7 +737,7 @@ catch(...)\
 			}
 
 			//元素递归访问
-			switch (ScanSwitch(tData, enListElementTag, tVisitor, szStackDepth - 1))
+			switch (ScanSwitch<Format>(tData, enListElementTag, tVisitor, szStackDepth - 1))
 			{
 			case Control::Continue:	/*继续（什么也不做）*/	break;
 			case Control::Break:	goto skip_any;			break;//跳过剩余所有
@@ -583,7 +766,7 @@ catch(...)\
 	skip_any://跳过剩余，如果没有则不跳过
 		for (size_t j = i; j < szListLength; ++j)//从当前i开始跳到结束
 		{
-			if (!SkipSwitch(tData, enListElementTag, tVisitor, szStackDepth - 1))
+			if (!SkipSwitch<Format>(tData, enListElementTag, tVisitor, szStackDepth - 1))
 			{
 				STACK_TRACEBACK("SkipSwitch Error, Size: [{}] Index: [{}]", szListLength, j);
 				return Control::Error;
@@ -595,14 +778,14 @@ catch(...)\
 	MYCATCH(Control::Error);
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static bool SkipListType(InputStream &tData, Visitor &tVisitor, size_t szStackDepth) noexcept
 	{
 		//栈深度检测
 		CHECK_STACK_DEPTH(szStackDepth, false);
 
 		NBT_TAG_RAW_TYPE u8ListElementTag = 0;//b=byte
-		if (!ReadBigEndian(tData, u8ListElementTag, tVisitor))
+		if (!ReadValue<Format>(tData, u8ListElementTag, tVisitor))
 		{
 			STACK_TRACEBACK("u8ListElementTag Read");
 			return false;
@@ -619,7 +802,7 @@ catch(...)\
 		NBT_TAG enListElementTag = (NBT_TAG)u8ListElementTag;
 
 		NBT_Type::ListLength iListLength = 0;//4byte
-		if (!ReadBigEndian(tData, iListLength, tVisitor))
+		if (!ReadValue<Format>(tData, iListLength, tVisitor))
 		{
 			STACK_TRACEBACK("iListLength Read");
 			return false;
@@ -647,11 +830,20 @@ catch(...)\
 			enListElementTag = NBT_TAG::End;
 		}
 
+		//VarInt格式下的Int与Long列表整体跳过，不解码
+		if constexpr (Format::bVarInt)
+		{
+			if (enListElementTag == NBT_TAG::Int || enListElementTag == NBT_TAG::Long)
+			{
+				return SkipVarIntElements<Format>(tData, szListLength, tVisitor);
+			}
+		}
+
 		size_t szSkipLength = szListLength;
 
 		for (size_t i = 0; i < szSkipLength; ++i)
 		{
-			if (!SkipSwitch(tData, enListElementTag, tVisitor, szStackDepth - 1))
+			if (!SkipSwitch<Format>(tData, enListElementTag, tVisitor, szStackDepth - 1))
 			{
 				STACK_TRACEBACK("SkipSwitch Error, Size: [{}] Index: [{}]", szListLength, i);
 				return false;
@@ -661,13 +853,16 @@ catch(...)\
 		return true;
 	}
 
-	template<bool bRoot, typename InputStream, typename Visitor>
+	template<typename Format, bool bRoot, typename InputStream, typename Visitor>
 	static Control ScanCompoundType(InputStream &tData, Visitor &tVisitor, size_t szStackDepth) noexcept
 	{
 	MYTRY;
 		//栈深度检测
 		CHECK_STACK_DEPTH(szStackDepth, Control::Error);
 
+		//视图模式下，无法直接引用流中数据时用于暂存名称，在条目间复用
+		[[maybe_unused]] NBT_Type::String sNameStorage{};
+
 		if constexpr (!bRoot)//非根部才进行compound调用
 		{
 			switch (tVisitor.VisitCompoundBegin())
@@ -731,32 +926,33 @@ catch(...)\
 				{
 					//类型已被读取
 					//跳过名称
-					if (!SkipName(tData, tVisitor))
+					if (!SkipName<Format>(tData, tVisitor))
 					{
 						STACK_TRACEBACK("SkipName Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 						return Control::Error;
 					}
 
 					//跳过数据
-					if (!SkipSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
+					if (!SkipSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
 					{
 						STACK_TRACEBACK("SkipSwitch Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 						return Control::Error;
 					}
+					continue;//名称与数据都已跳过，继续上面的循环
 				}
 				break;
 			case NBT_Visitor_NestingControl::Break:	//跳过所有（离开）
 				{
 					//类型已被读取
 					//跳过名称
-					if (!SkipName(tData, tVisitor))
+					if (!SkipName<Format>(tData, tVisitor))
 					{
 						STACK_TRACEBACK("SkipName Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 						return Control::Error;
 					}
 
 					//跳过数据
-					if (!SkipSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
+					if (!SkipSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
 					{
 						STACK_TRACEBACK("SkipSwitch Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 						return Control::Error;
@@ -772,9 +968,19 @@ catch(...)\
 				break;
 			}
 
-			//读取名称
-			NBT_Type::String sName{};
-			if (!GetName(tData, sName, tVisitor))
+			//读取名称（视图模式下只得到视图）
+			std::conditional_t<bViewVisitor<Visitor>, NBT_Type::String::View, NBT_Type::String> sName{};
+			bool bGetName;
+			if constexpr (bViewVisitor<Visitor>)
+			{
+				bGetName = GetName<Format>(tData, sName, sNameStorage, tVisitor);
+			}
+			else
+			{
+				bGetName = GetName<Format>(tData, sName, tVisitor);
+			}
+
+			if (!bGetName)
 			{
 				STACK_TRACEBACK("GetName Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 				return Control::Error;
@@ -788,7 +994,7 @@ catch(...)\
 				{
 					//类型、名称已被读取
 					//跳过数据
-					if (!SkipSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
+					if (!SkipSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
 					{
 						STACK_TRACEBACK("SkipSwitch Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 						return Control::Error;
@@ -800,7 +1006,7 @@ catch(...)\
 				{
 					//类型、名称已被读取
 					//跳过数据
-					if (!SkipSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))//先跳过当前
+					if (!SkipSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))//先跳过当前
 					{
 						STACK_TRACEBACK("SkipSwitch Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 						return Control::Error;
@@ -817,7 +1023,7 @@ catch(...)\
 			}
 
 			//元素递归访问
-			switch (ScanSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
+			switch (ScanSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
 			{
 			case Control::Continue:	/*继续（什么也不做）*/	break;
 			case Control::Break:	goto skip_any;			break;//跳过剩余所有
@@ -880,13 +1086,13 @@ catch(...)\
 
 			NBT_TAG enCompoundEntryTag = (NBT_TAG)u8CompoundEntryTag;
 
-			if (!SkipName(tData, tVisitor))
+			if (!SkipName<Format>(tData, tVisitor))
 			{
 				STACK_TRACEBACK("SkipName Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 				return Control::Error;
 			}
 
-			if (!SkipSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
+			if (!SkipSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
 			{
 				STACK_TRACEBACK("SkipSwitch Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 				return Control::Error;
@@ -906,7 +1112,7 @@ catch(...)\
 	MYCATCH(Control::Error);
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static bool SkipCompoundType(InputStream &tData, Visitor &tVisitor, size_t szStackDepth) noexcept
 	{
 		//栈深度检测
@@ -940,13 +1146,13 @@ catch(...)\
 
 			NBT_TAG enCompoundEntryTag = (NBT_TAG)u8CompoundEntryTag;
 
-			if (!SkipName(tData, tVisitor))
+			if (!SkipName<Format>(tData, tVisitor))
 			{
 				STACK_TRACEBACK("SkipName Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 				return false;
 			}
 
-			if (!SkipSwitch(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
+			if (!SkipSwitch<Format>(tData, enCompoundEntryTag, tVisitor, szStackDepth - 1))
 			{
 				STACK_TRACEBACK("SkipSwitch Fail, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
 				return false;
@@ -956,7 +1162,7 @@ catch(...)\
 		return true;
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static Control ScanSwitch(InputStream &tData, NBT_TAG tagNbt, Visitor &tVisitor, size_t szStackDepth) noexcept
 	{
 		Control retControl;
@@ -970,70 +1176,70 @@ catch(...)\
 		case NBT_TAG::Byte:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Byte>;
-				retControl = ScanBuiltInType<CurType>(tData, tVisitor);
+				retControl = ScanBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Short:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Short>;
-				retControl = ScanBuiltInType<CurType>(tData, tVisitor);
+				retControl = ScanBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Int:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Int>;
-				retControl = ScanBuiltInType<CurType>(tData, tVisitor);
+				retControl = ScanBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Long:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Long>;
-				retControl = ScanBuiltInType<CurType>(tData, tVisitor);
+				retControl = ScanBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Float:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Float>;
-				retControl = ScanBuiltInType<CurType>(tData, tVisitor);
+				retControl = ScanBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Double:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Double>;
-				retControl = ScanBuiltInType<CurType>(tData, tVisitor);
+				retControl = ScanBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::ByteArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::ByteArray>;
-				retControl = ScanArrayType<CurType>(tData, tVisitor);
+				retControl = ScanArrayType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::String:
 			{
-				retControl = ScanStringType(tData, tVisitor);
+				retControl = ScanStringType<Format>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::List:
 			{
-				retControl = ScanListType(tData, tVisitor, szStackDepth);
+				retControl = ScanListType<Format>(tData, tVisitor, szStackDepth);
 			}
 			break;
 		case NBT_TAG::Compound:
 			{
-				retControl = ScanCompoundType<false>(tData, tVisitor, szStackDepth);
+				retControl = ScanCompoundType<Format, false>(tData, tVisitor, szStackDepth);
 			}
 			break;
 		case NBT_TAG::IntArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::IntArray>;
-				retControl = ScanArrayType<CurType>(tData, tVisitor);
+				retControl = ScanArrayType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::LongArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::LongArray>;
-				retControl = ScanArrayType<CurType>(tData, tVisitor);
+				retControl = ScanArrayType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		default:
@@ -1054,7 +1260,7 @@ catch(...)\
 		return retControl;
 	}
 
-	template<typename InputStream, typename Visitor>
+	template<typename Format, typename InputStream, typename Visitor>
 	static bool SkipSwitch(InputStream &tData, NBT_TAG tagNbt, Visitor &tVisitor, size_t szStackDepth) noexcept
 	{
 		bool bRet = false;
@@ -1068,70 +1274,70 @@ catch(...)\
 		case NBT_TAG::Byte:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Byte>;
-				bRet = SkipBuiltInType<CurType>(tData, tVisitor);
+				bRet = SkipBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Short:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Short>;
-				bRet = SkipBuiltInType<CurType>(tData, tVisitor);
+				bRet = SkipBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Int:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Int>;
-				bRet = SkipBuiltInType<CurType>(tData, tVisitor);
+				bRet = SkipBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Long:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Long>;
-				bRet = SkipBuiltInType<CurType>(tData, tVisitor);
+				bRet = SkipBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Float:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Float>;
-				bRet = SkipBuiltInType<CurType>(tData, tVisitor);
+				bRet = SkipBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::Double:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Double>;
-				bRet = SkipBuiltInType<CurType>(tData, tVisitor);
+				bRet = SkipBuiltInType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::ByteArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::ByteArray>;
-				bRet = SkipArrayType<CurType>(tData, tVisitor);
+				bRet = SkipArrayType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::String:
 			{
-				bRet = SkipStringType(tData, tVisitor);
+				bRet = SkipStringType<Format>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::List:
 			{
-				bRet = SkipListType(tData, tVisitor, szStackDepth);
+				bRet = SkipListType<Format>(tData, tVisitor, szStackDepth);
 			}
 			break;
 		case NBT_TAG::Compound:
 			{
-				bRet = SkipCompoundType(tData, tVisitor, szStackDepth);
+				bRet = SkipCompoundType<Format>(tData, tVisitor, szStackDepth);
 			}
 			break;
 		case NBT_TAG::IntArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::IntArray>;
-				bRet = SkipArrayType<CurType>(tData, tVisitor);
+				bRet = SkipArrayType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		case NBT_TAG::LongArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::LongArray>;
-				bRet = SkipArrayType<CurType>(tData, tVisitor);
+				bRet = SkipArrayType<Format, CurType>(tData, tVisitor);
 			}
 			break;
 		default:
@@ -1155,72 +1361,98 @@ catch(...)\
 ///@endcond
 public:
 	/// @brief 从输入流中扫描NBT数据，并通过访问器回调处理每个节点
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式，扫描基岩版存档数据时使用NBT_Format::LittleEndian，
+	/// 扫描基岩版网络协议数据时使用NBT_Format::VarInt
 	/// @tparam InputStream 输入流类型，必须符合DefaultInputStream类型的接口
-	/// @tparam Visitor 访问器类型，必须符合IsLookLike_NBT_Visitor概念
+	/// @tparam Visitor 访问器类型，必须符合IsLookLike_NBT_ScanVisitor概念
 	/// @param IptStream 输入流对象
 	/// @param tVisitor 访问器对象，用于处理扫描过程中遇到的NBT数据节点
 	/// @param szStackDepth 递归最大深度，防止栈溢出
 	/// @return 扫描成功返回true，失败返回false
 	/// @note 函数通过访问器回调的方式遍历整个NBT结构，不会构建完整的内存树，适合处理大型NBT数据。
 	/// 若遇到格式错误或超过深度限制，函数将返回false并停止扫描。
-	template<typename InputStream, typename Visitor>
-	requires(IsLookLike_NBT_Visitor<Visitor>)
+	/// 如果访问器是视图模式访问器（满足IsLookLike_NBT_ViewVisitor而不满足IsLookLike_NBT_Visitor），
+	/// 键名与字符串结果以NBT_Type::String::View传递：流提供CurrentData时视图直接指向输入数据，
+	/// 扫描过程中不会为任何节点分配内存；否则视图指向扫描器内部复用的临时字符串。两种情况下视图都只在回调期间有效。
+	/// 如果访问器还满足IsLookLike_NBT_ArraySpanVisitor，数组以NBT_BigEndianSpan传给VisitArraySpanResult，不构建数组对象；
+	/// 非大端序格式下只有字节数组以视图传递，其余数组仍转换后传给VisitArrayResult。
+	template<typename Format = NBT_Format::BigEndian, typename InputStream, typename Visitor>
+	requires(IsLookLike_NBT_ScanVisitor<Visitor> && IsLookLike_NBT_Format<Format>)
 	static bool ScanNBT(InputStream &IptStream, Visitor &tVisitor, size_t szStackDepth = 512) noexcept
 	{
-		return ScanCompoundType<true>(IptStream, tVisitor, szStackDepth) != Control::Error;
+		return ScanCompoundType<Format, true>(IptStream, tVisitor, szStackDepth) != Control::Error;
 	}
 	
 	/// @brief 从数据容器中扫描NBT数据，并通过访问器回调处理每个节点
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
 	/// @tparam DataType 数据容器类型，默认为std::vector<uint8_t>
-	/// @tparam Visitor 访问器类型，必须符合IsLookLike_NBT_Visitor概念
+	/// @tparam Visitor 访问器类型，必须符合IsLookLike_NBT_ScanVisitor概念
 	/// @param tDataInput 输入数据容器
 	/// @param szStartIdx 数据起始索引，会忽略容器中前szStartIdx字节的数据
 	/// @param tVisitor 访问器对象，用于处理扫描过程中遇到的NBT数据节点
 	/// @param szStackDepth 递归最大深度，防止栈溢出
 	/// @return 扫描成功返回true，失败返回false
 	/// @note 此函数是ScanNBT(InputStream)版本的数据容器适配版本，其它行为请参考ScanNBT(InputStream)版本的说明。
-	template<typename DataType = std::vector<uint8_t>, typename Visitor>
-	requires(IsLookLike_NBT_Visitor<Visitor>)
+	template<typename Format = NBT_Format::BigEndian, typename DataType = std::vector<uint8_t>, typename Visitor>
+	requires(IsLookLike_NBT_ScanVisitor<Visitor> && IsLookLike_NBT_Format<Format>)
 	static bool ScanNBT(const DataType &tDataInput, size_t szStartIdx, Visitor &tVisitor, size_t szStackDepth = 512) noexcept
 	{
 		NBT_IO::DefaultInputStream<DataType> IptStream(tDataInput, szStartIdx);
-		return ScanCompoundType<true>(IptStream, tVisitor, szStackDepth) != Control::Error;
+		return ScanCompoundType<Format, true>(IptStream, tVisitor, szStackDepth) != Control::Error;
 	}
 
 #ifdef CJF2_NBT_CPP_USE_ZLIB
 
 	/// @brief 从可能被压缩的文件中扫描 NBT 数据，并通过访问器回调处理每个节点
-	/// @tparam Visitor 访问器类型，必须符合 IsLookLike_NBT_Visitor 概念
+	/// @tparam Visitor 访问器类型，必须符合 IsLookLike_NBT_ScanVisitor 概念
 	/// @tparam InfoFunc 错误信息输出仿函数类型
 	/// @param pathFileName 源文件路径
 	/// @param tVisitor 访问器对象，用于处理扫描过程中遇到的 NBT 数据节点
 	/// @param funcInfo 错误信息处理仿函数
 	/// @return 扫描成功返回 true，失败返回 false
-	/// @note 本函数会读取整个文件内容，先尝试使用 Zlib 解压。若解压失败，则假定文件未压缩，直接使用原始数据。
-	/// 然后调用 ScanNBT 扫描数据。如果文件不存在，则会失败。
+	/// @note 本函数会先以只读方式映射整个文件，若 NBT_IO::IsDataZipped 判断数据未压缩，则直接在映射上调用 ScanNBT，不产生任何文件数据拷贝；
+	/// 否则尝试使用 Zlib 解压，若解压失败，则假定文件未压缩，直接使用映射的原始数据。如果文件不存在，则会失败。
 	template <typename Visitor, typename InfoFunc = NBT_Print>
-	requires(IsLookLike_NBT_Visitor<Visitor>)
+	requires(IsLookLike_NBT_ScanVisitor<Visitor>)
 	static bool SimpleScanNbtFile(const std::filesystem::path &pathFileName, Visitor &tVisitor, InfoFunc funcInfo = InfoFunc{}) noexcept
 	{
-		// 读取文件
-		std::vector<uint8_t> vFileData;
-		if (!NBT_IO::ReadFile(pathFileName, vFileData, funcInfo))
+		// 映射文件
+		NBT_IO::MappedFile mfFile(pathFileName, NBT_IO::MappedFile::AccessHint::Sequential);
+		if (!mfFile.IsOpen())
 		{
-			funcInfo(NBT_Print_Level::Err, "Error: Cannot read file [{}].\n", pathFileName.string());
+			funcInfo(NBT_Print_Level::Err, "Error: Cannot read file [{}]: {}\n", pathFileName.string(), mfFile.GetErrorInfo());
 			return false;
 		}
 
+		// 未压缩则直接扫描映射
+		if (!NBT_IO::IsDataZipped(mfFile))
+		{
+			if (!ScanNBT(mfFile, 0, tVisitor, 512))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: ScanNBT failed.\n");
+				return false;
+			}
+
+			return true;
+		}
+
 		// 尝试解压，失败则视作未压缩数据
 		std::vector<uint8_t> vNbtData;
-		if (!NBT_IO::DecompressDataNoThrow(vNbtData, vFileData, funcInfo))
+		if (!NBT_IO::DecompressDataNoThrow(vNbtData, mfFile, funcInfo))
 		{
 			funcInfo(NBT_Print_Level::Warn, "Warning: Decompression failed, assuming uncompressed data.\n");
-			vNbtData = std::move(vFileData);
+
+			if (!ScanNBT(mfFile, 0, tVisitor, 512))
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: ScanNBT failed.\n");
+				return false;
+			}
+
+			return true;
 		}
 
-		// 清理数据
-		vFileData.clear();
-		vFileData.shrink_to_fit();
+		// 解压完成，提前解除映射
+		mfFile.Close();
 
 		// 扫描
 		if (!ScanNBT(vNbtData, 0, tVisitor, 512))
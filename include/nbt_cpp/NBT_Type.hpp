@@ -7,10 +7,20 @@
 #include <unordered_map>
 #include <string>
 #include <type_traits>
+#include <memory>//std::allocator
+#include <functional>//std::hash std::equal_to
 
 #include "NBT_TAG.hpp"
 #include "MUTF8_Tool.hpp"
 
+#ifdef CJF2_NBT_CPP_USE_ARENA_ALLOCATOR
+#include "NBT_Allocator.hpp"
+#endif
+
+#ifdef CJF2_NBT_CPP_USE_FLAT_COMPOUND
+#include "NBT_FlatMap.hpp"
+#endif
+
 /// @file
 /// @brief NBT所有类型定义与类型处理工具集
 
@@ -56,21 +66,36 @@ public:
 	using Float			= std::conditional_t<(sizeof(float) == sizeof(Float_Raw)), float, Float_Raw>;		///< 单精度浮点类型 @note 如果平台不支持，则替换为同等大小的原始数据类型
 	using Double		= std::conditional_t<(sizeof(double) == sizeof(Double_Raw)), double, Double_Raw>;	///< 双精度浮点类型 @note 如果平台不支持，则替换为同等大小的原始数据类型
 
+	//分配器类型
+	//定义CJF2_NBT_CPP_USE_ARENA_ALLOCATOR后使用NBT_Allocator，可以通过NBT_ArenaScope把整棵树分配到同一个内存资源中
+#ifdef CJF2_NBT_CPP_USE_ARENA_ALLOCATOR
+	template<typename T>
+	using Allocator		= NBT_Allocator<T>;	///< NBT容器使用的分配器类型
+#else
+	template<typename T>
+	using Allocator		= std::allocator<T>;	///< NBT容器使用的分配器类型
+#endif
+
 	//数组类型，不存在SortArray，由于NBT标准不提供，所以此处也不提供
-	using ByteArray		= NBT_Array<std::vector<Byte>>;	///< 存储 8位有符号整数的数组类型
-	using IntArray		= NBT_Array<std::vector<Int>>;	///< 存储32位有符号整数的数组类型
-	using LongArray		= NBT_Array<std::vector<Long>>;	///< 存储64位有符号整数的数组类型
+	using ByteArray		= NBT_Array<std::vector<Byte, Allocator<Byte>>>;	///< 存储 8位有符号整数的数组类型
+	using IntArray		= NBT_Array<std::vector<Int, Allocator<Int>>>;		///< 存储32位有符号整数的数组类型
+	using LongArray		= NBT_Array<std::vector<Long, Allocator<Long>>>;	///< 存储64位有符号整数的数组类型
 
 	//字符串类型
-	using String		= NBT_String<MUTF8_String, MUTF8_String_View>;	///< 字符串类型，存储Java M-UTF-8字符串
+	using String		= NBT_String<std::basic_string<MUTF8_Char_Type, MUTF8_Char_Traits<MUTF8_Char_Type>, Allocator<MUTF8_Char_Type>>, MUTF8_String_View>;	///< 字符串类型，存储Java M-UTF-8字符串
 
 	//列表类型
 	//存储一系列同类型标签的有效负载（无标签 ID 或名称），原先为list，因为mc内list也通过下标访问，所以改为vector模拟
-	using List			= NBT_List<std::vector<NBT_Node>>;	///< 列表类型，可顺序存储任意相同的NBT类型
+	using List			= NBT_List<std::vector<NBT_Node, Allocator<NBT_Node>>>;	///< 列表类型，可顺序存储任意相同的NBT类型
 
 	//集合类型
 	//挂在序列下的内容都通过map绑定名称
-	using Compound		= NBT_Compound<std::unordered_map<String, NBT_Node>>;	///< 集合类型，可存储任意不同的NBT类型，通过名称映射值
+	//定义CJF2_NBT_CPP_USE_FLAT_COMPOUND后使用开放寻址的NBT_FlatMap代替std::unordered_map，接口不变
+#ifdef CJF2_NBT_CPP_USE_FLAT_COMPOUND
+	using Compound		= NBT_Compound<NBT_FlatMap<String, NBT_Node, std::hash<String>, std::equal_to<String>, Allocator<std::pair<const String, NBT_Node>>>>;	///< 集合类型，可存储任意不同的NBT类型，通过名称映射值
+#else
+	using Compound		= NBT_Compound<std::unordered_map<String, NBT_Node, std::hash<String>, std::equal_to<String>, Allocator<std::pair<const String, NBT_Node>>>>;	///< 集合类型，可存储任意不同的NBT类型，通过名称映射值
+#endif
 
 	/// @}
 
@@ -2,6 +2,7 @@
 
 #include "NBT_Node.hpp"
 #include "NBT_Print.hpp"
+#include "NBT_BigEndianSpan.hpp"
 
 #include <stdint.h>
 #include <vector>
@@ -191,13 +192,53 @@ public:
 	}
 };
 
-/// @brief 检查类型是否符合 NBT 访问器（Visitor）的接口要求
+/// @brief 提示性实现类（鸭子类型），展示视图模式访问器与 NBT_Visitor 的不同之处
+/// @note 视图模式访问器的键名与字符串结果以 NBT_Type::String::View 传递，视图直接指向输入数据，
+/// 扫描器不会为它们分配任何内存，其余成员函数与 NBT_Visitor 完全相同。
+/// 用户自定义的访问器只要把这三个成员函数的参数改为 NBT_Type::String::View（按值或常量引用），
+/// 并满足 IsLookLike_NBT_ViewVisitor 概念，NBT_Scanner 就会自动使用视图模式扫描。
+/// 视图仅在回调期间有效，需要保留时请自行拷贝到 NBT_Type::String。
+/// 对于无法直接访问连续数据的输入流（比如 NBT_IO::InflateInputStream），
+/// 扫描器会先把数据读到一个复用的临时字符串中再传递视图，因此同样只在回调期间有效。
+class NBT_ViewVisitor : public NBT_Visitor
+{
+public:
+	/// @brief 处理字符串类型节点
+	/// @param strResult 指向输入数据的字符串视图
+	/// @return 控制码，决定后续行为
+	ResultControl VisitStringResult(NBT_Type::String::View strResult)
+	{
+		//do something...
+		return ResultControl::Continue;
+	}
+
+	/// @brief 开始处理 Compound 中的一个条目（键值对）
+	/// @param enCompoundEntryTag 条目的类型标签
+	/// @param sName 指向输入数据的条目键名视图
+	/// @return 嵌套控制码，决定后续行为
+	NestingControl VisitCompoundEntryBegin(NBT_TAG enCompoundEntryTag, NBT_Type::String::View sName)
+	{
+		//do something...
+		return NestingControl::Enter;
+	}
+
+	/// @brief 结束处理 Compound 中的一个条目
+	/// @param enCompoundEntryTag 条目的类型标签
+	/// @param sName 条目的键名视图，与 VisitCompoundEntryBegin 收到的内容相同
+	/// @return 控制码，决定后续行为
+	ResultControl VisitCompoundEntryEnd(NBT_TAG enCompoundEntryTag, NBT_Type::String::View sName)
+	{
+		//do something...
+		return ResultControl::Continue;
+	}
+};
+
+/// @brief 检查类型是否实现了 NBT 访问器中与字符串传递方式无关的那部分接口
 /// @tparam T 待检查的类型
-/// @note 该概念要求类型 T 实现 NBT_Visitor 类中定义的所有公共成员函数（包括数值/数组/字符串访问、
-/// List/Compound 相关回调、错误处理等）。满足此概念的类型可作为 NBT_Scanner::ScanNBT 的访问器参数。
-/// @see NBT_Visitor 提示性实现类，展示了完整的接口原型。
+/// @note 该概念是 IsLookLike_NBT_Visitor 与 IsLookLike_NBT_ViewVisitor 的公共部分，
+/// 不包括 VisitStringResult、VisitCompoundEntryBegin 与 VisitCompoundEntryEnd，一般用户无需直接使用。
 template <typename T>
-concept IsLookLike_NBT_Visitor =
+concept IsLookLike_NBT_VisitorBase =
 requires(
 	T visitor,
 	NBT_Visitor nbt_visitor,
@@ -216,7 +257,6 @@ requires(
 	NBT_Type::ByteArray nbt_bytearray,
 	NBT_Type::IntArray nbt_intarray,
 	NBT_Type::LongArray nbt_longarray,
-	NBT_Type::String nbt_string,
 	NBT_Print_Level nbt_print_level
 	)
 {
@@ -251,11 +291,6 @@ requires(
 		visitor.VisitArrayResult(std::move(nbt_longarray))
 	} -> std::same_as<decltype(nbt_visitor.VisitArrayResult(std::move(nbt_longarray)))>;
 
-	//字符串访问方法
-	{
-		visitor.VisitStringResult(std::move(nbt_string))
-	} -> std::same_as<decltype(nbt_visitor.VisitStringResult(std::move(nbt_string)))>;
-
 	//结束标记访问方法
 	{
 		visitor.VisitEndResult()
@@ -283,12 +318,6 @@ requires(
 	{
 		visitor.VisitCompoundNextEntryType(nbt_tag)
 	} -> std::same_as<decltype(nbt_visitor.VisitCompoundNextEntryType(nbt_tag))>;
-	{
-		visitor.VisitCompoundEntryBegin(nbt_tag, std::move(nbt_string))
-	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEntryBegin(nbt_tag, std::move(nbt_string)))>;
-	{
-		visitor.VisitCompoundEntryEnd(nbt_tag, std::move(nbt_string))
-	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEntryEnd(nbt_tag, std::move(nbt_string)))>;
 	{
 		visitor.VisitCompoundEnd()
 	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEnd())>;
@@ -313,7 +342,123 @@ requires(
 	};
 };
 
+/// @brief 提示性实现类（鸭子类型），展示数组原始数据回调的接口
+/// @note 这是一个可选回调：访问器（NBT_Visitor 或 NBT_ViewVisitor 形式均可）额外实现此成员函数，
+/// 并满足 IsLookLike_NBT_ArraySpanVisitor 概念时，NBT_Scanner 遇到 ByteArray、IntArray 与 LongArray
+/// 不再构建数组对象并转换全部元素，而是把指向原始大端序数据的 NBT_BigEndianSpan 传给此回调，
+/// 访问器可以只读取长度、按下标读取少数元素，或通过 Decode、ToArray 按需批量转换。
+/// 没有实现此回调的访问器仍然通过 VisitArrayResult 接收数组对象。
+/// 流提供 CurrentData 时，视图直接指向输入数据；否则视图指向扫描器读出的临时缓冲区，两种情况下视图都只在回调期间有效。
+class NBT_ArraySpanVisitor : public NBT_Visitor
+{
+public:
+	/// @brief 处理数组类型节点的原始数据
+	/// @tparam T 数组元素类型，分别对应 ByteArray、IntArray 与 LongArray 的 NBT_Type::Byte、NBT_Type::Int 与 NBT_Type::Long
+	/// @param spanResult 指向大端序原始数据的数组视图
+	/// @return 控制码，决定后续行为
+	template<typename T>
+	requires(std::is_same_v<T, NBT_Type::Byte> || std::is_same_v<T, NBT_Type::Int> || std::is_same_v<T, NBT_Type::Long>)
+	ResultControl VisitArraySpanResult(NBT_BigEndianSpan<T> spanResult)
+	{
+		//do something...
+		return ResultControl::Continue;
+	}
+};
+
+/// @brief 检查类型是否符合 NBT 访问器（Visitor）的接口要求
+/// @tparam T 待检查的类型
+/// @note 该概念要求类型 T 实现 NBT_Visitor 类中定义的所有公共成员函数（包括数值/数组/字符串访问、
+/// List/Compound 相关回调、错误处理等）。满足此概念的类型可作为 NBT_Scanner::ScanNBT 的访问器参数。
+/// @see NBT_Visitor 提示性实现类，展示了完整的接口原型。
+template <typename T>
+concept IsLookLike_NBT_Visitor =
+IsLookLike_NBT_VisitorBase<T> &&
+requires(
+	T visitor,
+	NBT_Visitor nbt_visitor,
+	NBT_TAG nbt_tag,
+	NBT_Type::String nbt_string
+	)
+{
+	//字符串访问方法
+	{
+		visitor.VisitStringResult(std::move(nbt_string))
+	} -> std::same_as<decltype(nbt_visitor.VisitStringResult(std::move(nbt_string)))>;
+
+	//Compound条目方法
+	{
+		visitor.VisitCompoundEntryBegin(nbt_tag, std::move(nbt_string))
+	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEntryBegin(nbt_tag, std::move(nbt_string)))>;
+	{
+		visitor.VisitCompoundEntryEnd(nbt_tag, std::move(nbt_string))
+	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEntryEnd(nbt_tag, std::move(nbt_string)))>;
+};
+
+/// @brief 检查类型是否符合视图模式 NBT 访问器的接口要求
+/// @tparam T 待检查的类型
+/// @note 与 IsLookLike_NBT_Visitor 的区别仅在于键名与字符串结果以 NBT_Type::String::View 传递。
+/// 满足此概念且不满足 IsLookLike_NBT_Visitor 的类型，NBT_Scanner::ScanNBT 会以视图模式扫描，
+/// 参数为 NBT_Type::String 的访问器也能从视图隐式构造出参数，因而同时满足两者，这类访问器仍然按原先的方式接收字符串对象。
+/// @see NBT_ViewVisitor 提示性实现类，展示了与 NBT_Visitor 不同的接口原型。
+template <typename T>
+concept IsLookLike_NBT_ViewVisitor =
+IsLookLike_NBT_VisitorBase<T> &&
+requires(
+	T visitor,
+	NBT_ViewVisitor nbt_visitor,
+	NBT_TAG nbt_tag,
+	NBT_Type::String::View nbt_string_view
+	)
+{
+	//字符串访问方法
+	{
+		visitor.VisitStringResult(nbt_string_view)
+	} -> std::same_as<decltype(nbt_visitor.VisitStringResult(nbt_string_view))>;
+
+	//Compound条目方法
+	{
+		visitor.VisitCompoundEntryBegin(nbt_tag, nbt_string_view)
+	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEntryBegin(nbt_tag, nbt_string_view))>;
+	{
+		visitor.VisitCompoundEntryEnd(nbt_tag, nbt_string_view)
+	} -> std::same_as<decltype(nbt_visitor.VisitCompoundEntryEnd(nbt_tag, nbt_string_view))>;
+};
+
+/// @brief 检查类型是否可以作为 NBT_Scanner 的访问器
+/// @tparam T 待检查的类型
+/// @note 满足 IsLookLike_NBT_Visitor 或 IsLookLike_NBT_ViewVisitor 其中之一即可。
+template <typename T>
+concept IsLookLike_NBT_ScanVisitor = IsLookLike_NBT_Visitor<T> || IsLookLike_NBT_ViewVisitor<T>;
+
+/// @brief 检查访问器是否实现了可选的数组原始数据回调
+/// @tparam T 待检查的类型
+/// @note 满足此概念的访问器，NBT_Scanner 会以 NBT_BigEndianSpan 调用 VisitArraySpanResult 代替 VisitArrayResult。
+/// @see NBT_ArraySpanVisitor 提示性实现类，展示了接口原型。
+template <typename T>
+concept IsLookLike_NBT_ArraySpanVisitor =
+requires(
+	T visitor,
+	NBT_ArraySpanVisitor nbt_visitor,
+	NBT_BigEndianSpan<NBT_Type::Byte> nbt_bytearray_span,
+	NBT_BigEndianSpan<NBT_Type::Int> nbt_intarray_span,
+	NBT_BigEndianSpan<NBT_Type::Long> nbt_longarray_span
+	)
+{
+	{
+		visitor.VisitArraySpanResult(nbt_bytearray_span)
+	} -> std::same_as<decltype(nbt_visitor.VisitArraySpanResult(nbt_bytearray_span))>;
+	{
+		visitor.VisitArraySpanResult(nbt_intarray_span)
+	} -> std::same_as<decltype(nbt_visitor.VisitArraySpanResult(nbt_intarray_span))>;
+	{
+		visitor.VisitArraySpanResult(nbt_longarray_span)
+	} -> std::same_as<decltype(nbt_visitor.VisitArraySpanResult(nbt_longarray_span))>;
+};
+
 static_assert(IsLookLike_NBT_Visitor<NBT_Visitor>);
+static_assert(IsLookLike_NBT_ViewVisitor<NBT_ViewVisitor> && !IsLookLike_NBT_Visitor<NBT_ViewVisitor>);
+static_assert(IsLookLike_NBT_Visitor<NBT_ArraySpanVisitor> && IsLookLike_NBT_ArraySpanVisitor<NBT_ArraySpanVisitor>);
+static_assert(!IsLookLike_NBT_ArraySpanVisitor<NBT_Visitor>);
 
 /// @brief NBT 数据收集器，实现访问器接口，将扫描结果构建为完整的 Compound 树
 /// @note 该类会自动管理栈帧，将解析出的值插入到正确的父容器（Compound 或 List）中。
@@ -619,4 +764,4 @@ public:
 	}
 };
 
-static_assert(IsLookLike_NBT_Visitor<NBT_Visitor_Collector>);
+static_assert(IsLookLike_NBT_Visitor<NBT_Visitor_Collector> && !IsLookLike_NBT_ArraySpanVisitor<NBT_Visitor_Collector>);
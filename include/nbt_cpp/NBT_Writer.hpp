@@ -9,10 +9,12 @@
 #include <utility>//std::move
 #include <type_traits>//类型约束
 #include <algorithm>//std::sort
+#include <span>//std::span
 
 #include "NBT_Print.hpp"//打印输出
 #include "NBT_Node.hpp"//nbt类型
 #include "NBT_Endian.hpp"//字节序
+#include "NBT_Format.hpp"//格式策略
 #include "NBT_IO.hpp"//IO流对象
 
 /// @file
@@ -232,19 +234,93 @@ catch(...)\
 	MYCATCH;
 	}
 
-	//写出大端序值
-	template<typename T, typename OutputStream, typename InfoFunc>
+	//按格式策略的字节序写出定长数值
+	template<typename Format, typename T, typename OutputStream, typename InfoFunc>
 	requires std::integral<T>
-	static inline ErrCode WriteBigEndian(OutputStream &tData, const T &tVal, InfoFunc &funcInfo) noexcept
+	static inline ErrCode WriteEndian(OutputStream &tData, const T &tVal, InfoFunc &funcInfo) noexcept
 	{
 	MYTRY;
-		auto BigEndianVal = NBT_Endian::NativeToBigAny(tVal);
-		tData.PutRange((const uint8_t *)&BigEndianVal, sizeof(BigEndianVal));
+		auto RawVal = Format::FromNative(tVal);
+		tData.PutRange((const uint8_t *)&RawVal, sizeof(RawVal));
 		return AllOk;
 	MYCATCH;
 	}
 
-	template<typename OutputStream, typename InfoFunc>
+	//按格式策略写出字段：VarInt字段通过策略编码，其余字段与WriteEndian相同
+	template<typename Format, typename T, typename OutputStream, typename InfoFunc>
+	requires std::integral<T>
+	static inline ErrCode WriteValue(OutputStream &tData, const T &tVal, InfoFunc &funcInfo) noexcept
+	{
+		if constexpr (Format::template bVarIntField<T>)
+		{
+		MYTRY;
+			uint8_t u8Buf[Format::szMaxFieldSize];
+			size_t szSize = Format::EncodeField(tVal, u8Buf);
+			tData.PutRange((const uint8_t *)u8Buf, szSize);
+			return AllOk;
+		MYCATCH;
+		}
+		else
+		{
+			return WriteEndian<Format>(tData, tVal, funcInfo);
+		}
+	}
+
+	//按格式策略批量写出数组，通过栈上缓冲区分块转换，整个数组只需一次异常包装
+	template<typename Format, typename T, typename OutputStream, typename InfoFunc>
+	requires std::integral<T>
+	static inline ErrCode WriteValueArray(OutputStream &tData, const T *pArray, size_t szCount, InfoFunc &funcInfo) noexcept
+	{
+	MYTRY;
+		//VarInt元素逐个编码到缓冲区，缓冲区满4KiB后写出
+		if constexpr (Format::template bVarIntField<T>)
+		{
+			constexpr size_t szBufSize = 4096;
+			uint8_t u8Buf[szBufSize + Format::szMaxFieldSize];
+			size_t szUsed = 0;
+
+			for (size_t i = 0; i < szCount; ++i)
+			{
+				szUsed += Format::EncodeField(pArray[i], &u8Buf[szUsed]);
+				if (szUsed >= szBufSize)
+				{
+					tData.PutRange((const uint8_t *)u8Buf, szUsed);
+					szUsed = 0;
+				}
+			}
+
+			if (szUsed != 0)
+			{
+				tData.PutRange((const uint8_t *)u8Buf, szUsed);
+			}
+			return AllOk;
+		}
+		//单字节或流字节序与平台一致，则无需转换，直接写出
+		else if constexpr (sizeof(T) == 1 || Format::bNativeOrder)
+		{
+			if (szCount != 0)
+			{
+				tData.PutRange((const uint8_t *)pArray, szCount * sizeof(T));
+			}
+			return AllOk;
+		}
+		else
+		{
+			constexpr size_t szBufCount = 4096 / sizeof(T);//每块4KiB
+			T tBuf[szBufCount];
+
+			for (size_t i = 0; i < szCount; i += szBufCount)
+			{
+				size_t szCurCount = std::min(szBufCount, szCount - i);
+				Format::FromNativeArray(tBuf, &pArray[i], szCurCount);
+				tData.PutRange((const uint8_t *)tBuf, szCurCount * sizeof(T));
+			}
+			return AllOk;
+		}
+	MYCATCH;
+	}
+
+	template<typename Format, typename OutputStream, typename InfoFunc>
 	static ErrCode PutName(OutputStream &tData, const NBT_Type::String &sName, InfoFunc &funcInfo) noexcept
 	{
 	MYTRY;
@@ -264,7 +340,7 @@ catch(...)\
 
 		//输出名称长度
 		NBT_Type::StringLength wStringLength = (NBT_Type::StringLength)szStringLength;
-		eRet = WriteBigEndian(tData, wStringLength, funcInfo);
+		eRet = WriteValue<Format>(tData, wStringLength, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("wStringLength Write");
@@ -288,7 +364,7 @@ catch(...)\
 	MYCATCH;
 	}
 
-	template<typename T, typename OutputStream, typename InfoFunc>
+	template<typename Format, typename T, typename OutputStream, typename InfoFunc>
 	static ErrCode PutbuiltInType(OutputStream &tData, const T &tBuiltIn, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
@@ -297,7 +373,7 @@ catch(...)\
 		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//原始类型映射
 		RAW_DATA_T tTmpRawData = std::bit_cast<RAW_DATA_T>(tBuiltIn);
 
-		eRet = WriteBigEndian(tData, tTmpRawData, funcInfo);
+		eRet = WriteValue<Format>(tData, tTmpRawData, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("tTmpRawData Write");
@@ -307,7 +383,7 @@ catch(...)\
 		return eRet;
 	}
 
-	template<typename T, typename OutputStream, typename InfoFunc>
+	template<typename Format, typename T, typename OutputStream, typename InfoFunc>
 	static ErrCode PutArrayType(OutputStream &tData, const T &tArray, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
@@ -325,7 +401,7 @@ catch(...)\
 
 		//获取实际写出大小
 		NBT_Type::ArrayLength iArrayLength = (NBT_Type::ArrayLength)szArrayLength;
-		eRet = WriteBigEndian(tData, iArrayLength, funcInfo);
+		eRet = WriteValue<Format>(tData, iArrayLength, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("iArrayLength Write");
@@ -343,20 +419,17 @@ catch(...)\
 			return eRet;
 		}
 
-		for (size_t i = 0; i < szArrayLength; ++i)
+		eRet = WriteValueArray<Format>(tData, tArray.data(), szArrayLength, funcInfo);
+		if (eRet != AllOk)
 		{
-			eRet = WriteBigEndian(tData, tArray[i], funcInfo);
-			if (eRet != AllOk)
-			{
-				STACK_TRACEBACK("tTmpData Write");
-				return eRet;
-			}
+			STACK_TRACEBACK("tArray Write");
+			return eRet;
 		}
 
 		return eRet;
 	}
 
-	template<typename SortPolicy, typename OutputStream, typename InfoFunc>
+	template<typename Format, typename SortPolicy, typename OutputStream, typename InfoFunc>
 	static ErrCode PutCompoundEntry(OutputStream &tData, const NBT_Type::String &sName, const NBT_Node &nodeNbt, size_t szStackDepth, InfoFunc &funcInfo)//它不是noexcept的
 	{
 		ErrCode eRet = AllOk;
@@ -374,7 +447,7 @@ catch(...)\
 		}
 
 		//先写出tag
-		eRet = WriteBigEndian(tData, (NBT_TAG_RAW_TYPE)enCompoundEntryTag, funcInfo);
+		eRet = WriteValue<Format>(tData, (NBT_TAG_RAW_TYPE)enCompoundEntryTag, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("enCompoundEntryTag Write");
@@ -382,7 +455,7 @@ catch(...)\
 		}
 
 		//然后写出name
-		eRet = PutName(tData, sName, funcInfo);
+		eRet = PutName<Format>(tData, sName, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("PutName Error, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enCompoundEntryTag));
@@ -390,7 +463,7 @@ catch(...)\
 		}
 
 		//最后根据tag类型写出数据
-		eRet = PutSwitch<SortPolicy>(tData, nodeNbt, enCompoundEntryTag, szStackDepth - 1, funcInfo);
+		eRet = PutSwitch<Format, SortPolicy>(tData, nodeNbt, enCompoundEntryTag, szStackDepth - 1, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("PutSwitch Error, Name: \"{}\", Type: [NBT_Type::{}]",
@@ -401,13 +474,13 @@ catch(...)\
 		return eRet;
 	}
 
-	template<typename OutputStream, typename InfoFunc>
+	template<typename Format, typename OutputStream, typename InfoFunc>
 	static ErrCode PutCompoundEnd(OutputStream &tData, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
 		
 		//注意Compound类型有一个NBT_TAG::End结尾
-		eRet = WriteBigEndian(tData, (NBT_TAG_RAW_TYPE)NBT_TAG::End, funcInfo);
+		eRet = WriteValue<Format>(tData, (NBT_TAG_RAW_TYPE)NBT_TAG::End, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("NBT_TAG::End[0x00(0)] Write");
@@ -418,7 +491,7 @@ catch(...)\
 	}
 
 	//如果是非根部，则会输出额外的Compound_End
-	template<bool bRoot, typename SortPolicy, typename OutputStream, typename InfoFunc>
+	template<typename Format, bool bRoot, typename SortPolicy, typename OutputStream, typename InfoFunc>
 	static ErrCode PutCompoundType(OutputStream &tData, const NBT_Type::Compound &tCompound, size_t szStackDepth, InfoFunc &funcInfo) noexcept
 	{
 	MYTRY;
@@ -488,7 +561,7 @@ catch(...)\
 				}
 			}();//立刻调用
 
-			eRet = PutCompoundEntry<SortPolicy>(tData, sName, nodeNbt, szStackDepth, funcInfo);
+			eRet = PutCompoundEntry<Format, SortPolicy>(tData, sName, nodeNbt, szStackDepth, funcInfo);
 			if (eRet != AllOk)
 			{
 				STACK_TRACEBACK("PutCompoundEntry");
@@ -498,7 +571,7 @@ catch(...)\
 
 		if constexpr (!bRoot)
 		{
-			eRet = PutCompoundEnd(tData, funcInfo);
+			eRet = PutCompoundEnd<Format>(tData, funcInfo);
 			if (eRet != AllOk)
 			{
 				STACK_TRACEBACK("PutCompoundEnd");
@@ -510,12 +583,12 @@ catch(...)\
 	MYCATCH;
 	}
 
-	template<typename OutputStream, typename InfoFunc>
+	template<typename Format, typename OutputStream, typename InfoFunc>
 	static ErrCode PutStringType(OutputStream &tData, const NBT_Type::String &tString, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
 
-		eRet = PutName(tData, tString, funcInfo);//借用PutName实现，因为string走的name相同操作
+		eRet = PutName<Format>(tData, tString, funcInfo);//借用PutName实现，因为string走的name相同操作
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("PutString");//因为是借用实现，所以这里小小的改个名，防止报错Name误导人
@@ -525,7 +598,79 @@ catch(...)\
 		return eRet;
 	}
 
-	template<typename SortPolicy, typename OutputStream, typename InfoFunc>
+	//定长数值类型的列表元素：逐个取出原始数据放入栈上缓冲区，分块转换字节序后批量写出
+	//打包的列表直接从打包缓冲区取出数据
+	template<typename Format, typename T, typename OutputStream, typename InfoFunc>
+	static ErrCode PutNumericListElements(OutputStream &tData, const NBT_Type::List &tList, InfoFunc &funcInfo) noexcept
+	{
+	MYTRY;
+		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//原始类型映射
+
+		constexpr size_t szBufCount = 4096 / sizeof(RAW_DATA_T);//每块4KiB
+		RAW_DATA_T tBuf[szBufCount];
+
+		std::span<const T> spanPacked = tList.GetPacked<T>();
+		size_t szListLength = tList.Size();
+		for (size_t i = 0; i < szListLength; i += szBufCount)
+		{
+			size_t szCurCount = std::min(szBufCount, szListLength - i);
+			if (tList.IsPacked())
+			{
+				for (size_t j = 0; j < szCurCount; ++j)
+				{
+					tBuf[j] = std::bit_cast<RAW_DATA_T>(spanPacked[i + j]);
+				}
+			}
+			else
+			{
+				for (size_t j = 0; j < szCurCount; ++j)
+				{
+					tBuf[j] = std::bit_cast<RAW_DATA_T>(tList[i + j].Get<T>());
+				}
+			}
+
+			if constexpr (Format::template bVarIntField<RAW_DATA_T>)
+			{
+				ErrCode eRet = WriteValueArray<Format>(tData, tBuf, szCurCount, funcInfo);
+				if (eRet != AllOk)
+				{
+					STACK_TRACEBACK("WriteValueArray Error, Index: [{}]", i);
+					return eRet;
+				}
+			}
+			else
+			{
+				Format::FromNativeArray(tBuf, tBuf, szCurCount);
+				tData.PutRange((const uint8_t *)tBuf, szCurCount * sizeof(RAW_DATA_T));
+			}
+		}
+
+		return AllOk;
+	MYCATCH;
+	}
+
+	template<typename Format, typename OutputStream, typename InfoFunc>
+	static ErrCode PutNumericListSwitch(OutputStream &tData, const NBT_Type::List &tList, NBT_TAG enListElementTag, InfoFunc &funcInfo) noexcept
+	{
+		switch (enListElementTag)
+		{
+		case NBT_TAG::Byte:		return PutNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Byte>>(tData, tList, funcInfo);
+		case NBT_TAG::Short:	return PutNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Short>>(tData, tList, funcInfo);
+		case NBT_TAG::Int:		return PutNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Int>>(tData, tList, funcInfo);
+		case NBT_TAG::Long:		return PutNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Long>>(tData, tList, funcInfo);
+		case NBT_TAG::Float:	return PutNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Float>>(tData, tList, funcInfo);
+		case NBT_TAG::Double:	return PutNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Double>>(tData, tList, funcInfo);
+		default:
+			{
+				ErrCode eRet = Error(NbtTypeTagError, tData, funcInfo, "{}:\nNot a numeric Tag[0x{:02X}({})]", __FUNCTION__,
+					(NBT_TAG_RAW_TYPE)enListElementTag, (NBT_TAG_RAW_TYPE)enListElementTag);
+				STACK_TRACEBACK("enListElementTag Test");
+				return eRet;
+			}
+		}
+	}
+
+	template<typename Format, typename SortPolicy, typename OutputStream, typename InfoFunc>
 	static ErrCode PutListType(OutputStream &tData, const NBT_Type::List &tList, size_t szStackDepth, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
@@ -538,34 +683,42 @@ catch(...)\
 		bool bNeedWarp = false;
 		NBT_TAG enListElementTag = NBT_TAG::End;
 
-		//判断列表元素一致性，不一致则使用Compound封装
-		for (const auto &it : tList)
+		//打包的列表元素类型一致且没有空元素，不需要遍历（遍历会展开列表）
+		//否则判断列表元素一致性，不一致则使用Compound封装
+		if (tList.IsPacked())
 		{
-			NBT_TAG curTag = it.GetTag();
-			if (curTag == NBT_TAG::End)
+			enListElementTag = tList.GetPackedTag();
+		}
+		else
+		{
+			for (const auto &it : tList)
 			{
-				++szListEmptyEntryLength;//统计空元素数量
-				continue;//空元素没有后续判断必要性，跳过
-			}
+				NBT_TAG curTag = it.GetTag();
+				if (curTag == NBT_TAG::End)
+				{
+					++szListEmptyEntryLength;//统计空元素数量
+					continue;//空元素没有后续判断必要性，跳过
+				}
 
-			//如果已经确定需要进行替换，则跳过
-			if (bNeedWarp == true)
-			{
-				continue;
-			}
+				//如果已经确定需要进行替换，则跳过
+				if (bNeedWarp == true)
+				{
+					continue;
+				}
 
-			//如果列表元素值为End，那么替换为当前类型
-			if (enListElementTag == NBT_TAG::End)
-			{
-				enListElementTag = curTag;
-				continue;
-			}
-			
-			//类型不同则设为替换类型
-			if (enListElementTag != curTag)
-			{
-				bNeedWarp = true;
-				enListElementTag = NBT_TAG::Compound;//修改为Compound封装
+				//如果列表元素值为End，那么替换为当前类型
+				if (enListElementTag == NBT_TAG::End)
+				{
+					enListElementTag = curTag;
+					continue;
+				}
+				
+				//类型不同则设为替换类型
+				if (enListElementTag != curTag)
+				{
+					bNeedWarp = true;
+					enListElementTag = NBT_TAG::Compound;//修改为Compound封装
+				}
 			}
 		}
 
@@ -576,7 +729,7 @@ catch(...)\
 
 		//检查
 		//仅判断去除空元素后是否超出上限
-		size_t szListLength = tList.size();
+		size_t szListLength = tList.Size();
 		size_t szListNoEmptyEntryLength = szListLength - szListEmptyEntryLength;
 		if (szListNoEmptyEntryLength > (size_t)NBT_Type::ListLength_Max)//大于的情况下强制赋值会导致严重问题，只能返回错误
 		{
@@ -587,7 +740,7 @@ catch(...)\
 		}
 
 		//写出标签
-		eRet = WriteBigEndian(tData, (NBT_TAG_RAW_TYPE)enListElementTag, funcInfo);
+		eRet = WriteValue<Format>(tData, (NBT_TAG_RAW_TYPE)enListElementTag, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("enListElementTag Write");
@@ -596,13 +749,24 @@ catch(...)\
 
 		//写出长度，不包含空元素，所以减去iListEmptyEntryLength
 		NBT_Type::ListLength iListLength = (NBT_Type::ListLength)szListNoEmptyEntryLength;
-		eRet = WriteBigEndian(tData, iListLength, funcInfo);
+		eRet = WriteValue<Format>(tData, iListLength, funcInfo);
 		if (eRet != AllOk)
 		{
 			STACK_TRACEBACK("iListLength Write");
 			return eRet;
 		}
 
+		//没有空元素的定长数值类型列表像数组一样批量写出
+		if (!bNeedWarp && szListEmptyEntryLength == 0 && NBT_Type::IsNumericTag(enListElementTag))
+		{
+			eRet = PutNumericListSwitch<Format>(tData, tList, enListElementTag, funcInfo);
+			if (eRet != AllOk)
+			{
+				STACK_TRACEBACK("PutNumericListSwitch Error, Size: [{}]", szListLength);
+			}
+			return eRet;
+		}
+
 		//写出列表（递归）
 		for (size_t i = 0; i < szListLength; ++i)//注意遍历仍然需要遍历整个列表而不是仅szListNoEmptyEntryLength，因为空元素可以在任何位置
 		{
@@ -620,7 +784,7 @@ catch(...)\
 			if (!bNeedWarp)//不需要封装，直接写出
 			{
 				//列表无名字，无需重复tag，只需输出数据
-				eRet = PutSwitch<SortPolicy>(tData, tmpNode, enListElementTag, szStackDepth - 1, funcInfo);//同一元素类型List
+				eRet = PutSwitch<Format, SortPolicy>(tData, tmpNode, enListElementTag, szStackDepth - 1, funcInfo);//同一元素类型List
 
 				if (eRet != AllOk)
 				{
@@ -637,14 +801,14 @@ catch(...)\
 					const auto &cpdNode = tmpNode.GetCompound();
 					if (cpdNode.Size() != 1 || !cpdNode.Contains(MU8STR("")))//直接写出为Compound
 					{
-						eRet = PutCompoundType<false, SortPolicy>(tData, cpdNode, szStackDepth - 1, funcInfo);
+						eRet = PutCompoundType<Format, false, SortPolicy>(tData, cpdNode, szStackDepth - 1, funcInfo);
 						continue;
 					}
 				}
 				
 				//是Compound但是需要再套一层或者不是Compound
 				MYTRY;
-				eRet = PutCompoundEntry<SortPolicy>(tData, MU8STR(""), tmpNode, szStackDepth - 1, funcInfo);
+				eRet = PutCompoundEntry<Format, SortPolicy>(tData, MU8STR(""), tmpNode, szStackDepth - 1, funcInfo);
 				MYCATCH;
 				if (eRet != AllOk)
 				{
@@ -652,7 +816,7 @@ catch(...)\
 					return eRet;
 				}
 
-				eRet = PutCompoundEnd(tData, funcInfo);
+				eRet = PutCompoundEnd<Format>(tData, funcInfo);
 				if (eRet != AllOk)
 				{
 					STACK_TRACEBACK("PutCompoundEnd");
@@ -664,7 +828,7 @@ catch(...)\
 		return eRet;
 	}
 
-	template<typename SortPolicy, typename OutputStream, typename InfoFunc>
+	template<typename Format, typename SortPolicy, typename OutputStream, typename InfoFunc>
 	static ErrCode PutSwitch(OutputStream &tData, const NBT_Node &nodeNbt, NBT_TAG tagNbt, size_t szStackDepth, InfoFunc &funcInfo) noexcept
 	{
 		ErrCode eRet = AllOk;
@@ -674,73 +838,73 @@ catch(...)\
 		case NBT_TAG::Byte:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Byte>;
-				eRet = PutbuiltInType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutbuiltInType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Short:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Short>;
-				eRet = PutbuiltInType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutbuiltInType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Int:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Int>;
-				eRet = PutbuiltInType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutbuiltInType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Long:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Long>;
-				eRet = PutbuiltInType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutbuiltInType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Float:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Float>;
-				eRet = PutbuiltInType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutbuiltInType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::Double:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Double>;
-				eRet = PutbuiltInType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutbuiltInType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::ByteArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::ByteArray>;
-				eRet = PutArrayType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutArrayType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::String://类型唯一，非模板函数
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::String>;
-				eRet = PutStringType(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutStringType<Format>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::List://可能递归，需要处理szStackDepth
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::List>;
-				eRet = PutListType<SortPolicy>(tData, nodeNbt.Get<CurType>(), szStackDepth, funcInfo);
+				eRet = PutListType<Format, SortPolicy>(tData, nodeNbt.Get<CurType>(), szStackDepth, funcInfo);
 			}
 			break;
 		case NBT_TAG::Compound://可能递归，需要处理szStackDepth
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::Compound>;
-				eRet = PutCompoundType<false, SortPolicy>(tData, nodeNbt.Get<CurType>(), szStackDepth, funcInfo);
+				eRet = PutCompoundType<Format, false, SortPolicy>(tData, nodeNbt.Get<CurType>(), szStackDepth, funcInfo);
 			}
 			break;
 		case NBT_TAG::IntArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::IntArray>;
-				eRet = PutArrayType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutArrayType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::LongArray:
 			{
 				using CurType = NBT_Type::TagToType_T<NBT_TAG::LongArray>;
-				eRet = PutArrayType<CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
+				eRet = PutArrayType<Format, CurType>(tData, nodeNbt.Get<CurType>(), funcInfo);
 			}
 			break;
 		case NBT_TAG::End://注意end标签绝对不可以进来
@@ -764,6 +928,292 @@ catch(...)\
 
 		return eRet;
 	}
+
+	//网络格式根部：先写出根标签类型，然后直接写出负载，没有根名称
+	//End根表示空值，只写出一个字节
+	template<typename Format, typename SortPolicy, typename OutputStream, typename InfoFunc>
+	static ErrCode PutNetworkRoot(OutputStream &tData, const NBT_Node &nodeRoot, size_t szStackDepth, InfoFunc &funcInfo) noexcept
+	{
+		ErrCode eRet = AllOk;
+
+		//写出根标签
+		NBT_TAG enRootTag = nodeRoot.GetTag();
+		eRet = WriteValue<Format>(tData, (NBT_TAG_RAW_TYPE)enRootTag, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("enRootTag Write");
+			return eRet;
+		}
+
+		if (enRootTag == NBT_TAG::End)
+		{
+			return eRet;
+		}
+
+		//根据tag类型写出数据
+		eRet = PutSwitch<Format, SortPolicy>(tData, nodeRoot, enRootTag, szStackDepth, funcInfo);
+		if (eRet != AllOk)
+		{
+			STACK_TRACEBACK("PutSwitch Error, Type: [NBT_Type::{}]", NBT_Type::GetTypeName(enRootTag));
+			return eRet;
+		}
+
+		return eRet;
+	}
+
+	//序列化大小计算：与Put系列函数的写出逻辑一一对应，把写出的字节数累加到szSize中
+	//可嵌套类型与Put系列一样检查递归深度，深度超限返回false，其余情况不会失败
+	//注意大小计算不检查长度上限，超出上限的对象会在写出时报错
+	template<typename Format, typename T>
+	static constexpr size_t SizeOfValue(const T &tVal) noexcept
+	{
+		if constexpr (Format::template bVarIntField<T>)
+		{
+			return Format::FieldSize(tVal);
+		}
+		else
+		{
+			return sizeof(T);
+		}
+	}
+
+	template<typename Format>
+	static size_t SizeOfName(const NBT_Type::String &sName) noexcept
+	{
+		using ValueType = NBT_Type::String::value_type;
+		return SizeOfValue<Format>((NBT_Type::StringLength)sName.size()) + sName.size() * sizeof(ValueType);
+	}
+
+	template<typename Format, typename T>
+	static size_t SizeOfBuiltInType(const T &tBuiltIn) noexcept
+	{
+		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//原始类型映射
+		return SizeOfValue<Format>(std::bit_cast<RAW_DATA_T>(tBuiltIn));
+	}
+
+	template<typename Format, typename T>
+	static size_t SizeOfArrayType(const T &tArray) noexcept
+	{
+		using ValueType = typename T::value_type;
+		size_t szSize = SizeOfValue<Format>((NBT_Type::ArrayLength)tArray.size());
+
+		if constexpr (Format::template bVarIntField<ValueType>)
+		{
+			for (const auto &it : tArray)
+			{
+				szSize += Format::FieldSize(it);
+			}
+		}
+		else
+		{
+			szSize += tArray.size() * sizeof(ValueType);
+		}
+
+		return szSize;
+	}
+
+	//没有空元素的数值类型列表：定长元素直接按数量计算，VarInt元素逐个计算
+	template<typename Format, typename T>
+	static size_t SizeOfNumericListElements(const NBT_Type::List &tList) noexcept
+	{
+		using RAW_DATA_T = NBT_Type::BuiltinRawType_T<T>;//原始类型映射
+
+		if constexpr (Format::template bVarIntField<RAW_DATA_T>)
+		{
+			size_t szSize = 0;
+			if (tList.IsPacked())
+			{
+				for (const T &tValue : tList.GetPacked<T>())
+				{
+					szSize += SizeOfBuiltInType<Format>(tValue);
+				}
+			}
+			else
+			{
+				for (const auto &it : tList)
+				{
+					szSize += SizeOfBuiltInType<Format>(it.Get<T>());
+				}
+			}
+			return szSize;
+		}
+		else
+		{
+			return tList.Size() * sizeof(RAW_DATA_T);
+		}
+	}
+
+	template<typename Format>
+	static size_t SizeOfNumericListSwitch(const NBT_Type::List &tList, NBT_TAG enListElementTag) noexcept
+	{
+		switch (enListElementTag)
+		{
+		case NBT_TAG::Byte:		return SizeOfNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Byte>>(tList);
+		case NBT_TAG::Short:	return SizeOfNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Short>>(tList);
+		case NBT_TAG::Int:		return SizeOfNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Int>>(tList);
+		case NBT_TAG::Long:		return SizeOfNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Long>>(tList);
+		case NBT_TAG::Float:	return SizeOfNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Float>>(tList);
+		case NBT_TAG::Double:	return SizeOfNumericListElements<Format, NBT_Type::TagToType_T<NBT_TAG::Double>>(tList);
+		default:				return 0;
+		}
+	}
+
+	template<typename Format>
+	static bool AddCompoundEntrySize(const NBT_Type::String &sName, const NBT_Node &nodeNbt, size_t szStackDepth, size_t &szSize) noexcept
+	{
+		//End元素不写出
+		NBT_TAG enCompoundEntryTag = nodeNbt.GetTag();
+		if (enCompoundEntryTag == NBT_TAG::End)
+		{
+			return true;
+		}
+
+		szSize += sizeof(NBT_TAG_RAW_TYPE) + SizeOfName<Format>(sName);
+		return AddSwitchSize<Format>(nodeNbt, enCompoundEntryTag, szStackDepth - 1, szSize);
+	}
+
+	//累加非根部Compound的大小，包括末尾的NBT_TAG::End，根部由调用者减去
+	template<typename Format>
+	static bool AddCompoundSize(const NBT_Type::Compound &tCompound, size_t szStackDepth, size_t &szSize) noexcept
+	{
+		if (szStackDepth == 0)
+		{
+			return false;
+		}
+
+		//排序只改变顺序，不影响大小
+		size_t szCompoundSize = sizeof(NBT_TAG_RAW_TYPE);//NBT_TAG::End
+		for (const auto &[sName, nodeNbt] : tCompound)
+		{
+			if (!AddCompoundEntrySize<Format>(sName, nodeNbt, szStackDepth, szCompoundSize))
+			{
+				return false;
+			}
+		}
+
+		szSize += szCompoundSize;
+		return true;
+	}
+
+	template<typename Format>
+	static bool AddListSize(const NBT_Type::List &tList, size_t szStackDepth, size_t &szSize) noexcept
+	{
+		if (szStackDepth == 0)
+		{
+			return false;
+		}
+
+		//与PutListType相同的方式确定元素类型与是否需要封装
+		size_t szListEmptyEntryLength = 0;
+		bool bNeedWarp = false;
+		NBT_TAG enListElementTag = NBT_TAG::End;
+		if (tList.IsPacked())
+		{
+			enListElementTag = tList.GetPackedTag();
+		}
+		else
+		{
+			for (const auto &it : tList)
+			{
+				NBT_TAG curTag = it.GetTag();
+				if (curTag == NBT_TAG::End)
+				{
+					++szListEmptyEntryLength;
+					continue;
+				}
+
+				if (bNeedWarp == true)
+				{
+					continue;
+				}
+
+				if (enListElementTag == NBT_TAG::End)
+				{
+					enListElementTag = curTag;
+					continue;
+				}
+
+				if (enListElementTag != curTag)
+				{
+					bNeedWarp = true;
+					enListElementTag = NBT_TAG::Compound;
+				}
+			}
+		}
+
+		//标签与不含空元素的长度
+		size_t szListSize = sizeof(NBT_TAG_RAW_TYPE) + SizeOfValue<Format>((NBT_Type::ListLength)(tList.Size() - szListEmptyEntryLength));
+
+		//与PutListType一样，没有空元素的数值类型列表整体计算
+		if (!bNeedWarp && szListEmptyEntryLength == 0 && NBT_Type::IsNumericTag(enListElementTag))
+		{
+			szListSize += SizeOfNumericListSwitch<Format>(tList, enListElementTag);
+		}
+		else
+		{
+			for (const auto &it : tList)
+			{
+				NBT_TAG curTag = it.GetTag();
+				if (curTag == NBT_TAG::End)//空元素不写出
+				{
+					continue;
+				}
+
+				if (!bNeedWarp)
+				{
+					if (!AddSwitchSize<Format>(it, enListElementTag, szStackDepth - 1, szListSize))
+					{
+						return false;
+					}
+					continue;
+				}
+
+				//封装：不会与封装模式混淆的Compound直接写出，其余元素套一层无名Compound
+				if (curTag == NBT_TAG::Compound)
+				{
+					const auto &cpdNode = it.GetCompound();
+					if (cpdNode.Size() != 1 || !cpdNode.Contains(MU8STR("")))
+					{
+						if (!AddCompoundSize<Format>(cpdNode, szStackDepth - 1, szListSize))
+						{
+							return false;
+						}
+						continue;
+					}
+				}
+
+				if (!AddCompoundEntrySize<Format>(MU8STR(""), it, szStackDepth - 1, szListSize))
+				{
+					return false;
+				}
+				szListSize += sizeof(NBT_TAG_RAW_TYPE);//NBT_TAG::End
+			}
+		}
+
+		szSize += szListSize;
+		return true;
+	}
+
+	template<typename Format>
+	static bool AddSwitchSize(const NBT_Node &nodeNbt, NBT_TAG tagNbt, size_t szStackDepth, size_t &szSize) noexcept
+	{
+		switch (tagNbt)
+		{
+		case NBT_TAG::Byte:			szSize += SizeOfBuiltInType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Byte>>());			return true;
+		case NBT_TAG::Short:		szSize += SizeOfBuiltInType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Short>>());			return true;
+		case NBT_TAG::Int:			szSize += SizeOfBuiltInType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Int>>());			return true;
+		case NBT_TAG::Long:			szSize += SizeOfBuiltInType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Long>>());			return true;
+		case NBT_TAG::Float:		szSize += SizeOfBuiltInType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Float>>());			return true;
+		case NBT_TAG::Double:		szSize += SizeOfBuiltInType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Double>>());			return true;
+		case NBT_TAG::ByteArray:	szSize += SizeOfArrayType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::ByteArray>>());		return true;
+		case NBT_TAG::IntArray:		szSize += SizeOfArrayType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::IntArray>>());			return true;
+		case NBT_TAG::LongArray:	szSize += SizeOfArrayType<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::LongArray>>());		return true;
+		case NBT_TAG::String:		szSize += SizeOfName<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::String>>());				return true;
+		case NBT_TAG::List:			return AddListSize<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::List>>(), szStackDepth, szSize);
+		case NBT_TAG::Compound:		return AddCompoundSize<Format>(nodeNbt.Get<NBT_Type::TagToType_T<NBT_TAG::Compound>>(), szStackDepth, szSize);
+		default:					return true;//End与未知类型由写出函数报错，此处不计大小
+		}
+	}
 ///@endcond
 
 public:
@@ -787,12 +1237,58 @@ public:
 		}
 	};
 
+	/// @brief 计算NBT_Type::Compound对象通过WriteNBT写出时的精确字节数
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @param tCompound 需要计算的对象，与WriteNBT一样，对象本身不写出，只计算其中的内容
+	/// @param[out] szSize 返回写出的字节数
+	/// @param szStackDepth 递归最大深度，与WriteNBT的参数一致
+	/// @return 计算成功返回true，嵌套深度超过szStackDepth时返回false
+	/// @note 结果与WriteNBT实际写出的字节数完全一致，排序策略不影响大小。可以用于提前写出长度前缀，或是提前分配区域文件扇区。
+	/// 大小计算不检查字符串、数组与列表的长度上限，超出上限的对象会在写出时报错。
+	template<typename Format = NBT_Format::BigEndian>
+	requires IsLookLike_NBT_Format<Format>
+	static bool GetNBTSize(const NBT_Type::Compound &tCompound, size_t &szSize, size_t szStackDepth = 512) noexcept
+	{
+		size_t szCompoundSize = 0;
+		if (!AddCompoundSize<Format>(tCompound, szStackDepth, szCompoundSize))
+		{
+			return false;
+		}
+
+		szSize = szCompoundSize - sizeof(NBT_TAG_RAW_TYPE);//根部没有NBT_TAG::End
+		return true;
+	}
+
+	/// @brief 计算NBT_Node对象的负载写出时的精确字节数，不包括类型标签与名称
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @param nodeNbt 需要计算的对象，End类型的大小为0
+	/// @param[out] szSize 返回写出的字节数
+	/// @param szStackDepth 递归最大深度
+	/// @return 计算成功返回true，嵌套深度超过szStackDepth时返回false
+	/// @note Compound对象的负载包括末尾的NBT_TAG::End，所以比作为根部通过GetNBTSize计算的结果多1字节。
+	/// 其它信息请参考GetNBTSize的说明。
+	template<typename Format = NBT_Format::BigEndian>
+	requires IsLookLike_NBT_Format<Format>
+	static bool GetPayloadSize(const NBT_Node &nodeNbt, size_t &szSize, size_t szStackDepth = 512) noexcept
+	{
+		size_t szPayloadSize = 0;
+		if (!AddSwitchSize<Format>(nodeNbt, nodeNbt.GetTag(), szStackDepth, szPayloadSize))
+		{
+			return false;
+		}
+
+		szSize = szPayloadSize;
+		return true;
+	}
+
 
 	//输出到tData中，部分功能和原理参照ReadNBT处的注释，szDataStartIndex在此处可以对一个tData通过不同的tCompound和szStartIdx = tData.size()
 	//来调用以达到把多个不同的nbt输出到同一个tData内的功能
 
 	/// @brief 将NBT_Type::Compound对象写入到输出流中
 	/// @tparam SortPolicy 用于进行Compound写出前排序的可调用类型，或不进行排序的提示标签类型
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式，写出基岩版存档数据时使用NBT_Format::LittleEndian，
+	/// 写出基岩版网络协议数据时使用NBT_Format::VarInt
 	/// @tparam OutputStream 输出流类型，必须符合DefaultOutputStream类型的接口
 	/// @tparam InfoFunc 信息输出仿函数类型
 	/// @param[out] OptStream 输出流对象
@@ -801,14 +1297,16 @@ public:
 	/// @param funcInfo 错误信息处理仿函数
 	/// @return 写入成功返回true，失败返回false
 	/// @note 错误与警告信息都输出到funcInfo，错误会导致函数结束剩下的写出任务，并进行栈回溯输出，最终返回false。警告则只会输出一次信息，然后继续执行，如果没有任何错误但是存在警告，函数仍将返回true。
-	template<typename SortPolicy = DefaultCompoundSort<true>, typename OutputStream, typename InfoFunc = NBT_Print>
+	template<typename SortPolicy = DefaultCompoundSort<true>, typename Format = NBT_Format::BigEndian, typename OutputStream, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
 	static bool WriteNBT(OutputStream &OptStream, const NBT_Type::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
 	{
-		return PutCompoundType<true, SortPolicy>(OptStream, tCompound, szStackDepth, funcInfo) == AllOk;
+		return PutCompoundType<Format, true, SortPolicy>(OptStream, tCompound, szStackDepth, funcInfo) == AllOk;
 	}
 
 	/// @brief 将NBT_Type::Compound对象写入到数据容器中
 	/// @tparam SortPolicy 用于进行Compound写出前排序的可调用类型，或不进行排序的提示标签类型
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
 	/// @tparam DataType 数据容器类型
 	/// @tparam InfoFunc 信息输出仿函数类型
 	/// @param[out] tDataOutput 输出数据容器
@@ -819,12 +1317,94 @@ public:
 	/// @return 写入成功返回true，失败返回false
 	/// @note 函数可以通过设置szStartIdx = tDataOutput.size()，把多个Compound对象的数据流合并到同一个tDataOutput对象内。如果多个对象中有重复、同名的NBT键，
 	/// 虽然可以合并到流中，但是如果对这个流进行读取，读取例程为了保证在同一个Compound中的键的唯一性，会丢失部分信息，具体请参考ReadNBT接口的说明。
+	/// 写出前通过GetNBTSize计算精确大小并只预分配一次，写出过程中容器不会再重新分配。
 	/// 此函数是WriteNBT的标准库容器版本，其它信息请参考WriteNBT(OutputStream)版本的详细说明。
-	template<typename SortPolicy = DefaultCompoundSort<true>, typename DataType = std::vector<uint8_t>, typename InfoFunc = NBT_Print>
+	template<typename SortPolicy = DefaultCompoundSort<true>, typename Format = NBT_Format::BigEndian, typename DataType = std::vector<uint8_t>, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
 	static bool WriteNBT(DataType &tDataOutput, size_t szStartIdx, const NBT_Type::Compound &tCompound, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
 	{
 		NBT_IO::DefaultOutputStream<DataType> OptStream(tDataOutput, szStartIdx);
-		return PutCompoundType<true, SortPolicy>(OptStream, tCompound, szStackDepth, funcInfo) == AllOk;
+
+		//先计算精确大小并只预分配一次，写出过程中容器不会再重新分配
+		//深度超限时不预分配，由写出报错
+		size_t szSize = 0;
+		if (GetNBTSize<Format>(tCompound, szSize, szStackDepth) && CheckReserve(OptStream, szSize, funcInfo) != AllOk)
+		{
+			return false;
+		}
+
+		return PutCompoundType<Format, true, SortPolicy>(OptStream, tCompound, szStackDepth, funcInfo) == AllOk;
+	}
+
+	/// @brief 计算单个无名根标签以网络格式写出时的精确字节数
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @param nodeRoot 根标签对象，可以是任意类型，End表示空值
+	/// @param[out] szSize 返回写出的字节数，包括根标签类型字节
+	/// @param szStackDepth 递归最大深度，与WriteNetworkNBT的参数一致
+	/// @return 计算成功返回true，嵌套深度超过szStackDepth时返回false
+	/// @note 结果与WriteNetworkNBT实际写出的字节数完全一致，可以用于提前写出网络包长度前缀，
+	/// 或在调用者持有的缓冲区中预留空间后通过NBT_IO::BufferOutputStream直接写入。其它信息请参考GetNBTSize的说明。
+	template<typename Format = NBT_Format::BigEndian>
+	requires IsLookLike_NBT_Format<Format>
+	static bool GetNetworkNBTSize(const NBT_Node &nodeRoot, size_t &szSize, size_t szStackDepth = 512) noexcept
+	{
+		size_t szPayloadSize = 0;
+		if (!GetPayloadSize<Format>(nodeRoot, szPayloadSize, szStackDepth))
+		{
+			return false;
+		}
+
+		szSize = sizeof(NBT_TAG_RAW_TYPE) + szPayloadSize;//根标签
+		return true;
+	}
+
+	/// @brief 以网络格式把单个无名根标签写入到输出流中
+	/// @tparam SortPolicy 用于进行Compound写出前排序的可调用类型，或不进行排序的提示标签类型
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @tparam OutputStream 输出流类型，必须符合DefaultOutputStream类型的接口
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param[out] OptStream 输出流对象
+	/// @param nodeRoot 根标签对象，可以是任意类型
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 写入成功返回true，失败返回false
+	/// @note Java版协议764起，网络包内的NBT只包含根标签类型与负载，没有根名称，与文件格式不同。
+	/// 如果nodeRoot为End类型，则只写出一个0x00字节，表示空值。
+	/// 需要写入定长缓冲区时，先通过GetNetworkNBTSize得到大小，再使用NBT_IO::BufferOutputStream作为输出流。
+	/// 其它信息请参考WriteNBT(OutputStream)版本的详细说明。
+	template<typename SortPolicy = DefaultCompoundSort<true>, typename Format = NBT_Format::BigEndian, typename OutputStream, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
+	static bool WriteNetworkNBT(OutputStream &OptStream, const NBT_Node &nodeRoot, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		return PutNetworkRoot<Format, SortPolicy>(OptStream, nodeRoot, szStackDepth, funcInfo) == AllOk;
+	}
+
+	/// @brief 以网络格式把单个无名根标签写入到数据容器中
+	/// @tparam SortPolicy 用于进行Compound写出前排序的可调用类型，或不进行排序的提示标签类型
+	/// @tparam Format 二进制格式策略，默认为Java版的大端序格式
+	/// @tparam DataType 数据容器类型
+	/// @tparam InfoFunc 信息输出仿函数类型
+	/// @param[out] tDataOutput 输出数据容器
+	/// @param szStartIdx 数据起始索引，设置为tDataOutput.size()则追加到已有数据（比如网络包头）之后
+	/// @param nodeRoot 根标签对象，可以是任意类型
+	/// @param szStackDepth 递归最大深度，防止栈溢出
+	/// @param funcInfo 错误信息处理仿函数
+	/// @return 写入成功返回true，失败返回false
+	/// @note 写出前通过GetNetworkNBTSize计算精确大小并只预分配一次，写出过程中容器不会再重新分配。
+	/// 此函数是WriteNetworkNBT的标准库容器版本，其它信息请参考WriteNetworkNBT(OutputStream)版本的详细说明。
+	template<typename SortPolicy = DefaultCompoundSort<true>, typename Format = NBT_Format::BigEndian, typename DataType = std::vector<uint8_t>, typename InfoFunc = NBT_Print>
+	requires IsLookLike_NBT_Format<Format>
+	static bool WriteNetworkNBT(DataType &tDataOutput, size_t szStartIdx, const NBT_Node &nodeRoot, size_t szStackDepth = 512, InfoFunc funcInfo = InfoFunc{}) noexcept
+	{
+		NBT_IO::DefaultOutputStream<DataType> OptStream(tDataOutput, szStartIdx);
+
+		size_t szSize = 0;
+		if (GetNetworkNBTSize<Format>(nodeRoot, szSize, szStackDepth) && CheckReserve(OptStream, szSize, funcInfo) != AllOk)//深度超限时不预分配，由写出报错
+		{
+			return false;
+		}
+
+		return PutNetworkRoot<Format, SortPolicy>(OptStream, nodeRoot, szStackDepth, funcInfo) == AllOk;
 	}
 
 #ifdef CJF2_NBT_CPP_USE_ZLIB
@@ -835,39 +1415,112 @@ public:
 	/// @param tCompound 用于写出的对象
 	/// @param funcInfo 错误信息处理仿函数
 	/// @return 写入成功返回 true，失败返回 false
-	/// @note 本函数会先调用 WriteNBT 将 Compound 序列化为二进制数据，然后尝试使用 Zlib 压缩（压缩级别 -1）。
-	/// 若压缩失败，则直接写出未压缩的数据。最终将结果写入指定文件。如果文件已存在，会被覆盖，文件未存在则创建文件。
+	/// @note 本函数通过 NBT_IO::DeflateOutputStream 边序列化边使用 Gzip 压缩（压缩级别 -1），不会在内存中保存完整的序列化数据或压缩数据。
+	/// 数据先写入同目录下的临时文件（目标文件名加 ".tmp" 后缀），全部成功后才替换目标文件，所以任何失败都不会破坏已存在的目标文件，
+	/// 临时文件在失败时会被删除。如果压缩流出错，则退化为在内存中序列化并写出未压缩的数据。
 	template <typename InfoFunc = NBT_Print>
 	static bool SimpleWriteNbtFile(const std::filesystem::path &pathFileName, const NBT_Type::Compound &tCompound, InfoFunc funcInfo = InfoFunc{}) noexcept
 	{
-		//写入文件
-		std::vector<uint8_t> vNbtData;
-		if (!WriteNBT(vNbtData, 0, tCompound, 512, funcInfo))
+		std::filesystem::path pathTemp{};
+		auto RemoveTemp = [&](void) noexcept -> void
 		{
-			funcInfo(NBT_Print_Level::Err, "Error: WriteNBT failed.\n");
-			return false;
-		}
+			if (!pathTemp.empty())
+			{
+				std::error_code ec{};
+				std::filesystem::remove(pathTemp, ec);//忽略错误
+			}
+		};
 
-		//尝试压缩，压缩失败则直接写出
-		std::vector<uint8_t> vFileData;
-		if (!NBT_IO::CompressDataNoThrow(vFileData, vNbtData, -1, funcInfo))
+		try
 		{
-			funcInfo(NBT_Print_Level::Warn, "Warning: Compression failed, using uncompressed data.\n");
-			vFileData = std::move(vNbtData);
-		}
+			pathTemp = pathFileName;
+			pathTemp += ".tmp";
+
+			//边写边压缩到临时文件，流在lambda返回时析构并关闭文件
+			bool bStreamGood = true;//为false表示压缩流本身出错，而不是序列化出错
+			bool bWritten = [&](void) -> bool
+			{
+				NBT_IO::DeflateOutputStream OptStream(pathTemp, -1);
+				if (!OptStream.IsGood())
+				{
+					funcInfo(NBT_Print_Level::Warn, "Warning: Cannot open deflate stream for [{}]: {}\n", pathTemp.string(), OptStream.GetErrorInfo());
+					bStreamGood = false;
+					return false;
+				}
+
+				if (!WriteNBT(OptStream, tCompound, 512, funcInfo))
+				{
+					bStreamGood = OptStream.IsGood();
+					return false;
+				}
+
+				if (!OptStream.FinishNoThrow(funcInfo))
+				{
+					bStreamGood = false;
+					return false;
+				}
+
+				return true;
+			}();
 
-		//清理数据
-		vNbtData.clear();
-		vNbtData.shrink_to_fit();
+			if (!bWritten)
+			{
+				//序列化失败，退化写出也不会成功，直接返回
+				if (bStreamGood)
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: WriteNBT failed.\n");
+					RemoveTemp();
+					return false;
+				}
+
+				//压缩失败则直接写出
+				funcInfo(NBT_Print_Level::Warn, "Warning: Compression failed, using uncompressed data.\n");
+				std::vector<uint8_t> vNbtData;
+				if (!WriteNBT(vNbtData, 0, tCompound, 512, funcInfo))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: WriteNBT failed.\n");
+					RemoveTemp();
+					return false;
+				}
+
+				if (!NBT_IO::WriteFile(pathTemp, vNbtData, funcInfo))
+				{
+					funcInfo(NBT_Print_Level::Err, "Error: Cannot write file [{}].\n", pathTemp.string());
+					RemoveTemp();
+					return false;
+				}
+			}
+
+			//全部写出成功后替换目标文件
+			std::error_code ec{};
+			std::filesystem::rename(pathTemp, pathFileName, ec);
+			if (ec)
+			{
+				funcInfo(NBT_Print_Level::Err, "Error: Cannot replace file [{}]: {}\n", pathFileName.string(), ec.message());
+				RemoveTemp();
+				return false;
+			}
 
-		//写出
-		if (!NBT_IO::WriteFile(pathFileName, vFileData, funcInfo))
+			return true;
+		}
+		catch (const std::bad_alloc &e)
 		{
-			funcInfo(NBT_Print_Level::Err, "Error: Cannot write file [{}].\n", pathFileName.string());
+			funcInfo(NBT_Print_Level::Err, "std::bad_alloc:[{}]\n", e.what());
+			RemoveTemp();
+			return false;
+		}
+		catch (const std::exception &e)
+		{
+			funcInfo(NBT_Print_Level::Err, "std::exception:[{}]\n", e.what());
+			RemoveTemp();
+			return false;
+		}
+		catch (...)
+		{
+			funcInfo(NBT_Print_Level::Err, "Unknown Error\n");
+			RemoveTemp();
 			return false;
 		}
-
-		return true;
 	}
 
 #endif
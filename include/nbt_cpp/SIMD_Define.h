@@ -0,0 +1,51 @@
+﻿#pragma once
+
+/// @file 
+/// @brief 指令集检测支持宏
+/// 
+/// 本文件定义了指令集检测宏，用于在编译期选择向量化实现：
+/// - CJF2_NBT_CPP_SIMD_SSE2   (x86/x64 SSE2指令集标识)
+/// - CJF2_NBT_CPP_SIMD_AVX2   (x86/x64 AVX2指令集标识)
+/// - CJF2_NBT_CPP_SIMD_NEON   (ARM NEON指令集标识)
+/// 
+/// 仅根据编译选项（如/arch:AVX2、-mavx2）进行编译期判断，不进行运行时检测。
+/// 在包含本库之前定义CJF2_NBT_CPP_NO_SIMD可以禁用所有向量化实现，全部回落到标量实现。
+
+
+/// @cond
+
+//先预定义所有可能的指令集宏
+#define CJF2_NBT_CPP_SIMD_SSE2 0
+#define CJF2_NBT_CPP_SIMD_AVX2 0
+#define CJF2_NBT_CPP_SIMD_NEON 0
+
+//后实际判断是否支持，支持就替换它自己的宏为1
+#ifndef CJF2_NBT_CPP_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#undef  CJF2_NBT_CPP_SIMD_SSE2
+		#define CJF2_NBT_CPP_SIMD_SSE2 1
+	#endif
+
+	#if defined(__AVX2__)
+		#undef  CJF2_NBT_CPP_SIMD_AVX2
+		#define CJF2_NBT_CPP_SIMD_AVX2 1
+	#endif
+
+	#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+		#undef  CJF2_NBT_CPP_SIMD_NEON
+		#define CJF2_NBT_CPP_SIMD_NEON 1
+	#endif
+#endif
+
+//包含对应的指令集头文件
+#if CJF2_NBT_CPP_SIMD_AVX2
+	#include <immintrin.h>
+#elif CJF2_NBT_CPP_SIMD_SSE2
+	#include <emmintrin.h>
+#endif
+
+#if CJF2_NBT_CPP_SIMD_NEON
+	#include <arm_neon.h>
+#endif
+
+/// @endcond
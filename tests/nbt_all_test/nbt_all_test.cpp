@@ -205,6 +205,48 @@ void NBT_Endian_Test(void)
 	MyAssert(TestFunc(NBT_Endian::ByteSwap64(U64VAL), _U64VAL));
 }
 
+void NBT_EndianArray_Test(void)
+{
+	//覆盖向量化主体与标量尾部的各种长度
+	auto TestFunc = []<typename T>(void) -> bool
+	{
+		for (size_t szCount = 0; szCount <= 67; ++szCount)
+		{
+			std::vector<T> vSrc(szCount);
+			for (size_t i = 0; i < szCount; ++i)
+			{
+				vSrc[i] = (T)((uint64_t)0x0102'0304'0506'0708 * (i + 1));
+			}
+
+			//拷贝转换
+			std::vector<T> vDest(szCount);
+			NBT_Endian::ByteSwapArray(vDest.data(), vSrc.data(), szCount);
+
+			//原地转换
+			std::vector<T> vInPlace = vSrc;
+			NBT_Endian::ByteSwapArray(vInPlace.data(), vInPlace.data(), szCount);
+
+			for (size_t i = 0; i < szCount; ++i)
+			{
+				if (vDest[i] != NBT_Endian::AutoByteSwap(vSrc[i]) || vInPlace[i] != vDest[i])
+				{
+					PrintHexValNative(vSrc[i]);
+					PrintHexValNative(vDest[i]);
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	MyAssert(TestFunc.template operator()<uint8_t>());
+	MyAssert(TestFunc.template operator()<int16_t>());
+	MyAssert(TestFunc.template operator()<int32_t>());
+	MyAssert(TestFunc.template operator()<int64_t>());
+	MyAssert(TestFunc.template operator()<uint64_t>());
+}
+
 template<bool bAutoUnwrapMixedList = true, typename Data_T>
 void NBT_ReadWrite_Test(const Data_T &NbtRawData, const NBT_Type::Compound &cpdGen)
 {
@@ -444,6 +486,45 @@ void MixedListTest()
 	NBT_ReadWrite_Test<true>(NbtRawData, cpdGen);
 }
 
+void LargeArrayTest()
+{
+	//构造跨越写出缓冲区分块边界的大数组
+	NBT_Type::ByteArray baGen{};
+	NBT_Type::IntArray iaGen{};
+	NBT_Type::LongArray laGen{};
+	for (size_t i = 0; i < 3001; ++i)
+	{
+		baGen.push_back((NBT_Type::Byte)i);
+		iaGen.push_back((NBT_Type::Int)(i * 0x01020304));
+		laGen.push_back((NBT_Type::Long)(i * 0x0102030405060708));
+	}
+
+	NBT_Type::Compound cpdGen
+	{
+		{MU8STR(""),NBT_Type::Compound
+			{
+				{MU8STR("b"),baGen},
+				{MU8STR("i"),iaGen},
+				{MU8STR("l"),laGen},
+			}
+		}
+	};
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>>(vData, 0, cpdGen));
+
+	//检查写出的原始字节确实为大端序：根(3) + "b"(4) + 长度(4) + 3001字节 + "i"(4) + 长度(4) + 第一个Int
+	constexpr size_t szSecondInt = 3 + 4 + 4 + 3001 + 4 + 4 + 4;
+	MyAssert(vData.size() > szSecondInt + 4);
+	MyAssert(vData[szSecondInt + 0] == 0x01 && vData[szSecondInt + 1] == 0x02 && vData[szSecondInt + 2] == 0x03 && vData[szSecondInt + 3] == 0x04);
+
+	NBT_ReadWrite_Test(vData, cpdGen);
+
+	NBT_Visitor_Collector vc;
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vc));
+	MyAssert(vc.MoveRoot() == cpdGen);
+}
+
 void ScannerTest()
 {
 	constexpr auto NbtRawData = StrHexArray::ToHexArr < R"(
@@ -655,208 +736,2968 @@ void ScannerSkipTest()
 	}
 }
 
-struct PriorityCompoundSort
+void InflateStreamTest()
 {
-	// 优先级键：按列表顺序排在最前面
-	static inline std::vector<NBT_Type::String> s_priorityKeys{};
-	// 拖尾键：按列表顺序排在最后面
-	static inline std::vector<NBT_Type::String> s_trailerKeys{};
+	//构造包含大数组、字符串与需要跳过的条目的数据
+	NBT_Type::Compound cpdInner{};
+	NBT_Type::List listStr{};
+	for (int32_t i = 0; i < 500; ++i)
+	{
+		listStr.AddBackString(MU8STR("palette entry"));
+		std::string strKey = "key" + std::to_string(i);
+		cpdInner.PutInt(NBT_Type::String(strKey.begin(), strKey.end()), i);
+	}
+	cpdInner.PutList(MU8STR("list"), std::move(listStr));
 
-	std::vector<NBT_Type::Compound::Const_Iterator> operator()(const NBT_Type::Compound &cpdSort) const
+	NBT_Type::LongArray laData{};
+	for (uint64_t i = 0; i < 5000; ++i)
 	{
-		std::vector<NBT_Type::Compound::Const_Iterator> result;
-		result.reserve(cpdSort.Size());
+		laData.push_back((NBT_Type::Long)(i * 0x0102030405060708));
+	}
+	cpdInner.PutLongArray(MU8STR("long array"), laData);
+	cpdInner.PutLongArray(MU8STR("long array skip"), laData);
 
-		std::vector<NBT_Type::Compound::Const_Iterator> priorityIts;
-		std::vector<NBT_Type::Compound::Const_Iterator> normalIts;
-		std::vector<NBT_Type::Compound::Const_Iterator> trailerIts;
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen));
+
+	std::vector<uint8_t> vZipped{};
+	MyAssert(NBT_IO::CompressDataNoThrow(vZipped, vData));
+
+	//使用最小窗口，强制多次补充与扩容
+	{
+		NBT_IO::InflateInputStream isInflate(vZipped, 0, NBT_IO::InflateInputStream::MIN_WINDOW_SIZE);
+		NBT_Type::Compound cpdRead{};
+		MyAssert(NBT_Reader::ReadNBT(isInflate, cpdRead));
+		MyAssert(isInflate.IsGood());
+		MyAssert(isInflate.Index() == vData.size());
+		MyAssert(cpdRead == cpdGen);
+	}
+
+	//扫描器跳过路径，跳过的数据不经过窗口扩容
+	{
+		NBT_IO::InflateInputStream isInflate(vZipped, 0, NBT_IO::InflateInputStream::MIN_WINDOW_SIZE);
+		SkippingCollector vc;
+		MyAssert(NBT_Scanner::ScanNBT(isInflate, vc));
+		NBT_Type::Compound cpdScan = vc.MoveRoot();
+		MyAssert(cpdScan.GetCompound(MU8STR("")).Size() == cpdGen.GetCompound(MU8STR("")).Size() - 1);
+		MyAssert(cpdScan.GetCompound(MU8STR("")).GetLongArray(MU8STR("long array")) == laData);
+	}
+
+	//截断的压缩数据必须失败
+	{
+		std::vector<uint8_t> vTruncated(vZipped.begin(), vZipped.begin() + vZipped.size() / 2);
+		NBT_IO::InflateInputStream isInflate(vTruncated);
+		NBT_Type::Compound cpdRead{};
+		MyAssert(!NBT_Reader::ReadNBT(isInflate, cpdRead, 512, NBT_NoPrint{}));
+		MyAssert(!isInflate.IsGood());
+	}
+
+	//从文件读取
+	{
+		std::filesystem::path pathTemp = std::filesystem::temp_directory_path() / "nbt_all_test_inflate.nbt";
+		MyAssert(NBT_IO::WriteFile(pathTemp, vZipped));
 
-		for (auto it = cpdSort.cbegin(); it != cpdSort.cend(); ++it)
 		{
-			bool bFound = false;
+			NBT_IO::InflateInputStream isInflate(pathTemp);
+			NBT_Type::Compound cpdRead{};
+			MyAssert(NBT_Reader::ReadNBT(isInflate, cpdRead));
+			MyAssert(cpdRead == cpdGen);
+		}
 
-			for (const auto &key : s_priorityKeys)
-			{
-				if (it->first == key)
-				{
-					priorityIts.push_back(it);
-					bFound = true;
-					break;
-				}
-			}
-			if (bFound) continue;
+		std::filesystem::remove(pathTemp);
+	}
+}
 
-			for (const auto &key : s_trailerKeys)
-			{
-				if (it->first == key)
+void DeflateStreamTest()
+{
+	//构造包含大数组与大量小条目的数据
+	NBT_Type::Compound cpdInner{};
+	for (int32_t i = 0; i < 1000; ++i)
+	{
+		std::string strKey = "entry" + std::to_string(i);
+		cpdInner.PutString(NBT_Type::String(strKey.begin(), strKey.end()), MU8STR("value"));
+	}
+
+	NBT_Type::IntArray iaData{};
+	for (int32_t i = 0; i < 20000; ++i)
+	{
+		iaData.push_back(i * 7);
+	}
+	cpdInner.PutIntArray(MU8STR("int array"), std::move(iaData));
+
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen));
+
+	//输出到接收函数，使用最小缓冲区，强制多次压缩与输出
+	for (bool bGzip : { true, false })
+	{
+		std::vector<uint8_t> vZipped{};
+		size_t szSinkCall = 0;
+		{
+			NBT_IO::DeflateOutputStream osDeflate(
+				[&](const uint8_t *pData, size_t szSize) -> bool
 				{
-					trailerIts.push_back(it);
-					bFound = true;
-					break;
-				}
-			}
-			if (bFound) continue;
+					vZipped.insert(vZipped.end(), pData, pData + szSize);
+					++szSinkCall;
+					return true;
+				},
+				Z_DEFAULT_COMPRESSION, bGzip, NBT_IO::DeflateOutputStream::MIN_BUFFER_SIZE);
+
+			MyAssert(NBT_Writer::WriteNBT(osDeflate, cpdGen));
+			MyAssert(osDeflate.Size() == vData.size());
+			osDeflate.Finish();
+			MyAssert(osDeflate.IsGood());
+		}
+		MyAssert(szSinkCall > 1);
+		MyAssert(NBT_IO::IsZlib(vZipped[0], vZipped[1]) == !bGzip);
 
-			normalIts.push_back(it);
+		std::vector<uint8_t> vUnzipped{};
+		MyAssert(NBT_IO::DecompressDataNoThrow(vUnzipped, vZipped));
+		MyAssert(vUnzipped == vData);
+	}
+
+	//接收函数失败时写出必须失败
+	{
+		NBT_IO::DeflateOutputStream osDeflate([](const uint8_t *, size_t) -> bool { return false; }, Z_DEFAULT_COMPRESSION, true, NBT_IO::DeflateOutputStream::MIN_BUFFER_SIZE);
+		MyAssert(!NBT_Writer::WriteNBT(osDeflate, cpdGen, 512, NBT_NoPrint{}));
+		MyAssert(!osDeflate.IsGood());
+		MyAssert(!osDeflate.FinishNoThrow(NBT_NoPrint{}));
+	}
+
+	//输出到文件，并通过简易接口读写
+	{
+		std::filesystem::path pathTemp = std::filesystem::temp_directory_path() / "nbt_all_test_deflate.nbt";
+		MyAssert(NBT_Writer::SimpleWriteNbtFile(pathTemp, cpdGen));
+
+		{
+			NBT_IO::InflateInputStream isInflate(pathTemp);
+			NBT_Type::Compound cpdRead{};
+			MyAssert(NBT_Reader::ReadNBT(isInflate, cpdRead));
+			MyAssert(cpdRead == cpdGen);
 		}
 
-		// 优先级键：按 s_priorityKeys 定义顺序排列
-		std::sort(priorityIts.begin(), priorityIts.end(),
-			[](const auto &l, const auto &r) -> bool
-			{
-				size_t posL = ~size_t(0), posR = ~size_t(0);
-				for (size_t i = 0; i < s_priorityKeys.size(); ++i)
-				{
-					if (l->first == s_priorityKeys[i]) posL = i;
-					if (r->first == s_priorityKeys[i]) posR = i;
-				}
-				return posL < posR;
-			});
+		NBT_Type::Compound cpdRead{};
+		MyAssert(NBT_Reader::SimpleReadNbtFile(pathTemp, cpdRead));
+		MyAssert(cpdRead == cpdGen);
 
-		// 普通键：字典升序
-		std::sort(normalIts.begin(), normalIts.end(),
-			[](const auto &l, const auto &r) -> bool
-			{
-				return l->first < r->first;
-			});
+		//序列化失败时不能破坏已存在的文件，也不能残留临时文件
+		std::vector<uint8_t> vBefore{};
+		MyAssert(NBT_IO::ReadFile(pathTemp, vBefore));
 
-		// 拖尾键：按 s_trailerKeys 定义顺序排列
-		std::sort(trailerIts.begin(), trailerIts.end(),
-			[](const auto &l, const auto &r) -> bool
-			{
-				size_t posL = ~size_t(0), posR = ~size_t(0);
-				for (size_t i = 0; i < s_trailerKeys.size(); ++i)
-				{
-					if (l->first == s_trailerKeys[i]) posL = i;
-					if (r->first == s_trailerKeys[i]) posR = i;
-				}
-				return posL < posR;
-			});
+		NBT_Type::Compound cpdBad{ {MU8STR(""),NBT_Type::Compound{ {MU8STR("str"),NBT_Type::String(std::string((size_t)NBT_Type::StringLength_Max + 1, 'x'))} }} };
+		MyAssert(!NBT_Writer::SimpleWriteNbtFile(pathTemp, cpdBad, NBT_NoPrint{}));
 
-		result.insert(result.end(), priorityIts.begin(), priorityIts.end());
-		result.insert(result.end(), normalIts.begin(), normalIts.end());
-		result.insert(result.end(), trailerIts.begin(), trailerIts.end());
-		return result;
+		std::vector<uint8_t> vAfter{};
+		MyAssert(NBT_IO::ReadFile(pathTemp, vAfter));
+		MyAssert(vAfter == vBefore);
+		std::filesystem::path pathTempFile = pathTemp;
+		pathTempFile += ".tmp";
+		MyAssert(!std::filesystem::exists(pathTempFile));
+
+		std::filesystem::remove(pathTemp);
 	}
-};
+}
 
-class KeyOrderRecorder : public NBT_Visitor
+void MmapStreamTest()
 {
-public:
-	using ResultControl = NBT_Visitor::ResultControl;
-	using NestingControl = NBT_Visitor::NestingControl;
+	NBT_Type::Compound cpdInner{};
+	cpdInner.PutString(MU8STR("name"), MU8STR("mmap"));
+	cpdInner.PutLongArray(MU8STR("long array skip"), NBT_Type::LongArray(1000, 0x1122334455667788));
+	cpdInner.PutIntArray(MU8STR("int array"), NBT_Type::IntArray(1000, 0x01020304));
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
 
-	// 每层 Compound 的键出现顺序（根层在最后）
-	std::vector<std::vector<NBT_Type::String>> m_keyOrders;
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen));
 
-private:
-	std::vector<std::vector<NBT_Type::String>> m_keyStack;
+	std::filesystem::path pathTemp = std::filesystem::temp_directory_path() / "nbt_all_test_mmap.nbt";
+	MyAssert(NBT_IO::WriteFile(pathTemp, vData));
 
-public:
-	NestingControl VisitCompoundEntryBegin(NBT_TAG enCompoundEntryTag, NBT_Type::String &&sName)
+	//直接在映射上读取与扫描
 	{
-		if (!m_keyStack.empty())
-			m_keyStack.back().push_back(std::move(sName));
-		return NestingControl::Enter;
+		NBT_IO::MmapInputStream isMmap(pathTemp);
+		MyAssert(isMmap.IsOpen());
+		MyAssert(isMmap.Size() == vData.size());
+		MyAssert(memcmp(isMmap.GetMappedFile().data(), vData.data(), vData.size()) == 0);
+
+		NBT_Type::Compound cpdRead{};
+		MyAssert(NBT_Reader::ReadNBT(isMmap, cpdRead));
+		MyAssert(cpdRead == cpdGen);
 	}
 
-	ResultControl VisitCompoundBegin(void)
 	{
-		m_keyStack.push_back({});
-		return ResultControl::Continue;
+		NBT_IO::MmapInputStream isMmap(pathTemp, 0, NBT_IO::MappedFile::AccessHint::Random);
+		SkippingCollector vc;
+		MyAssert(NBT_Scanner::ScanNBT(isMmap, vc));
+		NBT_Type::Compound cpdScan = vc.MoveRoot();
+		MyAssert(cpdScan.GetCompound(MU8STR("")).Size() == 2);
 	}
 
-	ResultControl VisitCompoundEnd(void)
+	//简易接口在未压缩时走映射路径
 	{
-		m_keyOrders.push_back(std::move(m_keyStack.back()));
-		m_keyStack.pop_back();
-		return ResultControl::Continue;
+		NBT_Type::Compound cpdRead{};
+		MyAssert(NBT_Reader::SimpleReadNbtFile(pathTemp, cpdRead));
+		MyAssert(cpdRead == cpdGen);
+
+		NBT_Visitor_Collector vc;
+		MyAssert(NBT_Scanner::SimpleScanNbtFile(pathTemp, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
 	}
 
-	void VisitBegin(void)
+	//映射对象可以移动
 	{
-		m_keyStack.push_back({});
+		NBT_IO::MappedFile mfFile(pathTemp);
+		NBT_IO::MappedFile mfMoved(std::move(mfFile));
+		MyAssert(mfFile.data() == NULL && mfFile.size() == 0);
+		MyAssert(mfMoved.IsOpen() && mfMoved.size() == vData.size());
 	}
 
-	void VisitEnd(void)
+	//空文件与不存在的文件
 	{
-		m_keyOrders.push_back(std::move(m_keyStack.back()));
-		m_keyStack.pop_back();
+		std::vector<uint8_t> vEmpty{};
+		MyAssert(NBT_IO::WriteFile(pathTemp, vEmpty));
+		NBT_IO::MmapInputStream isMmap(pathTemp);
+		MyAssert(isMmap.IsOpen());
+		MyAssert(isMmap.Size() == 0);
 	}
-};
 
-void CustomPrioritySortTest(void)
-{
-	// ============================================================
-	// 1. 构造三层嵌套测试数据
-	// ============================================================
+	std::filesystem::remove(pathTemp);
 
-	// 1.1 最深层 Compound（深度 = 3）
-	NBT_Type::Compound cpdDeep
 	{
-		{MU8STR("z_priority_first"), MU8STR("deep priority value")},
-		{MU8STR("a_deep_normal"),    (NBT_Type::Float)3.14f},
-		{MU8STR("b_deep_normal"),    (NBT_Type::Double)2.718281828},
-		{MU8STR("z_trailer_last"),   (NBT_Type::Long)999888777666},
-	};
+		NBT_IO::MmapInputStream isMmap(pathTemp);
+		MyAssert(!isMmap.IsOpen());
+		MyAssert(!isMmap.GetErrorInfo().empty());
+		MyAssert(isMmap.Size() == 0);
 
-	// 1.2 中间层 Compound（深度 = 2），内含多种类型和一个嵌套 Compound
-	NBT_Type::Compound cpdNested
+		NBT_Type::Compound cpdRead{};
+		MyAssert(!NBT_Reader::SimpleReadNbtFile(pathTemp, cpdRead, NBT_NoPrint{}));
+	}
+}
+
+struct TestRand
+{
+	uint64_t u64State;
+
+	uint64_t Next(void) noexcept
 	{
-		{MU8STR("z_priority_first"), (NBT_Type::Byte)10},
-		{MU8STR("a_nested_normal"),  (NBT_Type::Short)100},
-		{MU8STR("b_nested_normal"),  (NBT_Type::Int)1000},
-		{MU8STR("nested_deep"),      std::move(cpdDeep)},
-		{MU8STR("z_trailer_last"),   NBT_Type::ByteArray{1, 2, 3, 4, 5}},
-	};
+		u64State ^= u64State << 13;
+		u64State ^= u64State >> 7;
+		u64State ^= u64State << 17;
+		return u64State;
+	}
+};
 
-	// 1.3 构造一个 List 用于根层
-	NBT_Type::List testList
+std::vector<uint8_t> ZipForTest(const std::vector<uint8_t> &vData, bool bGzip)
+{
+	std::vector<uint8_t> vZipped{};
+	NBT_IO::DeflateOutputStream osDeflate([&](const uint8_t *pData, size_t szSize) -> bool
+		{
+			vZipped.insert(vZipped.end(), pData, pData + szSize);
+			return true;
+		}, Z_DEFAULT_COMPRESSION, bGzip);
+	osDeflate.PutRange(vData.data(), vData.size());
+	osDeflate.Finish();
+	return vZipped;
+}
+
+void RegionFileTest()
+{
+	std::filesystem::path pathDir = std::filesystem::temp_directory_path() / "nbt_all_test_region";
+	std::filesystem::create_directories(pathDir);
+	std::filesystem::path pathRegion = pathDir / "r.-1.2.mca";
+
+	//生成4个区块：Gzip、Zlib、未压缩、外部（Zlib）
+	NBT_Type::Compound cpdChunk[4]{};
+	std::vector<uint8_t> vChunkNbt[4]{};
+	for (int32_t i = 0; i < 4; ++i)
 	{
-		MU8STR("list_str_a"),
-		MU8STR("list_str_b"),
-		MU8STR("list_str_c"),
-	};
+		NBT_Type::Compound cpdInner{};
+		cpdInner.PutInt(MU8STR("xPos"), i);
+		cpdInner.PutLongArray(MU8STR("long array skip"), NBT_Type::LongArray(2000 * (i + 1), i));
+		cpdChunk[i] = NBT_Type::Compound{ {MU8STR(""),std::move(cpdInner)} };
+		MyAssert(NBT_Writer::WriteNBT(vChunkNbt[i], 0, cpdChunk[i]));
+	}
 
-	// 1.4 根 Compound（深度 = 1）
-	NBT_Type::Compound cpdRoot
+	const int32_t i32ChunkPos[4][2] = { {0,0},{31,0},{5,17},{31,31} };
+	const uint8_t u8Type[4] = { 1,2,3,2 | 0x80 };
+
+	std::vector<uint8_t> vRegion(NBT_RegionFile::HEADER_SIZE, 0);
+	for (int32_t i = 0; i < 4; ++i)
 	{
-		{MU8STR(""), NBT_Type::Compound
-			{
-				{MU8STR("z_priority_first"),  (NBT_Type::Byte)1},
-				{MU8STR("a_normal_cpd"),      std::move(cpdNested)},
-				{MU8STR("b_normal"),          (NBT_Type::Byte)2},
-				{MU8STR("c_normal_list"),     std::move(testList)},
-				{MU8STR("y_priority_second"), (NBT_Type::Short)3},
-				{MU8STR("z_trailer_last"),    NBT_Type::LongArray{1, 2, 3}},
-			}
+		std::vector<uint8_t> vPayload{};
+		switch (u8Type[i] & 0x7F)
+		{
+		case 1: vPayload = ZipForTest(vChunkNbt[i], true); break;
+		case 2: vPayload = ZipForTest(vChunkNbt[i], false); break;
+		default: vPayload = vChunkNbt[i]; break;
 		}
-	};
 
-	// ============================================================
-	// 2. 配置排序规则（对所有层级生效）
-	// ============================================================
-	PriorityCompoundSort::s_priorityKeys =
-	{
-		MU8STR("z_priority_first"),
-		MU8STR("y_priority_second"),
-	};
-	PriorityCompoundSort::s_trailerKeys =
+		if (u8Type[i] & 0x80)
+		{
+			//世界区块坐标：区域(-1, 2) -> (-32 + x, 64 + z)
+			std::filesystem::path pathExternal = pathDir / ("c." + std::to_string(-32 + i32ChunkPos[i][0]) + "." + std::to_string(64 + i32ChunkPos[i][1]) + ".mcc");
+			MyAssert(NBT_IO::WriteFile(pathExternal, vPayload));
+			vPayload.clear();
+		}
+
+		size_t szSector = vRegion.size() / NBT_RegionFile::SECTOR_SIZE;
+		uint32_t u32Length = (uint32_t)vPayload.size() + 1;
+		size_t szSectorCount = (4 + u32Length + NBT_RegionFile::SECTOR_SIZE - 1) / NBT_RegionFile::SECTOR_SIZE;
+
+		size_t szIdx = (size_t)i32ChunkPos[i][0] + (size_t)i32ChunkPos[i][1] * 32;
+		uint32_t u32Location = NBT_Endian::NativeToBigAny((uint32_t)(szSector << 8 | szSectorCount));
+		uint32_t u32Timestamp = NBT_Endian::NativeToBigAny((uint32_t)(1000 + i));
+		memcpy(&vRegion[szIdx * 4], &u32Location, 4);
+		memcpy(&vRegion[NBT_RegionFile::SECTOR_SIZE + szIdx * 4], &u32Timestamp, 4);
+
+		uint32_t u32BigLength = NBT_Endian::NativeToBigAny(u32Length);
+		vRegion.insert(vRegion.end(), (uint8_t *)&u32BigLength, (uint8_t *)&u32BigLength + 4);
+		vRegion.push_back(u8Type[i]);
+		vRegion.insert(vRegion.end(), vPayload.begin(), vPayload.end());
+		vRegion.resize((szSector + szSectorCount) * NBT_RegionFile::SECTOR_SIZE, 0);
+	}
+
+	//一个超出文件范围的位置条目，打开时应被忽略
 	{
-		MU8STR("z_trailer_last"),
-	};
+		uint32_t u32Location = NBT_Endian::NativeToBigAny((uint32_t)(1000 << 8 | 1));
+		memcpy(&vRegion[(1 + 1 * 32) * 4], &u32Location, 4);
+	}
 
-	// ============================================================
-	// 3. 写出：自定义排序 vs 默认排序
-	// ============================================================
-	std::vector<uint8_t> vDataPriority;
-	MyAssert(NBT_Writer::WriteNBT<PriorityCompoundSort>(vDataPriority, 0, cpdRoot));
+	MyAssert(NBT_IO::WriteFile(pathRegion, vRegion));
 
-	std::vector<uint8_t> vDataDefault;
-	MyAssert(NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>>(vDataDefault, 0, cpdRoot));
+	NBT_RegionFile rfRegion{};
+	MyAssert(rfRegion.Open(pathRegion, NBT_NoPrint{}));
+	MyAssert(rfRegion.IsOpen());
 
-	// ============================================================
-	// 4. 用 KeyOrderRecorder 扫描自定义排序的二进制输出
+	int32_t i32RegionX = 0, i32RegionZ = 0;
+	MyAssert(rfRegion.GetRegionPos(i32RegionX, i32RegionZ));
+	MyAssert(i32RegionX == -1 && i32RegionZ == 2);
+
+	MyAssert(!rfRegion.HasChunk(1, 1));
+	MyAssert(!rfRegion.HasChunk(2, 2));
+
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		//世界坐标与区域内坐标等价
+		int32_t i32X = -32 + i32ChunkPos[i][0];
+		int32_t i32Z = 64 + i32ChunkPos[i][1];
+		MyAssert(rfRegion.HasChunk(i32X, i32Z));
+		MyAssert(rfRegion.GetChunkInfo(i32X, i32Z).u32Timestamp == (uint32_t)(1000 + i));
+
+		NBT_RegionFile::ChunkPayload cpPayload{};
+		MyAssert(rfRegion.GetChunkPayload(i32X, i32Z, cpPayload));
+		MyAssert((uint8_t)cpPayload.enType == (u8Type[i] & 0x7F));
+		MyAssert(cpPayload.bExternal == ((u8Type[i] & 0x80) != 0));
+
+		std::vector<uint8_t> vData{};
+		MyAssert(rfRegion.ReadChunkData(i32ChunkPos[i][0], i32ChunkPos[i][1], vData));
+		MyAssert(vData == vChunkNbt[i]);
+
+		NBT_Type::Compound cpdRead{};
+		MyAssert(rfRegion.ReadChunk(i32ChunkPos[i][0], i32ChunkPos[i][1], cpdRead));
+		MyAssert(cpdRead == cpdChunk[i]);
+
+		SkippingCollector vc;
+		MyAssert(rfRegion.ScanChunk(i32ChunkPos[i][0], i32ChunkPos[i][1], vc));
+		MyAssert(vc.MoveRoot().GetCompound(MU8STR("")).GetInt(MU8STR("xPos")) == i);
+	}
+
+	//不存在的区块
+	{
+		NBT_Type::Compound cpdRead{};
+		MyAssert(!rfRegion.ReadChunk(2, 2, cpdRead, 512, NBT_NoPrint{}));
+	}
+
+	//并行读取所有区块，结果按区块索引顺序排列
+	for (size_t szThreadCount : { (size_t)0, (size_t)1, (size_t)3, (size_t)64 })
+	{
+		std::vector<NBT_RegionFile::ChunkResult> vResult{};
+		MyAssert(rfRegion.ReadAllChunks(vResult, szThreadCount));
+		MyAssert(vResult.size() == 4);
+		for (size_t i = 0; i < vResult.size(); ++i)
+		{
+			MyAssert(vResult[i].bSuccess);
+			MyAssert(vResult[i].i32ChunkX == i32ChunkPos[i][0] && vResult[i].i32ChunkZ == i32ChunkPos[i][1]);
+			MyAssert(vResult[i].cpdChunk == cpdChunk[i]);
+		}
+	}
+
+	//并行扫描，每个线程使用自己的访问器
+	{
+		std::vector<SkippingCollector> vVisitors(3);
+		std::mutex mtxSeen{};
+		int32_t i32SeenMask = 0;
+		MyAssert(rfRegion.ScanAllChunks(vVisitors,
+			[&](size_t szWorker, SkippingCollector &vc, int32_t i32ChunkX, int32_t i32ChunkZ, bool bSuccess) -> void
+			{
+				MyAssert(bSuccess && szWorker < 3);
+				int32_t i32XPos = vc.MoveRoot().GetCompound(MU8STR("")).GetInt(MU8STR("xPos"));
+				MyAssert(i32ChunkX == i32ChunkPos[i32XPos][0] && i32ChunkZ == i32ChunkPos[i32XPos][1]);
+				vc = SkippingCollector{};
+
+				std::lock_guard<std::mutex> lgSeen(mtxSeen);
+				i32SeenMask |= 1 << i32XPos;
+			}));
+		MyAssert(i32SeenMask == 0xF);
+	}
+
+	//移动后仍可读取
+	{
+		NBT_RegionFile rfMoved(std::move(rfRegion));
+		NBT_Type::Compound cpdRead{};
+		MyAssert(rfMoved.ReadChunk(0, 0, cpdRead));
+		MyAssert(cpdRead == cpdChunk[0]);
+	}
+
+	std::filesystem::remove_all(pathDir);
+}
+
+void RegionWriterTest()
+{
+	std::filesystem::path pathDir = std::filesystem::temp_directory_path() / "nbt_all_test_region_writer";
+	std::filesystem::remove_all(pathDir);
+	std::filesystem::create_directories(pathDir);
+	std::filesystem::path pathRegion = pathDir / "r.3.-4.mca";
+
+	auto MakeChunk = [](int32_t i32Id, size_t szLongCount) -> NBT_Type::Compound
+	{
+		NBT_Type::Compound cpdInner{};
+		cpdInner.PutInt(MU8STR("id"), i32Id);
+		NBT_Type::LongArray laData{};
+		TestRand rand{ (uint64_t)i32Id + 1 };
+		for (size_t i = 0; i < szLongCount; ++i)
+		{
+			laData.push_back((NBT_Type::Long)rand.Next());//随机数据，避免被压缩得太小
+		}
+		cpdInner.PutLongArray(MU8STR("data"), std::move(laData));
+		return NBT_Type::Compound{ {MU8STR(""),std::move(cpdInner)} };
+	};
+
+	auto CheckChunk = [&](int32_t i32ChunkX, int32_t i32ChunkZ, const NBT_Type::Compound &cpdExpect) -> void
+	{
+		NBT_RegionFile rfRegion{};
+		MyAssert(rfRegion.Open(pathRegion));
+		NBT_Type::Compound cpdRead{};
+		MyAssert(rfRegion.ReadChunk(i32ChunkX, i32ChunkZ, cpdRead));
+		MyAssert(cpdRead == cpdExpect);
+	};
+
+	NBT_Type::Compound cpdA = MakeChunk(1, 1000);//约2个扇区
+	NBT_Type::Compound cpdB = MakeChunk(2, 3000);//约6个扇区
+	NBT_Type::Compound cpdC = MakeChunk(3, 100);
+
+	NBT_RegionWriter rwRegion{};
+	MyAssert(rwRegion.Open(pathRegion));
+	MyAssert(rwRegion.GetSectorCount() == 2);
+
+	MyAssert(rwRegion.WriteChunk(0, 0, cpdA, NBT_RegionWriter::CompressionType::Zlib, -1, 100));
+	MyAssert(rwRegion.WriteChunk(1, 0, cpdB, NBT_RegionWriter::CompressionType::GZip, -1, 200));
+	MyAssert(rwRegion.WriteChunk(2, 0, cpdC, NBT_RegionWriter::CompressionType::None, -1, 300));
+	MyAssert(rwRegion.Flush());
+
+	CheckChunk(0, 0, cpdA);
+	CheckChunk(1, 0, cpdB);
+	CheckChunk(2, 0, cpdC);
+	MyAssert(rwRegion.GetChunkInfo(1, 0).u32Timestamp == 200);
+	MyAssert(std::filesystem::file_size(pathRegion) == rwRegion.GetSectorCount() * NBT_RegionWriter::SECTOR_SIZE);
+
+	//更小的数据原地覆盖
+	NBT_RegionWriter::ChunkInfo ciA = rwRegion.GetChunkInfo(0, 0);
+	NBT_Type::Compound cpdA2 = MakeChunk(4, 10);
+	MyAssert(rwRegion.WriteChunk(0, 0, cpdA2));
+	MyAssert(rwRegion.GetChunkInfo(0, 0).u32SectorOffset == ciA.u32SectorOffset);
+	MyAssert(rwRegion.GetChunkInfo(0, 0).u8SectorCount <= ciA.u8SectorCount);
+
+	//更大的数据重新分配，释放的扇区在之后被复用，文件不会增长
+	NBT_RegionWriter::ChunkInfo ciC = rwRegion.GetChunkInfo(2, 0);
+	size_t szSectorBefore = rwRegion.GetSectorCount();
+	NBT_Type::Compound cpdC2 = MakeChunk(5, 2000);
+	MyAssert(rwRegion.WriteChunk(2, 0, cpdC2));
+	MyAssert(rwRegion.GetChunkInfo(2, 0).u32SectorOffset != ciC.u32SectorOffset);
+	MyAssert(rwRegion.GetSectorCount() > szSectorBefore);
+
+	szSectorBefore = rwRegion.GetSectorCount();
+	MyAssert(rwRegion.WriteChunk(5, 5, cpdC, NBT_RegionWriter::CompressionType::None));
+	MyAssert(rwRegion.GetChunkInfo(5, 5).u32SectorOffset < szSectorBefore);
+	MyAssert(rwRegion.GetSectorCount() == szSectorBefore);
+	MyAssert(rwRegion.Flush());
+
+	CheckChunk(0, 0, cpdA2);
+	CheckChunk(1, 0, cpdB);
+	CheckChunk(2, 0, cpdC2);
+	CheckChunk(5, 5, cpdC);
+
+	//超过255个扇区的区块写入外部文件
+	std::filesystem::path pathExternal = NBT_RegionFile::GetExternalChunkPath(pathRegion, 3, -4, 7, 8);
+	MyAssert(pathExternal.filename() == "c.103.-120.mcc");
+	NBT_Type::Compound cpdHuge = MakeChunk(6, 160000);
+	MyAssert(rwRegion.WriteChunk(7, 8, cpdHuge, NBT_RegionWriter::CompressionType::None));
+	MyAssert(rwRegion.GetChunkInfo(7, 8).u8SectorCount == 1);
+	MyAssert(std::filesystem::exists(pathExternal));
+	MyAssert(rwRegion.Flush());
+	CheckChunk(7, 8, cpdHuge);
+
+	//替换为普通区块后外部文件被删除
+	MyAssert(rwRegion.WriteChunk(7, 8, cpdA));
+	MyAssert(!std::filesystem::exists(pathExternal));
+	MyAssert(rwRegion.Flush());
+	CheckChunk(7, 8, cpdA);
+
+	//删除区块
+	MyAssert(rwRegion.DeleteChunk(1, 0));
+	MyAssert(!rwRegion.HasChunk(1, 0));
+	MyAssert(rwRegion.DeleteChunk(1, 0));
+	rwRegion.Close();
+
+	{
+		NBT_RegionFile rfRegion{};
+		MyAssert(rfRegion.Open(pathRegion));
+		MyAssert(!rfRegion.HasChunk(1, 0));
+		MyAssert(rfRegion.GetChunkInfo(2, 0).u32Timestamp != 0);
+	}
+
+	//重新打开后文件头信息保持不变
+	{
+		NBT_RegionWriter rwReopen{};
+		MyAssert(rwReopen.Open(pathRegion));
+		MyAssert(rwReopen.HasChunk(0, 0) && rwReopen.HasChunk(2, 0) && rwReopen.HasChunk(5, 5) && rwReopen.HasChunk(7, 8));
+		MyAssert(!rwReopen.HasChunk(1, 0));
+		MyAssert(rwReopen.WriteChunk(1, 0, cpdB));
+	}
+	CheckChunk(1, 0, cpdB);
+
+	std::filesystem::remove_all(pathDir);
+}
+
+//统计分配次数的内存资源，实际分配转发给上游资源
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+	std::pmr::memory_resource *pUpstream = std::pmr::new_delete_resource();
+	size_t szAllocCount = 0;
+	size_t szDeallocCount = 0;
+
+private:
+	void *do_allocate(size_t szBytes, size_t szAlign) override
+	{
+		++szAllocCount;
+		return pUpstream->allocate(szBytes, szAlign);
+	}
+
+	void do_deallocate(void *p, size_t szBytes, size_t szAlign) override
+	{
+		++szDeallocCount;
+		pUpstream->deallocate(p, szBytes, szAlign);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+void ArenaAllocatorTest()
+{
+	//不在作用域内时使用默认资源
+	MyAssert(NBT_MemoryResource::Get() == std::pmr::get_default_resource());
+
+	CountingResource crOuter{};
+	{
+		NBT_ArenaScope asOuter(&crOuter);
+		MyAssert(NBT_MemoryResource::Get() == &crOuter);
+
+		std::vector<int32_t, NBT_Allocator<int32_t>> vOuter{};
+		vOuter.push_back(1);
+		MyAssert(vOuter.get_allocator().GetResource() == &crOuter);
+		MyAssert(crOuter.szAllocCount != 0);
+
+		//嵌套作用域，离开后恢复为外层资源
+		CountingResource crInner{};
+		{
+			NBT_ArenaScope asInner(&crInner);
+			MyAssert(NBT_MemoryResource::Get() == &crInner);
+
+			//拷贝构造时使用当前作用域的资源
+			std::vector<int32_t, NBT_Allocator<int32_t>> vCopy = vOuter;
+			MyAssert(vCopy.get_allocator().GetResource() == &crInner);
+			MyAssert(vCopy == vOuter);
+
+			//移动赋值时分配器随内容转移
+			std::vector<int32_t, NBT_Allocator<int32_t>> vMove{};
+			vMove = std::move(vCopy);
+			MyAssert(vMove.get_allocator().GetResource() == &crInner);
+		}
+		MyAssert(crInner.szAllocCount == crInner.szDeallocCount);
+		MyAssert(NBT_MemoryResource::Get() == &crOuter);
+	}
+	MyAssert(crOuter.szAllocCount == crOuter.szDeallocCount);
+	MyAssert(NBT_MemoryResource::Get() == std::pmr::get_default_resource());
+
+#ifdef CJF2_NBT_CPP_USE_ARENA_ALLOCATOR
+	NBT_Type::Compound cpdInner{};
+	cpdInner.PutString(MU8STR("name"), NBT_Type::String{ MU8STR("arena") });
+	cpdInner.PutIntArray(MU8STR("ints"), NBT_Type::IntArray{ 1,2,3,4,5 });
+	NBT_Type::List lstLong{};
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		lstLong.AddBackLong(i * 1000);
+	}
+	cpdInner.PutList(MU8STR("longs"), std::move(lstLong));
+	NBT_Type::Compound cpdSrc{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdSrc));
+
+	CountingResource crTree{};
+	{
+		std::pmr::monotonic_buffer_resource mbrArena{ &crTree };
+		NBT_Type::Compound cpdHeap{};
+		{
+			NBT_ArenaScope asScope(&mbrArena);
+
+			NBT_Type::Compound cpdArena{};
+			MyAssert(NBT_Reader::ReadNBT(vData, 0, cpdArena));
+			MyAssert(cpdArena == cpdSrc);
+			MyAssert(crTree.szAllocCount != 0);
+
+			//树中的子对象也分配在同一个资源上
+			const NBT_Type::Compound &cpdRoot = cpdArena.GetCompound(MU8STR(""));
+			MyAssert(cpdRoot.GetList(MU8STR("longs")).get_allocator().GetResource() == &mbrArena);
+			MyAssert(cpdRoot.GetIntArray(MU8STR("ints")).get_allocator().GetResource() == &mbrArena);
+
+			//单调资源在树析构时不会逐个释放
+			size_t szBefore = crTree.szDeallocCount;
+			cpdArena = NBT_Type::Compound{};
+			MyAssert(crTree.szDeallocCount == szBefore);
+		}
+
+		//离开作用域后构造的对象不再使用该资源
+		MyAssert(NBT_Reader::ReadNBT(vData, 0, cpdHeap));
+		MyAssert(cpdHeap == cpdSrc);
+		MyAssert(cpdHeap.get_allocator().GetResource() == std::pmr::get_default_resource());
+	}
+	MyAssert(crTree.szAllocCount == crTree.szDeallocCount);//资源析构时一次性归还
+#endif
+}
+
+void LazyCompoundTest()
+{
+	//构造一个类似区块的结构
+	NBT_Type::Compound cpdLevel{};
+	cpdLevel.PutInt(MU8STR("x"), -7);
+	cpdLevel.PutInt(MU8STR("z"), 12);
+
+	NBT_Type::List lstSections{};
+	for (int8_t i = -4; i < 4; ++i)
+	{
+		NBT_Type::Compound cpdSection{};
+		cpdSection.PutByte(MU8STR("Y"), i);
+		cpdSection.PutLongArray(MU8STR("BlockStates"), NBT_Type::LongArray(256, (NBT_Type::Long)i * 0x0101010101010101));
+		lstSections.AddBackCompound(std::move(cpdSection));
+	}
+
+	NBT_Type::Compound cpdChunk{};
+	cpdChunk.PutInt(MU8STR("DataVersion"), 3465);
+	cpdChunk.PutString(MU8STR("Status"), MU8STR("minecraft:full"));
+	cpdChunk.PutList(MU8STR("sections"), std::move(lstSections));
+	cpdChunk.PutCompound(MU8STR("Level"), std::move(cpdLevel));
+	NBT_Type::Compound cpdSrc{ {MU8STR(""),std::move(cpdChunk)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdSrc));
+
+	//解析只建立索引
+	NBT_LazyCompound lcFile{};
+	MyAssert(lcFile.Parse(vData));
+	MyAssert(lcFile.Size() == 1);
+	MyAssert(lcFile.ContainsCompound(MU8STR("")));
+	MyAssert(!lcFile.IsMaterialized(MU8STR("")));
+
+	NBT_LazyCompound &lcRoot = lcFile.GetLazyCompound(MU8STR(""));
+	MyAssert(!lcFile.IsMaterialized(MU8STR("")));//子集合不会反序列化父条目
+	MyAssert(lcRoot.Size() == 4);
+	MyAssert(lcRoot.GetTag(MU8STR("sections")) == NBT_TAG::List);
+	MyAssert(lcRoot.GetTag(MU8STR("missing")) == NBT_TAG::End);
+	MyAssert(!lcRoot.Contains(MU8STR("missing")));
+	MyAssert(lcRoot.Has(MU8STR("missing")) == nullptr);
+	MyAssert(lcRoot.GetRawValue(MU8STR("DataVersion")).size() == sizeof(NBT_Type::Int));
+
+	//首次访问时反序列化，其它条目保持未解析
+	MyAssert(lcRoot.GetInt(MU8STR("DataVersion")) == 3465);
+	MyAssert(lcRoot.IsMaterialized(MU8STR("DataVersion")));
+	MyAssert(!lcRoot.IsMaterialized(MU8STR("sections")));
+	MyAssert(lcRoot.HasLong(MU8STR("DataVersion")) == nullptr);
+	MyAssert(lcRoot.HasLong(MU8STR("Status")) == nullptr);
+	MyAssert(!lcRoot.IsMaterialized(MU8STR("Status")));//类型不匹配时不解析
+	MyAssert(lcRoot.HasString(MU8STR("Status")) != nullptr);
+	MyAssert(*lcRoot.HasString(MU8STR("Status")) == NBT_Type::String(MU8STR("minecraft:full")));
+
+	//嵌套的按需集合
+	NBT_LazyCompound *pLevel = lcRoot.HasLazyCompound(MU8STR("Level"));
+	MyAssert(pLevel != nullptr);
+	MyAssert(pLevel->GetInt(MU8STR("x")) == -7);
+	MyAssert(pLevel->GetInt(MU8STR("z")) == 12);
+	MyAssert(lcRoot.HasLazyCompound(MU8STR("Status")) == nullptr);
+
+	const NBT_Type::List &lstRead = lcRoot.GetList(MU8STR("sections"));
+	MyAssert(lstRead == cpdSrc.GetCompound(MU8STR("")).GetList(MU8STR("sections")));
+
+	bool bThrow = false;
+	try
+	{
+		lcRoot.Get(MU8STR("missing"));
+	}
+	catch (const std::out_of_range &)
+	{
+		bThrow = true;
+	}
+	MyAssert(bThrow);
+
+	//完整反序列化与ReadNBT结果一致，修改过的缓存会反映在结果中
+	NBT_Type::Compound cpdAll{};
+	MyAssert(lcFile.Materialize(cpdAll));
+	MyAssert(cpdAll == cpdSrc);
+
+	lcRoot.GetInt(MU8STR("DataVersion")) = 1;
+	NBT_Type::Compound cpdRoot{};
+	MyAssert(lcRoot.Materialize(cpdRoot));
+	MyAssert(cpdRoot.GetInt(MU8STR("DataVersion")) == 1);
+	MyAssert(cpdRoot.GetList(MU8STR("sections")) == lstRead);
+
+	//引用外部数据
+	NBT_LazyCompound lcBorrowed{};
+	MyAssert(lcBorrowed.ParseBorrowed(std::span<const uint8_t>(vData.data(), vData.size())));
+	MyAssert(lcBorrowed.GetLazyCompound(MU8STR("")).GetLazyCompound(MU8STR("Level")).GetInt(MU8STR("x")) == -7);
+
+	//同名条目以后出现的为准
+	std::vector<uint8_t> vDup{};
+	MyAssert(NBT_Writer::WriteNBT(vDup, 0, NBT_Type::Compound{ {MU8STR("a"),NBT_Type::Int{ 1 }} }));
+	MyAssert(NBT_Writer::WriteNBT(vDup, vDup.size(), NBT_Type::Compound{ {MU8STR("a"),NBT_Type::Int{ 2 }} }));
+	NBT_LazyCompound lcDup{};
+	MyAssert(lcDup.Parse(vDup));
+	MyAssert(lcDup.Size() == 2);
+	MyAssert(lcDup.GetInt(MU8STR("a")) == 2);
+
+	//截断的数据在解析时就会失败
+	std::vector<uint8_t> vBad(vData.begin(), vData.end() - 10);
+	NBT_LazyCompound lcBad{};
+	MyAssert(!lcBad.Parse(vBad));
+	MyAssert(lcBad.Empty());
+	MyAssert(!lcBad.Parse(vData, 0, 2));//嵌套深度超出
+	MyAssert(!lcBad.Parse(vData, vData.size() + 1));
+}
+
+void PathQueryTest()
+{
+	//路径编译
+	NBT_Path pathTest{};
+	MyAssert(pathTest.Compile("\"\".sections[*].BlockStates<LongArray>"));
+	MyAssert(pathTest.Size() == 4);
+	MyAssert(pathTest.HasWildcard());
+	MyAssert(pathTest.GetSteps()[0].sName.empty());
+	MyAssert(pathTest.GetSteps()[2].enType == NBT_Path::StepType::AnyIndex);
+	MyAssert(pathTest.GetSteps()[3].enFilter == NBT_TAG::LongArray);
+	MyAssert(pathTest.Compile("a.\"b.c\\\"\".*[12]"));
+	MyAssert(pathTest.Size() == 4);
+	MyAssert(pathTest.GetSteps()[1].sName == NBT_Type::String(MU8STR("b.c\"")));
+	MyAssert(pathTest.GetSteps()[2].enType == NBT_Path::StepType::AnyName);
+	MyAssert(pathTest.GetSteps()[3].szIndex == 12);
+	MyAssert(!pathTest.Compile(""));
+	MyAssert(pathTest.Empty());
+	MyAssert(!pathTest.Compile("a."));
+	MyAssert(!pathTest.Compile("a[1"));
+	MyAssert(!pathTest.Compile("a[x]"));
+	MyAssert(!pathTest.Compile("a<Foo>"));
+	MyAssert(!pathTest.Compile("\"abc"));
+	MyAssert(!pathTest.Compile("a b"));
+
+	//构造一个类似区块的结构
+	NBT_Type::Compound cpdLevel{};
+	cpdLevel.PutInt(MU8STR("x"), -7);
+	cpdLevel.PutString(MU8STR("name"), MU8STR("level"));
+
+	NBT_Type::List lstSections{};
+	for (int8_t i = 0; i < 5; ++i)
+	{
+		NBT_Type::Compound cpdSection{};
+		cpdSection.PutByte(MU8STR("Y"), i);
+		if (i != 3)//其中一个缺少BlockStates
+		{
+			cpdSection.PutLongArray(MU8STR("BlockStates"), NBT_Type::LongArray(4, (NBT_Type::Long)i));
+		}
+		lstSections.AddBackCompound(std::move(cpdSection));
+	}
+
+	NBT_Type::Compound cpdChunk{};
+	cpdChunk.PutInt(MU8STR("DataVersion"), 3465);
+	cpdChunk.PutInt(MU8STR("xPos"), 10);
+	cpdChunk.PutLong(MU8STR("LastUpdate"), 123456789);
+	cpdChunk.PutList(MU8STR("sections"), lstSections);
+	cpdChunk.PutCompound(MU8STR("Level"), cpdLevel);
+	NBT_Type::Compound cpdSrc{ {MU8STR(""),std::move(cpdChunk)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdSrc));
+
+	//多个路径一次扫描
+	NBT_Visitor_PathQuery vqQuery{};
+	size_t szLevelX = vqQuery.AddPath("\"\".Level.x");
+	size_t szStates = vqQuery.AddPath("\"\".sections[*].BlockStates<LongArray>");
+	size_t szY2 = vqQuery.AddPath("\"\".sections[2].Y");
+	size_t szInts = vqQuery.AddPath("\"\".*<Int>");
+	size_t szLevel = vqQuery.AddPath("\"\".Level");
+	size_t szSection = vqQuery.AddPath("\"\".sections[1]");
+	size_t szMissing = vqQuery.AddPath("\"\".sections[9].Y");
+	size_t szWrongType = vqQuery.AddPath("\"\".xPos<Long>");
+	MyAssert(vqQuery.GetPathCount() == 8);
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vqQuery));
+
+	MyAssert(vqQuery.ViewResult(szLevelX).size() == 1);
+	MyAssert(vqQuery.ViewResult(szLevelX)[0].GetInt() == -7);
+
+	const std::vector<NBT_Node> &vStates = vqQuery.ViewResult(szStates);
+	MyAssert(vStates.size() == 4);
+	MyAssert(vStates[0].GetLongArray() == NBT_Type::LongArray(4, 0));
+	MyAssert(vStates[3].GetLongArray() == NBT_Type::LongArray(4, 4));//按出现顺序
+
+	MyAssert(vqQuery.ViewResult(szY2).size() == 1);
+	MyAssert(vqQuery.ViewResult(szY2)[0].GetByte() == 2);
+
+	MyAssert(vqQuery.ViewResult(szInts).size() == 2);//DataVersion与xPos
+
+	MyAssert(vqQuery.ViewResult(szLevel).size() == 1);
+	MyAssert(vqQuery.ViewResult(szLevel)[0].GetCompound() == cpdLevel);
+
+	MyAssert(vqQuery.ViewResult(szSection).size() == 1);
+	MyAssert(vqQuery.ViewResult(szSection)[0].GetCompound() == lstSections.GetCompound(1));
+
+	MyAssert(vqQuery.ViewResult(szMissing).empty());
+	MyAssert(vqQuery.ViewResult(szWrongType).empty());
+
+	//结果在多次扫描之间累积
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vqQuery));
+	MyAssert(vqQuery.ViewResult(szLevel).size() == 2);
+	std::vector<NBT_Node> vLevel = vqQuery.MoveResult(szLevel);
+	MyAssert(vLevel.size() == 2 && vLevel[1].GetCompound() == cpdLevel);
+	vqQuery.ClearResult();
+	MyAssert(vqQuery.ViewResult(szStates).empty());
+
+	//嵌套命中：前缀路径与更深的路径同时收集
+	NBT_Visitor_PathQuery vqNested{};
+	size_t szAll = vqNested.AddPath("\"\"");
+	size_t szName = vqNested.AddPath("\"\".Level.name");
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vqNested));
+	MyAssert(vqNested.ViewResult(szAll).size() == 1);
+	MyAssert(vqNested.ViewResult(szAll)[0].GetCompound() == cpdSrc.GetCompound(MU8STR("")));
+	MyAssert(vqNested.ViewResult(szName).size() == 1);
+	MyAssert(vqNested.ViewResult(szName)[0].GetString() == NBT_Type::String(MU8STR("level")));
+
+	//没有通配符的路径全部命中后提前停止，结果与完整扫描一致
+	NBT_Visitor_PathQuery vqStop{};
+	size_t szDataVersion = vqStop.AddPath("\"\".DataVersion");
+	size_t szStopX = vqStop.AddPath("\"\".Level.x");
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vqStop));
+	MyAssert(vqStop.ViewResult(szDataVersion).size() == 1);
+	MyAssert(vqStop.ViewResult(szDataVersion)[0].GetInt() == 3465);
+	MyAssert(vqStop.ViewResult(szStopX).size() == 1);
+
+	//不清除结果再次扫描，提前停止只看本次扫描的命中，结果继续累积
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vqStop));
+	MyAssert(vqStop.ViewResult(szDataVersion).size() == 2);
+	MyAssert(vqStop.ViewResult(szStopX).size() == 2);
+	MyAssert(vqStop.ViewResult(szStopX)[1].GetInt() == -7);
+
+	vqStop.ClearResult();
+	vqStop.SetStopWhenDone(false);
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vqStop));
+	MyAssert(vqStop.ViewResult(szStopX).size() == 1);
+	MyAssert(vqStop.ViewResult(szStopX)[0].GetInt() == -7);
+}
+
+//所有键哈希冲突，用于测试开放寻址的探测与删除
+struct CollideHash
+{
+	size_t operator()(int32_t) const noexcept
+	{
+		return 0x2A;
+	}
+};
+
+void FlatMapTest()
+{
+	//与std::unordered_map对照的随机操作，覆盖线性查找与建立索引两种状态
+	{
+		NBT_FlatMap<std::string, int32_t> fmTest{};
+		std::unordered_map<std::string, int32_t> umRef{};
+
+		uint32_t u32Seed = 12345;
+		auto funcRand = [&](void) -> uint32_t
+		{
+			u32Seed = u32Seed * 1103515245 + 12345;
+			return (u32Seed >> 8) & 0xFFFF;
+		};
+
+		for (int32_t i = 0; i < 20000; ++i)
+		{
+			std::string strKey = "key" + std::to_string(funcRand() % 400);
+			switch (funcRand() % 4)
+			{
+			case 0:
+			case 1:
+				MyAssert(fmTest.insert_or_assign(strKey, i).second == umRef.insert_or_assign(strKey, i).second);
+				break;
+			case 2:
+				MyAssert(fmTest.erase(strKey) == umRef.erase(strKey));
+				break;
+			case 3:
+				MyAssert(fmTest.contains(strKey) == umRef.contains(strKey));
+				break;
+			}
+
+			if (i % 1000 == 0)//周期性清空，回到线性查找状态
+			{
+				for (const auto &it : umRef)
+				{
+					MyAssert(fmTest.at(it.first) == it.second);
+				}
+				if (i % 5000 == 0)
+				{
+					fmTest.clear();
+					umRef.clear();
+				}
+			}
+		}
+
+		MyAssert(fmTest.size() == umRef.size());
+		for (const auto &it : fmTest)
+		{
+			MyAssert(umRef.at(it.first) == it.second);
+		}
+
+		//迭代器与std::unordered_map一样只暴露const键，值可以修改
+		static_assert(std::is_same_v<decltype(*fmTest.begin()), std::pair<const std::string, int32_t> &>);
+		static_assert(std::is_same_v<decltype(*std::as_const(fmTest).begin()), const std::pair<const std::string, int32_t> &>);
+		for (std::pair<const std::string, int32_t> &it : fmTest)
+		{
+			it.second = -it.second;
+		}
+		for (const auto &[strKey, i32Val] : fmTest)
+		{
+			MyAssert(fmTest.at(strKey) == -umRef.at(strKey) && i32Val == fmTest.at(strKey));
+		}
+		decltype(fmTest)::const_iterator itConst = fmTest.begin();
+		MyAssert(itConst == fmTest.cbegin());
+	}
+
+	//全部冲突，删除后仍然可以找到其余元素
+	{
+		NBT_FlatMap<int32_t, int32_t, CollideHash> fmCollide{};
+		for (int32_t i = 0; i < 100; ++i)
+		{
+			MyAssert(fmCollide.try_emplace(i, i * 2).second);
+		}
+		MyAssert(!fmCollide.try_emplace(50, 0).second);
+		MyAssert(fmCollide.at(50) == 100);
+		MyAssert(!fmCollide.try_emplace_hashed(CollideHash{}(50), 50, 0).second);
+		MyAssert(fmCollide.try_emplace_hashed(CollideHash{}(100), 100, 200).second);
+		MyAssert(fmCollide.at(100) == 200 && fmCollide.erase(100) == 1);
+
+		for (int32_t i = 0; i < 100; i += 2)
+		{
+			MyAssert(fmCollide.erase(i) == 1);
+		}
+		MyAssert(fmCollide.size() == 50);
+		for (int32_t i = 0; i < 100; ++i)
+		{
+			MyAssert(fmCollide.contains(i) == (i % 2 != 0));
+		}
+
+		//大量删除与插入交替，已删除的槽位会被重用或清理
+		for (int32_t i = 100; i < 1000; ++i)
+		{
+			fmCollide.try_emplace(i, i);
+			fmCollide.erase(i - 1);
+		}
+		MyAssert(fmCollide.contains(999) && fmCollide.contains(1) && !fmCollide.contains(998));
+
+		//it = erase(it)的循环会访问到所有元素
+		for (auto it = fmCollide.begin(); it != fmCollide.end();)
+		{
+			it = fmCollide.erase(it);
+		}
+		MyAssert(fmCollide.empty());
+	}
+
+	//作为NBT_Compound的底层容器
+	using FlatCompound = NBT_Compound<NBT_FlatMap<NBT_Type::String, NBT_Node>>;
+	FlatCompound cpdFlat{};
+	for (int32_t i = 0; i < 32; ++i)
+	{
+		cpdFlat.PutInt(NBT_Type::String("int" + std::to_string(i)), i);
+	}
+	cpdFlat.PutString(MU8STR("name"), MU8STR("flat"));
+	MyAssert(cpdFlat.Size() == 33);
+	MyAssert(cpdFlat.GetInt(MU8STR("int7")) == 7);
+	MyAssert(cpdFlat.HasInt(MU8STR("name")) == nullptr);
+	MyAssert(cpdFlat.HasString(MU8STR("name")) != nullptr);
+	MyAssert(!cpdFlat.TryPutInt(MU8STR("int3"), 100).second);
+	MyAssert(!cpdFlat.PutInt(MU8STR("int3"), 100).second);
+	MyAssert(cpdFlat.GetInt(MU8STR("int3")) == 100);
+
+	bool bThrow = false;
+	try
+	{
+		cpdFlat.Get(MU8STR("missing"));
+	}
+	catch (const std::out_of_range &)
+	{
+		bThrow = true;
+	}
+	MyAssert(bThrow);
+
+	//相等比较与插入顺序无关
+	FlatCompound cpdReverse{};
+	for (const auto &it : std::as_const(cpdFlat).KeySortIt<false>())
+	{
+		cpdReverse.Put(it->first, it->second);
+	}
+	MyAssert(cpdReverse == cpdFlat);
+	MyAssert(cpdReverse.Remove(MU8STR("int0")));
+	MyAssert(!cpdReverse.Remove(MU8STR("int0")));
+	MyAssert(cpdReverse != cpdFlat);
+
+	//合并只移动不存在的键
+	FlatCompound cpdMerge{};
+	cpdMerge.PutInt(MU8STR("int0"), -1);
+	cpdMerge.PutInt(MU8STR("extra"), 1);
+	cpdReverse.Merge(std::move(cpdMerge));
+	MyAssert(cpdReverse.GetInt(MU8STR("int0")) == -1);
+	MyAssert(cpdReverse.GetInt(MU8STR("extra")) == 1);
+	MyAssert(cpdReverse.Size() == 34);
+
+	//节点取出与插入
+	auto nodeName = cpdFlat.GetData().extract(MU8STR("name"));
+	MyAssert(!nodeName.empty() && nodeName.mapped().GetString() == MU8STR("flat"));
+	MyAssert(!cpdFlat.Contains(MU8STR("name")));
+	MyAssert(cpdFlat.GetData().insert(std::move(nodeName)).inserted);
+	MyAssert(cpdFlat.GetString(MU8STR("name")) == MU8STR("flat"));
+
+	//定义CJF2_NBT_CPP_USE_FLAT_COMPOUND时NBT_Type::Compound即使用NBT_FlatMap
+#ifdef CJF2_NBT_CPP_USE_FLAT_COMPOUND
+	static_assert(std::is_same_v<NBT_Type::Compound::Super, NBT_FlatMap<NBT_Type::String, NBT_Node, std::hash<NBT_Type::String>, std::equal_to<NBT_Type::String>, NBT_Type::Allocator<std::pair<const NBT_Type::String, NBT_Node>>>>);
+#endif
+}
+
+void KeyPoolTest()
+{
+	//同一个键只插入一次
+	NBT_KeyPool kpTest{ 3 };
+	const NBT_Type::String sName = MU8STR("Name");
+	const NBT_Type::String *pName = kpTest.Intern(sName.data(), sName.size());
+	MyAssert(pName != NULL && *pName == sName);
+	MyAssert(kpTest.Intern(sName.data(), sName.size()) == pName);
+	MyAssert(kpTest.Size() == 1 && kpTest.GetHitCount() == 1 && kpTest.GetMissCount() == 1);
+
+	//池返回的哈希值与集合使用的哈希一致，可以直接用于插入
+	size_t szNameHash = 0;
+	MyAssert(kpTest.Intern(sName.data(), sName.size(), szNameHash) == pName);
+	MyAssert(szNameHash == std::hash<NBT_Type::String>{}(sName));
+
+	//达到上限后不再插入，已有的键仍然命中
+	const NBT_Type::String sA = MU8STR("a"), sB = MU8STR("b"), sC = MU8STR("c");
+	MyAssert(kpTest.Intern(sA.data(), sA.size()) != NULL);
+	MyAssert(kpTest.Intern(sB.data(), sB.size()) != NULL);
+	MyAssert(kpTest.Intern(sC.data(), sC.size()) == NULL);
+	MyAssert(kpTest.Intern(sName.data(), sName.size()) == pName);
+	MyAssert(kpTest.Size() == 3);
+
+	//构造重复键很多的数据，包含超过池长度上限的键
+	const NBT_Type::String sLongKey(std::string(NBT_KeyPool::szMaxKeyLength + 1, 'k'));
+	NBT_Type::List lstEntity{};
+	for (int32_t i = 0; i < 200; ++i)
+	{
+		NBT_Type::Compound cpdEntity{};
+		cpdEntity.PutString(MU8STR("id"), MU8STR("minecraft:pig"));
+		cpdEntity.PutInt(MU8STR("Count"), i);
+		cpdEntity.PutList(MU8STR("Pos"), NBT_Type::List{ NBT_Type::Double{ 1.0 },NBT_Type::Double{ 2.0 },NBT_Type::Double{ 3.0 } });
+		cpdEntity.PutByte(MU8STR("a_key_that_is_longer_than_short_string_optimization"), 1);
+		cpdEntity.PutByte(sLongKey, 2);
+		lstEntity.AddBackCompound(std::move(cpdEntity));
+	}
+	NBT_Type::Compound cpdRoot{};
+	cpdRoot.PutList(MU8STR("Entities"), std::move(lstEntity));
+
+	//足够多的键使NBT_FlatMap建立索引，插入时使用池给出的哈希值
+	NBT_Type::Compound cpdWide{};
+	for (int32_t i = 0; i < 40; ++i)
+	{
+		cpdWide.PutInt(NBT_Type::String("wide" + std::to_string(i)), i);
+	}
+	cpdRoot.PutCompound(MU8STR("Wide"), std::move(cpdWide));
+	NBT_Type::Compound cpdSrc{ {MU8STR(""),std::move(cpdRoot)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdSrc));
+
+	NBT_KeyPool kpRead{};
+	MyAssert(NBT_KeyPool::GetCurrent() == NULL);
+	for (int i = 0; i < 2; ++i)//第二次解析全部命中
+	{
+		NBT_KeyPoolScope kpsScope(&kpRead);
+		MyAssert(NBT_KeyPool::GetCurrent() == &kpRead);
+
+		NBT_Type::Compound cpdRead{};
+		MyAssert(NBT_Reader::ReadNBT(vData, 0, cpdRead));
+		MyAssert(cpdRead == cpdSrc);
+
+		const NBT_Type::Compound &cpdReadWide = cpdRead.GetCompound(MU8STR("")).GetCompound(MU8STR("Wide"));
+		for (int32_t i = 0; i < 40; ++i)
+		{
+			MyAssert(cpdReadWide.GetInt(NBT_Type::String("wide" + std::to_string(i))) == i);
+		}
+		MyAssert(!cpdReadWide.Contains(MU8STR("wide40")));
+	}
+	MyAssert(NBT_KeyPool::GetCurrent() == NULL);
+
+	//""、Entities、Wide、wide0~wide39、id、Count、Pos与较长的键，超过上限的键不进入池
+	MyAssert(kpRead.Size() == 6 + 1 + 40);
+	MyAssert(kpRead.GetMissCount() == 6 + 1 + 40);
+	MyAssert(kpRead.GetHitCount() == (1 + 1 + 1 + 40 + 200 * 4) * 2 - (6 + 1 + 40));
+
+	//池已满时仍然可以正确解析
+	NBT_KeyPool kpFull{ 1 };
+	{
+		NBT_KeyPoolScope kpsScope(&kpFull);
+		NBT_Type::Compound cpdRead{};
+		MyAssert(NBT_Reader::ReadNBT(vData, 0, cpdRead));
+		MyAssert(cpdRead == cpdSrc);
+	}
+	MyAssert(kpFull.Size() == 1);
+}
+
+void NumericListTest()
+{
+	//构造各种定长数值类型的列表，Int与Double跨越读写缓冲区分块边界
+	NBT_Type::List lstByte{}, lstShort{}, lstInt{}, lstLong{}, lstFloat{}, lstDouble{};
+	for (int32_t i = 0; i < 3001; ++i)
+	{
+		lstInt.AddBack(NBT_Type::Int((uint32_t)i * 0x01020304));
+		lstDouble.AddBack(NBT_Type::Double{ i * 0.5 - 100.0 });
+	}
+	for (int32_t i = 0; i < 300; ++i)
+	{
+		lstByte.AddBack(NBT_Type::Byte(i));
+		lstShort.AddBack(NBT_Type::Short(i * 0x0102));
+		lstLong.AddBack(NBT_Type::Long((uint64_t)i * 0x0102030405060708));
+		lstFloat.AddBack(NBT_Type::Float{ i * -0.25f });
+	}
+
+	NBT_Type::Compound cpdGen
+	{
+		{MU8STR(""),NBT_Type::Compound
+			{
+				{MU8STR("b"),lstByte},
+				{MU8STR("s"),lstShort},
+				{MU8STR("i"),lstInt},
+				{MU8STR("l"),lstLong},
+				{MU8STR("f"),lstFloat},
+				{MU8STR("d"),lstDouble},
+				{MU8STR("e"),NBT_Type::List{ NBT_Type::Int{ 1 } }},
+			}
+		}
+	};
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>>(vData, 0, cpdGen));
+
+	//检查写出的原始字节为大端序：根(3) + "b"(4) + 类型(1) + 长度(4) + 300字节 + "d"(4) + 类型(1) + 长度(4) + 第二个Double
+	constexpr size_t szSecondDouble = 3 + 4 + 1 + 4 + 300 + 4 + 1 + 4 + 8;
+	MyAssert(vData.size() > szSecondDouble + 8);
+	MyAssert(vData[szSecondDouble + 0] == 0xC0 && vData[szSecondDouble + 1] == 0x58 && vData[szSecondDouble + 2] == 0xE0);
+
+	NBT_ReadWrite_Test(vData, cpdGen);
+
+	NBT_Visitor_Collector vc;
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vc));
+	MyAssert(vc.MoveRoot() == cpdGen);
+
+	//截断的数据需要报错
+	std::vector<uint8_t> vTrunc(vData.begin(), vData.begin() + szSecondDouble);
+	NBT_Type::Compound cpdTrunc{};
+	MyAssert(!NBT_Reader::ReadNBT(vTrunc, 0, cpdTrunc));
+
+	//包含空元素的数值列表仍然逐个写出并跳过空元素
+	NBT_Type::List lstWithEnd{ NBT_Type::Int{ 1 }, NBT_Type::End{}, NBT_Type::Int{ 2 } };
+	NBT_Type::Compound cpdWithEnd{ {MU8STR(""),NBT_Type::Compound{ {MU8STR("l"),lstWithEnd} }} };
+	std::vector<uint8_t> vWithEnd{};
+	MyAssert(NBT_Writer::WriteNBT(vWithEnd, 0, cpdWithEnd));
+
+	NBT_Type::Compound cpdReadEnd{};
+	MyAssert(NBT_Reader::ReadNBT(vWithEnd, 0, cpdReadEnd));
+	const NBT_Type::List &lstReadEnd = cpdReadEnd.GetCompound(MU8STR("")).GetList(MU8STR("l"));
+	const NBT_Type::List lstExpect{ NBT_Type::Int{ 1 }, NBT_Type::Int{ 2 } };
+	MyAssert(lstReadEnd == lstExpect);
+}
+
+void PackedListTest()
+{
+	//打包不改变列表本身与节点的大小
+	static_assert(sizeof(NBT_Type::List) <= sizeof(NBT_Type::Compound));
+
+	NBT_Type::List lstPos{ NBT_Type::Double{ 1.5 }, NBT_Type::Double{ -64.0 }, NBT_Type::Double{ 300.25 } };
+	const NBT_Type::List lstPosNodes = lstPos;
+	MyAssert(!lstPos.IsPacked() && lstPos.GetPackedTag() == NBT_TAG::End);
+	MyAssert(lstPos.Pack() && lstPos.IsPacked() && lstPos.Pack());
+	MyAssert(lstPos.GetPackedTag() == NBT_TAG::Double && lstPos.Size() == 3 && !lstPos.Empty());
+
+	//数值类型的Get与Has直接访问缓冲区，不会展开
+	MyAssert(lstPos.GetPacked<NBT_Type::Double>().size() == 3 && lstPos.GetPacked<NBT_Type::Int>().empty());
+	MyAssert(lstPos.GetDouble(1) == -64.0 && lstPos.HasDouble(3) == nullptr && lstPos.HasInt(0) == nullptr && lstPos.HasString(0) == nullptr);
+	lstPos.GetDouble(1) = 65.0;
+	MyAssert(lstPos.GetPacked<NBT_Type::Double>()[1] == 65.0);
+	lstPos.GetPacked<NBT_Type::Double>()[1] = -64.0;
+	MyAssert(lstPos.Contains(NBT_Type::Double{ 300.25 }) && !lstPos.Contains(NBT_Type::Float{ 1.5f }));
+	MyAssert(lstPos.ContainsIf([](const NBT_Node &node) { return node.GetTag() == NBT_TAG::Double && node.GetDouble() < 0; }));
+	MyAssert(lstPos.IsPacked());
+
+	//打包与否不影响比较，拷贝仍然是打包的
+	MyAssert(lstPos == lstPosNodes && lstPosNodes == lstPos && (lstPos <=> lstPosNodes) == 0);
+	NBT_Type::List lstCopy = lstPos;
+	MyAssert(lstCopy.IsPacked() && lstCopy == lstPos);
+	lstCopy.GetDouble(2) = 0.0;
+	MyAssert(lstCopy != lstPos && lstCopy < lstPos && lstCopy < lstPosNodes && lstPosNodes > lstCopy);
+	NBT_Type::List lstMoved = std::move(lstCopy);
+	MyAssert(lstMoved.IsPacked() && lstMoved.Size() == 3);
+	lstMoved = lstPos;
+	MyAssert(lstMoved.IsPacked() && lstMoved == lstPos);
+	lstMoved = lstPosNodes;
+	MyAssert(!lstMoved.IsPacked() && lstMoved == lstPos);
+
+	//常量接口不会展开，常量迭代器为打包的元素临时构造节点
+	NBT_Type::List lstExpand = lstPos;
+	const NBT_Type::List &lstExpandRef = lstExpand;
+	std::span<const NBT_Type::Double> spanHeld = lstExpandRef.GetPacked<NBT_Type::Double>();
+	size_t szCount = 0;
+	for (const NBT_Node &node : lstExpandRef)
+	{
+		MyAssert(node == lstPosNodes.Get(szCount));
+		++szCount;
+	}
+	MyAssert(szCount == 3 && lstExpand.IsPacked());
+	for (auto it = lstExpandRef.crbegin(); it != lstExpandRef.crend(); ++it)
+	{
+		--szCount;
+		MyAssert(*it == lstPosNodes.Get(szCount) && it->GetTag() == NBT_TAG::Double);
+	}
+	MyAssert(szCount == 0 && lstExpand.IsPacked());
+	MyAssert(lstExpandRef.FrontDouble() == 1.5 && lstExpandRef.BackDouble() == 300.25);
+	MyAssert(lstExpandRef.FrontIfInt() == nullptr && *lstExpandRef.BackIfDouble() == 300.25);
+	MyAssert(lstExpandRef.Has(0) == nullptr && lstExpandRef.GetData().empty());
+	bool bThrow = false;
+	try
+	{
+		lstExpandRef.GetInt(0);
+	}
+	catch (const std::bad_variant_access &)
+	{
+		bThrow = true;
+	}
+	MyAssert(bThrow);
+	bThrow = false;
+	try
+	{
+		lstExpandRef.GetDouble(3);
+	}
+	catch (const std::out_of_range &)
+	{
+		bThrow = true;
+	}
+	MyAssert(bThrow);
+
+	//Helper的打印、序列化与哈希不会展开，结果与未打包的列表一致
+	MyAssert(NBT_Helper::Serialize(lstExpandRef) == NBT_Helper::Serialize(lstPosNodes));
+	NBT_Helper::Print(lstExpandRef, 0, "    ", NBT_NoPrint{});
+	MyAssert(NBT_Helper::Hash(lstExpandRef, 0x12345678) == NBT_Helper::Hash(lstPosNodes, 0x12345678));
+	NBT_Type::List lstMerge = lstPosNodes;
+	lstMerge.Merge(lstExpandRef);
+	MyAssert(lstMerge.Size() == 6 && lstMerge.GetDouble(5) == 300.25);
+	MyAssert(lstExpand.IsPacked() && spanHeld.data() == lstExpand.GetPacked<NBT_Type::Double>().data());
+
+	//非常量的节点接口会先展开
+	MyAssert(lstExpand.begin()->GetDouble() == 1.5 && !lstExpand.IsPacked() && lstExpand == lstPos);
+	NBT_Type::List lstAdd = lstPos;
+	lstAdd.AddBackString(MU8STR("mixed"));
+	MyAssert(!lstAdd.IsPacked() && lstAdd.Size() == 4 && lstAdd.GetDouble(2) == 300.25);
+	MyAssert(!lstAdd.Pack());
+
+	//类型不一致或为空的列表不能打包
+	NBT_Type::List lstMixed{ NBT_Type::Int{ 1 }, NBT_Type::Long{ 2 } };
+	NBT_Type::List lstEmpty{};
+	NBT_Type::List lstString{ MU8STR("a") };
+	MyAssert(!lstMixed.Pack() && !lstEmpty.Pack() && !lstString.Pack());
+	MyAssert(!lstMixed.IsPacked() && lstMixed.Size() == 2);
+	NBT_Type::List lstClear = lstPos;
+	lstClear.Clear();
+	MyAssert(!lstClear.IsPacked() && lstClear.Empty());
+
+	//写出结果与未打包的列表完全一致，包括VarInt格式
+	NBT_Type::List lstInt{}, lstByte{};
+	for (int32_t i = 0; i < 3001; ++i)
+	{
+		lstInt.AddBack(NBT_Type::Int((uint32_t)i * 0x01020304));
+		lstByte.AddBack(NBT_Type::Byte(i));
+	}
+	NBT_Type::Compound cpdNodes
+	{
+		{MU8STR(""),NBT_Type::Compound
+			{
+				{MU8STR("Pos"),lstPosNodes},
+				{MU8STR("i"),lstInt},
+				{MU8STR("b"),lstByte},
+				{MU8STR("s"),NBT_Type::List{ MU8STR("x"), MU8STR("y") }},
+				{MU8STR("sub"),NBT_Type::List{ NBT_Type::Compound{ {MU8STR("Motion"),lstPosNodes} } }},
+			}
+		}
+	};
+	NBT_Type::Compound cpdPacked = cpdNodes;
+	NBT_Type::Compound &cpdPackedRoot = cpdPacked.GetCompound(MU8STR(""));
+	MyAssert(cpdPackedRoot.GetList(MU8STR("Pos")).Pack());
+	MyAssert(cpdPackedRoot.GetList(MU8STR("i")).Pack());
+	MyAssert(cpdPackedRoot.GetList(MU8STR("b")).Pack());
+	MyAssert(cpdPacked == cpdNodes);
+
+	auto CheckWrite = [&]<typename Format>(void) -> void
+	{
+		std::vector<uint8_t> vNodes{}, vPacked{};
+		MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, Format>(vNodes, 0, cpdNodes)));
+		MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, Format>(vPacked, 0, cpdPacked)));
+		MyAssert(vNodes == vPacked);
+		size_t szPackedSize = 0;
+		MyAssert(NBT_Writer::GetNBTSize<Format>(cpdPacked, szPackedSize) && szPackedSize == vPacked.size());
+	};
+	CheckWrite.template operator()<NBT_Format::BigEndian>();
+	CheckWrite.template operator()<NBT_Format::VarInt>();
+	MyAssert(cpdPackedRoot.GetList(MU8STR("i")).IsPacked() && cpdPackedRoot.GetList(MU8STR("b")).IsPacked());
+
+	//作用域内读取时直接解码为打包状态
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdNodes));
+	NBT_Type::Compound cpdRead{};
+	{
+		NBT_PackedListScope plsScope{};
+		MyAssert(NBT_PackedListScope::GetCurrent());
+		MyAssert(NBT_Reader::ReadNBT(vData, 0, cpdRead));
+
+		NBT_Type::Compound cpdNoPack{};
+		{
+			NBT_PackedListScope plsOff(false);
+			MyAssert(NBT_Reader::ReadNBT(vData, 0, cpdNoPack));
+		}
+		MyAssert(!cpdNoPack.GetCompound(MU8STR("")).GetList(MU8STR("i")).IsPacked());
+		MyAssert(NBT_PackedListScope::GetCurrent());
+
+		//截断的数据仍然报错
+		NBT_Type::Compound cpdTrunc{};
+		std::vector<uint8_t> vTrunc(vData.begin(), vData.end() - 100);
+		MyAssert(!NBT_Reader::ReadNBT(vTrunc, 0, cpdTrunc, 512, NBT_NoPrint{}));
+	}
+	MyAssert(!NBT_PackedListScope::GetCurrent());
+
+	const NBT_Type::Compound &cpdReadRoot = cpdRead.GetCompound(MU8STR(""));
+	MyAssert(cpdReadRoot.GetList(MU8STR("Pos")).IsPacked());
+	MyAssert(cpdReadRoot.GetList(MU8STR("i")).GetPackedTag() == NBT_TAG::Int);
+	MyAssert(cpdReadRoot.GetList(MU8STR("b")).GetPacked<NBT_Type::Byte>().size() == 3001);
+	MyAssert(!cpdReadRoot.GetList(MU8STR("s")).IsPacked());
+	MyAssert(cpdReadRoot.GetList(MU8STR("sub")).GetCompound(0).GetList(MU8STR("Motion")).IsPacked());
+	MyAssert(cpdRead == cpdNodes);
+	MyAssert(NBT_Helper::Hash<NBT_Helper::DefaultCompoundSort<true>>(cpdRead, 0x12345678) == NBT_Helper::Hash<NBT_Helper::DefaultCompoundSort<true>>(cpdNodes, 0x12345678));
+}
+
+void SnbtReaderTest()
+{
+	//Serialize输出的SNBT可以读回相同的对象
+	NBT_Type::Compound cpdInner
+	{
+		{MU8STR("byte"),NBT_Type::Byte{ -128 }},
+		{MU8STR("short"),NBT_Type::Short{ 32767 }},
+		{MU8STR("int"),NBT_Type::Int{ -2147483647 - 1 }},
+		{MU8STR("long"),NBT_Type::Long{ 0x7FFFFFFFFFFFFFFF }},
+		{MU8STR("float"),NBT_Type::Float{ 0.1f }},
+		{MU8STR("double"),NBT_Type::Double{ -1.0e300 }},
+		{MU8STR("string"),NBT_Type::String{ MU8STR("测试 text") }},
+		{MU8STR("empty"),NBT_Type::String{}},
+		{MU8STR("byte array"),NBT_Type::ByteArray{ 1,-2,3 }},
+		{MU8STR("int array"),NBT_Type::IntArray{ -1,0,2147483647 }},
+		{MU8STR("long array"),NBT_Type::LongArray{}},
+		{MU8STR("list"),NBT_Type::List{ NBT_Type::Double{ 1.5 },NBT_Type::Double{ -0.0 } }},
+		{MU8STR("mixed"),NBT_Type::List{ NBT_Type::Int{ 1 },NBT_Type::String{ MU8STR("a") },NBT_Type::Compound{} }},
+		{MU8STR("empty list"),NBT_Type::List{}},
+		{MU8STR("nested"),NBT_Type::List{ NBT_Type::List{ NBT_Type::Compound{ {MU8STR("x"),NBT_Type::Short{ 1 }} } } }},
+	};
+	NBT_Type::Compound cpdSrc{ {MU8STR(""),cpdInner} };
+
+	NBT_Type::String sSnbt = NBT_Helper::Serialize<NBT_Helper::DefaultCompoundSort<true>, false, true>(cpdSrc);
+	NBT_Type::Compound cpdRead{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBT<true>(sSnbt.GetCharTypeView(), cpdRead));
+	MyAssert(cpdRead == cpdSrc);
+
+	//手写的SNBT：无引号的键与值、单引号、转义、空白、后缀大小写、布尔与数组后缀
+	std::string strHand = "\xEF\xBB\xBF" R"(
+	{
+		name: 'it\'s "quoted"\n',
+		id: minecraft.stone_1,
+		b: 1b, s: -2S, i: 3i, l: 4l, f: 0.5f, d: 2D, nd: .25, ni: +7, flag: true, off: false,
+		big: 128b, lead: 01, sci: 1e5,
+		u: "A\x42\u0000\U0001F600",
+		arr: [B; 1b, -2, 3B], iarr: [I;], larr: [L; 1L, -2],
+		"quoted key": [ {a: 1}, {b: [ ]} ]
+	}
+	)";
+
+	NBT_Type::Compound cpdHand{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBT(strHand, cpdHand));
+
+	const NBT_Type::Compound cpdExpect
+	{
+		{MU8STR("name"),NBT_Type::String{ MU8STR("it's \"quoted\"\n") }},
+		{MU8STR("id"),NBT_Type::String{ MU8STR("minecraft.stone_1") }},
+		{MU8STR("b"),NBT_Type::Byte{ 1 }},
+		{MU8STR("s"),NBT_Type::Short{ -2 }},
+		{MU8STR("i"),NBT_Type::Int{ 3 }},
+		{MU8STR("l"),NBT_Type::Long{ 4 }},
+		{MU8STR("f"),NBT_Type::Float{ 0.5f }},
+		{MU8STR("d"),NBT_Type::Double{ 2.0 }},
+		{MU8STR("nd"),NBT_Type::Double{ 0.25 }},
+		{MU8STR("ni"),NBT_Type::Int{ 7 }},
+		{MU8STR("flag"),NBT_Type::Byte{ 1 }},
+		{MU8STR("off"),NBT_Type::Byte{ 0 }},
+		{MU8STR("big"),NBT_Type::String{ MU8STR("128b") }},//超出范围
+		{MU8STR("lead"),NBT_Type::String{ MU8STR("01") }},//前导0
+		{MU8STR("sci"),NBT_Type::String{ MU8STR("1e5") }},//无后缀且无小数点
+		{MU8STR("u"),NBT_Type::String{ std::u16string(u"AB\0\U0001F600", 5) }},
+		{MU8STR("arr"),NBT_Type::ByteArray{ 1,-2,3 }},
+		{MU8STR("iarr"),NBT_Type::IntArray{}},
+		{MU8STR("larr"),NBT_Type::LongArray{ 1,-2 }},
+		{MU8STR("quoted key"),NBT_Type::List{ NBT_Type::Compound{ {MU8STR("a"),NBT_Type::Int{ 1 }} },NBT_Type::Compound{ {MU8STR("b"),NBT_Type::List{}} } }},
+	};
+	MyAssert(cpdHand == cpdExpect);
+
+	//UTF-8输入中的4字节字符转换为Modified-UTF-8
+	NBT_Node nodeEmoji{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBTValue("'\xF0\x9F\x98\x80'", nodeEmoji));
+	MyAssert(nodeEmoji.GetString() == NBT_Type::String(std::u16string(u"\U0001F600")));
+
+	//单个值
+	NBT_Node nodeValue{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBTValue(" [I; 1, 2i] ", nodeValue));
+	const NBT_Type::IntArray iaExpect{ 1,2 };
+	MyAssert(nodeValue.GetIntArray() == iaExpect);
+
+	//重复的键后来的值替换原先的值
+	NBT_Type::Compound cpdDup{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBT("{a:1,a:2b}", cpdDup, 512, NBT_NoPrint{}));
+	MyAssert(cpdDup.Size() == 1 && cpdDup.GetByte(MU8STR("a")) == 2);
+
+	//错误
+	const char *const arrBad[] =
+	{
+		"",
+		"[1]",
+		"{a:1",
+		"{a 1}",
+		"{a:1,}",
+		"{a:'abc}",
+		"{a:\"\\q\"}",
+		"{a:\"\\u12\"}",
+		"{a:[B;1,300]}",
+		"{a:[I;1L]}",
+		"{a:[X;1]}",
+		"{a:[1 2]}",
+		"{a:1} x",
+		"{a:minecraft:stone}",
+	};
+	for (const char *pBad : arrBad)
+	{
+		NBT_Type::Compound cpdBad{};
+		MyAssert(!NBT_SNBT_Reader::ReadSNBT(pBad, cpdBad));
+	}
+
+	//深度限制
+	NBT_Type::Compound cpdDeep{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBT("{a:[[[[1]]]]}", cpdDeep, 5));
+	cpdDeep.Clear();
+	MyAssert(!NBT_SNBT_Reader::ReadSNBT("{a:[[[[[1]]]]]}", cpdDeep, 5));
+}
+
+void SerializeStreamTest()
+{
+	//数值格式与转义
+	using DecSort = NBT_Helper::DefaultCompoundSort<true>;
+	const NBT_Node nInt{ NBT_Type::Int{ 1 } }, nByte{ NBT_Type::Byte{ -1 } }, nFloat{ NBT_Type::Float{ 0.1f } }, nDouble{ NBT_Type::Double{ -1.0e300 } };
+	const NBT_Node nEscape{ NBT_Type::String{ MU8STR("a\"b\\\n\x01") } };
+	const NBT_Node nNull{ NBT_Type::String(std::u16string(u"a\0\U0001F600", 4)) };//非SNBT输出转换为UTF-8
+	MyAssert(NBT_Helper::Serialize(nInt) == "0x00000001I");
+	MyAssert(NBT_Helper::Serialize(nByte) == "0xFFB");
+	MyAssert((NBT_Helper::Serialize<DecSort, false, false>(nFloat) == "0.1F"));
+	MyAssert((NBT_Helper::Serialize<DecSort, false, false>(nDouble) == "-1e+300D"));
+	MyAssert((NBT_Helper::Serialize<DecSort, false, false>(nEscape) == "\"a\\\"b\\\\\\n\\x01\""));
+	MyAssert((NBT_Helper::Serialize<DecSort, false, false>(nNull) == "\"a\\x00\xF0\x9F\x98\x80\""));
+
+	//构造超过缓冲区大小的对象，包含需要转义的字符串
+	NBT_Type::List lstEntry{};
+	for (int32_t i = 0; i < 2000; ++i)
+	{
+		NBT_Type::Compound cpdEntry{};
+		cpdEntry.PutString(MU8STR("text"), NBT_Type::String(std::u16string(u"say \"hi\"\\\n\0\U0001F600", 14)));
+		cpdEntry.PutInt(MU8STR("i"), i);
+		cpdEntry.PutFloat(MU8STR("f"), (NBT_Type::Float)i / 7.0f);
+		cpdEntry.PutDouble(MU8STR("d"), (NBT_Type::Double)i / 3.0);
+		lstEntry.AddBackCompound(std::move(cpdEntry));
+	}
+	NBT_Type::Compound cpdSrc{ {MU8STR(""),NBT_Type::Compound{ {MU8STR("entries"),std::move(lstEntry)},{MU8STR("la"),NBT_Type::LongArray{ -1,0,1 }} }} };
+
+	//写入输出流与返回字符串的结果相同
+	std::vector<uint8_t> vSnbt{};
+	NBT_IO::DefaultOutputStream<std::vector<uint8_t>> osSnbt(vSnbt);
+	NBT_Helper::Serialize<NBT_Helper::DefaultCompoundSort<true>, false, true>(cpdSrc, osSnbt);
+	NBT_Type::String sSnbt = NBT_Helper::Serialize<NBT_Helper::DefaultCompoundSort<true>, false, true>(cpdSrc);
+	MyAssert(vSnbt.size() > 16 * 1024);
+	MyAssert(vSnbt.size() == sSnbt.size() && memcmp(vSnbt.data(), sSnbt.data(), vSnbt.size()) == 0);
+
+	//SNBT可以读回相同的对象
+	NBT_Type::Compound cpdRead{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBT<true>(std::string_view((const char *)vSnbt.data(), vSnbt.size()), cpdRead));
+	MyAssert(cpdRead == cpdSrc);
+
+	//UTF-8输出也可以读回
+	std::string strText{};
+	NBT_IO::DefaultOutputStream<std::string> osText(strText);
+	NBT_Helper::Serialize<NBT_Helper::DefaultCompoundSort<true>, false, false>(cpdSrc, osText);
+	NBT_Type::Compound cpdReadText{};
+	MyAssert(NBT_SNBT_Reader::ReadSNBT(strText, cpdReadText));
+	MyAssert(cpdReadText == cpdSrc);
+}
+
+void MUTF8ConvertTest()
+{
+	using Tool = MUTF8_Tool<>;
+	using MU8_String = Tool::MU8_String;
+
+	//三种编码下互相对应的片段：ASCII、0字符、双字节、三字节、补充字符
+	struct Piece
+	{
+		std::u8string u8Str;
+		MU8_String mu8Str;
+		std::u16string u16Str;
+	};
+	const Piece arrPiece[] =
+	{
+		{ u8"a", { 'a' }, u"a" },
+		{ std::u8string(1, u8'\0'), { 0xC0, 0x80 }, std::u16string(1, u'\0') },
+		{ u8"é", { 0xC3, 0xA9 }, u"é" },
+		{ u8"中", { 0xE4, 0xB8, 0xAD }, u"中" },
+		{ u8"\U0001F600", { 0xED, 0xA0, 0xBD, 0xED, 0xB8, 0x80 }, u"\U0001F600" },
+	};
+
+	//生成ASCII长度不一的混合字符串，使特殊字符落在16/32字节分块的各个位置
+	uint32_t u32Seed = 12345;
+	auto funcNext = [&u32Seed](uint32_t u32Mod) -> uint32_t
+	{
+		u32Seed = u32Seed * 1103515245 + 12345;
+		return (u32Seed >> 16) % u32Mod;
+	};
+
+	for (size_t szCase = 0; szCase < 200; ++szCase)
+	{
+		std::u8string u8Str{};
+		MU8_String mu8Str{};
+		std::u16string u16Str{};
+
+		size_t szPieces = funcNext(12);
+		for (size_t i = 0; i < szPieces; ++i)
+		{
+			size_t szAscii = funcNext(80);
+			for (size_t j = 0; j < szAscii; ++j)
+			{
+				char8_t c = (char8_t)(0x20 + funcNext(0x5F));
+				u8Str.push_back(c);
+				mu8Str.push_back((uint8_t)c);
+				u16Str.push_back((char16_t)c);
+			}
+
+			const Piece &p = arrPiece[funcNext(sizeof(arrPiece) / sizeof(arrPiece[0]))];
+			u8Str += p.u8Str;
+			mu8Str += p.mu8Str;
+			u16Str += p.u16Str;
+		}
+
+		MyAssert(Tool::U8ToMU8(u8Str) == mu8Str);
+		MyAssert(Tool::U16ToMU8(u16Str) == mu8Str);
+		MyAssert(Tool::MU8ToU8(mu8Str) == u8Str);
+		MyAssert(Tool::MU8ToU16(mu8Str) == u16Str);
+
+		MyAssert(Tool::U8ToMU8Length(u8Str) == mu8Str.size());
+		MyAssert(Tool::U16ToMU8Length(u16Str) == mu8Str.size());
+		MyAssert(Tool::MU8ToU8Length(mu8Str) == u8Str.size());
+		MyAssert(Tool::MU8ToU16Length(mu8Str) == u16Str.size());
+	}
+
+	//非法序列前后有长ASCII段时，替换结果与逐字节处理一致
+	const std::string strAscii(40, 'x');
+	MU8_String mu8Bad(strAscii.begin(), strAscii.end());
+	mu8Bad += { 0xED, 0xA0 };//被截断的代理对
+	mu8Bad.append(strAscii.begin(), strAscii.end());
+	mu8Bad += { 0xE4, 0xED, 0xA0 };//三字节码点的第二字节为0xED，不能被当作代理对开始
+	mu8Bad.append(strAscii.begin(), strAscii.end());
+	mu8Bad += { 0xC0 };//末尾截断的0字符
+
+	std::u8string u8BadExpect(strAscii.begin(), strAscii.end());
+	u8BadExpect += u8"��";
+	u8BadExpect.append(strAscii.begin(), strAscii.end());
+	u8BadExpect += { (char8_t)0xE4, (char8_t)0xED, (char8_t)0xA0 };
+	u8BadExpect.append(strAscii.begin(), strAscii.end());
+	u8BadExpect += u8"�";
+	MyAssert(Tool::MU8ToU8(mu8Bad) == u8BadExpect);
+	MyAssert(Tool::MU8ToU8Length(mu8Bad) == u8BadExpect.size());
+
+	//UTF-16的孤立代理与UTF-8的截断四字节序列
+	std::u16string u16Bad(strAscii.begin(), strAscii.end());
+	u16Bad += (char16_t)0xDC00;
+	u16Bad.append(strAscii.begin(), strAscii.end());
+	MU8_String mu8U16BadExpect(strAscii.begin(), strAscii.end());
+	mu8U16BadExpect += { 0xEF, 0xBF, 0xBD };
+	mu8U16BadExpect.append(strAscii.begin(), strAscii.end());
+	MyAssert(Tool::U16ToMU8(u16Bad) == mu8U16BadExpect);
+
+	std::u8string u8Bad(strAscii.begin(), strAscii.end());
+	u8Bad += { (char8_t)0xF0, (char8_t)0x9F };
+	u8Bad.append(strAscii.begin(), strAscii.end());
+	MU8_String mu8U8BadExpect(strAscii.begin(), strAscii.end());
+	mu8U8BadExpect += { 0xEF, 0xBF, 0xBD, 0xEF, 0xBF, 0xBD };
+	mu8U8BadExpect.append(strAscii.begin(), strAscii.end());
+	MyAssert(Tool::U8ToMU8(u8Bad) == mu8U8BadExpect);
+}
+
+void BorrowedReadTest()
+{
+	NBT_Type::ByteArray baGen{};
+	NBT_Type::IntArray iaGen{};
+	NBT_Type::LongArray laGen{};
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		baGen.push_back((NBT_Type::Byte)i);
+		iaGen.push_back((NBT_Type::Int)((uint32_t)i * 0x01020304));
+		laGen.push_back((NBT_Type::Long)((uint64_t)i * 0x0102030405060708));
+	}
+
+	NBT_Type::List lstMixed{};
+	lstMixed.AddBackInt(1);
+	lstMixed.AddBackString(MU8STR("mixed"));
+	lstMixed.AddBackCompound(NBT_Type::Compound{ {MU8STR("k"),NBT_Type::Byte{ 3 }} });
+
+	NBT_Type::Compound cpdGen
+	{
+		{MU8STR(""),NBT_Type::Compound
+			{
+				{MU8STR("byte"),NBT_Type::Byte{ -5 }},
+				{MU8STR("short"),NBT_Type::Short{ 1234 }},
+				{MU8STR("int"),NBT_Type::Int{ -123456 }},
+				{MU8STR("long"),NBT_Type::Long{ 0x0102030405060708 }},
+				{MU8STR("float"),NBT_Type::Float{ 1.5f }},
+				{MU8STR("double"),NBT_Type::Double{ -2.25 }},
+				{MU8STR("str"),MU8STR("中文 string")},
+				{MU8STR("b"),baGen},
+				{MU8STR("i"),iaGen},
+				{MU8STR("l"),laGen},
+				{MU8STR("nums"),NBT_Type::List{ NBT_Type::Int{ 7 }, NBT_Type::Int{ 8 } }},
+				{MU8STR("empty"),NBT_Type::List{}},
+				{MU8STR("mixed"),lstMixed},
+				{MU8STR("sub"),NBT_Type::Compound{ {MU8STR("x"),NBT_Type::Int{ 42 }} }},
+			}
+		}
+	};
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen));
+
+	NBT_BorrowedNode::Compound cpdBorrowed{};
+	MyAssert(NBT_BorrowedReader::ReadNBT(vData, 0, cpdBorrowed));
+	MyAssert(cpdBorrowed.Size() == 1);
+
+	//访问接口
+	const NBT_BorrowedNode::Compound &cpdRoot = cpdBorrowed.GetCompound(MU8STR(""));
+	MyAssert(cpdRoot.GetByte(MU8STR("byte")) == -5);
+	MyAssert(cpdRoot.GetShort(MU8STR("short")) == 1234);
+	MyAssert(cpdRoot.GetInt(MU8STRV("int")) == -123456);
+	MyAssert(cpdRoot.GetLong(MU8STR("long")) == 0x0102030405060708);
+	MyAssert(cpdRoot.GetFloat(MU8STR("float")) == 1.5f);
+	MyAssert(cpdRoot.GetDouble(MU8STR("double")) == -2.25);
+	MyAssert(cpdRoot.HasInt(MU8STR("byte")) == nullptr);
+	MyAssert(cpdRoot.HasInt(MU8STR("missing")) == nullptr);
+	MyAssert(cpdRoot.ContainsCompound(MU8STR("sub")));
+	MyAssert(cpdRoot.GetCompound(MU8STR("sub")).GetInt(MU8STR("x")) == 42);
+
+	//字符串直接指向输入数据
+	const NBT_BorrowedNode::String &sStr = cpdRoot.GetString(MU8STR("str"));
+	MyAssert(sStr == MU8STRV("中文 string"));
+	MyAssert((const uint8_t *)sStr.data() >= vData.data() && (const uint8_t *)sStr.data() < vData.data() + vData.size());
+
+	//数组按需转换字节序
+	const NBT_BorrowedNode::IntArray &spanInt = cpdRoot.GetIntArray(MU8STR("i"));
+	MyAssert(spanInt.size() == iaGen.size());
+	MyAssert(spanInt[1] == iaGen[1] && spanInt[999] == iaGen[999]);
+	MyAssert(spanInt.GetRawData().data() >= vData.data() && spanInt.GetRawData().data() < vData.data() + vData.size());
+	MyAssert(spanInt.ToArray<NBT_Type::IntArray>() == iaGen);
+	MyAssert(std::equal(spanInt.begin(), spanInt.end(), iaGen.begin(), iaGen.end()));
+	NBT_Type::Long arrLong[3]{};
+	cpdRoot.GetLongArray(MU8STR("l")).Decode(500, 3, arrLong);
+	MyAssert(arrLong[0] == laGen[500] && arrLong[2] == laGen[502]);
+	MyAssert(cpdRoot.GetByteArray(MU8STR("b")).ToArray<NBT_Type::ByteArray>() == baGen);
+
+	//列表
+	const NBT_BorrowedNode::List &lstNums = cpdRoot.GetList(MU8STR("nums"));
+	MyAssert(lstNums.GetElementTag() == NBT_TAG::Int && lstNums.Size() == 2);
+	MyAssert(lstNums.GetInt(1) == 8 && lstNums.HasShort(0) == nullptr && lstNums.HasInt(2) == nullptr);
+	MyAssert(cpdRoot.GetList(MU8STR("empty")).GetElementTag() == NBT_TAG::End);
+
+	//混合列表按NBT_Reader的规则解包
+	const NBT_BorrowedNode::List &lstReadMixed = cpdRoot.GetList(MU8STR("mixed"));
+	MyAssert(lstReadMixed.Size() == 3);
+	MyAssert(lstReadMixed.GetInt(0) == 1);
+	MyAssert(lstReadMixed.GetString(1) == MU8STRV("mixed"));
+	MyAssert(lstReadMixed.GetCompound(2).GetByte(MU8STR("k")) == 3);
+
+	//转换为普通对象后与NBT_Reader的结果一致
+	NBT_Type::Compound cpdMaterialized{};
+	MyAssert(NBT_BorrowedReader::Materialize(cpdBorrowed, cpdMaterialized));
+	MyAssert(cpdMaterialized == cpdGen);
+
+	NBT_Type::Compound cpdNoUnwrap{};
+	MyAssert(NBT_Reader::ReadNBT<false>(vData, 0, cpdNoUnwrap));
+	NBT_BorrowedNode::Compound cpdBorrowedNoUnwrap{};
+	MyAssert(NBT_BorrowedReader::ReadNBT<false>(std::span<const uint8_t>(vData), 0, cpdBorrowedNoUnwrap));
+	NBT_Type::Compound cpdMaterializedNoUnwrap{};
+	MyAssert(NBT_BorrowedReader::Materialize(cpdBorrowedNoUnwrap, cpdMaterializedNoUnwrap));
+	MyAssert(cpdMaterializedNoUnwrap == cpdNoUnwrap);
+
+	//同名条目以后出现的为准
+	std::vector<uint8_t> vDup{ 0x03, 0x00, 0x01, 'a', 0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x01, 'a', 0x00, 0x00, 0x00, 0x02 };
+	NBT_BorrowedNode::Compound cpdDup{};
+	MyAssert(NBT_BorrowedReader::ReadNBT(vDup, 0, cpdDup));
+	MyAssert(cpdDup.Size() == 2 && cpdDup.GetInt(MU8STR("a")) == 2);
+
+	//小端格式同样直接引用输入数据，数组视图按记录的字节序转换
+	std::vector<uint8_t> vDataLE{};
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, NBT_Format::LittleEndian>(vDataLE, 0, cpdGen)));
+	NBT_BorrowedNode::Compound cpdBorrowedLE{};
+	MyAssert((NBT_BorrowedReader::ReadNBT<true, NBT_Format::LittleEndian>(vDataLE, 0, cpdBorrowedLE)));
+	const NBT_BorrowedNode::Compound &cpdRootLE = cpdBorrowedLE.GetCompound(MU8STR(""));
+	MyAssert(cpdRootLE.GetShort(MU8STR("short")) == 1234);
+	MyAssert(cpdRootLE.GetLong(MU8STR("long")) == 0x0102030405060708);
+	MyAssert(cpdRootLE.GetString(MU8STR("str")) == MU8STRV("中文 string"));
+	const NBT_BorrowedNode::IntArray &spanIntLE = cpdRootLE.GetIntArray(MU8STR("i"));
+	MyAssert(spanIntLE.GetByteOrder() == std::endian::little && spanInt.GetByteOrder() == std::endian::big);
+	MyAssert(spanIntLE.GetRawData().data() >= vDataLE.data() && spanIntLE.GetRawData().data() < vDataLE.data() + vDataLE.size());
+	MyAssert(spanIntLE[1] == iaGen[1] && spanIntLE.ToArray<NBT_Type::IntArray>() == iaGen);
+	MyAssert(spanIntLE == spanInt);
+	MyAssert(std::equal(spanIntLE.begin(), spanIntLE.end(), iaGen.begin(), iaGen.end()));
+	cpdRootLE.GetLongArray(MU8STR("l")).Decode(500, 3, arrLong);
+	MyAssert(arrLong[0] == laGen[500] && arrLong[2] == laGen[502]);
+	NBT_Type::Compound cpdMaterializedLE{};
+	MyAssert(NBT_BorrowedReader::Materialize(cpdBorrowedLE, cpdMaterializedLE));
+	MyAssert(cpdMaterializedLE == cpdGen);
+	NBT_BorrowedNode::Compound cpdTruncLE{};
+	MyAssert((!NBT_BorrowedReader::ReadNBT<true, NBT_Format::LittleEndian>(std::span<const uint8_t>(vDataLE.data(), vDataLE.size() - 1), 0, cpdTruncLE, 512, NBT_NoPrint{})));
+
+	//截断的数据与过深的嵌套需要报错
+	for (size_t szCut : { (size_t)3, (size_t)20, vData.size() / 2, vData.size() - 1 })
+	{
+		NBT_BorrowedNode::Compound cpdTrunc{};
+		MyAssert(!NBT_BorrowedReader::ReadNBT(std::span<const uint8_t>(vData.data(), szCut), 0, cpdTrunc, 512, NBT_NoPrint{}));
+	}
+
+	NBT_BorrowedNode::Compound cpdDeep{};
+	MyAssert(!NBT_BorrowedReader::ReadNBT(vData, 0, cpdDeep, 1, NBT_NoPrint{}));
+	MyAssert(!NBT_BorrowedReader::ReadNBT(vData, vData.size() + 1, cpdDeep, 512, NBT_NoPrint{}));
+}
+
+//视图模式的SkippingCollector：键名与字符串以视图传递，同时检查视图是否指向输入数据
+class ViewSkippingCollector : public NBT_Visitor_Collector
+{
+public:
+	using ResultControl = NBT_Visitor::ResultControl;
+	using NestingControl = NBT_Visitor::NestingControl;
+
+	const uint8_t *pBeg = NULL;
+	const uint8_t *pEnd = NULL;
+	size_t szOutside = 0;//不在[pBeg, pEnd)范围内的视图个数
+	size_t szNameMismatch = 0;//条目结束回调与开始回调键名不同的次数
+	NBT_Type::String sLastName{};
+	bool bQuiet = false;
+
+	static bool ContainsSkip(NBT_Type::String::View view) noexcept
+	{
+		return view.find(MU8STRV("skip")) != std::string_view::npos;
+	}
+
+	void CheckRange(NBT_Type::String::View view) noexcept
+	{
+		const uint8_t *pView = (const uint8_t *)view.data();
+		if (pBeg != NULL && !view.empty() && (pView < pBeg || pView + view.size() > pEnd))
+		{
+			++szOutside;
+		}
+	}
+
+	NestingControl VisitCompoundEntryBegin(NBT_TAG enTag, NBT_Type::String::View sName)
+	{
+		CheckRange(sName);
+		if (ContainsSkip(sName))
+		{
+			return NestingControl::Skip;
+		}
+
+		sLastName = NBT_Type::String(sName);
+		sPendingKey = NBT_Type::String(sName);
+		return NestingControl::Enter;
+	}
+
+	ResultControl VisitCompoundEntryEnd(NBT_TAG enTag, NBT_Type::String::View sName)
+	{
+		if (enTag != NBT_TAG::Compound && enTag != NBT_TAG::List && sName != sLastName)
+		{
+			++szNameMismatch;
+		}
+		return ResultControl::Continue;
+	}
+
+	ResultControl VisitStringResult(NBT_Type::String::View strResult)
+	{
+		CheckRange(strResult);
+		if (ContainsSkip(strResult))
+		{
+			return ResultControl::Continue;//丢弃并跳过
+		}
+
+		if (!AppendStackTop(NBT_Type::String(strResult)))
+		{
+			return ResultControl::Stop;
+		}
+		return ResultControl::Continue;
+	}
+
+	template<typename... Args>
+	void VisitError(NBT_Print_Level lvl, const std::format_string<Args...> fmt, Args&&... args) noexcept
+	{
+		if (!bQuiet)
+		{
+			NBT_Print{}(lvl, fmt, std::forward<Args>(args)...);
+		}
+	}
+};
+
+static_assert(IsLookLike_NBT_ViewVisitor<ViewSkippingCollector> && !IsLookLike_NBT_Visitor<ViewSkippingCollector>);
+static_assert(IsLookLike_NBT_Visitor<SkippingCollector>);
+
+void ScannerViewTest()
+{
+	NBT_Type::Compound cpdInner{};
+	NBT_Type::List listStr{};
+	for (int32_t i = 0; i < 200; ++i)
+	{
+		std::string strVal = "palette entry with a fairly long name " + std::to_string(i) + ((i % 3 == 0) ? " skip" : "");
+		listStr.AddBackString(NBT_Type::String(strVal.begin(), strVal.end()));
+
+		std::string strKey = "a key that does not fit into small buffers " + std::to_string(i) + ((i % 5 == 0) ? " skip" : "");
+		cpdInner.PutInt(NBT_Type::String(strKey.begin(), strKey.end()), i);
+	}
+	cpdInner.PutList(MU8STR("list"), std::move(listStr));
+	cpdInner.PutString(MU8STR(""), MU8STR(""));
+	cpdInner.PutString(MU8STR("string"), MU8STR("测试"));
+	cpdInner.PutCompound(MU8STR("nested"), NBT_Type::Compound{ {MU8STR("k"),MU8STR("v")},{MU8STR("k skip"),MU8STR("v")} });
+	cpdInner.PutLongArray(MU8STR("long array"), NBT_Type::LongArray(300, 0x0102030405060708));
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen));
+
+	//参照结果：原先的字符串对象模式
+	SkippingCollector vcRef;
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vcRef));
+	NBT_Type::Compound cpdRef = vcRef.MoveRoot();
+	MyAssert(cpdRef.GetCompound(MU8STR("")).Size() == cpdGen.GetCompound(MU8STR("")).Size() - 40);
+
+	//连续数据：视图直接指向输入
+	{
+		ViewSkippingCollector vc;
+		vc.pBeg = vData.data();
+		vc.pEnd = vData.data() + vData.size();
+		MyAssert(NBT_Scanner::ScanNBT(vData, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdRef);
+		MyAssert(vc.szOutside == 0);
+		MyAssert(vc.szNameMismatch == 0);
+	}
+
+	//内存映射流同样提供连续数据
+	{
+		std::filesystem::path pathTemp = std::filesystem::temp_directory_path() / "nbt_all_test_scan_view.nbt";
+		MyAssert(NBT_IO::WriteFile(pathTemp, vData));
+
+		{
+			NBT_IO::MmapInputStream isMmap(pathTemp);
+			MyAssert(isMmap.IsOpen());
+
+			ViewSkippingCollector vc;
+			vc.pBeg = isMmap.GetMappedFile().data();
+			vc.pEnd = vc.pBeg + isMmap.Size();
+			MyAssert(NBT_Scanner::ScanNBT(isMmap, vc));
+			MyAssert(vc.MoveRoot() == cpdRef);
+			MyAssert(vc.szOutside == 0);
+		}
+
+		std::filesystem::remove(pathTemp);
+	}
+
+	//解压流无法直接引用，视图指向扫描器内部的临时字符串，结果相同
+	{
+		std::vector<uint8_t> vZipped{};
+		MyAssert(NBT_IO::CompressDataNoThrow(vZipped, vData));
+
+		NBT_IO::InflateInputStream isInflate(vZipped, 0, NBT_IO::InflateInputStream::MIN_WINDOW_SIZE);
+		ViewSkippingCollector vc;
+		MyAssert(NBT_Scanner::ScanNBT(isInflate, vc));
+		MyAssert(vc.MoveRoot() == cpdRef);
+		MyAssert(vc.szNameMismatch == 0);
+	}
+
+	//提示性实现类本身可以直接用于扫描
+	NBT_ViewVisitor vvDefault{};
+	MyAssert(NBT_Scanner::ScanNBT(vData, 0, vvDefault));
+
+	//截断的数据与过深的嵌套需要报错
+	for (size_t szCut : { (size_t)3, (size_t)20, vData.size() / 2, vData.size() - 1 })
+	{
+		std::vector<uint8_t> vTrunc(vData.begin(), vData.begin() + szCut);
+		ViewSkippingCollector vc;
+		vc.bQuiet = true;
+		MyAssert(!NBT_Scanner::ScanNBT(vTrunc, 0, vc));
+	}
+
+	ViewSkippingCollector vcDeep;
+	vcDeep.bQuiet = true;
+	MyAssert(!NBT_Scanner::ScanNBT(vData, 0, vcDeep, 1));
+}
+
+//通过原始数据回调接收数组，再转换为数组对象插入，结果应与NBT_Visitor_Collector相同
+class ArraySpanCollector : public NBT_Visitor_Collector
+{
+public:
+	using ResultControl = NBT_Visitor::ResultControl;
+
+	const uint8_t *pBeg = NULL;
+	const uint8_t *pEnd = NULL;
+	size_t szOutside = 0;//不在[pBeg, pEnd)范围内的视图个数
+	size_t szSpanCount = 0;
+	size_t szBadElement = 0;//下标访问、迭代器与批量转换结果不一致的次数
+
+	template<typename T>
+	ResultControl VisitArraySpanResult(NBT_BigEndianSpan<T> spanResult)
+	{
+		++szSpanCount;
+
+		std::span<const uint8_t> spanRaw = spanResult.GetRawData();
+		if (pBeg != NULL && !spanRaw.empty() && (spanRaw.data() < pBeg || spanRaw.data() + spanRaw.size() > pEnd))
+		{
+			++szOutside;
+		}
+
+		using ArrayType = std::conditional_t<std::is_same_v<T, NBT_Type::Byte>, NBT_Type::ByteArray,
+			std::conditional_t<std::is_same_v<T, NBT_Type::Int>, NBT_Type::IntArray, NBT_Type::LongArray>>;
+		ArrayType tArray = spanResult.template ToArray<ArrayType>();
+
+		size_t i = 0;
+		for (T tVal : spanResult)
+		{
+			if (tVal != tArray[i] || spanResult[i] != tArray[i])
+			{
+				++szBadElement;
+			}
+			++i;
+		}
+		if (i != tArray.size())
+		{
+			++szBadElement;
+		}
+
+		if (!AppendStackTop(std::move(tArray)))
+		{
+			return ResultControl::Stop;
+		}
+		return ResultControl::Continue;
+	}
+};
+
+static_assert(IsLookLike_NBT_Visitor<ArraySpanCollector> && IsLookLike_NBT_ArraySpanVisitor<ArraySpanCollector>);
+
+//视图模式加原始数据回调：只统计长度并抽样元素
+class ArraySpanCounter : public NBT_ViewVisitor
+{
+public:
+	size_t szElementCount = 0;
+	int64_t i64LastSum = 0;
+
+	template<typename T>
+	ResultControl VisitArraySpanResult(NBT_BigEndianSpan<T> spanResult)
+	{
+		szElementCount += spanResult.size();
+		if (!spanResult.empty())
+		{
+			i64LastSum += spanResult[spanResult.size() - 1];
+		}
+		return ResultControl::Continue;
+	}
+};
+
+static_assert(IsLookLike_NBT_ViewVisitor<ArraySpanCounter> && IsLookLike_NBT_ArraySpanVisitor<ArraySpanCounter>);
+
+void ScannerArraySpanTest()
+{
+	NBT_Type::Compound cpdInner{};
+	NBT_Type::List listInt{};
+	size_t szElementCount = 0;
+	int64_t i64LastSum = 0;
+	for (uint32_t i = 0; i < 64; ++i)
+	{
+		NBT_Type::IntArray iaElem{};
+		for (uint32_t j = 0; j < i; ++j)
+		{
+			iaElem.push_back((NBT_Type::Int)(j * 0x01020304u + i));
+		}
+		szElementCount += iaElem.size();
+		i64LastSum += iaElem.empty() ? 0 : iaElem.back();
+		listInt.AddBackIntArray(std::move(iaElem));
+	}
+	cpdInner.PutList(MU8STR("int arrays"), std::move(listInt));
+
+	NBT_Type::ByteArray baGen{};
+	NBT_Type::LongArray laGen{};
+	for (uint64_t i = 0; i < 4099; ++i)
+	{
+		baGen.push_back((NBT_Type::Byte)(i * 7));
+		laGen.push_back((NBT_Type::Long)(i * 0x0102030405060708ull));
+	}
+	szElementCount += baGen.size() + laGen.size();
+	i64LastSum += baGen.back() + laGen.back();
+	cpdInner.PutByteArray(MU8STR("byte array"), baGen);
+	cpdInner.PutLongArray(MU8STR("long array"), laGen);
+	cpdInner.PutCompound(MU8STR("nested"), NBT_Type::Compound{ {MU8STR("empty"),NBT_Type::LongArray{}},{MU8STR("name"),MU8STR("value")} });
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen));
+
+	//连续数据：视图直接指向输入
+	{
+		ArraySpanCollector vc;
+		vc.pBeg = vData.data();
+		vc.pEnd = vData.data() + vData.size();
+		MyAssert(NBT_Scanner::ScanNBT(vData, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+		MyAssert(vc.szSpanCount == 64 + 3);
+		MyAssert(vc.szOutside == 0);
+		MyAssert(vc.szBadElement == 0);
+	}
+
+	//解压流：原始数据先读到临时缓冲区中
+	{
+		std::vector<uint8_t> vZipped{};
+		MyAssert(NBT_IO::CompressDataNoThrow(vZipped, vData));
+
+		NBT_IO::InflateInputStream isInflate(vZipped, 0, NBT_IO::InflateInputStream::MIN_WINDOW_SIZE);
+		ArraySpanCollector vc;
+		MyAssert(NBT_Scanner::ScanNBT(isInflate, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+		MyAssert(vc.szBadElement == 0);
+	}
+
+	//不实现原始数据回调的访问器仍然接收数组对象
+	{
+		NBT_Visitor_Collector vc;
+		MyAssert(NBT_Scanner::ScanNBT(vData, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+	}
+
+	//与视图模式组合
+	{
+		ArraySpanCounter vc;
+		MyAssert(NBT_Scanner::ScanNBT(vData, 0, vc));
+		MyAssert(vc.szElementCount == szElementCount);
+		MyAssert(vc.i64LastSum == i64LastSum);
+	}
+
+	//截断在数组中间需要报错
+	{
+		std::vector<uint8_t> vTrunc(vData.begin(), vData.end() - 100);
+		ArraySpanCollector vc;
+		MyAssert(!NBT_Scanner::ScanNBT(vTrunc, 0, vc));
+	}
+}
+
+void LittleEndianFormatTest()
+{
+	using LE = NBT_Format::LittleEndian;
+
+	//手工构造的小端序数据：根(0A 0000) + Int "i"(03 0100 69 04030201) + String "s"(08 0100 73 0200 6869) + End + End
+	const std::vector<uint8_t> vExpect
+	{
+		0x0A, 0x00, 0x00,
+		0x03, 0x01, 0x00, 'i', 0x04, 0x03, 0x02, 0x01,
+		0x08, 0x01, 0x00, 's', 0x02, 0x00, 'h', 'i',
+		0x00,
+	};
+	NBT_Type::Compound cpdSmall{ {MU8STR(""),NBT_Type::Compound{ {MU8STR("i"),NBT_Type::Int{ 0x01020304 }},{MU8STR("s"),MU8STR("hi")} }} };
+
+	std::vector<uint8_t> vSmall{};
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, LE>(vSmall, 0, cpdSmall)));
+	MyAssert(vSmall == vExpect);
+
+	NBT_Type::Compound cpdSmallRead{};
+	MyAssert((NBT_Reader::ReadNBT<true, LE>(vExpect, 0, cpdSmallRead)));
+	MyAssert(cpdSmallRead == cpdSmall);
+
+	//覆盖所有类型，数组与数值列表跨越分块边界
+	NBT_Type::Compound cpdInner{};
+	NBT_Type::ByteArray baGen{};
+	NBT_Type::IntArray iaGen{};
+	NBT_Type::LongArray laGen{};
+	NBT_Type::List lstInt{}, lstDouble{}, lstCpd{};
+	for (uint32_t i = 0; i < 3001; ++i)
+	{
+		baGen.push_back((NBT_Type::Byte)(i * 3));
+		iaGen.push_back((NBT_Type::Int)(i * 0x01020304u));
+		laGen.push_back((NBT_Type::Long)(i * 0x0102030405060708ull));
+		lstInt.AddBack(NBT_Type::Int((int32_t)(i * 0x00010203u)));
+		lstDouble.AddBack(NBT_Type::Double{ i * 0.25 - 7.0 });
+	}
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		lstCpd.AddBack(NBT_Type::Compound{ {MU8STR("id"),NBT_Type::Short((int16_t)(i * 0x0101))} });
+	}
+	cpdInner.PutByte(MU8STR("byte"), NBT_Type::Byte{ -5 });
+	cpdInner.PutShort(MU8STR("short"), NBT_Type::Short{ 0x1234 });
+	cpdInner.PutLong(MU8STR("long"), NBT_Type::Long{ 0x0102030405060708 });
+	cpdInner.PutFloat(MU8STR("float"), NBT_Type::Float{ 1.5f });
+	cpdInner.PutDouble(MU8STR("double"), NBT_Type::Double{ -2.75 });
+	cpdInner.PutString(MU8STR("string"), MU8STR("Bedrock"));
+	cpdInner.PutByteArray(MU8STR("byte array"), baGen);
+	cpdInner.PutIntArray(MU8STR("int array"), iaGen);
+	cpdInner.PutLongArray(MU8STR("long array"), laGen);
+	cpdInner.PutList(MU8STR("int list"), lstInt);
+	cpdInner.PutList(MU8STR("double list"), lstDouble);
+	cpdInner.PutList(MU8STR("compound list"), lstCpd);
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vBig{}, vLittle{};
+	MyAssert(NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>>(vBig, 0, cpdGen));
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, LE>(vLittle, 0, cpdGen)));
+	MyAssert(vBig.size() == vLittle.size());
+	MyAssert(vBig != vLittle);
+
+	//读回与原数据一致，再次写出字节完全相同
+	NBT_Type::Compound cpdRead{};
+	MyAssert((NBT_Reader::ReadNBT<true, LE>(vLittle, 0, cpdRead)));
+	MyAssert(cpdRead == cpdGen);
+
+	std::vector<uint8_t> vRewrite{};
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, LE>(vRewrite, 0, cpdRead)));
+	MyAssert(vRewrite == vLittle);
+
+	//输入流版本
+	{
+		NBT_IO::DefaultInputStream<std::vector<uint8_t>> isLittle(vLittle, 0);
+		NBT_Type::Compound cpdStream{};
+		MyAssert((NBT_Reader::ReadNBT<true, LE>(isLittle, cpdStream)));
+		MyAssert(cpdStream == cpdGen);
+	}
+
+	//扫描器
+	{
+		NBT_Visitor_Collector vc;
+		MyAssert(NBT_Scanner::ScanNBT<LE>(vLittle, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+	}
+
+	//原始数据回调：只有字节数组以视图传递，其余数组转换后传递
+	{
+		ArraySpanCollector vc;
+		vc.pBeg = vLittle.data();
+		vc.pEnd = vLittle.data() + vLittle.size();
+		MyAssert(NBT_Scanner::ScanNBT<LE>(vLittle, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+		MyAssert(vc.szSpanCount == 1);
+		MyAssert(vc.szOutside == 0);
+		MyAssert(vc.szBadElement == 0);
+	}
+
+	//视图模式：键名与字符串直接指向输入
+	{
+		ViewSkippingCollector vc;
+		vc.pBeg = vLittle.data();
+		vc.pEnd = vLittle.data() + vLittle.size();
+		MyAssert(NBT_Scanner::ScanNBT<LE>(vLittle, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+		MyAssert(vc.szOutside == 0);
+		MyAssert(vc.szNameMismatch == 0);
+	}
+
+	//截断的数据需要报错
+	std::vector<uint8_t> vTrunc(vLittle.begin(), vLittle.end() - 100);
+	NBT_Type::Compound cpdTrunc{};
+	MyAssert(!(NBT_Reader::ReadNBT<true, LE>(vTrunc, 0, cpdTrunc)));
+	NBT_Visitor_Collector vcTrunc;
+	MyAssert(!NBT_Scanner::ScanNBT<LE>(vTrunc, 0, vcTrunc));
+}
+
+void VarIntFormatTest()
+{
+	using VI = NBT_Format::VarInt;
+
+	//编解码边界值：解码缓冲区补零，保证满足解码窗口
+	{
+		const uint64_t u64Vals[] = { 0, 1, 127, 128, 300, 16383, 16384, 0x0FFFFFFF, 0x10000000, UINT32_MAX, 0x00FFFFFFFFFFFFFFull, 0x0100000000000000ull, 0x8000000000000000ull, UINT64_MAX };
+		for (uint64_t u64Val : u64Vals)
+		{
+			uint8_t u8Buf[16] = {};
+			size_t szSize = VI::EncodeVarInt(u64Val, u8Buf);
+			MyAssert(szSize == VI::VarIntSize(u64Val));
+
+			uint64_t u64Decode = 0;
+			MyAssert(VI::DecodeVarInt(u8Buf, u64Decode) == szSize);
+			MyAssert(u64Decode == u64Val);
+
+			if (u64Val <= UINT32_MAX)
+			{
+				uint32_t u32Decode = 0;
+				MyAssert(VI::DecodeVarInt(u8Buf, u32Decode) == szSize);
+				MyAssert(u32Decode == (uint32_t)u64Val);
+			}
+		}
+
+		const int64_t i64Vals[] = { 0, -1, 1, -64, 64, INT32_MIN, INT32_MAX, INT64_MIN, INT64_MAX };
+		for (int64_t i64Val : i64Vals)
+		{
+			MyAssert(VI::ZigZagDecode(VI::ZigZagEncode(i64Val)) == i64Val);
+		}
+		MyAssert(VI::ZigZagEncode((int32_t)-1) == 1u && VI::ZigZagEncode((int32_t)1) == 2u && VI::ZigZagEncode(INT32_MIN) == UINT32_MAX);
+
+		//32位VarInt最多5字节
+		const uint8_t u8TooLong[16] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+		uint32_t u32Decode = 0;
+		MyAssert(VI::DecodeVarInt(u8TooLong, u32Decode) == 0);
+		uint64_t u64Decode = 0;
+		MyAssert(VI::DecodeVarInt(u8TooLong, u64Decode) == 6);
+	}
+
+	//手工构造的数据：根(0A 00) + IntArray "a"{1,-2,150} + Int "i"(-1) + Long "l"(300) + String "s"("hi") + End
+	const std::vector<uint8_t> vExpect
+	{
+		0x0A, 0x00,
+		0x0B, 0x01, 'a', 0x06, 0x02, 0x03, 0xAC, 0x02,
+		0x03, 0x01, 'i', 0x01,
+		0x04, 0x01, 'l', 0xD8, 0x04,
+		0x08, 0x01, 's', 0x02, 'h', 'i',
+		0x00,
+	};
+	NBT_Type::Compound cpdSmall
+	{
+		{MU8STR(""),NBT_Type::Compound
+			{
+				{MU8STR("a"),NBT_Type::IntArray{ 1, -2, 150 }},
+				{MU8STR("i"),NBT_Type::Int{ -1 }},
+				{MU8STR("l"),NBT_Type::Long{ 300 }},
+				{MU8STR("s"),MU8STR("hi")},
+			}
+		}
+	};
+
+	std::vector<uint8_t> vSmall{};
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, VI>(vSmall, 0, cpdSmall)));
+	MyAssert(vSmall == vExpect);
+
+	NBT_Type::Compound cpdSmallRead{};
+	MyAssert((NBT_Reader::ReadNBT<true, VI>(vExpect, 0, cpdSmallRead)));
+	MyAssert(cpdSmallRead == cpdSmall);
+
+	//覆盖所有类型，数值长短混合，字符串长度需要多字节VarInt
+	NBT_Type::Compound cpdInner{};
+	NBT_Type::ByteArray baGen{};
+	NBT_Type::IntArray iaGen{ INT32_MIN, INT32_MAX, 0, -1 };
+	NBT_Type::LongArray laGen{ INT64_MIN, INT64_MAX, 0, -1 };
+	NBT_Type::List lstInt{}, lstLong{}, lstFloat{}, lstCpd{};
+	uint64_t u64Seed = 0x9E3779B97F4A7C15ull;
+	for (uint32_t i = 0; i < 3001; ++i)
+	{
+		u64Seed = u64Seed * 6364136223846793005ull + 1442695040888963407ull;
+		int32_t iVal = (int32_t)(u64Seed >> 32) >> (i % 31);//按位数分散的长度
+		int64_t i64Val = (int64_t)u64Seed >> (i % 63);
+
+		baGen.push_back((NBT_Type::Byte)i);
+		iaGen.push_back(iVal);
+		laGen.push_back(i64Val);
+		lstInt.AddBack(NBT_Type::Int{ iVal });
+		lstLong.AddBack(NBT_Type::Long{ i64Val });
+		lstFloat.AddBack(NBT_Type::Float{ i * 0.5f });
+	}
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		lstCpd.AddBack(NBT_Type::Compound{ {MU8STR("id"),NBT_Type::Int{ i * -1000 }},{MU8STR("skip ids"),NBT_Type::IntArray{ i, -i, i * 100000 }} });
+	}
+	cpdInner.PutByte(MU8STR("byte"), NBT_Type::Byte{ -5 });
+	cpdInner.PutShort(MU8STR("short"), NBT_Type::Short{ -0x1234 });
+	cpdInner.PutInt(MU8STR("int min"), NBT_Type::Int{ INT32_MIN });
+	cpdInner.PutLong(MU8STR("long min"), NBT_Type::Long{ INT64_MIN });
+	cpdInner.PutFloat(MU8STR("float"), NBT_Type::Float{ 1.5f });
+	cpdInner.PutDouble(MU8STR("double"), NBT_Type::Double{ -2.75 });
+	cpdInner.PutString(MU8STR("string"), NBT_Type::String(std::string(300, 'x')));
+	cpdInner.PutByteArray(MU8STR("byte array"), baGen);
+	cpdInner.PutIntArray(MU8STR("int array"), iaGen);
+	cpdInner.PutLongArray(MU8STR("skip long array"), laGen);
+	cpdInner.PutList(MU8STR("skip int list"), lstInt);
+	cpdInner.PutList(MU8STR("long list"), lstLong);
+	cpdInner.PutList(MU8STR("float list"), lstFloat);
+	cpdInner.PutList(MU8STR("compound list"), lstCpd);
+	cpdInner.PutCompound(MU8STR("skip nested"), NBT_Type::Compound{ {MU8STR("long"),NBT_Type::Long{ -7 }},{MU8STR("list"),lstLong} });
+	NBT_Type::Compound cpdGen{ {MU8STR(""),std::move(cpdInner)} };
+
+	std::vector<uint8_t> vData{};
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, VI>(vData, 0, cpdGen)));
+
+	//读回与原数据一致，再次写出字节完全相同
+	NBT_Type::Compound cpdRead{};
+	MyAssert((NBT_Reader::ReadNBT<true, VI>(vData, 0, cpdRead)));
+	MyAssert(cpdRead == cpdGen);
+
+	std::vector<uint8_t> vRewrite{};
+	MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, VI>(vRewrite, 0, cpdRead)));
+	MyAssert(vRewrite == vData);
+
+	//扫描器
+	{
+		NBT_Visitor_Collector vc;
+		MyAssert(NBT_Scanner::ScanNBT<VI>(vData, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdGen);
+	}
+
+	//跳过的子树不解码，结果与删除这些键后一致
+	{
+		NBT_Type::Compound cpdExpect = cpdGen;
+		NBT_Type::Compound &cpdExpectInner = cpdExpect.GetCompound(MU8STR(""));
+		cpdExpectInner.Remove(MU8STR("skip long array"));
+		cpdExpectInner.Remove(MU8STR("skip int list"));
+		cpdExpectInner.Remove(MU8STR("skip nested"));
+		for (auto &it : cpdExpectInner.GetList(MU8STR("compound list")))
+		{
+			it.GetCompound().Remove(MU8STR("skip ids"));
+		}
+
+		SkippingCollector vc;
+		MyAssert(NBT_Scanner::ScanNBT<VI>(vData, 0, vc));
+		MyAssert(vc.MoveRoot() == cpdExpect);
+	}
+
+	//不提供CurrentData的流逐字节解码
+	{
+		std::vector<uint8_t> vZipped{};
+		MyAssert(NBT_IO::CompressDataNoThrow(vZipped, vData));
+
+		NBT_IO::InflateInputStream isRead(vZipped, 0, NBT_IO::InflateInputStream::MIN_WINDOW_SIZE);
+		NBT_Type::Compound cpdInflate{};
+		MyAssert((NBT_Reader::ReadNBT<true, VI>(isRead, cpdInflate)));
+		MyAssert(cpdInflate == cpdGen);
+
+		NBT_IO::InflateInputStream isScan(vZipped, 0, NBT_IO::InflateInputStream::MIN_WINDOW_SIZE);
+		SkippingCollector vc;
+		MyAssert(NBT_Scanner::ScanNBT<VI>(isScan, vc));
+	}
+
+	//过长的VarInt需要报错：Int最多5字节
+	{
+		const std::vector<uint8_t> vTooLong{ 0x0A, 0x00, 0x03, 0x01, 'i', 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+		NBT_Type::Compound cpdTooLong{};
+		MyAssert(!(NBT_Reader::ReadNBT<true, VI>(vTooLong, 0, cpdTooLong)));
+		NBT_Visitor_Collector vc;
+		MyAssert(!NBT_Scanner::ScanNBT<VI>(vTooLong, 0, vc));
+	}
+
+	//字符串长度超过上限需要报错
+	{
+		const std::vector<uint8_t> vLongName{ 0x0A, 0x00, 0x08, 0x80, 0x80, 0x04 };
+		NBT_Type::Compound cpdLongName{};
+		MyAssert(!(NBT_Reader::ReadNBT<true, VI>(vLongName, 0, cpdLongName)));
+	}
+
+	//截断的数据需要报错，包括截断在VarInt中间
+	for (size_t szCut : { (size_t)1, (size_t)100, vData.size() / 2 })
+	{
+		std::vector<uint8_t> vTrunc(vData.begin(), vData.end() - szCut);
+		NBT_Type::Compound cpdTrunc{};
+		MyAssert(!(NBT_Reader::ReadNBT<true, VI>(vTrunc, 0, cpdTrunc)));
+		NBT_Visitor_Collector vc;
+		MyAssert(!NBT_Scanner::ScanNBT<VI>(vTrunc, 0, vc));
+		SkippingCollector vcSkip;
+		MyAssert(!NBT_Scanner::ScanNBT<VI>(vTrunc, 0, vcSkip));
+	}
+}
+
+void NetworkNBTTest()
+{
+	//无名Compound根：与文件格式相比只少了根名称
+	{
+		const std::vector<uint8_t> vExpect
+		{
+			0x0A,
+			0x03, 0x00, 0x01, 'a', 0x00, 0x00, 0x00, 0x01,
+			0x08, 0x00, 0x01, 's', 0x00, 0x01, 'x',
+			0x00,
+		};
+		const NBT_Node nodeRoot{ NBT_Type::Compound{ {MU8STR("s"),MU8STR("x")},{MU8STR("a"),NBT_Type::Int{ 1 }} } };
+
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNetworkNBTSize(nodeRoot, szSize));
+		MyAssert(szSize == vExpect.size());
+		std::vector<uint8_t> vNet{};
+		MyAssert(NBT_Writer::WriteNetworkNBT(vNet, 0, nodeRoot));
+		MyAssert(vNet == vExpect);
+
+		NBT_Node nodeRead{};
+		MyAssert(NBT_Reader::ReadNetworkNBT(vExpect, 0, nodeRead));
+		MyAssert(nodeRead == nodeRoot);
+	}
+
+	//任意类型的根
+	{
+		const std::vector<uint8_t> vString{ 0x08, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o' };
+		const NBT_Node nodeString{ NBT_Type::String(MU8STR("hello")) };
+		std::vector<uint8_t> vNet{};
+		MyAssert(NBT_Writer::WriteNetworkNBT(vNet, 0, nodeString));
+		MyAssert(vNet == vString);
+		NBT_Node nodeRead{};
+		MyAssert(NBT_Reader::ReadNetworkNBT(vString, 0, nodeRead));
+		MyAssert(nodeRead == nodeString);
+
+		const std::vector<uint8_t> vList{ 0x09, 0x01, 0x00, 0x00, 0x00, 0x02, 0x7F, 0x80 };
+		NBT_Type::List lstByte{};
+		lstByte.AddBackByte(127);
+		lstByte.AddBackByte(-128);
+		const NBT_Node nodeList{ lstByte };
+		MyAssert(NBT_Writer::WriteNetworkNBT(vNet, 0, nodeList));
+		MyAssert(vNet == vList);
+		MyAssert(NBT_Reader::ReadNetworkNBT(vList, 0, nodeRead));
+		MyAssert(nodeRead == nodeList);
+
+		const NBT_Node nodeInt{ NBT_Type::Int{ -2 } };
+		MyAssert(NBT_Writer::WriteNetworkNBT(vNet, 0, nodeInt));
+		MyAssert((vNet == std::vector<uint8_t>{ 0x03, 0xFF, 0xFF, 0xFF, 0xFE }));
+		MyAssert(NBT_Reader::ReadNetworkNBT(vNet, 0, nodeRead));
+		MyAssert(nodeRead == nodeInt);
+
+		//End根表示空值，只有一个字节
+		const NBT_Node nodeEnd{};
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNetworkNBTSize(nodeEnd, szSize));
+		MyAssert(szSize == 1);
+		MyAssert(NBT_Writer::WriteNetworkNBT(vNet, 0, nodeEnd));
+		MyAssert((vNet == std::vector<uint8_t>{ 0x00 }));
+		nodeRead = nodeInt;
+		MyAssert(NBT_Reader::ReadNetworkNBT(vNet, 0, nodeRead));
+		MyAssert(nodeRead.GetTag() == NBT_TAG::End);
+	}
+
+	//覆盖所有类型、混合列表与空元素
+	NBT_Type::Compound cpdGen{};
+	{
+		NBT_Type::List lstMixed{};
+		lstMixed.AddBackInt(1);
+		lstMixed.AddBackString(MU8STR("str"));
+		lstMixed.AddBackCompound(NBT_Type::Compound{ {MU8STR(""),NBT_Type::Long{ -3 }} });//需要再套一层
+		lstMixed.AddBackCompound(NBT_Type::Compound{ {MU8STR("x"),NBT_Type::Short{ 5 }} });//直接写出
+		NBT_Type::List lstLong{};
+		NBT_Type::List lstEmptyEntry{};
+		for (int64_t i = 0; i < 300; ++i)
+		{
+			lstLong.AddBackLong(i * i * i * (i % 2 == 0 ? 1 : -1));
+		}
+		lstEmptyEntry.AddBack(NBT_Node{});
+		lstEmptyEntry.AddBackInt(7);
+		lstEmptyEntry.AddBack(NBT_Node{});
+
+		cpdGen.PutByte(MU8STR("byte"), NBT_Type::Byte{ 1 });
+		cpdGen.PutShort(MU8STR("short"), NBT_Type::Short{ -300 });
+		cpdGen.PutInt(MU8STR("int"), NBT_Type::Int{ INT32_MIN });
+		cpdGen.PutLong(MU8STR("long"), NBT_Type::Long{ 1234567890123ll });
+		cpdGen.PutFloat(MU8STR("float"), NBT_Type::Float{ 0.25f });
+		cpdGen.PutDouble(MU8STR("double"), NBT_Type::Double{ 8.5 });
+		cpdGen.PutString(MU8STR("string"), NBT_Type::String(std::string(200, 's')));
+		cpdGen.PutByteArray(MU8STR("byte array"), NBT_Type::ByteArray{ 1, 2, 3 });
+		cpdGen.PutIntArray(MU8STR("int array"), NBT_Type::IntArray{ 0, -1, 200, INT32_MAX });
+		cpdGen.PutLongArray(MU8STR("long array"), NBT_Type::LongArray{ 0, -1, INT64_MIN, 1ll << 40 });
+		cpdGen.PutList(MU8STR("mixed list"), lstMixed);
+		cpdGen.PutList(MU8STR("long list"), lstLong);
+		cpdGen.PutList(MU8STR("empty entry list"), lstEmptyEntry);
+		cpdGen.PutList(MU8STR("empty list"), NBT_Type::List{});
+		cpdGen.Put(MU8STR("end"), NBT_Node{});//End元素不写出
+		cpdGen.PutCompound(MU8STR("nested"), NBT_Type::Compound{ {MU8STR("inner"),NBT_Type::Compound{ {MU8STR("v"),NBT_Type::Int{ 9 }} }} });
+	}
+	const NBT_Node nodeGen{ cpdGen };
+
+	//预计算的大小与各格式实际写出的大小一致
+	auto CheckSize = [&]<typename Format>(void) -> void
+	{
+		std::vector<uint8_t> vNet{};
+		MyAssert((NBT_Writer::WriteNetworkNBT<NBT_Writer::DefaultCompoundSort<true>, Format>(vNet, 0, nodeGen)));
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNetworkNBTSize<Format>(nodeGen, szSize));
+		MyAssert(szSize == vNet.size());
+
+		NBT_Node nodeRead{};
+		MyAssert((NBT_Reader::ReadNetworkNBT<true, Format>(vNet, 0, nodeRead)));
+		MyAssert(nodeRead.GetTag() == NBT_TAG::Compound);
+		MyAssert(nodeRead.GetCompound().Size() == cpdGen.Size() - 1);//End元素被丢弃
+
+		//子节点单独作为根
+		for (const auto &[sName, nodeChild] : cpdGen)
+		{
+			MyAssert((NBT_Writer::WriteNetworkNBT<NBT_Writer::DefaultCompoundSort<true>, Format>(vNet, 0, nodeChild)));
+			MyAssert(NBT_Writer::GetNetworkNBTSize<Format>(nodeChild, szSize));
+			MyAssert(szSize == vNet.size());
+		}
+	};
+	CheckSize.template operator()<NBT_Format::BigEndian>();
+	CheckSize.template operator()<NBT_Format::LittleEndian>();
+	CheckSize.template operator()<NBT_Format::VarInt>();
+
+	//与文件格式对比：去掉根名称的两个字节后完全相同
+	std::vector<uint8_t> vNet{};
+	MyAssert(NBT_Writer::WriteNetworkNBT(vNet, 0, nodeGen));
+	{
+		std::vector<uint8_t> vFile{};
+		MyAssert(NBT_Writer::WriteNBT(vFile, 0, NBT_Type::Compound{ {MU8STR(""),cpdGen} }));
+		MyAssert(vFile.size() == vNet.size() + 2);
+		vFile.erase(vFile.begin() + 1, vFile.begin() + 3);
+		MyAssert(vFile == vNet);
+	}
+
+	//追加到已有的网络包头之后，并从包中间读取，读取后停在NBT之后
+	{
+		std::vector<uint8_t> vPacket{ 0x2A, 0x01 };
+		MyAssert(NBT_Writer::WriteNetworkNBT(vPacket, vPacket.size(), nodeGen));
+		MyAssert(vPacket.size() == 2 + vNet.size());
+		MyAssert(vPacket[0] == 0x2A && vPacket[1] == 0x01);
+		MyAssert(std::equal(vNet.begin(), vNet.end(), vPacket.begin() + 2));
+		vPacket.push_back(0x7F);//后续字段
+
+		NBT_IO::DefaultInputStream<std::vector<uint8_t>> isPacket(vPacket, 2);
+		NBT_Node nodeRead{};
+		MyAssert(NBT_Reader::ReadNetworkNBT(isPacket, nodeRead));
+		MyAssert(isPacket.Index() == 2 + vNet.size());
+		MyAssert(isPacket.GetNext() == 0x7F);
+
+		std::vector<uint8_t> vRewrite{};
+		MyAssert(NBT_Writer::WriteNetworkNBT(vRewrite, 0, nodeRead));
+		MyAssert(vRewrite == vNet);
+	}
+
+	//直接写入调用者持有的定长缓冲区
+	{
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNetworkNBTSize(nodeGen, szSize));
+		std::vector<uint8_t> vBuffer(szSize + 3, 0xCC);
+
+		NBT_IO::BufferOutputStream osExact(vBuffer.data() + 3, szSize);
+		MyAssert(NBT_Writer::WriteNetworkNBT(osExact, nodeGen));
+		MyAssert(osExact.Size() == szSize);
+		MyAssert(std::equal(vNet.begin(), vNet.end(), vBuffer.begin() + 3));
+		MyAssert(vBuffer[0] == 0xCC && vBuffer[2] == 0xCC);
+
+		//容量不足需要报错
+		NBT_IO::BufferOutputStream osSmall(vBuffer.data(), szSize - 1);
+		MyAssert(!NBT_Writer::WriteNetworkNBT(osSmall, nodeGen, 512, NBT_NoPrint{}));
+	}
+
+	//嵌套超过深度限制
+	{
+		NBT_Node nodeDeep{ NBT_Type::Compound{} };
+		for (int i = 0; i < 8; ++i)
+		{
+			nodeDeep = NBT_Node{ NBT_Type::Compound{ {MU8STR("d"),std::move(nodeDeep)} } };
+		}
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNetworkNBTSize(nodeDeep, szSize, 9));
+		MyAssert(!NBT_Writer::GetNetworkNBTSize(nodeDeep, szSize, 8));
+		std::vector<uint8_t> vDeep{};
+		MyAssert(NBT_Writer::WriteNetworkNBT(vDeep, 0, nodeDeep, 9));
+		MyAssert(NBT_Writer::GetNetworkNBTSize(nodeDeep, szSize, 9));
+		MyAssert(szSize == vDeep.size());
+		MyAssert(!NBT_Writer::WriteNetworkNBT(vDeep, 0, nodeDeep, 8, NBT_NoPrint{}));
+	}
+
+	//错误数据
+	{
+		NBT_Node nodeRead{};
+		const std::vector<uint8_t> vEmpty{};
+		MyAssert(!NBT_Reader::ReadNetworkNBT(vEmpty, 0, nodeRead, 512, NBT_NoPrint{}));
+		const std::vector<uint8_t> vBadTag{ 0x0D };
+		MyAssert(!NBT_Reader::ReadNetworkNBT(vBadTag, 0, nodeRead, 512, NBT_NoPrint{}));
+		std::vector<uint8_t> vTrunc(vNet.begin(), vNet.end() - 1);
+		MyAssert(!NBT_Reader::ReadNetworkNBT(vTrunc, 0, nodeRead, 512, NBT_NoPrint{}));
+	}
+}
+
+void SerializedSizeTest()
+{
+	//构造覆盖各种写出分支的数据：嵌套列表、混合列表、带空元素的数值列表、End元素
+	NBT_Type::Compound cpdLevel{};
+	{
+		NBT_Type::List lstNested{};
+		for (int32_t i = 0; i < 4; ++i)
+		{
+			NBT_Type::List lstInner{};
+			for (int32_t j = 0; j <= i; ++j)
+			{
+				lstInner.AddBackInt(j * -70000);
+			}
+			lstNested.AddBackList(std::move(lstInner));
+		}
+
+		NBT_Type::List lstMixed{};
+		lstMixed.AddBackShort(3);
+		lstMixed.AddBackCompound(NBT_Type::Compound{ {MU8STR(""),NBT_Type::String(MU8STR("wrapped"))} });
+		lstMixed.AddBackCompound(NBT_Type::Compound{ {MU8STR("a"),NBT_Type::Byte{ 1 }},{MU8STR("b"),NBT_Type::Byte{ 2 }} });
+		lstMixed.AddBack(NBT_Node{});
+
+		NBT_Type::List lstNumericEmpty{};
+		lstNumericEmpty.AddBackLong(-1);
+		lstNumericEmpty.AddBack(NBT_Node{});
+		lstNumericEmpty.AddBackLong(1ll << 50);
+
+		NBT_Type::List lstSection{};
+		for (int32_t i = 0; i < 16; ++i)
+		{
+			NBT_Type::LongArray laStates(i * 16);
+			for (size_t j = 0; j < laStates.size(); ++j)
+			{
+				laStates[j] = (int64_t)(j * 0x0123456789ABCDEFull);
+			}
+			lstSection.AddBackCompound(NBT_Type::Compound
+			{
+				{MU8STR("Y"),NBT_Type::Byte{ (NBT_Type::Byte)i }},
+				{MU8STR("BlockStates"),std::move(laStates)},
+				{MU8STR("Palette"),NBT_Type::List{}},
+			});
+		}
+
+		NBT_Type::List lstFloat{};
+		for (int32_t i = 0; i < 100; ++i)
+		{
+			lstFloat.AddBackFloat(i * 0.1f);
+		}
+
+		cpdLevel.PutInt(MU8STR("xPos"), NBT_Type::Int{ -12 });
+		cpdLevel.PutLong(MU8STR("LastUpdate"), NBT_Type::Long{ 987654321 });
+		cpdLevel.PutString(MU8STR("Status"), MU8STR("minecraft:full"));
+		cpdLevel.PutList(MU8STR("Nested"), std::move(lstNested));
+		cpdLevel.PutList(MU8STR("Mixed"), std::move(lstMixed));
+		cpdLevel.PutList(MU8STR("NumericEmpty"), std::move(lstNumericEmpty));
+		cpdLevel.PutList(MU8STR("Sections"), std::move(lstSection));
+		cpdLevel.PutList(MU8STR("Floats"), std::move(lstFloat));
+		cpdLevel.PutIntArray(MU8STR("Heightmap"), NBT_Type::IntArray(256, 64));
+		cpdLevel.Put(MU8STR("Removed"), NBT_Node{});
+	}
+	NBT_Type::Compound cpdGen{ {MU8STR(""),NBT_Type::Compound{ {MU8STR("Level"),cpdLevel},{MU8STR("DataVersion"),NBT_Type::Int{ 3465 }} }} };
+
+	//计算的大小与各格式实际写出的大小一致，且写出只分配一次
+	auto CheckSize = [&]<typename Format>(void) -> void
+	{
+		std::vector<uint8_t> vData{};
+		MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, Format>(vData, 0, cpdGen)));
+		MyAssert(vData.capacity() == vData.size());
+
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNBTSize<Format>(cpdGen, szSize));
+		MyAssert(szSize == vData.size());
+
+		//排序策略不影响大小
+		std::vector<uint8_t> vNoSort{};
+		MyAssert((NBT_Writer::WriteNBT<NBT_Writer::NoSortCompound, Format>(vNoSort, 0, cpdGen)));
+		MyAssert(vNoSort.size() == szSize);
+
+		//负载大小：Compound比根部多一个NBT_TAG::End
+		size_t szPayload = 0;
+		MyAssert(NBT_Writer::GetPayloadSize<Format>(NBT_Node{ cpdGen }, szPayload));
+		MyAssert(szPayload == szSize + 1);
+
+		for (const auto &[sName, nodeChild] : cpdLevel)
+		{
+			std::vector<uint8_t> vNet{};
+			MyAssert((NBT_Writer::WriteNetworkNBT<NBT_Writer::DefaultCompoundSort<true>, Format>(vNet, 0, nodeChild)));
+			MyAssert(NBT_Writer::GetPayloadSize<Format>(nodeChild, szPayload));
+			MyAssert(szPayload + 1 == vNet.size());
+		}
+	};
+	CheckSize.template operator()<NBT_Format::BigEndian>();
+	CheckSize.template operator()<NBT_Format::LittleEndian>();
+	CheckSize.template operator()<NBT_Format::VarInt>();
+
+	//修改子树后重新计算即可得到新的大小
+	{
+		size_t szBefore = 0;
+		MyAssert(NBT_Writer::GetNBTSize<NBT_Format::VarInt>(cpdGen, szBefore));
+
+		NBT_Type::List &lstFloatRef = cpdGen.GetCompound(MU8STR("")).GetCompound(MU8STR("Level")).GetList(MU8STR("Floats"));
+		lstFloatRef.AddBackFloat(1.0f);
+
+		size_t szAfter = 0;
+		MyAssert(NBT_Writer::GetNBTSize<NBT_Format::VarInt>(cpdGen, szAfter));
+		MyAssert(szAfter == szBefore + sizeof(float));
+
+		std::vector<uint8_t> vAfter{};
+		MyAssert((NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, NBT_Format::VarInt>(vAfter, 0, cpdGen)));
+		MyAssert(vAfter.size() == szAfter);
+	}
+
+	//追加写出时同样只扩容一次
+	{
+		std::vector<uint8_t> vData{ 0x01, 0x02, 0x03 };
+		vData.shrink_to_fit();
+		MyAssert(NBT_Writer::WriteNBT(vData, vData.size(), cpdGen));
+		MyAssert(vData.capacity() == vData.size());
+		MyAssert(vData[0] == 0x01 && vData[2] == 0x03);
+
+		size_t szSize = 0;
+		MyAssert(NBT_Writer::GetNBTSize(cpdGen, szSize));
+		MyAssert(vData.size() == szSize + 3);
+	}
+
+	//空Compound根部不写出任何数据，嵌套过深计算失败
+	{
+		size_t szSize = 1;
+		MyAssert(NBT_Writer::GetNBTSize(NBT_Type::Compound{}, szSize));
+		MyAssert(szSize == 0);
+
+		//根、""、Level、Sections、Sections元素、Palette共6层
+		std::vector<uint8_t> vData{};
+		MyAssert(NBT_Writer::GetNBTSize(cpdGen, szSize, 6));
+		MyAssert(NBT_Writer::WriteNBT(vData, 0, cpdGen, 6));
+		MyAssert(!NBT_Writer::GetNBTSize(cpdGen, szSize, 5));
+		MyAssert(!NBT_Writer::WriteNBT(vData, 0, cpdGen, 5, NBT_NoPrint{}));
+	}
+}
+
+struct PriorityCompoundSort
+{
+	// 优先级键：按列表顺序排在最前面
+	static inline std::vector<NBT_Type::String> s_priorityKeys{};
+	// 拖尾键：按列表顺序排在最后面
+	static inline std::vector<NBT_Type::String> s_trailerKeys{};
+
+	std::vector<NBT_Type::Compound::Const_Iterator> operator()(const NBT_Type::Compound &cpdSort) const
+	{
+		std::vector<NBT_Type::Compound::Const_Iterator> result;
+		result.reserve(cpdSort.Size());
+
+		std::vector<NBT_Type::Compound::Const_Iterator> priorityIts;
+		std::vector<NBT_Type::Compound::Const_Iterator> normalIts;
+		std::vector<NBT_Type::Compound::Const_Iterator> trailerIts;
+
+		for (auto it = cpdSort.cbegin(); it != cpdSort.cend(); ++it)
+		{
+			bool bFound = false;
+
+			for (const auto &key : s_priorityKeys)
+			{
+				if (it->first == key)
+				{
+					priorityIts.push_back(it);
+					bFound = true;
+					break;
+				}
+			}
+			if (bFound) continue;
+
+			for (const auto &key : s_trailerKeys)
+			{
+				if (it->first == key)
+				{
+					trailerIts.push_back(it);
+					bFound = true;
+					break;
+				}
+			}
+			if (bFound) continue;
+
+			normalIts.push_back(it);
+		}
+
+		// 优先级键：按 s_priorityKeys 定义顺序排列
+		std::sort(priorityIts.begin(), priorityIts.end(),
+			[](const auto &l, const auto &r) -> bool
+			{
+				size_t posL = ~size_t(0), posR = ~size_t(0);
+				for (size_t i = 0; i < s_priorityKeys.size(); ++i)
+				{
+					if (l->first == s_priorityKeys[i]) posL = i;
+					if (r->first == s_priorityKeys[i]) posR = i;
+				}
+				return posL < posR;
+			});
+
+		// 普通键：字典升序
+		std::sort(normalIts.begin(), normalIts.end(),
+			[](const auto &l, const auto &r) -> bool
+			{
+				return l->first < r->first;
+			});
+
+		// 拖尾键：按 s_trailerKeys 定义顺序排列
+		std::sort(trailerIts.begin(), trailerIts.end(),
+			[](const auto &l, const auto &r) -> bool
+			{
+				size_t posL = ~size_t(0), posR = ~size_t(0);
+				for (size_t i = 0; i < s_trailerKeys.size(); ++i)
+				{
+					if (l->first == s_trailerKeys[i]) posL = i;
+					if (r->first == s_trailerKeys[i]) posR = i;
+				}
+				return posL < posR;
+			});
+
+		result.insert(result.end(), priorityIts.begin(), priorityIts.end());
+		result.insert(result.end(), normalIts.begin(), normalIts.end());
+		result.insert(result.end(), trailerIts.begin(), trailerIts.end());
+		return result;
+	}
+};
+
+class KeyOrderRecorder : public NBT_Visitor
+{
+public:
+	using ResultControl = NBT_Visitor::ResultControl;
+	using NestingControl = NBT_Visitor::NestingControl;
+
+	// 每层 Compound 的键出现顺序（根层在最后）
+	std::vector<std::vector<NBT_Type::String>> m_keyOrders;
+
+private:
+	std::vector<std::vector<NBT_Type::String>> m_keyStack;
+
+public:
+	NestingControl VisitCompoundEntryBegin(NBT_TAG enCompoundEntryTag, NBT_Type::String &&sName)
+	{
+		if (!m_keyStack.empty())
+			m_keyStack.back().push_back(std::move(sName));
+		return NestingControl::Enter;
+	}
+
+	ResultControl VisitCompoundBegin(void)
+	{
+		m_keyStack.push_back({});
+		return ResultControl::Continue;
+	}
+
+	ResultControl VisitCompoundEnd(void)
+	{
+		m_keyOrders.push_back(std::move(m_keyStack.back()));
+		m_keyStack.pop_back();
+		return ResultControl::Continue;
+	}
+
+	void VisitBegin(void)
+	{
+		m_keyStack.push_back({});
+	}
+
+	void VisitEnd(void)
+	{
+		m_keyOrders.push_back(std::move(m_keyStack.back()));
+		m_keyStack.pop_back();
+	}
+};
+
+void CustomPrioritySortTest(void)
+{
+	// ============================================================
+	// 1. 构造三层嵌套测试数据
+	// ============================================================
+
+	// 1.1 最深层 Compound（深度 = 3）
+	NBT_Type::Compound cpdDeep
+	{
+		{MU8STR("z_priority_first"), MU8STR("deep priority value")},
+		{MU8STR("a_deep_normal"),    (NBT_Type::Float)3.14f},
+		{MU8STR("b_deep_normal"),    (NBT_Type::Double)2.718281828},
+		{MU8STR("z_trailer_last"),   (NBT_Type::Long)999888777666},
+	};
+
+	// 1.2 中间层 Compound（深度 = 2），内含多种类型和一个嵌套 Compound
+	NBT_Type::Compound cpdNested
+	{
+		{MU8STR("z_priority_first"), (NBT_Type::Byte)10},
+		{MU8STR("a_nested_normal"),  (NBT_Type::Short)100},
+		{MU8STR("b_nested_normal"),  (NBT_Type::Int)1000},
+		{MU8STR("nested_deep"),      std::move(cpdDeep)},
+		{MU8STR("z_trailer_last"),   NBT_Type::ByteArray{1, 2, 3, 4, 5}},
+	};
+
+	// 1.3 构造一个 List 用于根层
+	NBT_Type::List testList
+	{
+		MU8STR("list_str_a"),
+		MU8STR("list_str_b"),
+		MU8STR("list_str_c"),
+	};
+
+	// 1.4 根 Compound（深度 = 1）
+	NBT_Type::Compound cpdRoot
+	{
+		{MU8STR(""), NBT_Type::Compound
+			{
+				{MU8STR("z_priority_first"),  (NBT_Type::Byte)1},
+				{MU8STR("a_normal_cpd"),      std::move(cpdNested)},
+				{MU8STR("b_normal"),          (NBT_Type::Byte)2},
+				{MU8STR("c_normal_list"),     std::move(testList)},
+				{MU8STR("y_priority_second"), (NBT_Type::Short)3},
+				{MU8STR("z_trailer_last"),    NBT_Type::LongArray{1, 2, 3}},
+			}
+		}
+	};
+
+	// ============================================================
+	// 2. 配置排序规则（对所有层级生效）
+	// ============================================================
+	PriorityCompoundSort::s_priorityKeys =
+	{
+		MU8STR("z_priority_first"),
+		MU8STR("y_priority_second"),
+	};
+	PriorityCompoundSort::s_trailerKeys =
+	{
+		MU8STR("z_trailer_last"),
+	};
+
+	// ============================================================
+	// 3. 写出：自定义排序 vs 默认排序
+	// ============================================================
+	std::vector<uint8_t> vDataPriority;
+	MyAssert(NBT_Writer::WriteNBT<PriorityCompoundSort>(vDataPriority, 0, cpdRoot));
+
+	std::vector<uint8_t> vDataDefault;
+	MyAssert(NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>>(vDataDefault, 0, cpdRoot));
+
+	// ============================================================
+	// 4. 用 KeyOrderRecorder 扫描自定义排序的二进制输出
 	// ============================================================
 	KeyOrderRecorder recorder;
 	MyAssert(NBT_Scanner::ScanNBT(vDataPriority, 0, recorder));
@@ -909,15 +3750,40 @@ void CustomPrioritySortTest(void)
 int main(void)
 {
 	StrHexArrayTest();
+	NBT_EndianArray_Test();
 	NBT_IO_Test();
 
 	MultiDataTest();
 	EmptyCompoundTest();
 	MixedListTest();
+	LargeArrayTest();
 
 	ScannerTest();
 	ScannerSkipTest();
 
+	InflateStreamTest();
+	DeflateStreamTest();
+	MmapStreamTest();
+	RegionFileTest();
+	RegionWriterTest();
+	ArenaAllocatorTest();
+	LazyCompoundTest();
+	PathQueryTest();
+	FlatMapTest();
+	KeyPoolTest();
+	NumericListTest();
+	PackedListTest();
+	SnbtReaderTest();
+	SerializeStreamTest();
+	MUTF8ConvertTest();
+	BorrowedReadTest();
+	ScannerViewTest();
+	ScannerArraySpanTest();
+	LittleEndianFormatTest();
+	VarIntFormatTest();
+	NetworkNBTTest();
+	SerializedSizeTest();
+
 	CustomPrioritySortTest();
 
 	return 0;
@@ -1,6 +1,858 @@
 ﻿#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main(void)
+#include <new>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+#include <nbt_cpp/NBT_All.hpp>
+#include <my/CodeTimer.hpp>
+
+//------------------------------------------------------------------------------
+//全局分配计数：替换全局operator new/delete，统计每次操作期间的分配次数
+//------------------------------------------------------------------------------
+
+//GCC会把替换后的operator new内联为malloc，进而误报delete中的free不匹配
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static std::atomic<uint64_t> g_u64AllocCount{ 0 };
+static std::atomic<uint64_t> g_u64AllocBytes{ 0 };
+
+void *operator new(size_t szSize)
+{
+	g_u64AllocCount.fetch_add(1, std::memory_order_relaxed);
+	g_u64AllocBytes.fetch_add(szSize, std::memory_order_relaxed);
+
+	void *p = malloc(szSize == 0 ? 1 : szSize);
+	if (p == NULL)
+	{
+		throw std::bad_alloc{};
+	}
+	return p;
+}
+
+void *operator new[](size_t szSize)
+{
+	return operator new(szSize);
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+	free(p);
+}
+
+//------------------------------------------------------------------------------
+//合成语料：模拟真实游戏数据的形状
+//------------------------------------------------------------------------------
+
+//简单的确定性伪随机数（xorshift64），保证每次运行语料完全一致
+class BenchRand
+{
+private:
+	uint64_t u64State;
+
+public:
+	BenchRand(uint64_t u64Seed) : u64State(u64Seed)
+	{}
+
+	uint64_t Next(void)
+	{
+		u64State ^= u64State << 13;
+		u64State ^= u64State >> 7;
+		u64State ^= u64State << 17;
+		return u64State;
+	}
+};
+
+static NBT_Type::String MakeString(const std::string &str)
+{
+	return NBT_Type::String(str.begin(), str.end());
+}
+
+static NBT_Type::LongArray MakeLongArray(BenchRand &rand, size_t szCount)
+{
+	NBT_Type::LongArray arr{};
+	arr.reserve(szCount);
+	for (size_t i = 0; i < szCount; ++i)
+	{
+		arr.push_back((NBT_Type::Long)rand.Next());
+	}
+	return arr;
+}
+
+static NBT_Type::ByteArray MakeByteArray(BenchRand &rand, size_t szCount)
+{
+	NBT_Type::ByteArray arr{};
+	arr.reserve(szCount);
+	for (size_t i = 0; i < szCount; ++i)
+	{
+		arr.push_back((NBT_Type::Byte)rand.Next());
+	}
+	return arr;
+}
+
+static const char *const g_strBlockNames[] =
+{
+	"minecraft:stone", "minecraft:deepslate", "minecraft:dirt", "minecraft:grass_block",
+	"minecraft:oak_log", "minecraft:oak_leaves", "minecraft:water", "minecraft:lava",
+	"minecraft:iron_ore", "minecraft:coal_ore", "minecraft:gravel", "minecraft:andesite",
+	"minecraft:diorite", "minecraft:granite", "minecraft:tuff", "minecraft:air",
+};
+
+//区块形状：24个section，每个包含调色板与LongArray，另有高度图、方块实体等
+static NBT_Type::Compound MakeChunkCorpus(void)
+{
+	BenchRand rand(0x9E3779B97F4A7C15);
+
+	NBT_Type::Compound cpdChunk{};
+	cpdChunk.PutInt(MU8STR("DataVersion"), 3955);
+	cpdChunk.PutInt(MU8STR("xPos"), -12);
+	cpdChunk.PutInt(MU8STR("zPos"), 34);
+	cpdChunk.PutInt(MU8STR("yPos"), -4);
+	cpdChunk.PutString(MU8STR("Status"), MU8STR("minecraft:full"));
+	cpdChunk.PutLong(MU8STR("LastUpdate"), 114514);
+	cpdChunk.PutLong(MU8STR("InhabitedTime"), 1919810);
+
+	NBT_Type::Compound cpdHeightmaps{};
+	cpdHeightmaps.PutLongArray(MU8STR("MOTION_BLOCKING"), MakeLongArray(rand, 37));
+	cpdHeightmaps.PutLongArray(MU8STR("MOTION_BLOCKING_NO_LEAVES"), MakeLongArray(rand, 37));
+	cpdHeightmaps.PutLongArray(MU8STR("OCEAN_FLOOR"), MakeLongArray(rand, 37));
+	cpdHeightmaps.PutLongArray(MU8STR("WORLD_SURFACE"), MakeLongArray(rand, 37));
+	cpdChunk.PutCompound(MU8STR("Heightmaps"), std::move(cpdHeightmaps));
+
+	NBT_Type::List listSections{};
+	for (int32_t y = -4; y < 20; ++y)
+	{
+		NBT_Type::Compound cpdSection{};
+		cpdSection.PutByte(MU8STR("Y"), (NBT_Type::Byte)y);
+
+		NBT_Type::List listPalette{};
+		size_t szPalette = 4 + rand.Next() % 12;
+		for (size_t i = 0; i < szPalette; ++i)
+		{
+			NBT_Type::Compound cpdBlock{};
+			cpdBlock.PutString(MU8STR("Name"), MakeString(g_strBlockNames[i % (sizeof(g_strBlockNames) / sizeof(g_strBlockNames[0]))]));
+			if (i % 3 == 0)
+			{
+				NBT_Type::Compound cpdProp{};
+				cpdProp.PutString(MU8STR("axis"), MU8STR("y"));
+				cpdProp.PutString(MU8STR("waterlogged"), MU8STR("false"));
+				cpdBlock.PutCompound(MU8STR("Properties"), std::move(cpdProp));
+			}
+			listPalette.AddBackCompound(std::move(cpdBlock));
+		}
+
+		NBT_Type::Compound cpdBlockStates{};
+		cpdBlockStates.PutList(MU8STR("palette"), std::move(listPalette));
+		cpdBlockStates.PutLongArray(MU8STR("data"), MakeLongArray(rand, 256));
+		cpdSection.PutCompound(MU8STR("block_states"), std::move(cpdBlockStates));
+
+		NBT_Type::Compound cpdBiomes{};
+		cpdBiomes.PutList(MU8STR("palette"), NBT_Type::List{ MU8STR("minecraft:plains"), MU8STR("minecraft:river") });
+		cpdBiomes.PutLongArray(MU8STR("data"), MakeLongArray(rand, 1));
+		cpdSection.PutCompound(MU8STR("biomes"), std::move(cpdBiomes));
+
+		cpdSection.PutByteArray(MU8STR("BlockLight"), MakeByteArray(rand, 2048));
+		cpdSection.PutByteArray(MU8STR("SkyLight"), MakeByteArray(rand, 2048));
+
+		listSections.AddBackCompound(std::move(cpdSection));
+	}
+	cpdChunk.PutList(MU8STR("sections"), std::move(listSections));
+
+	NBT_Type::List listBlockEntities{};
+	for (int32_t i = 0; i < 32; ++i)
+	{
+		NBT_Type::Compound cpdEntity{};
+		cpdEntity.PutString(MU8STR("id"), MU8STR("minecraft:chest"));
+		cpdEntity.PutInt(MU8STR("x"), i);
+		cpdEntity.PutInt(MU8STR("y"), 64);
+		cpdEntity.PutInt(MU8STR("z"), -i);
+		cpdEntity.PutByte(MU8STR("keepPacked"), 0);
+
+		NBT_Type::List listItems{};
+		for (int32_t j = 0; j < 8; ++j)
+		{
+			NBT_Type::Compound cpdItem{};
+			cpdItem.PutByte(MU8STR("Slot"), (NBT_Type::Byte)j);
+			cpdItem.PutString(MU8STR("id"), MU8STR("minecraft:diamond"));
+			cpdItem.PutInt(MU8STR("count"), 64);
+			listItems.AddBackCompound(std::move(cpdItem));
+		}
+		cpdEntity.PutList(MU8STR("Items"), std::move(listItems));
+
+		listBlockEntities.AddBackCompound(std::move(cpdEntity));
+	}
+	cpdChunk.PutList(MU8STR("block_entities"), std::move(listBlockEntities));
+
+	return NBT_Type::Compound{ {MU8STR(""), std::move(cpdChunk)} };
+}
+
+//超大LongArray：以数组解码/编码吞吐为主
+static NBT_Type::Compound MakeLongArrayCorpus(void)
+{
+	BenchRand rand(0xD1B54A32D192ED03);
+
+	NBT_Type::Compound cpdRoot{};
+	cpdRoot.PutLongArray(MU8STR("data0"), MakeLongArray(rand, 1 << 16));
+	cpdRoot.PutLongArray(MU8STR("data1"), MakeLongArray(rand, 1 << 16));
+	cpdRoot.PutLongArray(MU8STR("data2"), MakeLongArray(rand, 1 << 16));
+	cpdRoot.PutLongArray(MU8STR("data3"), MakeLongArray(rand, 1 << 16));
+
+	return NBT_Type::Compound{ {MU8STR(""), std::move(cpdRoot)} };
+}
+
+//深层列表：多条深度递归的List链，末端为小数值列表
+static NBT_Type::Compound MakeDeepListCorpus(void)
+{
+	constexpr size_t szChainCount = 32;
+	constexpr size_t szChainDepth = 256;//小于默认的最大深度512
+
+	NBT_Type::Compound cpdRoot{};
+	for (size_t szChain = 0; szChain < szChainCount; ++szChain)
+	{
+		NBT_Type::List listCur{};
+		for (int32_t i = 0; i < 4; ++i)
+		{
+			listCur.AddBackInt(i);
+		}
+
+		for (size_t szDepth = 0; szDepth < szChainDepth; ++szDepth)
+		{
+			NBT_Type::List listOuter{};
+			listOuter.AddBackList(std::move(listCur));
+			listCur = std::move(listOuter);
+		}
+
+		cpdRoot.PutList(MakeString("chain" + std::to_string(szChain)), std::move(listCur));
+	}
+
+	return NBT_Type::Compound{ {MU8STR(""), std::move(cpdRoot)} };
+}
+
+//字符串密集的调色板：大量短字符串与小Compound
+static NBT_Type::Compound MakeStringPaletteCorpus(void)
+{
+	BenchRand rand(0x94D049BB133111EB);
+
+	NBT_Type::List listPalette{};
+	for (size_t i = 0; i < 4096; ++i)
+	{
+		NBT_Type::Compound cpdEntry{};
+		cpdEntry.PutString(MU8STR("Name"), MakeString(std::string(g_strBlockNames[rand.Next() % (sizeof(g_strBlockNames) / sizeof(g_strBlockNames[0]))]) + "_" + std::to_string(i)));
+
+		NBT_Type::Compound cpdProp{};
+		cpdProp.PutString(MU8STR("facing"), MU8STR("north"));
+		cpdProp.PutString(MU8STR("half"), MU8STR("bottom"));
+		cpdProp.PutString(MU8STR("shape"), MakeString("variant_" + std::to_string(rand.Next() % 64)));
+		cpdEntry.PutCompound(MU8STR("Properties"), std::move(cpdProp));
+
+		listPalette.AddBackCompound(std::move(cpdEntry));
+	}
+
+	NBT_Type::Compound cpdRoot{};
+	cpdRoot.PutList(MU8STR("palette"), std::move(listPalette));
+
+	return NBT_Type::Compound{ {MU8STR(""), std::move(cpdRoot)} };
+}
+
+//数值列表密集：大量实体的坐标、速度与旋转，以及几个较长的数值列表
+static NBT_Type::Compound MakeNumericListCorpus(void)
+{
+	BenchRand rand(0xBF58476D1CE4E5B9);
+
+	NBT_Type::List listEntities{};
+	for (size_t i = 0; i < 1024; ++i)
+	{
+		NBT_Type::List listPos{}, listMotion{}, listRotation{};
+		for (size_t j = 0; j < 3; ++j)
+		{
+			listPos.AddBackDouble((double)(rand.Next() % 100000) / 16.0);
+			listMotion.AddBackDouble((double)(int64_t)(rand.Next() % 2001 - 1000) / 1000.0);
+		}
+		listRotation.AddBackFloat((float)(rand.Next() % 360));
+		listRotation.AddBackFloat((float)(rand.Next() % 180) - 90.0f);
+
+		NBT_Type::Compound cpdEntity{};
+		cpdEntity.PutList(MU8STR("Pos"), std::move(listPos));
+		cpdEntity.PutList(MU8STR("Motion"), std::move(listMotion));
+		cpdEntity.PutList(MU8STR("Rotation"), std::move(listRotation));
+		listEntities.AddBackCompound(std::move(cpdEntity));
+	}
+
+	NBT_Type::List listInt{}, listLong{}, listShort{};
+	for (size_t i = 0; i < 1 << 14; ++i)
+	{
+		listInt.AddBackInt((NBT_Type::Int)rand.Next());
+		listLong.AddBackLong((NBT_Type::Long)rand.Next());
+		listShort.AddBackShort((NBT_Type::Short)rand.Next());
+	}
+
+	NBT_Type::Compound cpdRoot{};
+	cpdRoot.PutList(MU8STR("Entities"), std::move(listEntities));
+	cpdRoot.PutList(MU8STR("ints"), std::move(listInt));
+	cpdRoot.PutList(MU8STR("longs"), std::move(listLong));
+	cpdRoot.PutList(MU8STR("shorts"), std::move(listShort));
+
+	return NBT_Type::Compound{ {MU8STR(""), std::move(cpdRoot)} };
+}
+
+//统计NBT节点数量（每个标签计为一个节点，数组整体计为一个节点）
+static uint64_t CountNodes(const NBT_Node &node)
+{
+	uint64_t u64Count = 1;
+
+	if (const auto *pCompound = node.GetIfCompound(); pCompound != NULL)
+	{
+		for (const auto &[sName, nodeSub] : *pCompound)
+		{
+			u64Count += CountNodes(nodeSub);
+		}
+	}
+	else if (const auto *pList = node.GetIfList(); pList != NULL)
+	{
+		for (const auto &nodeSub : *pList)
+		{
+			u64Count += CountNodes(nodeSub);
+		}
+	}
+
+	return u64Count;
+}
+
+static uint64_t CountNodes(const NBT_Type::Compound &cpdRoot)
+{
+	uint64_t u64Count = 0;
+	for (const auto &[sName, nodeSub] : cpdRoot)
+	{
+		u64Count += CountNodes(nodeSub);
+	}
+	return u64Count;
+}
+
+//收集树中所有集合的所有键，用于测量集合查找
+static void CollectKeys(const NBT_Type::Compound &cpdRoot, std::vector<std::pair<const NBT_Type::Compound *, const NBT_Type::String *>> &vKeys)
+{
+	for (const auto &[sName, nodeSub] : cpdRoot)
+	{
+		vKeys.emplace_back(&cpdRoot, &sName);
+
+		if (const auto *pCompound = nodeSub.GetIfCompound(); pCompound != NULL)
+		{
+			CollectKeys(*pCompound, vKeys);
+		}
+		else if (const auto *pList = nodeSub.GetIfList(); pList != NULL)
+		{
+			for (const auto &nodeElement : *pList)
+			{
+				if (const auto *pElement = nodeElement.GetIfCompound(); pElement != NULL)
+				{
+					CollectKeys(*pElement, vKeys);
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+//过滤扫描：只比较键名并统计字符串长度，不保留任何数据
+//------------------------------------------------------------------------------
+
+//字符串对象模式，扫描器为每个键名与字符串分配对象
+class BenchFilterVisitor : public NBT_Visitor
+{
+public:
+	uint64_t u64Match = 0;
+	uint64_t u64StringBytes = 0;
+
+	NestingControl VisitCompoundEntryBegin(NBT_TAG enCompoundEntryTag, NBT_Type::String &&sName)
+	{
+		if (sName == MU8STRV("Name"))
+		{
+			++u64Match;
+		}
+		return NestingControl::Enter;
+	}
+
+	ResultControl VisitStringResult(NBT_Type::String &&strResult)
+	{
+		u64StringBytes += strResult.size();
+		return ResultControl::Continue;
+	}
+};
+
+//视图模式，键名与字符串直接指向输入数据
+class BenchFilterViewVisitor : public NBT_ViewVisitor
+{
+public:
+	uint64_t u64Match = 0;
+	uint64_t u64StringBytes = 0;
+
+	NestingControl VisitCompoundEntryBegin(NBT_TAG enCompoundEntryTag, NBT_Type::String::View sName)
+	{
+		if (sName == MU8STRV("Name"))
+		{
+			++u64Match;
+		}
+		return NestingControl::Enter;
+	}
+
+	ResultControl VisitStringResult(NBT_Type::String::View strResult)
+	{
+		u64StringBytes += strResult.size();
+		return ResultControl::Continue;
+	}
+};
+
+//视图模式加数组原始数据回调，数组只读取长度与首个元素
+class BenchFilterSpanVisitor : public BenchFilterViewVisitor
+{
+public:
+	uint64_t u64ArrayElements = 0;
+
+	template<typename T>
+	ResultControl VisitArraySpanResult(NBT_BigEndianSpan<T> spanResult)
+	{
+		u64ArrayElements += spanResult.size();
+		if (!spanResult.empty())
+		{
+			u64StringBytes += (uint64_t)spanResult[0];
+		}
+		return ResultControl::Continue;
+	}
+};
+
+//------------------------------------------------------------------------------
+//测量与输出
+//------------------------------------------------------------------------------
+
+struct BenchResult
+{
+	std::string strCorpus{};
+	std::string strOperation{};
+	uint64_t u64Bytes = 0;//每次操作处理的字节数（未压缩的NBT大小，压缩相关则为未压缩侧）
+	uint64_t u64Nodes = 0;//每次操作处理的节点数
+	uint64_t u64BestNs = 0;//多次迭代中的最短耗时
+	uint64_t u64AllocCount = 0;//单次操作的分配次数
+	uint64_t u64AllocBytes = 0;//单次操作的分配字节数
+};
+
+//运行一次预热后，迭代多次取最短耗时；分配统计取最后一次迭代
+static BenchResult RunBench(const char *pCorpus, const char *pOperation, uint64_t u64Bytes, uint64_t u64Nodes, size_t szIterations, const std::function<void(void)> &funcOp)
+{
+	BenchResult ret{ pCorpus, pOperation, u64Bytes, u64Nodes, UINT64_MAX, 0, 0 };
+
+	funcOp();//预热
+
+	CodeTimer timer{};
+	for (size_t i = 0; i < szIterations; ++i)
+	{
+		uint64_t u64CountBeg = g_u64AllocCount.load(std::memory_order_relaxed);
+		uint64_t u64BytesBeg = g_u64AllocBytes.load(std::memory_order_relaxed);
+
+		timer.Start();
+		funcOp();
+		timer.Stop();
+
+		ret.u64AllocCount = g_u64AllocCount.load(std::memory_order_relaxed) - u64CountBeg;
+		ret.u64AllocBytes = g_u64AllocBytes.load(std::memory_order_relaxed) - u64BytesBeg;
+
+		uint64_t u64Ns = (uint64_t)timer.Diff<std::chrono::nanoseconds>().count();
+		if (u64Ns < ret.u64BestNs)
+		{
+			ret.u64BestNs = u64Ns;
+		}
+	}
+
+	if (ret.u64BestNs == 0)
+	{
+		ret.u64BestNs = 1;//防止除零
+	}
+
+	return ret;
+}
+
+static double GetMBps(const BenchResult &res)
+{
+	return ((double)res.u64Bytes / (1024.0 * 1024.0)) / ((double)res.u64BestNs / 1e9);
+}
+
+static double GetNodesps(const BenchResult &res)
+{
+	return (double)res.u64Nodes / ((double)res.u64BestNs / 1e9);
+}
+
+static double GetAllocsPerNode(const BenchResult &res)
+{
+	return res.u64Nodes == 0 ? 0.0 : (double)res.u64AllocCount / (double)res.u64Nodes;
+}
+
+static void PrintTable(FILE *fp, const std::vector<BenchResult> &vResult)
+{
+	fprintf(fp, "%-16s %-20s %12s %10s %12s %14s %12s\n", "corpus", "operation", "bytes", "nodes", "MB/s", "nodes/s", "allocs/node");
+	for (const auto &it : vResult)
+	{
+		fprintf(fp, "%-16s %-20s %12llu %10llu %12.2f %14.0f %12.3f\n",
+			it.strCorpus.c_str(), it.strOperation.c_str(),
+			(unsigned long long)it.u64Bytes, (unsigned long long)it.u64Nodes,
+			GetMBps(it), GetNodesps(it), GetAllocsPerNode(it));
+	}
+}
+
+static void PrintJson(FILE *fp, size_t szIterations, const std::vector<BenchResult> &vResult)
+{
+	fprintf(fp, "{\n\t\"iterations\": %zu,\n\t\"results\": [\n", szIterations);
+	for (size_t i = 0; i < vResult.size(); ++i)
+	{
+		const auto &it = vResult[i];
+		fprintf(fp,
+			"\t\t{\"corpus\": \"%s\", \"operation\": \"%s\", \"bytes\": %llu, \"nodes\": %llu, "
+			"\"best_ns\": %llu, \"mb_per_s\": %.3f, \"nodes_per_s\": %.1f, "
+			"\"allocs\": %llu, \"alloc_bytes\": %llu, \"allocs_per_node\": %.4f}%s\n",
+			it.strCorpus.c_str(), it.strOperation.c_str(),
+			(unsigned long long)it.u64Bytes, (unsigned long long)it.u64Nodes,
+			(unsigned long long)it.u64BestNs, GetMBps(it), GetNodesps(it),
+			(unsigned long long)it.u64AllocCount, (unsigned long long)it.u64AllocBytes, GetAllocsPerNode(it),
+			i + 1 < vResult.size() ? "," : "");
+	}
+	fprintf(fp, "\t]\n}\n");
+}
+
+//对一个语料运行所有基准
+static void BenchCorpus(const char *pCorpus, const NBT_Type::Compound &cpdCorpus, size_t szIterations, std::vector<BenchResult> &vResult)
 {
+	std::vector<uint8_t> vData{};
+	if (!NBT_Writer::WriteNBT(vData, 0, cpdCorpus))
+	{
+		fprintf(stderr, "corpus [%s] write failed\n", pCorpus);
+		exit(-1);
+	}
+
+	std::vector<uint8_t> vZipped{};
+	NBT_IO::CompressData(vZipped, vData);
+
+	std::vector<uint8_t> vLittle{};
+	if (!NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, NBT_Format::LittleEndian>(vLittle, 0, cpdCorpus))
+	{
+		fprintf(stderr, "corpus [%s] little endian write failed\n", pCorpus);
+		exit(-1);
+	}
+
+	std::vector<uint8_t> vVarInt{};
+	if (!NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, NBT_Format::VarInt>(vVarInt, 0, cpdCorpus))
+	{
+		fprintf(stderr, "corpus [%s] varint write failed\n", pCorpus);
+		exit(-1);
+	}
+
+	const uint64_t u64Bytes = vData.size();
+	const uint64_t u64Nodes = CountNodes(cpdCorpus);
+
+	vResult.push_back(RunBench(pCorpus, "ReadNBT", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_Type::Compound cpdRead{};
+			if (!NBT_Reader::ReadNBT(vData, 0, cpdRead))
+			{
+				exit(-1);
+			}
+		}));
+
+	//小端序（基岩版）：小端平台上数值与数组直接拷贝，不转换字节序
+	vResult.push_back(RunBench(pCorpus, "ReadNBT_LittleEndian", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_Type::Compound cpdRead{};
+			if (!NBT_Reader::ReadNBT<true, NBT_Format::LittleEndian>(vLittle, 0, cpdRead))
+			{
+				exit(-1);
+			}
+		}));
+
+	//网络VarInt（基岩版）：Int/Long与长度字段按变长整数解码
+	vResult.push_back(RunBench(pCorpus, "ReadNBT_VarInt", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_Type::Compound cpdRead{};
+			if (!NBT_Reader::ReadNBT<true, NBT_Format::VarInt>(vVarInt, 0, cpdRead))
+			{
+				exit(-1);
+			}
+		}));
+
+#ifdef CJF2_NBT_CPP_USE_ARENA_ALLOCATOR
+	vResult.push_back(RunBench(pCorpus, "ReadNBT_Arena", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::pmr::monotonic_buffer_resource mbrArena{ vData.size() * 2 };
+			NBT_ArenaScope asScope(&mbrArena);
+			NBT_Type::Compound cpdRead{};
+			if (!NBT_Reader::ReadNBT(vData, 0, cpdRead))
+			{
+				exit(-1);
+			}
+		}));
+#endif
+
+	//借用模式：字符串与数组指向输入数据，不拷贝也不转换字节序
+	vResult.push_back(RunBench(pCorpus, "ReadNBT_Borrowed", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_BorrowedNode::Compound cpdRead{};
+			if (!NBT_BorrowedReader::ReadNBT(vData, 0, cpdRead))
+			{
+				exit(-1);
+			}
+		}));
+
+	//键驻留：池在所有迭代间共享，第一次之后全部命中
+	NBT_KeyPool kpRead{};
+	vResult.push_back(RunBench(pCorpus, "ReadNBT_KeyPool", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_KeyPoolScope kpsScope(&kpRead);
+			NBT_Type::Compound cpdRead{};
+			if (!NBT_Reader::ReadNBT(vData, 0, cpdRead))
+			{
+				exit(-1);
+			}
+		}));
+
+	//集合查找：对树中每个集合的每个键调用一次Has，衡量集合底层容器的查找开销
+	std::vector<std::pair<const NBT_Type::Compound *, const NBT_Type::String *>> vKeys{};
+	CollectKeys(cpdCorpus, vKeys);
+	vResult.push_back(RunBench(pCorpus, "CompoundLookup", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			for (const auto &[pCompound, pName] : vKeys)
+			{
+				if (pCompound->Has(*pName) == nullptr)
+				{
+					exit(-1);
+				}
+			}
+		}));
+
+	//按需解析：建立索引后只访问根集合中的一个字段
+	const NBT_Type::String sFirstKey = cpdCorpus.GetCompound(MU8STR("")).begin()->first;
+	vResult.push_back(RunBench(pCorpus, "LazyParse_FirstField", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_LazyCompound lcRead{};
+			if (!lcRead.ParseBorrowed(std::span<const uint8_t>(vData.data(), vData.size())))
+			{
+				exit(-1);
+			}
+			if (lcRead.GetLazyCompound(MU8STR("")).Has(sFirstKey) == nullptr)
+			{
+				exit(-1);
+			}
+		}));
+
+	//路径查询：扫描时只进入与路径匹配的部分
+	NBT_Visitor_PathQuery vqFirstField{};
+	vqFirstField.AddPath("\"\".\"" + sFirstKey.ToCharTypeUTF8() + "\"");
+	vResult.push_back(RunBench(pCorpus, "PathQuery_FirstField", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			vqFirstField.ClearResult();
+			if (!NBT_Scanner::ScanNBT(vData, 0, vqFirstField) || vqFirstField.ViewResult(0).empty())
+			{
+				exit(-1);
+			}
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "WriteNBT", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vWrite{};
+			if (!NBT_Writer::WriteNBT(vWrite, 0, cpdCorpus))
+			{
+				exit(-1);
+			}
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "WriteNBT_LittleEndian", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vWrite{};
+			if (!NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, NBT_Format::LittleEndian>(vWrite, 0, cpdCorpus))
+			{
+				exit(-1);
+			}
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "WriteNBT_VarInt", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vWrite{};
+			if (!NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>, NBT_Format::VarInt>(vWrite, 0, cpdCorpus))
+			{
+				exit(-1);
+			}
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "WriteNBT_Sorted", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vWrite{};
+			if (!NBT_Writer::WriteNBT<NBT_Writer::DefaultCompoundSort<true>>(vWrite, 0, cpdCorpus))
+			{
+				exit(-1);
+			}
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "ScanNBT_Collector", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_Visitor_Collector vc{};
+			if (!NBT_Scanner::ScanNBT(vData, 0, vc))
+			{
+				exit(-1);
+			}
+			NBT_Type::Compound cpdScan = vc.MoveRoot();
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "ScanNBT_Filter", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			BenchFilterVisitor vf{};
+			if (!NBT_Scanner::ScanNBT(vData, 0, vf))
+			{
+				exit(-1);
+			}
+			volatile uint64_t u64Sink = vf.u64Match + vf.u64StringBytes;
+			(void)u64Sink;
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "ScanNBT_FilterView", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			BenchFilterViewVisitor vf{};
+			if (!NBT_Scanner::ScanNBT(vData, 0, vf))
+			{
+				exit(-1);
+			}
+			volatile uint64_t u64Sink = vf.u64Match + vf.u64StringBytes;
+			(void)u64Sink;
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "ScanNBT_FilterSpan", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			BenchFilterSpanVisitor vf{};
+			if (!NBT_Scanner::ScanNBT(vData, 0, vf))
+			{
+				exit(-1);
+			}
+			volatile uint64_t u64Sink = vf.u64Match + vf.u64StringBytes + vf.u64ArrayElements;
+			(void)u64Sink;
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "CompressData", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vOut{};
+			NBT_IO::CompressData(vOut, vData);
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "DecompressData", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vOut{};
+			NBT_IO::DecompressData(vOut, vZipped);
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "Hash", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			volatile NBT_Hash::HASH_T hash = NBT_Helper::Hash(cpdCorpus, NBT_Hash{ 0x12345678 });
+			(void)hash;
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "Serialize", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::string strOut = NBT_Helper::Serialize(cpdCorpus);
+		}));
+
+	vResult.push_back(RunBench(pCorpus, "SerializeStream", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::vector<uint8_t> vOut{};
+			NBT_IO::DefaultOutputStream<std::vector<uint8_t>> osOut(vOut);
+			NBT_Helper::Serialize<NBT_Helper::DefaultCompoundSort<true>, false, true>(cpdCorpus, osOut);
+		}));
+
+	//SNBT文本解析，输入为Serialize的SNBT输出
+	const NBT_Type::String sSnbt = NBT_Helper::Serialize<NBT_Helper::DefaultCompoundSort<true>, false, true>(cpdCorpus);
+	vResult.push_back(RunBench(pCorpus, "ReadSNBT", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			NBT_Type::Compound cpdOut{};
+			NBT_SNBT_Reader::ReadSNBT<true>(sSnbt.GetCharTypeView(), cpdOut);
+		}));
+
+	//M-UTF-8与UTF-8、UTF-16的相互转换，输入同样为SNBT文本
+	vResult.push_back(RunBench(pCorpus, "MUTF8_Convert", u64Bytes, u64Nodes, szIterations, [&](void) -> void
+		{
+			std::u8string u8Str = sSnbt.ToUTF8();
+			std::u16string u16Str = sSnbt.ToUTF16();
+			volatile size_t szSize = MUTF8_Tool<>::U8ToMU8(u8Str).size() + MUTF8_Tool<>::U16ToMU8(u16Str).size();
+			(void)szSize;
+		}));
+}
+
+//用法：nbt_benchmark [-n 迭代次数] [-o JSON输出文件]
+//结果表格输出到stderr，JSON输出到stdout（或指定文件），便于对比不同版本的运行结果
+int main(int argc, char *argv[])
+{
+	size_t szIterations = 3;//默认迭代次数较少，以便在CI中快速完成
+	const char *pJsonPath = NULL;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			szIterations = (size_t)strtoull(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+			pJsonPath = argv[++i];
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-n iterations] [-o output.json]\n", argv[0]);
+			return -1;
+		}
+	}
+
+	if (szIterations == 0)
+	{
+		szIterations = 1;
+	}
+
+	std::vector<BenchResult> vResult{};
+	BenchCorpus("chunk", MakeChunkCorpus(), szIterations, vResult);
+	BenchCorpus("long_array", MakeLongArrayCorpus(), szIterations, vResult);
+	BenchCorpus("deep_list", MakeDeepListCorpus(), szIterations, vResult);
+	BenchCorpus("string_palette", MakeStringPaletteCorpus(), szIterations, vResult);
+	BenchCorpus("numeric_list", MakeNumericListCorpus(), szIterations, vResult);
+
+	PrintTable(stderr, vResult);
+
+	if (pJsonPath != NULL)
+	{
+		FILE *fp = fopen(pJsonPath, "wb");
+		if (fp == NULL)
+		{
+			fprintf(stderr, "cannot open [%s]\n", pJsonPath);
+			return -1;
+		}
+		PrintJson(fp, szIterations, vResult);
+		fclose(fp);
+	}
+	else
+	{
+		PrintJson(stdout, szIterations, vResult);
+	}
+
 	return 0;
-}
\ No newline at end of file
+}